@@ -99,13 +99,15 @@ public:
 
     /// @brief Builds a new Device
     /// @param serial Serial number of the camera to open. If it is an empty string, the first available camera will be
-    /// opened
+    /// opened. If it starts with "shm://", the stream published in the shared memory ring with the following name is
+    /// opened (see @ref ShmRingWriter)
     /// @return A new Device
     static std::unique_ptr<Device> open(const std::string &serial);
 
     /// @brief Builds a new Device
     /// @param serial Serial number of the camera to open. If it is an empty string, the first available camera will be
-    /// opened
+    /// opened. If it starts with "shm://", the stream published in the shared memory ring with the following name is
+    /// opened (see @ref ShmRingWriter)
     /// @param config Configuration used to build the camera
     /// @return A new Device
     static std::unique_ptr<Device> open(const std::string &serial, DeviceConfig &config);
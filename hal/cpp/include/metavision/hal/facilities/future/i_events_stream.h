@@ -14,6 +14,7 @@
 
 #include <string>
 #include <fstream>
+#include <functional>
 #include <memory>
 #include <thread>
 #include <mutex>
@@ -76,6 +77,22 @@ public:
     /// log_raw_data
     RawData *get_latest_raw_data(long &n_rawbytes);
 
+    /// @brief Gets the number of buffers transferred by the data transfer that have not been retrieved yet with
+    /// @ref get_latest_raw_data
+    /// @return Number of buffers waiting to be processed
+    size_t get_pending_buffers_count();
+
+    /// @brief Gets the number of buffers dropped by the underlying data transfer
+    /// @return Number of dropped buffers since the events stream was built
+    uint64_t get_dropped_buffers_count() const;
+
+    /// @brief Gets the data transfer owned by this events stream
+    ///
+    /// Callbacks added to the data transfer are called with the whole transferred buffers, e.g. to publish them with
+    /// @ref ShmRingWriter::tap. They must be added or removed while the stream is stopped.
+    /// @return The underlying data transfer
+    DataTransfer &get_data_transfer();
+
     /// @brief Enables the logging of the stream of events in the input file @a f
     ///
     /// This methods first writes the header retrieved through @ref I_HW_Identification.
@@ -162,13 +179,27 @@ public:
     /// dedicated thread. Until the index is loaded in memory, seek operations are not available. The return value
     /// of @ref get_seek_range can be used to check the current @ref IndexStatus.
     ///
+    /// The index is built in the background with a low CPU and I/O priority, and its read bandwidth is bounded while
+    /// an events stream of the file is streaming, so that streaming can start right away. If an index is already
+    /// being built for the same RAW file by another events stream of the process, it is shared and
+    /// @p device_for_indexing is not used.
+    ///
     /// @param device_for_indexing The device to use to index the RAW file.
     /// @warning The input device must have been built with the same RAW file used to initialize this class
     void index(std::unique_ptr<Device> device_for_indexing);
 
+    /// @brief Builds an index to enable navigation in a RAW file, as @ref index(std::unique_ptr<Device>), opening the
+    /// device used for indexing only if the index isn't shared with another events stream
+    /// @param make_device_for_indexing Function returning the device to use to index the RAW file, not called if the
+    /// index is shared
+    /// @warning The device must have been built with the same RAW file used to initialize this class
+    void index(const std::function<std::unique_ptr<Device>()> &make_device_for_indexing);
+
 private:
-    /// @brief Builds and loads the index in memory
-    virtual Index index_impl(Device &device);
+    struct IndexBuilder;
+
+    /// @brief Sets the index once it has been built or loaded
+    void set_index(const Index &index);
 
     void release_data_transfer_buffers();
 
@@ -199,9 +230,8 @@ private:
     bool stop_;
 
     std::atomic<bool> seeking_;
-    std::thread index_build_thread_;
+    std::shared_ptr<IndexBuilder> index_builder_;
     Index index_;
-    std::atomic<bool> abort_index_building_;
     mutable std::mutex index_safety_;
 };
 
@@ -70,6 +70,22 @@ public:
     /// @note This function must be called to write the buffer of events in the log file defined in @ref log_raw_data
     RawData *get_latest_raw_data(long &n_rawbytes);
 
+    /// @brief Gets the number of buffers transferred by the data transfer that have not been retrieved yet with
+    /// @ref get_latest_raw_data
+    /// @return Number of buffers waiting to be processed
+    size_t get_pending_buffers_count();
+
+    /// @brief Gets the number of buffers dropped by the underlying data transfer
+    /// @return Number of dropped buffers since the events stream was built
+    uint64_t get_dropped_buffers_count() const;
+
+    /// @brief Gets the data transfer owned by this events stream
+    ///
+    /// Callbacks added to the data transfer are called with the whole transferred buffers, e.g. to publish them with
+    /// @ref ShmRingWriter::tap. They must be added or removed while the stream is stopped.
+    /// @return The underlying data transfer
+    DataTransfer &get_data_transfer();
+
     /// @brief Enables the logging of the stream of events in the input file @a f
     ///
     /// This methods first writes the header retrieved through @ref I_HW_Identification.
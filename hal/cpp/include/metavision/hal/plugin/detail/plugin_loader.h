@@ -9,6 +9,9 @@
  * See the License for the specific language governing permissions and limitations under the License.                 *
  **********************************************************************************************************************/
 
+#include <map>
+#include <memory>
+#include <set>
 #include <vector>
 #include <string>
 
@@ -27,21 +30,55 @@ public:
     void insert_folder(const std::string &folder);
     void insert_folders(const std::vector<std::string> &folders);
 
+    /// @brief Lists the plugin libraries available in the folders, without loading them
+    void discover_plugins();
+
+    /// @brief Forgets the libraries listed by @ref discover_plugins, already loaded plugins are kept loaded
+    void clear_discovered_plugins();
+
+    /// @brief Discovers and loads all the plugins available in the folders
     void load_plugins();
 
+    /// @brief Loads the discovered plugins that may match the input names
+    ///
+    /// Only the libraries which can match are opened: the plugin name is the library name and the integrator name of
+    /// a library already opened once is kept in the discovery cache.
+    ///
+    /// @param integrator_name Integrator name the plugins must match, or empty to match any integrator
+    /// @param plugin_name Plugin name the plugins must match, or empty to match any plugin
+    void load_plugins(const std::string &integrator_name, const std::string &plugin_name);
+
+    /// @brief Sets the file used to persist the discovery cache between processes
+    ///
+    /// The cache maps each library (path and modification time) to the integrator name of the plugin it contains, so
+    /// that opening a device does not require to open all the libraries in a new process.
+    /// @param cache_file Path of the cache file, or empty to only keep the cache in memory
+    void set_discovery_cache_file(const std::string &cache_file);
+
     class PluginList;
     PluginList get_plugin_list();
 
 private:
     struct PluginInfo;
     struct Library;
+    struct CacheEntry {
+        long long modification_time{0};
+        bool is_plugin{false};
+        std::string integrator_name;
+    };
 
-    void insert_plugin(const std::string &name, const std::string &library_path);
-    void insert_plugin(const PluginInfo &info);
+    void read_discovery_cache();
+    void write_discovery_cache() const;
 
     std::vector<std::string> folders_;
+    std::vector<std::pair<std::string, std::string>> discovered_plugins_; // plugin name and library path
+    std::set<std::string> opened_library_paths_;
     std::vector<std::unique_ptr<Library>> libraries_;
 
+    std::string cache_file_;
+    std::map<std::string, CacheEntry> cache_;
+    bool cache_dirty_{false};
+
     static std::unique_ptr<Plugin> make_plugin(const std::string &plugin_name);
 
 public:
@@ -103,6 +103,13 @@ public:
         return true;
     }
 
+    /// @brief Returns the number of buffers that have been dropped since the data transfer was built
+    /// @note Buffers can only be dropped when the data transfer has been built with a bounded buffer pool and buffer
+    /// drop allowed
+    uint64_t get_dropped_buffers_count() const {
+        return dropped_buffers_count_;
+    }
+
 protected:
     /// @brief Returns the size of a RAW event in bytes
     ///
@@ -127,6 +134,7 @@ protected:
             // No storage left and we don't want to wait on a buffer to be freed.
             // We drop the buffer, back to the pool !
             buffer.reset();
+            ++dropped_buffers_count_;
         } else {
             fire_callbacks(buffer);
         }
@@ -197,6 +205,7 @@ private:
     std::atomic<bool> stop_{false};
     uint32_t cb_index_{0};
     const bool allow_buffer_drop_{false};
+    std::atomic<uint64_t> dropped_buffers_count_{0};
 };
 
 } // namespace Metavision
@@ -54,6 +54,10 @@ public:
     /// @param data_end_pos The offset position of the next position after the last data in the file
     void get_seek_range(std::streampos &data_start_pos, std::streampos &data_end_pos) const;
 
+    /// @brief Gets the position in the file of the next data to be read
+    /// @note This position is updated by the transfer thread, it may thus be ahead of the data already processed
+    std::streampos get_read_position() const;
+
 private:
     FileDataTransfer(const std::shared_ptr<std::istream> &stream, uint32_t raw_event_size_bytes,
                      const RawFileConfig &config);
@@ -78,6 +82,7 @@ private:
     std::mutex stream_mutex_;
     std::condition_variable stream_cond_;
     std::streampos data_start_pos_, data_end_pos_;
+    std::atomic<int64_t> read_position_;
     std::shared_ptr<std::istream>
         stream_to_read_; // stored as shared_ptr as a workaround, unique_ptr should preferred here
 };
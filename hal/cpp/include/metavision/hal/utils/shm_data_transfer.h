@@ -0,0 +1,52 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_HAL_SHM_DATA_TRANSFER_H
+#define METAVISION_HAL_SHM_DATA_TRANSFER_H
+
+#include <cstdint>
+#include <memory>
+
+#include "metavision/hal/utils/data_transfer.h"
+#include "metavision/hal/utils/shm_ring.h"
+
+namespace Metavision {
+
+/// @brief Data transfer reading the RAW data published in a shared memory ring by another process
+///
+/// The transfer stops once the writer has closed the ring and the remaining data has been read. The data of the slots
+/// overwritten while they were being read is discarded, see @ref ShmRingReader.
+class ShmDataTransfer : public DataTransfer {
+public:
+    /// @brief Constructor
+    /// @param reader Reader of the shared memory ring
+    /// @param raw_event_size_bytes The size of a RAW event in bytes
+    /// @param n_buffers Number of buffers in the pool. If the consumer does not keep up, the transfer waits for a
+    /// buffer to be available, and the reader eventually skips the slots it could not read in time
+    ShmDataTransfer(std::unique_ptr<ShmRingReader> reader, uint32_t raw_event_size_bytes, uint32_t n_buffers = 64);
+
+    /// @brief Stops ongoing transfers
+    ~ShmDataTransfer();
+
+    /// @brief Gets the shared memory ring reader
+    const ShmRingReader &get_reader() const;
+
+private:
+    void start_impl(BufferPtr buffer) override final;
+    void run_impl() override final;
+
+    BufferPtr data_read_;
+    std::unique_ptr<ShmRingReader> reader_;
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_HAL_SHM_DATA_TRANSFER_H
@@ -0,0 +1,137 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_HAL_SHM_RING_H
+#define METAVISION_HAL_SHM_RING_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace Metavision {
+
+class DataTransfer;
+namespace Future {
+class DataTransfer;
+}
+
+/// Prefix of the serials used to open a stream published in a shared memory ring, e.g. "shm://my_camera"
+constexpr char ShmRingSerialPrefix[] = "shm://";
+
+/// @brief Gets the name of the shared memory ring designated by a serial
+/// @param serial Serial to parse
+/// @return The name of the ring if the serial starts with @ref ShmRingSerialPrefix, an empty string otherwise
+std::string get_shm_ring_name(const std::string &serial);
+
+/// @brief Publishes RAW data buffers in a named shared memory ring, so that other processes can read them
+///
+/// The ring is made of a fixed number of fixed-size slots. The writer never waits for the readers: each written
+/// buffer overwrites the oldest slot, and readers that are too slow to keep up detect it and skip ahead (see
+/// @ref ShmRingReader).
+/// The ring also holds the RAW header of the stream, which the readers use to decode the data.
+/// @note Shared memory rings are only available on POSIX systems
+class ShmRingWriter {
+public:
+    /// @brief Creates the shared memory ring
+    ///
+    /// The ring is only accessible to the user of the process. A ring with the same name is only replaced if its
+    /// writer process is no longer running, e.g. after a crash.
+    /// @param name Name of the ring
+    /// @param raw_header RAW header of the published stream
+    /// @param slot_count Number of slots in the ring
+    /// @param slot_size Maximum size in bytes of the data held by a slot, rounded up to a multiple of 4. Larger buffers
+    /// are split across consecutive slots
+    /// @throw HalException if the ring can not be created, e.g. if a running process already writes a ring with the
+    /// same name
+    ShmRingWriter(const std::string &name, const std::string &raw_header, uint32_t slot_count = 64,
+                  uint32_t slot_size = 1024 * 1024);
+
+    /// @brief Marks the ring as closed, so that the readers stop once they have read the remaining data, and removes
+    /// its name from the system
+    ~ShmRingWriter();
+
+    /// @brief Publishes a buffer of RAW data
+    ///
+    /// This function never blocks.
+    /// @param data Pointer to the data
+    /// @param size Size of the data in bytes
+    void write(const uint8_t *data, size_t size);
+
+    /// @brief Publishes every buffer transferred by a data transfer
+    /// @param data_transfer Data transfer to tap. It must not outlive this writer
+    /// @return The id of the callback added to the data transfer
+    size_t tap(DataTransfer &data_transfer);
+
+    /// @brief Publishes every buffer transferred by a data transfer
+    /// @param data_transfer Data transfer to tap. It must not outlive this writer
+    /// @return The id of the callback added to the data transfer
+    size_t tap(Future::DataTransfer &data_transfer);
+
+    /// @brief Gets the name of the ring
+    const std::string &get_name() const;
+
+    /// @brief Gets the number of slots written since the ring was created
+    uint64_t get_written_slots_count() const;
+
+private:
+    struct Private;
+    std::unique_ptr<Private> pimpl_;
+};
+
+/// @brief Reads the RAW data buffers published by a @ref ShmRingWriter in another process
+///
+/// Each reader has its own cursor in the ring, and data is accessed in place without being copied. Since the writer
+/// never waits, a reader that falls more than a full ring behind loses the oldest slots: it skips ahead to the middle
+/// of the ring and counts the slots it has missed. After skipping, it also skips the remaining slots of a buffer split
+/// across slots, so that it always resumes at the beginning of a buffer.
+class ShmRingReader {
+public:
+    /// @brief Opens an existing shared memory ring
+    ///
+    /// The reader starts at the slot written next, i.e. it does not read the data published before it was opened.
+    /// @param name Name of the ring
+    /// @throw HalException if the ring does not exist or is not valid
+    explicit ShmRingReader(const std::string &name);
+
+    /// @brief Destructor
+    ~ShmRingReader();
+
+    /// @brief Gets the RAW header of the published stream
+    const std::string &get_raw_header() const;
+
+    /// @brief Gets the data of the next slot, without waiting
+    ///
+    /// The data stays in the ring and may be overwritten by the writer at any time. It must only be used once
+    /// @ref release confirmed it was valid.
+    /// @param size Size of the data in bytes, if any
+    /// @return A pointer to the data, or nullptr if no new slot is available
+    const uint8_t *try_acquire(size_t &size);
+
+    /// @brief Moves to the next slot after a successful call to @ref try_acquire
+    /// @return true if the acquired data was not overwritten while it was being used, false otherwise, in which case
+    /// the data must be discarded
+    bool release();
+
+    /// @brief Checks if the writer has closed the ring and all the published data has been read
+    bool is_closed() const;
+
+    /// @brief Gets the number of slots skipped because this reader was lagging behind the writer
+    uint64_t get_skipped_slots_count() const;
+
+private:
+    struct Private;
+    std::unique_ptr<Private> pimpl_;
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_HAL_SHM_RING_H
@@ -10,11 +10,14 @@
  **********************************************************************************************************************/
 
 #include "metavision/hal/utils/detail/hal_log_impl.h"
+#include <functional>
 #include <memory>
 #include <assert.h>
 #include <string>
 #include <map>
+#include <mutex>
 #include <vector>
+#include <sstream>
 #include <algorithm>
 #include <dirent.h>
 #ifdef _WIN32
@@ -37,6 +40,7 @@
 #include "metavision/hal/utils/device_config.h"
 #include "metavision/hal/facilities/i_events_stream.h"
 #include "metavision/hal/utils/hal_error_code.h"
+#include "metavision/hal/utils/shm_ring.h"
 #include "metavision/hal/utils/hal_exception.h"
 #include "metavision/hal/utils/hal_log.h"
 #include "metavision/hal/utils/resources_folder.h"
@@ -55,23 +59,31 @@ std::string CameraTypeLabels[] = {"remote", "local", "any"};
 
 Metavision::PluginLoader plugin_loader;
 
-Metavision::PluginLoader::PluginList get_plugins() {
-    static bool loaded            = false;
-    static char *last_plugin_path = nullptr;
+// Plugins are loaded once and kept loaded for the whole process, this mutex only protects the discovery and the
+// loading of the plugins: the loaded plugins are then used without it, so that devices can be opened concurrently
+std::mutex plugin_loader_mutex;
 
-    MV_HAL_LOG_TRACE() << "Loading plugins";
+// Lists the available plugin libraries, without loading them
+void discover_plugins() {
+    static bool discovered = false;
+    static std::string last_plugin_path;
 
-    char *plugin_path = getenv("MV_HAL_PLUGIN_PATH");
-    if (loaded && (!plugin_path || strcmp(plugin_path, last_plugin_path) == 0)) {
-        MV_HAL_LOG_TRACE()
-            << "  MV_HAL_PLUGIN_PATH did not change and plugins are already loaded, no need to reload plugins";
-        return plugin_loader.get_plugin_list();
+    const char *cache_file = getenv("MV_HAL_PLUGIN_DISCOVERY_CACHE");
+    plugin_loader.set_discovery_cache_file(cache_file ? cache_file : "");
+
+    const char *plugin_path_env   = getenv("MV_HAL_PLUGIN_PATH");
+    const std::string plugin_path = plugin_path_env ? plugin_path_env : "";
+    if (discovered && plugin_path == last_plugin_path) {
+        MV_HAL_LOG_TRACE() << "  MV_HAL_PLUGIN_PATH did not change and plugins are already discovered, no need to "
+                              "discover plugins again";
+        return;
     }
     last_plugin_path = plugin_path;
 
     plugin_loader.clear_folders();
+    plugin_loader.clear_discovered_plugins();
     MV_HAL_LOG_TRACE() << "  Setting up search paths";
-    if (plugin_path) {
+    if (!plugin_path.empty()) {
         std::string plugin_folders(plugin_path);
 #ifdef _WIN32
         std::string delimiter = ";";
@@ -92,7 +104,7 @@ Metavision::PluginLoader::PluginList get_plugins() {
             folders.push_back(plugin_folders);
         }
         plugin_loader.insert_folders(folders);
-        plugin_loader.load_plugins();
+        plugin_loader.discover_plugins();
         plugin_loader.clear_folders();
     }
 
@@ -104,15 +116,38 @@ Metavision::PluginLoader::PluginList get_plugins() {
     if (!plugin_install_path.empty()) {
         MV_HAL_LOG_TRACE() << "    Adding plugin search path:" << plugin_install_path;
         plugin_loader.insert_folder(plugin_install_path);
-        plugin_loader.load_plugins();
+        plugin_loader.discover_plugins();
         plugin_loader.clear_folders();
     }
+    discovered = true;
+}
+
+using PluginRefList = std::vector<std::reference_wrapper<Metavision::Plugin>>;
+
+// Gets the loaded plugins, after loading the ones which may match the input names
+// Only the required libraries are opened when an integrator or plugin name is provided. The returned plugins stay
+// valid without holding the plugin loader mutex, as loaded plugins are never unloaded
+PluginRefList get_plugins(const std::string &integrator_name = std::string(),
+                          const std::string &plugin_name     = std::string()) {
+    PluginRefList plugin_list;
+    {
+        std::lock_guard<std::mutex> lock(plugin_loader_mutex);
+        MV_HAL_LOG_TRACE() << "Loading plugins";
+        discover_plugins();
+
+        MV_HAL_LOG_TRACE() << "  Loading plugins...";
+        plugin_loader.load_plugins(integrator_name, plugin_name);
+        for (auto &plugin : plugin_loader.get_plugin_list()) {
+            plugin_list.emplace_back(plugin);
+        }
+    }
+    if (!integrator_name.empty() || !plugin_name.empty()) {
+        return plugin_list;
+    }
 
-    MV_HAL_LOG_TRACE() << "  Loading plugins...";
     bool has_camera_discovery = false;
     bool has_file_discovery   = false;
-    auto plugin_list          = plugin_loader.get_plugin_list();
-    for (auto &plugin : plugin_list) {
+    for (Metavision::Plugin &plugin : plugin_list) {
         if (plugin.get_camera_discovery_list().size() != 0) {
             has_camera_discovery = true;
         }
@@ -137,9 +172,8 @@ Metavision::PluginLoader::PluginList get_plugins() {
     } else {
         MV_HAL_LOG_TRACE() << "  Found" << plugin_list.size() << "plugins";
     }
-    loaded = true;
 
-    return plugin_loader.get_plugin_list();
+    return plugin_list;
 }
 
 std::string get_full_serial(const std::string &integrator, const std::string &plugin, const std::string &serial) {
@@ -197,7 +231,7 @@ DeviceDiscovery::SerialList list_serial_camera(CameraType flag = ANY) {
 
     MV_HAL_LOG_TRACE() << "Listing cameras of" << CameraTypeLabels[flag - 1] << "type";
 
-    for (auto &plugin : get_plugins()) {
+    for (Plugin &plugin : get_plugins()) {
         MV_HAL_LOG_TRACE() << Log::no_space << "  Plugin [" << plugin.get_plugin_name() << "] ("
                            << plugin.get_integrator_name() << ")";
         if (plugin.get_camera_discovery_list().empty() && plugin.get_file_discovery_list().empty())
@@ -234,7 +268,7 @@ DeviceDiscovery::SystemList list_systems_camera(CameraType flag = ANY) {
 
     MV_HAL_LOG_TRACE() << "Listing cameras of" << CameraTypeLabels[flag - 1] << "type";
 
-    for (auto &plugin : get_plugins()) {
+    for (Plugin &plugin : get_plugins()) {
         MV_HAL_LOG_TRACE() << Log::no_space << "  Plugin [" << plugin.get_plugin_name() << "] ("
                            << plugin.get_integrator_name() << ")";
         bool has_serial = false;
@@ -307,31 +341,49 @@ std::unique_ptr<Device> DeviceDiscovery::open(const std::string &input_serial, D
     std::string integrator_name;
     std::string plugin_name;
 
-    // split name plugin_name:intergrator:serial
-    size_t pos             = 0;
-    std::string tmp_serial = input_serial;
-    std::string delimiter  = ":";
-    std::vector<std::string> fields;
-    while ((pos = tmp_serial.find(delimiter)) != std::string::npos) {
-        auto field = tmp_serial.substr(0, pos);
-        fields.push_back(field);
-        tmp_serial.erase(0, pos + delimiter.length());
-    }
-    std::string serial = tmp_serial;
-
-    assert(fields.size() <= 2);
+    std::string serial;
     std::string input_integrator_name;
     std::string input_plugin_name;
     std::string input_common_name;
-    if (fields.size() == 1) {
-        input_common_name = fields[0];
-    }
-    if (fields.size() == 2) {
-        input_integrator_name = fields[0];
-        input_plugin_name     = fields[1];
+    const std::string shm_ring_name = get_shm_ring_name(input_serial);
+    if (!shm_ring_name.empty()) {
+        // a stream published in a shared memory ring is opened by the plugin that produced it, as for a RAW file
+        try {
+            ShmRingReader reader(shm_ring_name);
+            std::istringstream header_stream(reader.get_raw_header());
+            RawFileHeader header(header_stream);
+            input_integrator_name = header.get_integrator_name();
+            input_plugin_name     = header.get_plugin_name();
+        } catch (const HalException &e) {
+            MV_HAL_LOG_TRACE() << "Could not open shared memory ring:" << e.what();
+            return device;
+        }
+        serial = input_serial;
+    } else {
+        // split name plugin_name:intergrator:serial
+        size_t pos             = 0;
+        std::string tmp_serial = input_serial;
+        std::string delimiter  = ":";
+        std::vector<std::string> fields;
+        while ((pos = tmp_serial.find(delimiter)) != std::string::npos) {
+            auto field = tmp_serial.substr(0, pos);
+            fields.push_back(field);
+            tmp_serial.erase(0, pos + delimiter.length());
+        }
+        serial = tmp_serial;
+
+        assert(fields.size() <= 2);
+        if (fields.size() == 1) {
+            input_common_name = fields[0];
+        }
+        if (fields.size() == 2) {
+            input_integrator_name = fields[0];
+            input_plugin_name     = fields[1];
+        }
     }
 
-    for (auto &plugin : get_plugins()) {
+    // when both the integrator and plugin names are known, only the matching plugin needs to be loaded
+    for (Plugin &plugin : get_plugins(input_integrator_name, input_plugin_name)) {
         if (device) {
             break;
         }
@@ -434,20 +486,20 @@ std::unique_ptr<Device> DeviceDiscovery::open_raw_file(const std::string &raw_fi
         if (future_events_stream) {
             future_events_stream->set_underlying_filename(raw_file);
             if (file_config.build_index_) {
-                // We create an additional decicated device that we will use for indexing the RAW file
+                // We create an additional decicated device that we will use for indexing the RAW file, unless the
+                // index is shared with another events stream of the same file
                 // We set build_index_ = false for this device, because it won't be used for seeking, so it does
                 // not need to have an index automatically built. Not doing so would create an infinite loop
                 // of devices created for the purpose of building the index for the one previously created.
-                Future::RawFileConfig cfg;
-                cfg.do_time_shifting_    = true;
-                cfg.build_index_         = false;
-                auto device_for_indexing = open_raw_file(raw_file, cfg);
-                if (device_for_indexing) {
-                    try {
-                        future_events_stream->index(std::move(device_for_indexing));
-                    } catch (const HalException &e) {
-                        MV_HAL_LOG_TRACE() << "Could not build index for the file. Exception caught:\n" << e.what();
-                    }
+                try {
+                    future_events_stream->index([&raw_file]() {
+                        Future::RawFileConfig cfg;
+                        cfg.do_time_shifting_ = true;
+                        cfg.build_index_      = false;
+                        return open_raw_file(raw_file, cfg);
+                    });
+                } catch (const HalException &e) {
+                    MV_HAL_LOG_TRACE() << "Could not build index for the file. Exception caught:\n" << e.what();
                 }
             }
         }
@@ -479,9 +531,13 @@ std::unique_ptr<Device> DeviceDiscovery::open_stream(std::unique_ptr<std::istrea
                        << (input_plugin_name.empty() ? "Unknown" : input_plugin_name) << "] ("
                        << (input_integrator_name.empty() ? "Unknown" : input_integrator_name) << ")";
 
-    auto list_plugins = get_plugins();
+    // only load the plugins which may match the header, old RAW files without names in the header can only be
+    // read by Prophesee plugins
+    auto list_plugins = (input_integrator_name.empty() && input_plugin_name.empty()) ?
+                            get_plugins("Prophesee") :
+                            get_plugins(input_integrator_name, input_plugin_name);
 
-    for (auto &plugin : list_plugins) {
+    for (Plugin &plugin : list_plugins) {
         if (device) {
             break;
         }
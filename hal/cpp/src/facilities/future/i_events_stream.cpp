@@ -13,6 +13,17 @@
 #include <algorithm>
 #include <random>
 #include <functional>
+#include <map>
+#ifdef _WIN32
+#include <windows.h>
+#elif defined __APPLE__
+#include <pthread.h>
+#include <sys/qos.h>
+#else
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 
 #include "metavision/hal/device/device.h"
 #include "metavision/hal/facilities/future/i_decoder.h"
@@ -61,6 +72,11 @@ static const std::string index_version_key      = "index_version";
 static const std::string ts_shift_key           = "ts_shift_us";
 
 static const std::string index_version          = "2.0";
+
+// While a reader of the same file is streaming, the index is built at most at this rate, sleeping by steps of at most
+// the pause period so that an abort is handled promptly
+static constexpr double index_building_bandwidth_budget_bytes_per_s = 64. * 1024 * 1024;
+static constexpr std::chrono::milliseconds index_building_pause_period(20);
 static const uint32_t bookmark_period_us        = 2000;
 static const std::string bookmark_period_us_str = std::to_string(bookmark_period_us);
 
@@ -100,6 +116,23 @@ bool deserialize_bookmark(I_EventsStream::Bookmark &bookmark, std::ifstream &inp
     return true;
 }
 
+void lower_current_thread_priority() {
+#ifdef _WIN32
+    // background mode lowers both the CPU and I/O priorities of the thread
+    SetThreadPriority(GetCurrentThread(), THREAD_MODE_BACKGROUND_BEGIN);
+#elif defined __APPLE__
+    pthread_set_qos_class_self_np(QOS_CLASS_BACKGROUND, 0);
+#else
+    // on Linux, the nice value and the I/O priority of a thread id only apply to this thread
+    const pid_t tid = static_cast<pid_t>(syscall(SYS_gettid));
+    setpriority(PRIO_PROCESS, tid, 19);
+#ifdef SYS_ioprio_set
+    constexpr int ioprio_who_process = 1, ioprio_class_idle = 3, ioprio_class_shift = 13;
+    syscall(SYS_ioprio_set, ioprio_who_process, tid, ioprio_class_idle << ioprio_class_shift);
+#endif
+#endif
+}
+
 bool add_bookmarks(size_t last_bookmark_index, size_t bookmark_index, I_EventsStream::Bookmark &bookmark,
                    I_EventsStream::Index &index, std::ofstream &output_index_file) {
     for (; last_bookmark_index < bookmark_index; ++last_bookmark_index) {
@@ -153,7 +186,8 @@ bool check_magic_number_presence(std::ifstream &input_index_file) {
 }
 
 bool build_and_try_writing_bookmarks(Device &device, I_EventsStream::Index &index, const std::string &raw_file_name,
-                                     std::ofstream &output_index_file, const std::atomic<bool> &abort) {
+                                     std::ofstream &output_index_file, const std::atomic<bool> &abort,
+                                     const std::function<void(uint64_t)> &before_decoding) {
     I_EventsStream::Bookmark bookmark;
 
     // Grabs the facilities
@@ -199,6 +233,8 @@ bool build_and_try_writing_bookmarks(Device &device, I_EventsStream::Index &inde
             MV_HAL_LOG_TRACE() << "Still building index for" << raw_file_name << "...";
         }
 
+        before_decoding(current_byte_offset);
+
         long read_size_bytes;
         auto buffer           = file_events_stream->get_latest_raw_data(read_size_bytes);
         const auto buffer_end = buffer + read_size_bytes;
@@ -293,7 +329,8 @@ I_EventsStream::Bookmarks load_bookmarks(std::ifstream &input_index_file, const
     return bookmarks;
 }
 
-I_EventsStream::Index build_index(Device &device, const std::string &raw_file_name, const std::atomic<bool> &abort) {
+I_EventsStream::Index build_index(Device &device, const std::string &raw_file_name, const std::atomic<bool> &abort,
+                                  const std::function<void(uint64_t)> &before_decoding) {
     I_EventsStream::Index index;
     bool do_build_index = false;
 
@@ -420,7 +457,8 @@ I_EventsStream::Index build_index(Device &device, const std::string &raw_file_na
             output_index_file << index_file_header;
         }
 
-        if (!build_and_try_writing_bookmarks(device, index, raw_file_name, output_index_file, abort)) {
+        if (!build_and_try_writing_bookmarks(device, index, raw_file_name, output_index_file, abort,
+                                             before_decoding)) {
             MV_HAL_LOG_ERROR() << "Failed to build index for input RAW file" << raw_file_name;
             index.status_ = I_EventsStream::IndexStatus::Bad;
             return index;
@@ -470,6 +508,160 @@ I_EventsStream::Index build_index(Device &device, const std::string &raw_file_na
 
 } // namespace
 
+/// @brief Builds or loads the index of a RAW file in a background thread, on behalf of all the events streams of the
+/// process reading this file
+struct I_EventsStream::IndexBuilder {
+    IndexBuilder(const std::string &raw_file_name, std::unique_ptr<Device> device) :
+        raw_file_name_(raw_file_name),
+        device_(std::move(device)),
+        abort_(false),
+        budget_start_time_(std::chrono::steady_clock::now()) {
+        // the data transfer reading the file for indexing runs in its own thread
+        auto indexing_fes = device_->get_facility<I_EventsStream>();
+        indexing_fes->data_transfer_->add_status_changed_callback([](DataTransfer::Status status) {
+            if (status == DataTransfer::Status::Started) {
+                lower_current_thread_priority();
+            }
+        });
+    }
+
+    /// @brief Subscribes to the index being built for the input file, if any
+    /// @return The builder the stream has been subscribed to, nullptr if the file is not being indexed
+    static std::shared_ptr<IndexBuilder> subscribe_existing(const std::string &raw_file_name,
+                                                            I_EventsStream *stream) {
+        std::lock_guard<std::mutex> registry_lock(registry_mutex());
+        auto it = registry().find(raw_file_name);
+        if (it == registry().end()) {
+            return nullptr;
+        }
+        auto builder = it->second.lock();
+        if (builder) {
+            std::lock_guard<std::mutex> lock(builder->mutex_);
+            builder->subscribers_.push_back(stream);
+        }
+        return builder;
+    }
+
+    /// @brief Creates a builder for the input file, subscribes the stream to it and starts indexing
+    static std::shared_ptr<IndexBuilder> create(const std::string &raw_file_name, std::unique_ptr<Device> device,
+                                                I_EventsStream *stream) {
+        auto builder = std::make_shared<IndexBuilder>(raw_file_name, std::move(device));
+        builder->subscribers_.push_back(stream);
+        {
+            std::lock_guard<std::mutex> registry_lock(registry_mutex());
+            registry()[raw_file_name] = builder;
+        }
+        builder->thread_ = std::thread([builder = builder.get()]() { builder->run(); });
+        return builder;
+    }
+
+    /// @brief Unsubscribes a stream, the indexing is aborted if there are no more subscribers
+    void unsubscribe(I_EventsStream *stream) {
+        bool last = false;
+        {
+            std::lock_guard<std::mutex> registry_lock(registry_mutex());
+            std::lock_guard<std::mutex> lock(mutex_);
+            subscribers_.erase(std::remove(subscribers_.begin(), subscribers_.end(), stream), subscribers_.end());
+            last_read_positions_.erase(stream);
+            if (subscribers_.empty()) {
+                last   = true;
+                abort_ = true;
+                remove_from_registry();
+            }
+        }
+        if (last && thread_.joinable()) {
+            thread_.join();
+        }
+    }
+
+private:
+    static std::mutex &registry_mutex() {
+        static std::mutex mutex;
+        return mutex;
+    }
+
+    // Only builders that are still running are registered: once built, the index is loaded from its file
+    static std::map<std::string, std::weak_ptr<IndexBuilder>> &registry() {
+        static std::map<std::string, std::weak_ptr<IndexBuilder>> builders;
+        return builders;
+    }
+
+    void remove_from_registry() {
+        auto it = registry().find(raw_file_name_);
+        if (it != registry().end() && it->second.lock().get() == this) {
+            registry().erase(it);
+        }
+    }
+
+    void run() {
+        lower_current_thread_priority();
+        auto index = build_index(*device_, raw_file_name_, abort_, [this](uint64_t offset) { throttle(offset); });
+        device_.reset();
+
+        {
+            std::lock_guard<std::mutex> registry_lock(registry_mutex());
+            remove_from_registry();
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto *stream : subscribers_) {
+            stream->set_index(index);
+        }
+    }
+
+    /// @brief Bounds the read bandwidth of the indexing while a subscriber is streaming the file
+    ///
+    /// The indexing thread runs with an idle I/O priority, which not all disk schedulers honor. The budget bounds the
+    /// share of the disk bandwidth taken from the subscribers in any case, without ever stopping the indexing, so that
+    /// the index keeps progressing even when a subscriber reads ahead of it.
+    void throttle(uint64_t offset) {
+        const auto now = std::chrono::steady_clock::now();
+        if (!is_subscriber_streaming()) {
+            budget_start_time_   = now;
+            budget_start_offset_ = offset;
+            return;
+        }
+
+        const std::chrono::duration<double> budget_duration((offset - budget_start_offset_) /
+                                                            index_building_bandwidth_budget_bytes_per_s);
+        const auto budget_end_time = budget_start_time_ + std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                                              budget_duration);
+        for (auto t = now; t < budget_end_time && !abort_; t = std::chrono::steady_clock::now()) {
+            std::this_thread::sleep_for(
+                std::min<std::chrono::steady_clock::duration>(budget_end_time - t, index_building_pause_period));
+        }
+    }
+
+    /// @brief Returns whether a subscriber has read the file since the previous call
+    bool is_subscriber_streaming() {
+        bool streaming = false;
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto *stream : subscribers_) {
+            auto file_data_transfer = dynamic_cast<FileDataTransfer *>(stream->data_transfer_.get());
+            if (!file_data_transfer) {
+                continue;
+            }
+            const int64_t position = file_data_transfer->get_read_position();
+            auto it                = last_read_positions_.insert({stream, -1}).first;
+            streaming              = streaming || it->second != position;
+            it->second             = position;
+        }
+        return streaming;
+    }
+
+    const std::string raw_file_name_;
+    std::unique_ptr<Device> device_;
+    std::atomic<bool> abort_;
+    std::thread thread_;
+
+    std::chrono::steady_clock::time_point budget_start_time_; ///< Start of the current bandwidth budget window
+    uint64_t budget_start_offset_{0};                         ///< Indexed offset at the start of the window
+
+    std::mutex mutex_; // protects the subscribers
+    std::vector<I_EventsStream *> subscribers_;
+    std::map<I_EventsStream *, int64_t> last_read_positions_;
+};
+
 I_EventsStream::I_EventsStream(std::unique_ptr<DataTransfer> data_transfer,
                                const std::shared_ptr<I_HW_Identification> &hw_identification,
                                const std::shared_ptr<I_Decoder> &decoder) :
@@ -535,9 +727,8 @@ I_EventsStream::I_EventsStream(std::unique_ptr<DataTransfer> data_transfer,
 }
 
 I_EventsStream::~I_EventsStream() {
-    if (index_build_thread_.joinable()) {
-        abort_index_building_ = true;
-        index_build_thread_.join();
+    if (index_builder_) {
+        index_builder_->unsubscribe(this);
     }
     stop();
     data_transfer_.reset(nullptr);
@@ -747,49 +938,82 @@ I_EventsStream::IndexStatus I_EventsStream::get_seek_range(timestamp &data_start
 }
 
 void I_EventsStream::index(std::unique_ptr<Device> device_for_indexing) {
-    std::lock_guard<std::mutex> lock(index_safety_);
-    if (index_.status_ == IndexStatus::Good) {
-        return;
-    }
+    index([&device_for_indexing]() { return std::move(device_for_indexing); });
+}
 
-    if (get_underlying_filename().empty()) {
-        MV_HAL_LOG_ERROR() << "Can not build index for the stream input (no valid RAW file name found).";
-        index_.status_ = IndexStatus::Bad;
-        return;
-    }
+void I_EventsStream::index(const std::function<std::unique_ptr<Device>()> &make_device_for_indexing) {
+    std::shared_ptr<IndexBuilder> previous_builder;
+    {
+        std::lock_guard<std::mutex> lock(index_safety_);
+        if (index_.status_ == IndexStatus::Good || index_.status_ == IndexStatus::Building) {
+            return;
+        }
 
-    auto indexing_fes = device_for_indexing->get_facility<Metavision::Future::I_EventsStream>();
-    if (!indexing_fes || !dynamic_cast<Future::FileDataTransfer *>(indexing_fes->data_transfer_.get())) {
-        MV_HAL_LOG_ERROR() << "Can not build index for the stream input: invalid indexing device.";
-        return;
-    }
+        if (get_underlying_filename().empty()) {
+            MV_HAL_LOG_ERROR() << "Can not build index for the stream input (no valid RAW file name found).";
+            index_.status_ = IndexStatus::Bad;
+            return;
+        }
 
-    if (indexing_fes->get_underlying_filename() != get_underlying_filename()) {
-        MV_HAL_LOG_ERROR() << "Can not build index for the stream input: indexing device is built from another RAW "
-                              "file as source. The file to index is"
-                           << get_underlying_filename() << "whereas the input indexing device has been built from"
-                           << indexing_fes->get_underlying_filename();
+        index_.status_ = IndexStatus::Building;
+        std::swap(previous_builder, index_builder_);
+    }
+    if (previous_builder) {
+        previous_builder->unsubscribe(this);
     }
 
-    index_.status_ = IndexStatus::Building;
+    // The index lock must not be held here: the builder calls set_index while holding its own lock
+    auto builder = IndexBuilder::subscribe_existing(get_underlying_filename(), this);
+    if (builder) {
+        MV_HAL_LOG_TRACE() << "Sharing the index being built for" << get_underlying_filename();
+    } else {
+        std::unique_ptr<Device> device_for_indexing;
+        try {
+            device_for_indexing = make_device_for_indexing();
+        } catch (const HalException &e) {
+            MV_HAL_LOG_TRACE() << "Could not open the device for indexing. Exception caught:\n" << e.what();
+        }
+        auto indexing_fes =
+            device_for_indexing ? device_for_indexing->get_facility<Metavision::Future::I_EventsStream>() : nullptr;
+        if (!indexing_fes || !dynamic_cast<Future::FileDataTransfer *>(indexing_fes->data_transfer_.get())) {
+            MV_HAL_LOG_ERROR() << "Can not build index for the stream input: invalid indexing device.";
+            std::lock_guard<std::mutex> lock(index_safety_);
+            index_.status_ = IndexStatus::NotBuilt;
+            return;
+        }
 
-    // Start the indexing thread
-    index_build_thread_ = std::thread([device_for_indexing = std::move(device_for_indexing), this]() {
-        auto index = index_impl(*device_for_indexing);
+        if (indexing_fes->get_underlying_filename() != get_underlying_filename()) {
+            MV_HAL_LOG_ERROR() << "Can not build index for the stream input: indexing device is built from another RAW "
+                                  "file as source. The file to index is"
+                               << get_underlying_filename() << "whereas the input indexing device has been built from"
+                               << indexing_fes->get_underlying_filename();
+        }
 
-        std::lock_guard<std::mutex> lock(index_safety_);
-        std::swap(index_, index);
-    });
+        builder = IndexBuilder::create(get_underlying_filename(), std::move(device_for_indexing), this);
+    }
 
-    // Wait for the thread to be running
-    while (!index_build_thread_.joinable()) {}
+    std::lock_guard<std::mutex> lock(index_safety_);
+    index_builder_ = builder;
 }
 
-I_EventsStream::Index I_EventsStream::index_impl(Device &device) {
-    abort_index_building_ = false;
-    auto index            = build_index(device, get_underlying_filename(), abort_index_building_);
+void I_EventsStream::set_index(const Index &index) {
     decoder_->reset_timestamp_shift(index.ts_shift_us_);
-    return index;
+
+    std::lock_guard<std::mutex> lock(index_safety_);
+    index_ = index;
+}
+
+size_t I_EventsStream::get_pending_buffers_count() {
+    std::lock_guard<std::mutex> lock(new_buffer_safety_);
+    return available_buffers_.size();
+}
+
+uint64_t I_EventsStream::get_dropped_buffers_count() const {
+    return data_transfer_->get_dropped_buffers_count();
+}
+
+DataTransfer &I_EventsStream::get_data_transfer() {
+    return *data_transfer_;
 }
 
 void I_EventsStream::stop_log_raw_data() {
@@ -158,6 +158,19 @@ I_EventsStream::RawData *I_EventsStream::get_latest_raw_data(long &size) {
     return returned_buffer_->data();
 }
 
+size_t I_EventsStream::get_pending_buffers_count() {
+    std::lock_guard<std::mutex> lock(new_buffer_safety_);
+    return available_buffers_.size();
+}
+
+uint64_t I_EventsStream::get_dropped_buffers_count() const {
+    return data_transfer_->get_dropped_buffers_count();
+}
+
+DataTransfer &I_EventsStream::get_data_transfer() {
+    return *data_transfer_;
+}
+
 void I_EventsStream::stop_log_raw_data() {
     std::lock_guard<std::mutex> guard(log_raw_safety_);
     log_raw_data_.reset(nullptr);
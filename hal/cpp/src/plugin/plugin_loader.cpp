@@ -11,7 +11,11 @@
 
 #include <memory>
 #include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <random>
 #include <dirent.h>
+#include <sys/stat.h>
 #ifdef _WIN32
 #include <windows.h>
 #include <strsafe.h>
@@ -100,6 +104,15 @@ std::string get_plugin_name(const std::string &filename, const std::string &ext,
 
 using PluginEntry = decltype(&initialize_plugin);
 
+// Returns the last modification time of a file, or -1 if it can not be retrieved
+long long get_modification_time(const std::string &path) {
+    struct stat st;
+    if (stat(path.c_str(), &st) != 0) {
+        return -1;
+    }
+    return static_cast<long long>(st.st_mtime);
+}
+
 struct dlcloser {
     void operator()(void *handle) {
         if (handle) {
@@ -208,7 +221,7 @@ void PluginLoader::insert_folders(const std::vector<std::string> &folders) {
     }
 }
 
-void PluginLoader::load_plugins() {
+void PluginLoader::discover_plugins() {
     for (auto folder : folders_) {
         DIR *dir_descriptor;
         dir_descriptor = opendir(folder.c_str());
@@ -217,24 +230,144 @@ void PluginLoader::load_plugins() {
             while ((entries = readdir(dir_descriptor)) != NULL) {
                 std::string filename = entries->d_name;
                 auto plugin_info     = PluginInfo(folder, filename);
-                insert_plugin(plugin_info);
+                if (plugin_info.name.empty()) {
+                    continue;
+                }
+                auto plugin = std::make_pair(plugin_info.name, plugin_info.path);
+                if (std::find(discovered_plugins_.begin(), discovered_plugins_.end(), plugin) ==
+                    discovered_plugins_.end()) {
+                    discovered_plugins_.push_back(plugin);
+                }
             }
             closedir(dir_descriptor);
         }
     }
 }
 
-void PluginLoader::insert_plugin(const std::string &name, const std::string &library_path) {
-    if (!name.empty() && !library_path.empty()) {
-        auto library = std::make_unique<Library>(get_plugin_entry_point(), name, library_path);
+void PluginLoader::clear_discovered_plugins() {
+    discovered_plugins_.clear();
+}
+
+void PluginLoader::load_plugins() {
+    discover_plugins();
+    load_plugins(std::string(), std::string());
+}
+
+void PluginLoader::load_plugins(const std::string &integrator_name, const std::string &plugin_name) {
+    for (const auto &plugin : discovered_plugins_) {
+        const std::string &name = plugin.first;
+        const std::string &path = plugin.second;
+        if (opened_library_paths_.count(path)) {
+            continue;
+        }
+        if (!plugin_name.empty() && plugin_name != name) {
+            continue;
+        }
+
+        const long long modification_time = get_modification_time(path);
+        auto cache_it                     = cache_.find(path);
+        if (cache_it != cache_.end() && cache_it->second.modification_time == modification_time) {
+            if (!cache_it->second.is_plugin) {
+                // we already know this library is not a plugin
+                continue;
+            }
+            if (!integrator_name.empty() && integrator_name != cache_it->second.integrator_name) {
+                continue;
+            }
+        }
+
+        auto library = std::make_unique<Library>(get_plugin_entry_point(), name, path);
+
+        // a library we could not open at all may be fixed later, so it is neither cached nor marked as opened
+        if (library->handle) {
+            opened_library_paths_.insert(path);
+            CacheEntry entry;
+            entry.modification_time = modification_time;
+            entry.is_plugin         = (library->plugin != nullptr);
+            if (library->plugin) {
+                entry.integrator_name = library->plugin->get_integrator_name();
+            }
+            cache_[path] = entry;
+            cache_dirty_ = true;
+        }
         if (library->plugin) {
             libraries_.push_back(std::move(library));
         }
     }
+
+    if (cache_dirty_) {
+        write_discovery_cache();
+        cache_dirty_ = false;
+    }
+}
+
+void PluginLoader::set_discovery_cache_file(const std::string &cache_file) {
+    if (cache_file == cache_file_) {
+        return;
+    }
+    cache_file_ = cache_file;
+    read_discovery_cache();
+    // plugins may have been loaded before the cache file was set
+    if (!cache_.empty()) {
+        write_discovery_cache();
+    }
 }
 
-void PluginLoader::insert_plugin(const PluginInfo &info) {
-    insert_plugin(info.name, info.path);
+void PluginLoader::read_discovery_cache() {
+    if (cache_file_.empty()) {
+        return;
+    }
+
+    std::ifstream ifs(cache_file_);
+    std::string line;
+    while (std::getline(ifs, line)) {
+        // each line is formatted as: path \t modification time \t is plugin \t integrator name
+        std::vector<std::string> fields;
+        size_t start = 0, pos;
+        while ((pos = line.find('\t', start)) != std::string::npos) {
+            fields.push_back(line.substr(start, pos - start));
+            start = pos + 1;
+        }
+        fields.push_back(line.substr(start));
+        if (fields.size() != 4) {
+            continue;
+        }
+
+        CacheEntry entry;
+        try {
+            entry.modification_time = std::stoll(fields[1]);
+        } catch (const std::exception &) { continue; }
+        entry.is_plugin       = (fields[2] == "1");
+        entry.integrator_name = fields[3];
+        // entries updated in this process take precedence
+        cache_.insert(std::make_pair(fields[0], entry));
+    }
+}
+
+void PluginLoader::write_discovery_cache() const {
+    if (cache_file_.empty()) {
+        return;
+    }
+
+    // write in a temporary file first, so that concurrent processes never read a partially written cache
+    const std::string tmp_file = cache_file_ + "." + std::to_string(std::random_device()()) + ".tmp";
+    {
+        std::ofstream ofs(tmp_file);
+        if (!ofs) {
+            MV_HAL_LOG_TRACE() << "Could not write plugin discovery cache" << cache_file_;
+            return;
+        }
+        for (const auto &p : cache_) {
+            ofs << p.first << '\t' << p.second.modification_time << '\t' << (p.second.is_plugin ? 1 : 0) << '\t'
+                << p.second.integrator_name << '\n';
+        }
+    }
+#ifdef _WIN32
+    std::remove(cache_file_.c_str());
+#endif
+    if (std::rename(tmp_file.c_str(), cache_file_.c_str()) != 0) {
+        std::remove(tmp_file.c_str());
+    }
 }
 
 std::unique_ptr<Plugin> PluginLoader::make_plugin(const std::string &plugin_name) {
@@ -53,6 +53,7 @@ FileDataTransfer::FileDataTransfer(const std::shared_ptr<std::istream> &stream,
 
     stream_to_read_->clear();
     stream_to_read_->seekg(data_start_pos_);
+    read_position_ = static_cast<int64_t>(data_start_pos_);
 
     seek_buffer_ = get_buffer();
 }
@@ -75,6 +76,10 @@ void FileDataTransfer::get_seek_range(std::streampos &data_start_pos, std::strea
     data_end_pos   = data_end_pos_;
 }
 
+std::streampos FileDataTransfer::get_read_position() const {
+    return read_position_.load(std::memory_order_relaxed);
+}
+
 void FileDataTransfer::start_impl(BufferPtr buffer) {
     data_read_ = buffer;
 }
@@ -107,6 +112,8 @@ void FileDataTransfer::run_impl() {
             auto good = stream_to_read_->good();
 
             if (count > 0) {
+                read_position_.fetch_add(count, std::memory_order_relaxed);
+
                 // If something has been read, transfer the data
                 data_read_->resize(count);
                 auto next_data_read = transfer_data(data_read_);
@@ -141,7 +148,8 @@ bool FileDataTransfer::seek_impl(const std::streampos &target_position) {
         if (stream_to_read_->good()) {
             // valid seek
             stream_to_read_->unget();
-            ret = true;
+            read_position_ = static_cast<int64_t>(target_position);
+            ret            = true;
         } else {
             // Invalid seek -> return to initial position
             stream_to_read_->clear(); // If status is failed, seek may not work thus clear is necessary
@@ -0,0 +1,62 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+#include "metavision/hal/utils/hal_exception.h"
+#include "metavision/hal/utils/shm_data_transfer.h"
+
+namespace Metavision {
+
+ShmDataTransfer::ShmDataTransfer(std::unique_ptr<ShmRingReader> reader, uint32_t raw_event_size_bytes,
+                                 uint32_t n_buffers) :
+    DataTransfer(raw_event_size_bytes, BufferPool::make_bounded(std::max(2u, n_buffers))), reader_(std::move(reader)) {
+    if (!reader_) {
+        throw HalException(HalErrorCode::InvalidArgument, "Shared memory ring reader must not be null.");
+    }
+}
+
+ShmDataTransfer::~ShmDataTransfer() {
+    stop();
+}
+
+const ShmRingReader &ShmDataTransfer::get_reader() const {
+    return *reader_;
+}
+
+void ShmDataTransfer::start_impl(BufferPtr buffer) {
+    data_read_ = buffer;
+}
+
+void ShmDataTransfer::run_impl() {
+    while (!should_stop()) {
+        size_t size;
+        const uint8_t *data = reader_->try_acquire(size);
+        if (!data) {
+            if (reader_->is_closed()) {
+                break;
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+            continue;
+        }
+
+        data_read_->assign(data, data + size);
+        // The copy is only transferred if the writer did not overwrite the slot in the meantime
+        if (reader_->release()) {
+            auto next_data_read = transfer_data(data_read_);
+            data_read_          = next_data_read;
+        }
+    }
+}
+
+} // namespace Metavision
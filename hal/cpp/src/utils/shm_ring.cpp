@@ -0,0 +1,427 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <atomic>
+#include <algorithm>
+#include <cstring>
+#if !defined(_WIN32) && !defined(__ANDROID__)
+#define METAVISION_HAL_HAS_POSIX_SHM
+#endif
+
+#ifdef METAVISION_HAL_HAS_POSIX_SHM
+#include <cerrno>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "metavision/hal/utils/shm_ring.h"
+#include "metavision/hal/utils/data_transfer.h"
+#include "metavision/hal/utils/future/data_transfer.h"
+#include "metavision/hal/utils/hal_exception.h"
+#include "metavision/hal/utils/hal_log.h"
+
+namespace Metavision {
+
+namespace {
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "Shared memory rings require lock-free 64 bits atomics");
+
+constexpr uint64_t ShmRingMagic   = 0x474e49524d485356; // "VSHMRING"
+constexpr uint32_t ShmRingVersion = 2;
+constexpr size_t CacheLineSize    = 64;
+
+// Layout of the shared memory: control block, RAW header, then slot_count slots of slot_stride bytes each
+//
+// Each slot starts with a sequence number, used as a seqlock: while the writer fills the slot for the n-th write, the
+// sequence is 2n+1, and it is set to 2n+2 once the data is complete. A reader expecting the n-th write knows the data
+// is not published yet if the sequence is lower than 2n+2, and that it has been overwritten if it is greater.
+//
+// A buffer larger than a slot is split across consecutive slots, the first one being flagged so that a reader which
+// skipped slots resumes at the beginning of a buffer.
+struct ShmRingControl {
+    std::atomic<uint64_t> magic;
+    uint32_t version;
+    uint32_t slot_count;
+    uint32_t slot_size;
+    uint32_t raw_header_size;
+    uint64_t slots_offset;
+    uint64_t slot_stride;
+    int64_t writer_pid; // used to detect a ring left over by a writer that did not exit cleanly
+    alignas(CacheLineSize) std::atomic<uint64_t> write_index;
+    std::atomic<uint32_t> closed;
+};
+
+constexpr uint32_t ShmRingSlotFirst = 1; // the slot holds the beginning of a buffer
+
+struct ShmRingSlot {
+    std::atomic<uint64_t> sequence;
+    uint32_t size;
+    uint32_t flags;
+
+    uint8_t *data() {
+        return reinterpret_cast<uint8_t *>(this) + sizeof(ShmRingSlot);
+    }
+};
+
+size_t align_up(size_t value, size_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+std::string get_shm_object_name(const std::string &name) {
+    if (name.empty()) {
+        throw HalException(HalErrorCode::InvalidArgument, "Shared memory ring name must not be empty.");
+    }
+    if (name.find('/') != std::string::npos) {
+        throw HalException(HalErrorCode::InvalidArgument,
+                           "Shared memory ring name '" + name + "' must not contain any '/'.");
+    }
+    return "/" + name;
+}
+
+#ifndef METAVISION_HAL_HAS_POSIX_SHM
+[[noreturn]] void throw_not_implemented() {
+    throw HalException(HalErrorCode::OperationNotImplemented,
+                       "Shared memory rings are not available on this platform.");
+}
+#else
+std::string get_error_string() {
+    return std::strerror(errno);
+}
+
+// Checks if an existing ring was left over by a writer process which is no longer running. A ring which can not be
+// checked, e.g. because it belongs to another user or is being created, is considered in use
+bool is_stale_ring(const std::string &object_name) {
+    int fd = shm_open(object_name.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+        return false;
+    }
+    bool stale = false;
+    struct stat st;
+    if (fstat(fd, &st) == 0 && static_cast<size_t>(st.st_size) >= sizeof(ShmRingControl)) {
+        void *mapping = mmap(nullptr, sizeof(ShmRingControl), PROT_READ, MAP_SHARED, fd, 0);
+        if (mapping != MAP_FAILED) {
+            const auto *control = static_cast<const ShmRingControl *>(mapping);
+            if (control->magic.load(std::memory_order_acquire) == ShmRingMagic &&
+                control->version == ShmRingVersion && control->writer_pid > 0) {
+                stale = kill(static_cast<pid_t>(control->writer_pid), 0) != 0 && errno == ESRCH;
+            }
+            munmap(mapping, sizeof(ShmRingControl));
+        }
+    }
+    close(fd);
+    return stale;
+}
+#endif
+
+} // namespace
+
+std::string get_shm_ring_name(const std::string &serial) {
+    const std::string prefix(ShmRingSerialPrefix);
+    if (serial.compare(0, prefix.size(), prefix) != 0) {
+        return std::string();
+    }
+    return serial.substr(prefix.size());
+}
+
+struct ShmRingWriter::Private {
+    std::string name;
+    std::string object_name;
+    void *mapping{nullptr};
+    size_t mapping_size{0};
+    ShmRingControl *control{nullptr};
+    uint8_t *slots{nullptr};
+
+    ShmRingSlot &slot(uint64_t index) {
+        return *reinterpret_cast<ShmRingSlot *>(slots + (index % control->slot_count) * control->slot_stride);
+    }
+
+    void write_slot(const uint8_t *data, size_t size, uint32_t flags) {
+        // There is a single writer, so the index can not change concurrently
+        const uint64_t index = control->write_index.load(std::memory_order_relaxed);
+        ShmRingSlot &s       = slot(index);
+        s.sequence.store(2 * index + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        s.size  = static_cast<uint32_t>(size);
+        s.flags = flags;
+        std::memcpy(s.data(), data, size);
+        s.sequence.store(2 * index + 2, std::memory_order_release);
+        control->write_index.store(index + 1, std::memory_order_release);
+    }
+};
+
+ShmRingWriter::ShmRingWriter(const std::string &name, const std::string &raw_header, uint32_t slot_count,
+                             uint32_t slot_size) :
+    pimpl_(new Private()) {
+#ifndef METAVISION_HAL_HAS_POSIX_SHM
+    throw_not_implemented();
+#else
+    if (slot_count == 0 || slot_size == 0) {
+        throw HalException(HalErrorCode::InvalidArgument,
+                           "Shared memory ring slot count and slot size must be greater than 0.");
+    }
+    slot_size = static_cast<uint32_t>(align_up(slot_size, 4));
+
+    pimpl_->name                = name;
+    pimpl_->object_name         = get_shm_object_name(name);
+    const uint64_t slots_offset = align_up(sizeof(ShmRingControl) + raw_header.size(), CacheLineSize);
+    const uint64_t slot_stride  = align_up(sizeof(ShmRingSlot) + slot_size, CacheLineSize);
+    pimpl_->mapping_size        = slots_offset + slot_count * slot_stride;
+
+    // The ring is only readable and writable by the user of this process. An existing ring is only replaced if it was
+    // left over by a writer that did not exit cleanly
+    int fd = shm_open(pimpl_->object_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0 && errno == EEXIST && is_stale_ring(pimpl_->object_name)) {
+        MV_HAL_LOG_TRACE() << "Replacing shared memory ring" << name << "left over by a writer no longer running";
+        shm_unlink(pimpl_->object_name.c_str());
+        fd = shm_open(pimpl_->object_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    }
+    if (fd < 0) {
+        throw HalException(HalErrorCode::FailedInitialization,
+                           "Unable to create shared memory ring '" + name + "': " + get_error_string());
+    }
+    if (ftruncate(fd, pimpl_->mapping_size) != 0) {
+        const std::string error = get_error_string();
+        close(fd);
+        shm_unlink(pimpl_->object_name.c_str());
+        throw HalException(HalErrorCode::FailedInitialization,
+                           "Unable to allocate shared memory ring '" + name + "': " + error);
+    }
+    pimpl_->mapping = mmap(nullptr, pimpl_->mapping_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (pimpl_->mapping == MAP_FAILED) {
+        const std::string error = get_error_string();
+        shm_unlink(pimpl_->object_name.c_str());
+        throw HalException(HalErrorCode::FailedInitialization,
+                           "Unable to map shared memory ring '" + name + "': " + error);
+    }
+
+    // The memory is zero-initialized, which is a valid state for the atomics and the slots sequences
+    auto *base      = static_cast<uint8_t *>(pimpl_->mapping);
+    auto *control   = reinterpret_cast<ShmRingControl *>(base);
+    pimpl_->control = control;
+    pimpl_->slots   = base + slots_offset;
+
+    control->version         = ShmRingVersion;
+    control->slot_count      = slot_count;
+    control->slot_size       = slot_size;
+    control->raw_header_size = static_cast<uint32_t>(raw_header.size());
+    control->slots_offset    = slots_offset;
+    control->slot_stride     = slot_stride;
+    control->writer_pid      = getpid();
+    std::memcpy(base + sizeof(ShmRingControl), raw_header.data(), raw_header.size());
+    // Readers only use the ring once the magic number is visible
+    control->magic.store(ShmRingMagic, std::memory_order_release);
+#endif
+}
+
+ShmRingWriter::~ShmRingWriter() {
+#ifdef METAVISION_HAL_HAS_POSIX_SHM
+    if (pimpl_->mapping) {
+        pimpl_->control->closed.store(1, std::memory_order_release);
+        munmap(pimpl_->mapping, pimpl_->mapping_size);
+        // Readers that already opened the ring keep their mapping until they are destroyed
+        shm_unlink(pimpl_->object_name.c_str());
+    }
+#endif
+}
+
+void ShmRingWriter::write(const uint8_t *data, size_t size) {
+    const size_t slot_size = pimpl_->control->slot_size;
+    for (uint32_t flags = ShmRingSlotFirst; size > 0; flags = 0) {
+        const size_t n = std::min(size, slot_size);
+        pimpl_->write_slot(data, n, flags);
+        data += n;
+        size -= n;
+    }
+}
+
+size_t ShmRingWriter::tap(DataTransfer &data_transfer) {
+    return data_transfer.add_new_buffer_callback(
+        [this](const DataTransfer::BufferPtr &buffer) { write(buffer->data(), buffer->size()); });
+}
+
+size_t ShmRingWriter::tap(Future::DataTransfer &data_transfer) {
+    return data_transfer.add_new_buffer_callback(
+        [this](const Future::DataTransfer::BufferPtr &buffer) { write(buffer->data(), buffer->size()); });
+}
+
+const std::string &ShmRingWriter::get_name() const {
+    return pimpl_->name;
+}
+
+uint64_t ShmRingWriter::get_written_slots_count() const {
+    return pimpl_->control->write_index.load(std::memory_order_relaxed);
+}
+
+struct ShmRingReader::Private {
+    std::string raw_header;
+    void *mapping{nullptr};
+    size_t mapping_size{0};
+    const ShmRingControl *control{nullptr};
+    const uint8_t *slots{nullptr};
+    // Layout of the ring, copied once validated so that the writer can not change it afterwards
+    uint32_t slot_count{0};
+    uint32_t slot_size{0};
+    uint64_t slot_stride{0};
+    uint64_t read_index{0};
+    uint64_t skipped_slots{0};
+    // Set when the reader may be in the middle of a buffer, whose remaining slots are then skipped
+    bool resynchronizing{true};
+
+    const ShmRingSlot &slot(uint64_t index) const {
+        return *reinterpret_cast<const ShmRingSlot *>(slots + (index % slot_count) * slot_stride);
+    }
+
+    // Moves the cursor to the middle of the ring, leaving the reader some time before the writer catches up again
+    void skip_to_middle(uint64_t write_index) {
+        const uint64_t new_read_index = write_index - std::min<uint64_t>(write_index, slot_count / 2);
+        if (new_read_index > read_index) {
+            MV_HAL_LOG_TRACE() << "Shared memory ring reader lagging behind, skipping" << new_read_index - read_index
+                               << "slots";
+            skipped_slots += new_read_index - read_index;
+            read_index      = new_read_index;
+            resynchronizing = true;
+        }
+    }
+};
+
+ShmRingReader::ShmRingReader(const std::string &name) : pimpl_(new Private()) {
+#ifndef METAVISION_HAL_HAS_POSIX_SHM
+    throw_not_implemented();
+#else
+    const std::string object_name = get_shm_object_name(name);
+    int fd                        = shm_open(object_name.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+        throw HalException(HalErrorCode::FailedInitialization,
+                           "Unable to open shared memory ring '" + name + "': " + get_error_string());
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(ShmRingControl)) {
+        close(fd);
+        throw HalException(HalErrorCode::FailedInitialization, "Invalid shared memory ring '" + name + "'.");
+    }
+    pimpl_->mapping_size = st.st_size;
+    pimpl_->mapping      = mmap(nullptr, pimpl_->mapping_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (pimpl_->mapping == MAP_FAILED) {
+        pimpl_->mapping = nullptr;
+        throw HalException(HalErrorCode::FailedInitialization,
+                           "Unable to map shared memory ring '" + name + "': " + get_error_string());
+    }
+
+    const auto *base = static_cast<const uint8_t *>(pimpl_->mapping);
+    const auto *ctrl = reinterpret_cast<const ShmRingControl *>(base);
+    // The layout is read once and checked against the size of the mapping, so that a corrupted ring can not make the
+    // reader access memory out of it
+    const bool valid = ctrl->magic.load(std::memory_order_acquire) == ShmRingMagic &&
+                       ctrl->version == ShmRingVersion;
+    const uint32_t slot_count      = ctrl->slot_count;
+    const uint32_t slot_size       = ctrl->slot_size;
+    const uint32_t raw_header_size = ctrl->raw_header_size;
+    const uint64_t slots_offset    = ctrl->slots_offset;
+    const uint64_t slot_stride     = ctrl->slot_stride;
+    if (!valid || slot_count == 0 || slot_size == 0 || sizeof(ShmRingControl) + raw_header_size > slots_offset ||
+        slot_stride < sizeof(ShmRingSlot) + slot_size || slot_stride % alignof(ShmRingSlot) != 0 ||
+        slots_offset % alignof(ShmRingSlot) != 0 || slots_offset > pimpl_->mapping_size ||
+        (pimpl_->mapping_size - slots_offset) / slot_stride < slot_count) {
+        munmap(pimpl_->mapping, pimpl_->mapping_size);
+        pimpl_->mapping = nullptr;
+        throw HalException(HalErrorCode::FailedInitialization, "Invalid shared memory ring '" + name + "'.");
+    }
+    pimpl_->control     = ctrl;
+    pimpl_->slots       = base + slots_offset;
+    pimpl_->slot_count  = slot_count;
+    pimpl_->slot_size   = slot_size;
+    pimpl_->slot_stride = slot_stride;
+    pimpl_->raw_header  = std::string(reinterpret_cast<const char *>(base + sizeof(ShmRingControl)), raw_header_size);
+    pimpl_->read_index  = ctrl->write_index.load(std::memory_order_acquire);
+#endif
+}
+
+ShmRingReader::~ShmRingReader() {
+#ifdef METAVISION_HAL_HAS_POSIX_SHM
+    if (pimpl_->mapping) {
+        munmap(pimpl_->mapping, pimpl_->mapping_size);
+    }
+#endif
+}
+
+const std::string &ShmRingReader::get_raw_header() const {
+    return pimpl_->raw_header;
+}
+
+const uint8_t *ShmRingReader::try_acquire(size_t &size) {
+    while (true) {
+        const uint64_t write_index = pimpl_->control->write_index.load(std::memory_order_acquire);
+        if (write_index - pimpl_->read_index > pimpl_->slot_count) {
+            pimpl_->skip_to_middle(write_index);
+        }
+        if (pimpl_->read_index >= write_index) {
+            return nullptr;
+        }
+
+        const ShmRingSlot &s = pimpl_->slot(pimpl_->read_index);
+        const uint64_t seq   = 2 * pimpl_->read_index + 2;
+        if (s.sequence.load(std::memory_order_acquire) != seq) {
+            // The slot is being overwritten for a later write
+            pimpl_->skip_to_middle(write_index + 1);
+            return nullptr;
+        }
+        if (!pimpl_->resynchronizing) {
+            size = std::min<uint32_t>(s.size, pimpl_->slot_size);
+            return const_cast<ShmRingSlot &>(s).data();
+        }
+
+        // After skipping slots, the data is only forwarded from the beginning of a buffer, the end of the
+        // interrupted buffer being useless to decode. The flags are only trusted if the slot was not overwritten
+        // while they were read
+        const bool first = (s.flags & ShmRingSlotFirst) != 0;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (s.sequence.load(std::memory_order_relaxed) != seq) {
+            pimpl_->skip_to_middle(write_index + 1);
+            return nullptr;
+        }
+        if (first) {
+            pimpl_->resynchronizing = false;
+        } else {
+            ++pimpl_->read_index;
+            ++pimpl_->skipped_slots;
+        }
+    }
+}
+
+bool ShmRingReader::release() {
+    const ShmRingSlot &s = pimpl_->slot(pimpl_->read_index);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const bool valid = s.sequence.load(std::memory_order_relaxed) == 2 * pimpl_->read_index + 2;
+    if (valid) {
+        ++pimpl_->read_index;
+    } else {
+        pimpl_->skip_to_middle(pimpl_->control->write_index.load(std::memory_order_acquire) + 1);
+        // The next slot may continue the buffer whose data has just been lost
+        pimpl_->resynchronizing = true;
+    }
+    return valid;
+}
+
+bool ShmRingReader::is_closed() const {
+    return pimpl_->control->closed.load(std::memory_order_acquire) != 0 &&
+           pimpl_->read_index >= pimpl_->control->write_index.load(std::memory_order_acquire);
+}
+
+uint64_t ShmRingReader::get_skipped_slots_count() const {
+    return pimpl_->skipped_slots;
+}
+
+} // namespace Metavision
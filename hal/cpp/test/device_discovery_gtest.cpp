@@ -94,6 +94,113 @@ TEST_F(DeviceDiscovery_GTest, open_rawfile_success_with_dummy_test_plugin) {
 #endif
 }
 
+TEST_F(DeviceDiscovery_GTest, open_rawfile_with_dummy_test_plugin_fills_discovery_cache) {
+    const std::string dummy_plugin_test_path(HAL_DUMMY_TEST_PLUGIN);
+    const std::string cache_path = tmpdir_handler_->get_full_path("hal_plugin_discovery_cache");
+    const char *env              = getenv("MV_HAL_PLUGIN_PATH");
+
+#ifdef _WIN32
+    std::string s("MV_HAL_PLUGIN_PATH=");
+    s += std::string(env ? env : "") + ";" + dummy_plugin_test_path;
+    _putenv(s.c_str());
+    _putenv(("MV_HAL_PLUGIN_DISCOVERY_CACHE=" + cache_path).c_str());
+#else
+    std::string s(env ? env : "");
+    s += ":" + dummy_plugin_test_path;
+    setenv("MV_HAL_PLUGIN_PATH", s.c_str(), 1);
+    setenv("MV_HAL_PLUGIN_DISCOVERY_CACHE", cache_path.c_str(), 1);
+#endif
+
+    // only the integrator name is known: the libraries need to be opened once to find the matching plugin
+    RawFileHeader header;
+    const std::string integrator_name("__DummyTest__");
+    header.set_integrator_name(integrator_name);
+    write_header(0, header);
+
+    std::unique_ptr<Device> device;
+    ASSERT_NO_THROW(device = DeviceDiscovery::open_raw_file(rawfile_to_log_path_));
+    ASSERT_EQ(integrator_name, device->get_facility<I_HW_Identification>()->get_integrator());
+
+    std::ifstream cache_ifs(cache_path);
+    ASSERT_TRUE(cache_ifs.is_open());
+    bool found = false;
+    std::string line;
+    while (std::getline(cache_ifs, line)) {
+        if (line.find("hal_dummy_test_plugin") != std::string::npos) {
+            found = true;
+            ASSERT_NE(std::string::npos, line.find("\t1\t" + integrator_name));
+        }
+    }
+    ASSERT_TRUE(found);
+
+#ifdef _WIN32
+    s = "MV_HAL_PLUGIN_PATH=" + std::string(env ? env : "");
+    _putenv(s.c_str());
+    _putenv("MV_HAL_PLUGIN_DISCOVERY_CACHE=");
+#else
+    setenv("MV_HAL_PLUGIN_PATH", env ? env : "", 1);
+    unsetenv("MV_HAL_PLUGIN_DISCOVERY_CACHE");
+#endif
+}
+
+TEST_F(DeviceDiscovery_GTest, open_rawfile_retries_plugin_library_that_failed_to_open) {
+#ifdef _WIN32
+    const std::string dummy_library_name("hal_dummy_test_plugin.dll");
+    const std::string retry_library_name("hal_retry_test_plugin.dll");
+#elif defined __APPLE__
+    const std::string dummy_library_name("libhal_dummy_test_plugin.dylib");
+    const std::string retry_library_name("libhal_retry_test_plugin.dylib");
+#else
+    const std::string dummy_library_name("libhal_dummy_test_plugin.so");
+    const std::string retry_library_name("libhal_retry_test_plugin.so");
+#endif
+    const std::string dummy_library_path = std::string(HAL_DUMMY_TEST_PLUGIN) + "/" + dummy_library_name;
+    const std::string retry_library_path = tmpdir_handler_->get_full_path(retry_library_name);
+    const char *env                      = getenv("MV_HAL_PLUGIN_PATH");
+
+#ifdef _WIN32
+    std::string s("MV_HAL_PLUGIN_PATH=");
+    s += std::string(env ? env : "") + ";" + tmpdir_handler_->get_tmpdir_path();
+    _putenv(s.c_str());
+#else
+    std::string s(env ? env : "");
+    s += ":" + tmpdir_handler_->get_tmpdir_path();
+    setenv("MV_HAL_PLUGIN_PATH", s.c_str(), 1);
+#endif
+
+    RawFileHeader header;
+    const std::string integrator_name("__DummyTest__");
+    const std::string plugin_name("hal_retry_test_plugin");
+    header.set_integrator_name(integrator_name);
+    header.set_plugin_name(plugin_name);
+    write_header(0, header);
+
+    // the library of the plugin can not be opened yet
+    {
+        std::ofstream library_ofs(retry_library_path, std::ios::out | std::ios::binary);
+        library_ofs << "not a shared library";
+    }
+    std::unique_ptr<Device> device;
+    ASSERT_THROW(device = DeviceDiscovery::open_raw_file(rawfile_to_log_path_), HalException);
+
+    // once fixed, the library is opened on the next attempt
+    {
+        std::ifstream library_ifs(dummy_library_path, std::ios::in | std::ios::binary);
+        ASSERT_TRUE(library_ifs.is_open());
+        std::ofstream library_ofs(retry_library_path, std::ios::out | std::ios::binary | std::ios::trunc);
+        library_ofs << library_ifs.rdbuf();
+    }
+    ASSERT_NO_THROW(device = DeviceDiscovery::open_raw_file(rawfile_to_log_path_));
+    ASSERT_EQ(plugin_name, device->get_facility<I_PluginSoftwareInfo>()->get_plugin_name());
+
+#ifdef _WIN32
+    s = "MV_HAL_PLUGIN_PATH=" + std::string(env ? env : "");
+    _putenv(s.c_str());
+#else
+    setenv("MV_HAL_PLUGIN_PATH", env ? env : "", 1);
+#endif
+}
+
 TEST_WITHOUT_CAMERA(DeviceDiscoveryNoF_GTest, open_camera_fails_if_no_camera_plugged) {
     std::unique_ptr<Device> device;
     ASSERT_NO_THROW(device = DeviceDiscovery::open(""));
@@ -0,0 +1,260 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include "metavision/hal/utils/hal_exception.h"
+#include "metavision/hal/utils/shm_data_transfer.h"
+#include "metavision/hal/utils/shm_ring.h"
+
+using namespace Metavision;
+
+namespace {
+std::vector<uint8_t> make_buffer(size_t size, uint8_t first_value) {
+    std::vector<uint8_t> buffer(size);
+    for (size_t i = 0; i < size; ++i) {
+        buffer[i] = static_cast<uint8_t>(first_value + i);
+    }
+    return buffer;
+}
+
+std::vector<uint8_t> read_next(ShmRingReader &reader) {
+    size_t size;
+    const uint8_t *data = reader.try_acquire(size);
+    if (!data) {
+        return std::vector<uint8_t>();
+    }
+    std::vector<uint8_t> buffer(data, data + size);
+    EXPECT_TRUE(reader.release());
+    return buffer;
+}
+} // namespace
+
+class ShmRing_GTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        // Names are shared by the whole system, make sure concurrent runs do not interfere
+        name_ = "mv_hal_gtest_" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count());
+    }
+
+    std::string name_;
+};
+
+TEST(ShmRingName_GTest, get_shm_ring_name) {
+    EXPECT_EQ("camera", get_shm_ring_name("shm://camera"));
+    EXPECT_EQ("", get_shm_ring_name("00001234"));
+    EXPECT_EQ("", get_shm_ring_name("Prophesee:hal_plugin_gen3:00001234"));
+}
+
+TEST_F(ShmRing_GTest, open_non_existing_ring_throws) {
+    EXPECT_THROW(ShmRingReader reader(name_), HalException);
+}
+
+TEST_F(ShmRing_GTest, write_and_read) {
+    const std::string raw_header = "% format EVT3\n% geometry 640x480\n";
+    ShmRingWriter writer(name_, raw_header, 8, 64);
+    ShmRingReader reader1(name_), reader2(name_);
+    EXPECT_EQ(raw_header, reader1.get_raw_header());
+
+    size_t size;
+    EXPECT_EQ(nullptr, reader1.try_acquire(size));
+
+    const auto buffer1 = make_buffer(40, 0);
+    const auto buffer2 = make_buffer(64, 100);
+    writer.write(buffer1.data(), buffer1.size());
+    writer.write(buffer2.data(), buffer2.size());
+    EXPECT_EQ(2u, writer.get_written_slots_count());
+
+    // Each reader has its own cursor
+    for (auto *reader : {&reader1, &reader2}) {
+        EXPECT_EQ(buffer1, read_next(*reader));
+        EXPECT_EQ(buffer2, read_next(*reader));
+        EXPECT_EQ(nullptr, reader->try_acquire(size));
+        EXPECT_FALSE(reader->is_closed());
+        EXPECT_EQ(0u, reader->get_skipped_slots_count());
+    }
+}
+
+TEST_F(ShmRing_GTest, large_buffer_is_split_across_slots) {
+    ShmRingWriter writer(name_, "", 8, 64);
+    ShmRingReader reader(name_);
+
+    const auto buffer = make_buffer(150, 0);
+    writer.write(buffer.data(), buffer.size());
+    EXPECT_EQ(3u, writer.get_written_slots_count());
+
+    std::vector<uint8_t> read;
+    for (int i = 0; i < 3; ++i) {
+        const auto slot = read_next(reader);
+        EXPECT_LE(slot.size(), 64u);
+        read.insert(read.end(), slot.begin(), slot.end());
+    }
+    EXPECT_EQ(buffer, read);
+}
+
+TEST_F(ShmRing_GTest, reader_opened_late_starts_at_next_slot) {
+    ShmRingWriter writer(name_, "", 8, 64);
+    const auto buffer1 = make_buffer(16, 0);
+    const auto buffer2 = make_buffer(16, 50);
+    writer.write(buffer1.data(), buffer1.size());
+
+    ShmRingReader reader(name_);
+    writer.write(buffer2.data(), buffer2.size());
+    EXPECT_EQ(buffer2, read_next(reader));
+}
+
+TEST_F(ShmRing_GTest, lagging_reader_skips_ahead_without_blocking_writer) {
+    ShmRingWriter writer(name_, "", 4, 64);
+    ShmRingReader reader(name_);
+
+    for (uint8_t i = 0; i < 10; ++i) {
+        const auto buffer = make_buffer(16, i);
+        writer.write(buffer.data(), buffer.size());
+    }
+
+    // The reader jumps to the middle of the ring: the last 2 slots are still available
+    EXPECT_EQ(make_buffer(16, 8), read_next(reader));
+    EXPECT_EQ(8u, reader.get_skipped_slots_count());
+    EXPECT_EQ(make_buffer(16, 9), read_next(reader));
+}
+
+TEST_F(ShmRing_GTest, lagging_reader_resumes_at_beginning_of_buffer) {
+    ShmRingWriter writer(name_, "", 4, 64);
+    ShmRingReader reader(name_);
+
+    // Buffers of 3 slots: after skipping to the middle of the ring, the reader lands on the last slot of a buffer
+    for (uint8_t i = 0; i < 4; ++i) {
+        const auto buffer = make_buffer(150, i);
+        writer.write(buffer.data(), buffer.size());
+    }
+    EXPECT_EQ(12u, writer.get_written_slots_count());
+    EXPECT_TRUE(read_next(reader).empty());
+    EXPECT_EQ(12u, reader.get_skipped_slots_count());
+
+    // The next buffer is read from its first slot
+    const auto buffer = make_buffer(150, 10);
+    writer.write(buffer.data(), buffer.size());
+    std::vector<uint8_t> read;
+    for (int i = 0; i < 3; ++i) {
+        const auto slot = read_next(reader);
+        read.insert(read.end(), slot.begin(), slot.end());
+    }
+    EXPECT_EQ(buffer, read);
+    EXPECT_EQ(12u, reader.get_skipped_slots_count());
+}
+
+TEST_F(ShmRing_GTest, ring_of_running_writer_is_not_replaced) {
+    ShmRingWriter writer(name_, "", 4, 64);
+    EXPECT_THROW(ShmRingWriter other_writer(name_, "", 4, 64), HalException);
+
+    // The existing ring is left untouched
+    ShmRingReader reader(name_);
+    const auto buffer = make_buffer(16, 0);
+    writer.write(buffer.data(), buffer.size());
+    EXPECT_EQ(buffer, read_next(reader));
+}
+
+TEST_F(ShmRing_GTest, ring_left_over_by_exited_writer_is_replaced) {
+    // The child process exits without destroying its writer, which leaves the ring behind as after a crash
+    const pid_t pid = fork();
+    ASSERT_NE(-1, pid);
+    if (pid == 0) {
+        new ShmRingWriter(name_, "", 4, 64);
+        _exit(0);
+    }
+    int status;
+    ASSERT_EQ(pid, waitpid(pid, &status, 0));
+
+    ShmRingWriter writer(name_, "", 4, 64);
+    ShmRingReader reader(name_);
+    const auto buffer = make_buffer(16, 0);
+    writer.write(buffer.data(), buffer.size());
+    EXPECT_EQ(buffer, read_next(reader));
+}
+
+TEST_F(ShmRing_GTest, data_overwritten_while_acquired_is_invalid) {
+    ShmRingWriter writer(name_, "", 4, 64);
+    ShmRingReader reader(name_);
+
+    const auto buffer = make_buffer(16, 0);
+    writer.write(buffer.data(), buffer.size());
+
+    size_t size;
+    ASSERT_NE(nullptr, reader.try_acquire(size));
+    for (int i = 0; i < 4; ++i) {
+        writer.write(buffer.data(), buffer.size());
+    }
+    EXPECT_FALSE(reader.release());
+    EXPECT_GT(reader.get_skipped_slots_count(), 0u);
+}
+
+TEST_F(ShmRing_GTest, reader_is_closed_once_remaining_data_is_read) {
+    auto writer = std::make_unique<ShmRingWriter>(name_, "", 4, 64);
+    ShmRingReader reader(name_);
+
+    const auto buffer = make_buffer(16, 0);
+    writer->write(buffer.data(), buffer.size());
+    writer.reset();
+
+    // The ring can not be opened anymore, but the data is still readable
+    EXPECT_THROW(ShmRingReader other_reader(name_), HalException);
+    EXPECT_FALSE(reader.is_closed());
+    EXPECT_EQ(buffer, read_next(reader));
+    EXPECT_TRUE(reader.is_closed());
+}
+
+TEST_F(ShmRing_GTest, data_transfer_reads_until_ring_is_closed) {
+    auto writer = std::make_unique<ShmRingWriter>(name_, "", 4, 64);
+    ShmDataTransfer data_transfer(std::make_unique<ShmRingReader>(name_), 4);
+
+    std::vector<uint8_t> read;
+    std::atomic<size_t> read_size{0};
+    std::atomic<bool> stopped{false};
+    data_transfer.add_new_buffer_callback([&read, &read_size](const DataTransfer::BufferPtr &buffer) {
+        read.insert(read.end(), buffer->begin(), buffer->end());
+        read_size = read.size();
+    });
+    data_transfer.add_status_changed_callback([&stopped](DataTransfer::Status status) {
+        if (status == DataTransfer::Status::Stopped) {
+            stopped = true;
+        }
+    });
+    data_transfer.start();
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    std::vector<uint8_t> expected;
+    for (uint8_t i = 0; i < 3; ++i) {
+        const auto buffer = make_buffer(32, static_cast<uint8_t>(10 * i));
+        writer->write(buffer.data(), buffer.size());
+        expected.insert(expected.end(), buffer.begin(), buffer.end());
+        // Let the reader keep up with the writer
+        while (read_size < expected.size() && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    writer.reset();
+
+    while (!stopped && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ASSERT_TRUE(stopped);
+    EXPECT_EQ(expected, read);
+}
@@ -0,0 +1,49 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ * Copyright (c) Framos GmbH                                                                                          *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_HAL_FRAMOS_IMX636_SHM_DISCOVERY_H
+#define METAVISION_HAL_FRAMOS_IMX636_SHM_DISCOVERY_H
+
+#include <metavision/hal/utils/camera_discovery.h>
+#include <metavision/hal/utils/device_config.h>
+
+/// @brief Discovers the streams published by a FRAMOS IMX636 camera in shared memory rings, using serials like
+/// "shm://name"
+///
+/// This class is the implementation of HAL's class @ref Metavision::CameraDiscovery
+class FramosImx636ShmDiscovery : public Metavision::CameraDiscovery {
+public:
+    /// @brief Lists serial number of available streams
+    ///
+    /// @return An empty list, as shared memory rings can not be enumerated
+    Metavision::CameraDiscovery::SerialList list() override final;
+
+    /// @brief Lists system information about available streams
+    ///
+    /// @return An empty list, as shared memory rings can not be enumerated
+    Metavision::CameraDiscovery::SystemList list_available_sources() override final;
+
+    /// @brief Discovers a device and initializes a corresponding @ref DeviceBuilder
+    /// @param device_builder Device builder to configure so that it can build a @ref Device from the parameters
+    /// @param serial Serial of the stream to open, starting with @ref Metavision::ShmRingSerialPrefix
+    /// @param config Configuration of camera creation
+    /// @return true if a device builder could be discovered from the parameters
+    bool discover(Metavision::DeviceBuilder &device_builder, const std::string &serial,
+                  const Metavision::DeviceConfig &config) override;
+
+    /// @brief Tells if this CameraDiscovery detects camera locally plugged (USB/MIPI/...) as opposed to remote
+    ///
+    /// @return false, the streams are published by other processes
+    bool is_for_local_camera() const override final;
+};
+
+#endif // METAVISION_HAL_FRAMOS_IMX636_SHM_DISCOVERY_H
@@ -13,11 +13,14 @@
 #include <string>
 #include <memory>
 #include "metavision/hal/plugin/plugin_entrypoint.h"
+#include "metavision/hal/utils/hal_exception.h"
+#include "metavision/hal/utils/hal_log.h"
 #include "metavision/hal/utils/hal_software_info.h"
 
 #include "framos_imx636_camera_discovery.h"
 #include "framos_imx636_file_discovery.h"
 #include "framos_imx636_hw_identification.h"
+#include "framos_imx636_shm_discovery.h"
 
 int FRAMOS_IMX636_PLUGIN_VERSION_MAJOR                 = 0;
 int FRAMOS_IMX636_PLUGIN_VERSION_MINOR                 = 1;
@@ -43,6 +46,12 @@ void initialize_plugin(void *plugin_ptr) {
     plugin.set_plugin_info(get_framos_imx636_plugin_software_info());
     plugin.set_hal_info(Metavision::get_hal_software_info());
 
-    plugin.add_camera_discovery(std::make_unique<FramosImx636CameraDiscovery>());
+    // The streams published in shared memory by another process can be opened without any camera connected
+    plugin.add_camera_discovery(std::make_unique<FramosImx636ShmDiscovery>());
+    try {
+        plugin.add_camera_discovery(std::make_unique<FramosImx636CameraDiscovery>());
+    } catch (const Metavision::HalException &e) {
+        MV_HAL_LOG_TRACE() << "No FRAMOS IMX636 camera available:" << e.what();
+    }
     plugin.add_file_discovery(std::make_unique<FramosImx636FileDiscovery>());
 }
@@ -0,0 +1,96 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ * Copyright (c) Framos GmbH                                                                                          *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <metavision/hal/facilities/i_device_control.h>
+#include <metavision/hal/facilities/i_events_stream.h>
+#include <metavision/hal/utils/device_builder.h>
+#include <metavision/hal/utils/hal_exception.h>
+#include <metavision/hal/utils/hal_log.h>
+#include <metavision/hal/utils/shm_data_transfer.h>
+#include <metavision/hal/utils/shm_ring.h>
+
+#include "framos_imx636_shm_discovery.h"
+#include "framos_imx636_hw_identification.h"
+#include "framos_imx636_geometry.h"
+#include "decoders/evt3/evt3_decoder.h"
+
+namespace {
+
+// The camera is controlled by the process publishing the stream
+class FramosImx636ShmDeviceControl : public Metavision::I_DeviceControl {
+public:
+    void reset() override {}
+    void start() override {}
+    void stop() override {}
+
+    bool set_mode_standalone() override {
+        return true;
+    }
+
+    bool set_mode_master() override {
+        return false;
+    }
+
+    bool set_mode_slave() override {
+        return false;
+    }
+
+    SyncMode get_mode() override {
+        return SyncMode::STANDALONE;
+    }
+};
+
+} // namespace
+
+Metavision::CameraDiscovery::SerialList FramosImx636ShmDiscovery::list() {
+    return SerialList();
+}
+
+Metavision::CameraDiscovery::SystemList FramosImx636ShmDiscovery::list_available_sources() {
+    return SystemList();
+}
+
+bool FramosImx636ShmDiscovery::discover(Metavision::DeviceBuilder &device_builder, const std::string &serial,
+                                        const Metavision::DeviceConfig &config) {
+    const std::string name = Metavision::get_shm_ring_name(serial);
+    if (name.empty()) {
+        return false;
+    }
+
+    std::unique_ptr<Metavision::ShmRingReader> reader;
+    try {
+        reader = std::make_unique<Metavision::ShmRingReader>(name);
+    } catch (const Metavision::HalException &e) {
+        MV_HAL_LOG_TRACE() << "Could not open shared memory ring:" << e.what();
+        return false;
+    }
+
+    // Add facilities to the device
+    auto hw_identification = device_builder.add_facility(
+        std::make_unique<FramosImx636HWIdentification>(device_builder.get_plugin_software_info(), "Shm", serial));
+    device_builder.add_facility(std::make_unique<FramosImx636Geometry>());
+    device_builder.add_facility(std::make_unique<FramosImx636ShmDeviceControl>());
+
+    auto cd_event_decoder =
+        device_builder.add_facility(std::make_unique<Metavision::I_EventDecoder<Metavision::EventCD>>());
+    // Timestamps are not shifted, so that all the processes reading the ring share the camera time base
+    auto decoder = device_builder.add_facility(make_evt3_decoder(false, 720, 1280, cd_event_decoder));
+    device_builder.add_facility(std::make_unique<Metavision::I_EventsStream>(
+        std::make_unique<Metavision::ShmDataTransfer>(std::move(reader), decoder->get_raw_event_size_bytes()),
+        hw_identification));
+
+    return true;
+}
+
+bool FramosImx636ShmDiscovery::is_for_local_camera() const {
+    return false;
+}
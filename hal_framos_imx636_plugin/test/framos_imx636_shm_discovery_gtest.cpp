@@ -0,0 +1,125 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ * Copyright (c) Framos GmbH                                                                                          *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "metavision/hal/device/device.h"
+#include "metavision/hal/device/device_discovery.h"
+#include "metavision/hal/facilities/i_decoder.h"
+#include "metavision/hal/facilities/i_device_control.h"
+#include "metavision/hal/facilities/i_event_decoder.h"
+#include "metavision/hal/facilities/i_events_stream.h"
+#include "metavision/hal/facilities/i_geometry.h"
+#include "metavision/hal/facilities/i_hw_identification.h"
+#include "metavision/hal/facilities/i_plugin_software_info.h"
+#include "metavision/hal/utils/raw_file_header.h"
+#include "metavision/hal/utils/shm_ring.h"
+#include "metavision/sdk/base/events/event_cd.h"
+#include "framos_imx636_hw_identification.h"
+
+using namespace Metavision;
+
+class FramosImx636ShmDiscovery_GTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        // Names are shared by the whole system, make sure concurrent runs do not interfere
+        name_ = "mv_framos_gtest_" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count());
+
+        // Same identification as the header of a stream published from a FRAMOS IMX636 camera
+        RawFileHeader header;
+        header.set_integrator_name(FramosImx636HWIdentification::FRAMOS_IMX636_INTEGRATOR);
+        header.set_plugin_name(plugin_name_);
+        writer_ = std::make_unique<ShmRingWriter>(name_, header.to_string(), 8, 1024);
+    }
+
+    const std::string plugin_name_ = "hal_framos_imx636_plugin";
+    std::string name_;
+    std::unique_ptr<ShmRingWriter> writer_;
+};
+
+TEST_F(FramosImx636ShmDiscovery_GTest, open_stream_published_by_framos_camera) {
+    // GIVEN a stream published in a shared memory ring, whose header names the FRAMOS IMX636 plugin
+    // WHEN we open it, without any FRAMOS camera connected
+    std::unique_ptr<Device> device;
+    ASSERT_NO_THROW(device = DeviceDiscovery::open(std::string(ShmRingSerialPrefix) + name_));
+
+    // THEN the device is built by the FRAMOS IMX636 plugin
+    ASSERT_NE(nullptr, device);
+    I_PluginSoftwareInfo *i_plugin_software_info = device->get_facility<I_PluginSoftwareInfo>();
+    ASSERT_NE(nullptr, i_plugin_software_info);
+    ASSERT_EQ(plugin_name_, i_plugin_software_info->get_plugin_name());
+
+    I_HW_Identification *i_hw_identification = device->get_facility<I_HW_Identification>();
+    ASSERT_NE(nullptr, i_hw_identification);
+    ASSERT_EQ(FramosImx636HWIdentification::FRAMOS_IMX636_INTEGRATOR, i_hw_identification->get_integrator());
+    ASSERT_EQ("Shm", i_hw_identification->get_connection_type());
+
+    I_Geometry *i_geometry = device->get_facility<I_Geometry>();
+    ASSERT_NE(nullptr, i_geometry);
+    ASSERT_EQ(1280, i_geometry->get_width());
+    ASSERT_EQ(720, i_geometry->get_height());
+
+    ASSERT_NE(nullptr, device->get_facility<I_DeviceControl>());
+}
+
+TEST_F(FramosImx636ShmDiscovery_GTest, decode_stream_published_by_framos_camera) {
+    // GIVEN a device opened from a stream published by a FRAMOS IMX636 camera
+    std::unique_ptr<Device> device = DeviceDiscovery::open(std::string(ShmRingSerialPrefix) + name_);
+    ASSERT_NE(nullptr, device);
+
+    I_Decoder *i_decoder                  = device->get_facility<I_Decoder>();
+    I_EventDecoder<EventCD> *i_cd_decoder = device->get_facility<I_EventDecoder<EventCD>>();
+    I_EventsStream *i_events_stream       = device->get_facility<I_EventsStream>();
+    ASSERT_NE(nullptr, i_decoder);
+    ASSERT_NE(nullptr, i_cd_decoder);
+    ASSERT_NE(nullptr, i_events_stream);
+
+    std::vector<EventCD> decoded_events;
+    i_cd_decoder->add_event_buffer_callback([&decoded_events](const EventCD *begin, const EventCD *end) {
+        decoded_events.insert(decoded_events.end(), begin, end);
+    });
+    i_events_stream->start();
+
+    // WHEN the camera publishes EVT3 data, then stops
+    const std::vector<uint16_t> evt3_data = {
+        0x8001,      // EVT_TIME_HIGH, t = 4096
+        0x6010,      // EVT_TIME_LOW, t = 4112
+        0x0005,      // EVT_ADDR_Y, y = 5
+        0x2800 | 10, // EVT_ADDR_X, x = 10, p = 1
+        0x2000 | 11, // EVT_ADDR_X, x = 11, p = 0
+    };
+    writer_->write(reinterpret_cast<const uint8_t *>(evt3_data.data()), evt3_data.size() * sizeof(uint16_t));
+    writer_.reset();
+
+    while (i_events_stream->wait_next_buffer() > 0) {
+        long n_rawbytes;
+        I_EventsStream::RawData *data = i_events_stream->get_latest_raw_data(n_rawbytes);
+        i_decoder->decode(data, data + n_rawbytes);
+    }
+
+    // THEN the published events are decoded in the camera time base
+    ASSERT_EQ(2u, decoded_events.size());
+    EXPECT_EQ(10, decoded_events[0].x);
+    EXPECT_EQ(5, decoded_events[0].y);
+    EXPECT_EQ(1, decoded_events[0].p);
+    EXPECT_EQ(4112, decoded_events[0].t);
+    EXPECT_EQ(11, decoded_events[1].x);
+    EXPECT_EQ(5, decoded_events[1].y);
+    EXPECT_EQ(0, decoded_events[1].p);
+    EXPECT_EQ(4112, decoded_events[1].t);
+}
@@ -0,0 +1,36 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_HAL_SHM_CAMERA_DISCOVERY_H
+#define METAVISION_HAL_SHM_CAMERA_DISCOVERY_H
+
+#include <string>
+
+#include "metavision/hal/utils/camera_discovery.h"
+
+namespace Metavision {
+
+/// @brief Opens the streams published in shared memory rings by other processes, using serials like "shm://name"
+///
+/// The RAW header stored in the ring is used to build the device the same way as for a RAW file. Since the rings can
+/// not be enumerated, they are never listed.
+class ShmCameraDiscovery : public CameraDiscovery {
+public:
+    virtual CameraDiscovery::SerialList list() override;
+    virtual CameraDiscovery::SystemList list_available_sources() override;
+    virtual bool discover(DeviceBuilder &device_builder, const std::string &serial,
+                          const DeviceConfig &config) override;
+    virtual bool is_for_local_camera() const override;
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_HAL_SHM_CAMERA_DISCOVERY_H
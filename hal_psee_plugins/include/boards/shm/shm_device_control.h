@@ -0,0 +1,48 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_HAL_SHM_DEVICE_CONTROL_H
+#define METAVISION_HAL_SHM_DEVICE_CONTROL_H
+
+#include "metavision/hal/facilities/i_device_control.h"
+
+namespace Metavision {
+
+/// @brief Device control of a stream read from a shared memory ring
+///
+/// The camera is controlled by the process publishing the stream, so this facility does nothing and only reports the
+/// standalone mode.
+class ShmDeviceControl : public I_DeviceControl {
+public:
+    void reset() override {}
+    void start() override {}
+    void stop() override {}
+
+    bool set_mode_standalone() override {
+        return true;
+    }
+
+    bool set_mode_master() override {
+        return false;
+    }
+
+    bool set_mode_slave() override {
+        return false;
+    }
+
+    SyncMode get_mode() override {
+        return SyncMode::STANDALONE;
+    }
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_HAL_SHM_DEVICE_CONTROL_H
@@ -0,0 +1,93 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include "boards/shm/shm_camera_discovery.h"
+#include "boards/shm/shm_device_control.h"
+#include "boards/rawfile/psee_raw_file_header.h"
+#include "boards/rawfile/file_hw_identification.h"
+#include "decoders/evt2/evt2_decoder.h"
+#include "decoders/evt3/evt3_decoder.h"
+#include "metavision/hal/facilities/i_event_decoder.h"
+#include "metavision/hal/facilities/i_events_stream.h"
+#include "metavision/hal/utils/device_builder.h"
+#include "metavision/hal/utils/hal_log.h"
+#include "metavision/hal/utils/shm_data_transfer.h"
+#include "metavision/hal/utils/shm_ring.h"
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/base/events/event_ext_trigger.h"
+
+namespace Metavision {
+
+CameraDiscovery::SerialList ShmCameraDiscovery::list() {
+    return SerialList();
+}
+
+CameraDiscovery::SystemList ShmCameraDiscovery::list_available_sources() {
+    return SystemList();
+}
+
+bool ShmCameraDiscovery::is_for_local_camera() const {
+    return false;
+}
+
+bool ShmCameraDiscovery::discover(DeviceBuilder &device_builder, const std::string &serial,
+                                  const DeviceConfig &config) {
+    const std::string name = get_shm_ring_name(serial);
+    if (name.empty()) {
+        return false;
+    }
+
+    try {
+        auto reader = std::make_unique<ShmRingReader>(name);
+        std::istringstream header_stream(reader->get_raw_header());
+        PseeRawFileHeader psee_header(header_stream);
+        std::unique_ptr<I_Geometry> geometry = psee_header.get_geometry();
+        std::string format                   = psee_header.get_format();
+
+        // header ill-formed => can't handle this stream
+        if (!geometry) {
+            return false;
+        }
+
+        auto file_hw_id = device_builder.add_facility(
+            std::make_unique<FileHWIdentification>(device_builder.get_plugin_software_info(), psee_header));
+
+        auto i_geometry       = device_builder.add_facility(std::move(geometry));
+        auto cd_decoder       = device_builder.add_facility(std::make_unique<I_EventDecoder<EventCD>>());
+        auto ext_trig_decoder = device_builder.add_facility(std::make_unique<I_EventDecoder<EventExtTrigger>>());
+
+        // Timestamps are not shifted, so that all the processes reading the ring share the producer time base
+        std::shared_ptr<I_Decoder> decoder;
+        if (format == "EVT3") {
+            decoder = device_builder.add_facility(make_evt3_decoder(false, i_geometry->get_height(),
+                                                                    i_geometry->get_width(), cd_decoder,
+                                                                    ext_trig_decoder));
+        } else if (format == "EVT2") {
+            decoder = device_builder.add_facility(std::make_unique<EVT2Decoder>(false, cd_decoder, ext_trig_decoder));
+        } else {
+            return false;
+        }
+
+        device_builder.add_facility(std::make_unique<ShmDeviceControl>());
+        device_builder.add_facility(std::make_unique<I_EventsStream>(
+            std::make_unique<ShmDataTransfer>(std::move(reader), decoder->get_raw_event_size_bytes()), file_hw_id));
+        return true;
+    } catch (std::exception &e) {
+        MV_HAL_LOG_TRACE() << "Could not open shared memory ring:" << e.what();
+        return false;
+    }
+}
+
+} // namespace Metavision
@@ -14,6 +14,7 @@
 #include "devices/gen31/gen31_fx3_facilities_builder.h"
 #endif
 #include "boards/rawfile/psee_file_discovery.h"
+#include "boards/shm/shm_camera_discovery.h"
 #include "devices/utils/device_system_id.h"
 #include "metavision/hal/plugin/plugin.h"
 #include "metavision/hal/plugin/plugin_entrypoint.h"
@@ -32,6 +33,9 @@ void initialize_plugin(void *plugin_ptr) {
     fx3_disc.register_device_builder(SYSTEM_CCAM3_GEN31, build_gen31_fx3_device);
 #endif
 
+    // Register discovery of the streams published in shared memory by other processes
+    plugin.add_camera_discovery(std::make_unique<ShmCameraDiscovery>());
+
     // Register raw file discoveries
     auto &file_disc = plugin.add_file_discovery(std::make_unique<PseeFileDiscovery>());
 }
@@ -15,6 +15,7 @@
 #include "devices/gen41/gen41_evk2_tz_device.h"
 #endif
 #include "boards/rawfile/psee_file_discovery.h"
+#include "boards/shm/shm_camera_discovery.h"
 #include "metavision/hal/plugin/plugin.h"
 #include "metavision/hal/plugin/plugin_entrypoint.h"
 #include "metavision/hal/utils/hal_software_info.h"
@@ -35,5 +36,8 @@ void initialize_plugin(void *plugin_ptr) {
     evk2_disc.factory().set("psee,video", TzEvk2Gen41::build, TzEvk2Gen41::can_build);
 #endif
 
+    // Register discovery of the streams published in shared memory by other processes
+    plugin.add_camera_discovery(std::make_unique<ShmCameraDiscovery>());
+
     auto &file_disc = plugin.add_file_discovery(std::make_unique<PseeFileDiscovery>());
 }
@@ -14,6 +14,7 @@
 #include "boards/treuzell/tz_libusb_board_command.h"
 #endif
 #include "boards/rawfile/psee_file_discovery.h"
+#include "boards/shm/shm_camera_discovery.h"
 #include "metavision/hal/plugin/plugin.h"
 #include "metavision/hal/plugin/plugin_entrypoint.h"
 #include "metavision/hal/utils/hal_software_info.h"
@@ -32,6 +33,9 @@ void initialize_plugin(void *plugin_ptr) {
     auto &evk3_disc = plugin.add_camera_discovery(std::make_unique<TzCameraDiscovery>());
 #endif
 
+    // Register discovery of the streams published in shared memory by other processes
+    plugin.add_camera_discovery(std::make_unique<ShmCameraDiscovery>());
+
     // Register raw file discoveries
     auto &file_disc = plugin.add_file_discovery(std::make_unique<PseeFileDiscovery>());
 }
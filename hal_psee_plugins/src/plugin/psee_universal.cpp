@@ -22,6 +22,7 @@
 #include "boards/treuzell/tz_libusb_board_command.h"
 #endif
 #include "boards/rawfile/psee_file_discovery.h"
+#include "boards/shm/shm_camera_discovery.h"
 #include "devices/utils/device_system_id.h"
 #include "metavision/hal/plugin/plugin.h"
 #include "metavision/hal/plugin/plugin_entrypoint.h"
@@ -51,5 +52,8 @@ void initialize_plugin(void *plugin_ptr) {
     auto &tz_disc = plugin.add_camera_discovery(std::make_unique<TzCameraDiscovery>());
 #endif
 
+    // Register discovery of the streams published in shared memory by other processes
+    plugin.add_camera_discovery(std::make_unique<ShmCameraDiscovery>());
+
     auto &file_disc = plugin.add_file_discovery(std::make_unique<PseeFileDiscovery>());
 }
@@ -116,6 +116,65 @@ TEST_F_WITH_DATASET(I_EventsStream_Gtest, valid_index_file) {
     }
 }
 
+TEST_F_WITH_DATASET(I_EventsStream_Gtest, index_shared_between_events_streams) {
+    ////////////////////////////////////////////////////////////////////////////////
+    // PURPOSE
+    // Check that an index being built for a file is shared with the other events streams opened on the same file,
+    // without opening another device to index the file
+
+    for (const auto &dataset : datasets_) {
+        boost::filesystem::remove(dataset + ".tmp_index");
+        ASSERT_FALSE(boost::filesystem::exists(dataset + ".tmp_index"));
+
+        // Open the file twice, the first device building the index
+        Future::RawFileConfig config;
+        auto device_1 = DeviceDiscovery::open_raw_file(dataset, config);
+        config.build_index_ = false;
+        auto device_2       = DeviceDiscovery::open_raw_file(dataset, config);
+        ASSERT_NE(nullptr, device_1.get());
+        ASSERT_NE(nullptr, device_2.get());
+
+        auto fes_1 = device_1->get_facility<Future::I_EventsStream>();
+        auto fes_2 = device_2->get_facility<Future::I_EventsStream>();
+        ASSERT_NE(nullptr, fes_1);
+        ASSERT_NE(nullptr, fes_2);
+
+        // Streaming can start while the index is being built, the indexing being then slowed down
+        fes_1->start();
+        ASSERT_EQ(1, fes_1->wait_next_buffer());
+
+        // The second events stream shares the index being built for the first one
+        int n_devices_for_indexing = 0;
+        fes_2->index([&]() {
+            ++n_devices_for_indexing;
+            Future::RawFileConfig indexing_config;
+            indexing_config.build_index_ = false;
+            return DeviceDiscovery::open_raw_file(dataset, indexing_config);
+        });
+        EXPECT_EQ(0, n_devices_for_indexing);
+
+        constexpr uint32_t max_trials = 1000;
+        uint32_t trials               = 1;
+        timestamp start_1, end_1, start_2, end_2;
+        auto s_1 = fes_1->get_seek_range(start_1, end_1);
+        auto s_2 = fes_2->get_seek_range(start_2, end_2);
+        for (trials = 1; (s_1 != Metavision::Future::I_EventsStream::IndexStatus::Good ||
+                          s_2 != Metavision::Future::I_EventsStream::IndexStatus::Good) &&
+                         trials < max_trials;
+             ++trials) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            s_1 = fes_1->get_seek_range(start_1, end_1);
+            s_2 = fes_2->get_seek_range(start_2, end_2);
+        }
+        ASSERT_LT(trials, max_trials);
+        fes_1->stop();
+
+        EXPECT_EQ(start_1, start_2);
+        EXPECT_EQ(end_1, end_2);
+        EXPECT_TRUE(boost::filesystem::exists(dataset + ".tmp_index"));
+    }
+}
+
 TEST_F_WITH_DATASET(I_EventsStream_Gtest, invalid_index_file) {
     ////////////////////////////////////////////////////////////////////////////////
     // PURPOSE
@@ -197,11 +197,11 @@ private:
         /// @return the number of newly allocated object in the pool
         template<typename... Args>
         size_t arrange(size_t size, Args &&...args) {
+            std::unique_lock<std::mutex> lock(mutex_);
             if (bounded_memory_ || size <= pool_.size()) {
                 return 0;
             }
 
-            std::unique_lock<std::mutex> lock(mutex_);
             size_t nb_allocated_obj = size - pool_.size();
             while (pool_.size() < size) {
                 pool_.push(std::unique_ptr<T>(new T(std::forward<Args>(args)...)));
@@ -110,6 +110,8 @@ int main(int argc, char *argv[]) {
     Metavision::PeriodicFrameGenerationAlgorithm frame_generation(geometry.width(), geometry.height());
     frame_generation.set_accumulation_time_us(accumulation_time);
     frame_generation.set_fps(slow_motion_factor * fps);
+    // The recorder copies the frames, so that they can be updated incrementally
+    frame_generation.set_incremental_update(true);
     frame_generation.set_output_callback(
         [&](Metavision::timestamp frame_ts, cv::Mat &cd_frame) { recorder.write(cd_frame); });
 
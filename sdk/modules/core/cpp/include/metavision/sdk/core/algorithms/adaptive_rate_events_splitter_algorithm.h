@@ -13,7 +13,13 @@
 #define METAVISION_SDK_CORE_ADAPTIVE_RATE_EVENTS_SPLITTER_ALGORITHM_H
 
 #include "metavision/sdk/base/events/event_cd.h"
+#include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
 #include <assert.h>
 
 namespace Metavision {
@@ -25,6 +31,9 @@ namespace Metavision {
 /// events. An additional criterion is the maximum proportion of active pixels containing both positive and negative
 /// events.
 ///
+/// The events can either be gathered by the algorithm (@ref process_events and @ref retrieve_events), or left in the
+/// caller's buffers, the algorithm then only reporting where to split them (@ref split_events).
+///
 class AdaptiveRateEventsSplitterAlgorithm {
 public:
     /// @brief Constructs a new AdaptiveRateEventsSplitterAlgorithm
@@ -57,9 +66,36 @@ public:
         reset_local_variables();
     }
 
+    /// @brief Processes a buffer of events without copying them, and determines where slicing should be performed
+    ///
+    /// The splitting criteria are evaluated every @p n_events_per_check events and at the end of the buffer. Each time
+    /// a slice is ready, its end is appended to @p split_offsets and the internal state is reset. The events after the
+    /// last split belong to the slice continued by the next call. With @p n_events_per_check equal to 0, the criteria
+    /// are evaluated at the end of the buffer only, which splits the stream as @ref process_events does.
+    ///
+    /// @param begin Iterator pointing to the beginning of the events buffer
+    /// @param end Iterator pointing to the end of the events buffer
+    /// @param split_offsets Offsets from @p begin of the past-the-end events of the slices ready in the buffer
+    /// @param n_events_per_check Number of events between two evaluations of the splitting criteria
+    template<typename RandomIt>
+    void split_events(RandomIt begin, RandomIt end, std::vector<std::size_t> &split_offsets,
+                      std::size_t n_events_per_check = 0);
+
+    /// @brief Resets the internal state, dropping the events of the current slice
+    void reset() {
+        reset_local_variables();
+    }
+
 private:
     void reset_local_variables();
 
+    /// @brief Updates the statistics of the current slice with the events of a buffer
+    template<typename InputIt>
+    void update_statistics(InputIt begin, InputIt end);
+
+    /// @brief Evaluates the splitting criteria on the statistics of the current slice
+    bool is_slice_ready();
+
     int height_, width_, shift_;
     float thr_var_per_event_;
 
@@ -69,7 +105,6 @@ private:
     float prev_var_pos_;
     float prev_var_per_event_pos_;
     int nb_pos_pix_;
-    std::vector<std::uint16_t> img_pos_;
 
     int nb_neg_;
     float mean_neg_;
@@ -77,10 +112,12 @@ private:
     float prev_var_neg_;
     float prev_var_per_event_neg_;
     int nb_neg_pix_;
-    std::vector<std::uint16_t> img_neg_;
 
     int nb_both_pos_and_neg_pix_;
 
+    std::vector<std::array<std::uint16_t, 2>> img_counts_; ///< Number of negative and positive events per pixel
+    std::vector<std::uint32_t> active_pixels_;            ///< Bitset of the pixels with events, reset with the slice
+
     float one_over_height_times_width_;
     float one_over_height_times_width_squared_;
 
@@ -92,65 +129,72 @@ private:
 template<typename InputIt>
 bool AdaptiveRateEventsSplitterAlgorithm::process_events(InputIt begin, InputIt end) {
     std::copy(begin, end, std::back_inserter(events_));
-    const int two_pow_shift = 1 << shift_;
+    update_statistics(begin, end);
+    if (is_slice_ready()) {
+        assert(events_.size());
+        return true;
+    }
+    return false;
+}
+
+template<typename RandomIt>
+void AdaptiveRateEventsSplitterAlgorithm::split_events(RandomIt begin, RandomIt end,
+                                                       std::vector<std::size_t> &split_offsets,
+                                                       std::size_t n_events_per_check) {
+    split_offsets.clear();
+    const std::size_t n_events = static_cast<std::size_t>(std::distance(begin, end));
+    for (std::size_t offset = 0; offset < n_events;) {
+        const std::size_t next_offset =
+            n_events_per_check > 0 ? std::min(n_events, offset + n_events_per_check) : n_events;
+        update_statistics(begin + offset, begin + next_offset);
+        offset = next_offset;
+        if (is_slice_ready()) {
+            split_offsets.push_back(offset);
+            reset_local_variables();
+        }
+    }
+}
+
+template<typename InputIt>
+void AdaptiveRateEventsSplitterAlgorithm::update_statistics(InputIt begin, InputIt end) {
+    const int downsampling_mask = (1 << shift_) - 1;
     for (auto it = begin; it != end; ++it) {
-        if ((it->x % two_pow_shift) || (it->y % two_pow_shift)) {
+        if ((it->x | it->y) & downsampling_mask) {
             continue;
         }
         const int x       = it->x >> shift_;
         const int y       = it->y >> shift_;
         const int idx_pix = y * width_ + x;
+        auto &counts      = img_counts_[idx_pix];
+        if ((counts[0] | counts[1]) == 0) {
+            active_pixels_[idx_pix >> 5] |= std::uint32_t(1) << (idx_pix & 31);
+        }
         if (it->p == 1) {
-            if (img_pos_[idx_pix] == 0) {
+            if (counts[1] == 0) {
                 nb_pos_pix_++;
-                if (img_neg_[idx_pix]) {
+                if (counts[0]) {
                     nb_both_pos_and_neg_pix_++;
                 }
             }
             mean_pos_ += one_over_height_times_width_;
             var_pos_ += one_over_height_times_width_squared_ +
-                        (2.f * (img_pos_[idx_pix] - mean_pos_) + 1.f) * one_over_height_times_width_;
-            img_pos_[idx_pix]++;
+                        (2.f * (counts[1] - mean_pos_) + 1.f) * one_over_height_times_width_;
+            counts[1]++;
             nb_pos_++;
         } else {
-            if (img_neg_[idx_pix] == 0) {
+            if (counts[0] == 0) {
                 nb_neg_pix_++;
-                if (img_pos_[idx_pix]) {
+                if (counts[1]) {
                     nb_both_pos_and_neg_pix_++;
                 }
             }
             mean_neg_ += one_over_height_times_width_;
             var_neg_ += one_over_height_times_width_squared_ +
-                        (2.f * (img_neg_[idx_pix] - mean_neg_) + 1.f) * one_over_height_times_width_;
-            img_neg_[idx_pix]++;
+                        (2.f * (counts[0] - mean_neg_) + 1.f) * one_over_height_times_width_;
+            counts[0]++;
             nb_neg_++;
         }
     }
-    float var_per_event_pos = 0.f;
-    if (nb_pos_ == 0) {
-        assert(var_pos_ == 0.f);
-    } else {
-        var_per_event_pos = var_pos_ / nb_pos_;
-    }
-    float var_per_event_neg = 0.f;
-    if (nb_neg_ == 0) {
-        assert(var_neg_ == 0.f);
-    } else {
-        var_per_event_neg = var_neg_ / nb_neg_;
-    }
-    const float ratio_pix_both = nb_both_pos_and_neg_pix_ / (nb_pos_pix_ + nb_neg_pix_ + 1e-5f);
-
-    if ((ratio_pix_both >= kMaxRatioBothPix) ||
-        ((var_per_event_neg < prev_var_per_event_neg_) && (var_per_event_neg > thr_var_per_event_)) ||
-        ((var_per_event_pos < prev_var_per_event_pos_) && (var_per_event_pos > thr_var_per_event_))) {
-        assert(events_.size());
-        auto first_ts = events_[0].t;
-        auto last_ts  = events_[events_.size() - 1].t;
-        return true;
-    }
-    prev_var_per_event_neg_ = var_per_event_neg;
-    prev_var_per_event_pos_ = var_per_event_pos;
-    return false;
 }
 
 } // namespace Metavision
@@ -0,0 +1,86 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_CORE_BATCH_FRAME_GENERATION_ALGORITHM_H
+#define METAVISION_SDK_CORE_BATCH_FRAME_GENERATION_ALGORITHM_H
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "metavision/sdk/base/utils/timestamp.h"
+#include "metavision/sdk/core/algorithms/base_frame_generation_algorithm.h"
+
+namespace Metavision {
+
+/// @brief Algorithm that generates many frames at once from a single buffer of events
+///
+/// This class is meant for high frame rates (e.g. slow motion videos), where the accumulation windows of consecutive
+/// frames overlap a lot. Instead of rendering each frame from all the events of its window, the frames are rendered
+/// in sequence: each frame starts from a copy of the previous one, the events that left the window are erased and the
+/// ones that entered it are drawn. Each event is thus visited twice, whatever the overlap between the windows.
+///
+/// When several threads are available, the frames are split in as many sequences, rendered in parallel.
+///
+/// A frame generated at timestamp t with an accumulation time dt holds the events in [t - dt, t[, like the frames
+/// generated by @ref PeriodicFrameGenerationAlgorithm.
+class BatchFrameGenerationAlgorithm : public BaseFrameGenerationAlgorithm {
+public:
+    /// @brief Constructor
+    /// @param sensor_width Sensor's width (in pixels)
+    /// @param sensor_height Sensor's height (in pixels)
+    /// @param palette The Prophesee's color palette to use (@ref set_color_palette)
+    BatchFrameGenerationAlgorithm(int sensor_width, int sensor_height,
+                                  const Metavision::ColorPalette &palette = default_palette());
+
+    /// @brief Generates frames from a buffer of events
+    /// @tparam EventIt Random access iterator over a buffer of @ref EventCD or equivalent, sorted by timestamp
+    /// @param it_begin Iterator to the first input event
+    /// @param it_end Iterator to the past-the-end event
+    /// @param frames_ts Timestamps at which to generate the frames, in increasing order
+    /// @param accumulation_times_us Accumulation time (in us) of each frame
+    /// @param frames Generated frames, one per timestamp. Frames that already have the expected size and type, and that
+    /// are not shared with other matrices, are reused, so that passing the same vector for each batch avoids any
+    /// allocation
+    /// @throw invalid_argument if @p frames_ts is not sorted, or if @p accumulation_times_us does not have the same
+    /// size
+    template<typename EventIt>
+    void generate(EventIt it_begin, EventIt it_end, const std::vector<timestamp> &frames_ts,
+                  const std::vector<uint32_t> &accumulation_times_us, std::vector<cv::Mat> &frames);
+
+    /// @overload
+    /// @param it_begin Iterator to the first input event
+    /// @param it_end Iterator to the past-the-end event
+    /// @param frames_ts Timestamps at which to generate the frames, in increasing order
+    /// @param accumulation_time_us Accumulation time (in us) of all the frames
+    /// @param frames Generated frames, one per timestamp
+    template<typename EventIt>
+    void generate(EventIt it_begin, EventIt it_end, const std::vector<timestamp> &frames_ts,
+                  uint32_t accumulation_time_us, std::vector<cv::Mat> &frames);
+
+    /// @brief Sets the maximum number of sequences of frames rendered in parallel
+    /// @param max_threads Maximum number of threads. If 0, the number of threads used by OpenCV is used (default)
+    void set_max_threads(int max_threads);
+
+    /// @brief Returns the maximum number of sequences of frames rendered in parallel
+    int get_max_threads() const;
+
+private:
+    int max_threads_{0};                             ///< Maximum number of sequences rendered in parallel
+    std::vector<std::pair<size_t, size_t>> windows_; ///< Indices of the first and past-the-end events of each frame
+    std::vector<std::vector<uint32_t>> counts_;      ///< Per sequence, number of events in the window of each pixel
+};
+
+} // namespace Metavision
+
+#include "metavision/sdk/core/algorithms/detail/batch_frame_generation_algorithm_impl.h"
+
+#endif // METAVISION_SDK_CORE_BATCH_FRAME_GENERATION_ALGORITHM_H
@@ -12,7 +12,12 @@
 #ifndef METAVISION_SDK_CORE_BASE_FRAME_GENERATION_ALGORITHM_IMPL_H
 #define METAVISION_SDK_CORE_BASE_FRAME_GENERATION_ALGORITHM_IMPL_H
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
 #include <opencv2/core/mat.hpp>
+#include <opencv2/core/utility.hpp>
 
 #include "metavision/sdk/core/utils/colors.h"
 
@@ -37,6 +42,104 @@ inline cv::Vec3b rgb(const cv::Vec4b &v) {
 inline cv::Vec3b rgb(const cv::Vec3b &v) {
     return {v[2], v[1], v[0]};
 }
+
+/// Pixel of a frame with N 8-bit channels, written at once
+template<int N>
+struct FramePixel {
+    uint8_t c[N];
+};
+
+template<int N>
+inline FramePixel<N> frame_pixel(const cv::Vec4b &color) {
+    FramePixel<N> pixel;
+    std::copy(color.val, color.val + N, pixel.c);
+    return pixel;
+}
+
+/// Minimum number of events per band for the frame to be rendered by several threads. Below this, spreading the work
+/// costs more than it saves
+constexpr std::ptrdiff_t frame_rendering_min_events_per_band = 1 << 16;
+
+/// Minimum number of rows per band
+constexpr int frame_rendering_min_rows_per_band = 8;
+
+/// Fills rows [row_begin, row_end[ of the frame with the background color
+///
+/// The first row is filled pixel per pixel, and then copied to the others, so that most of the work is done by memcpy
+/// using the widest instructions available.
+template<int N>
+void fill_frame_rows(cv::Mat &frame, int row_begin, int row_end, const FramePixel<N> &bg_color) {
+    if (row_begin >= row_end) {
+        return;
+    }
+    auto *first_row = reinterpret_cast<FramePixel<N> *>(frame.ptr(row_begin));
+    std::fill_n(first_row, frame.cols, bg_color);
+    const size_t row_size = static_cast<size_t>(frame.cols) * N;
+    for (int y = row_begin + 1; y < row_end; ++y) {
+        std::memcpy(frame.ptr(y), first_row, row_size);
+    }
+}
+
+/// Renders the events whose (possibly flipped) row lies in [row_begin, row_end[, on top of the background color
+///
+/// Events are written in order, so that the last event of a pixel gives its color.
+template<int N, typename EventIt>
+void render_frame_rows(EventIt it_begin, EventIt it_end, cv::Mat &frame, int row_begin, int row_end,
+                       const FramePixel<N> &bg_color, const std::array<FramePixel<N>, 2> &off_on_colors,
+                       bool flip_y) {
+    fill_frame_rows<N>(frame, row_begin, row_end, bg_color);
+
+    uint8_t *const data   = frame.data;
+    const size_t step     = frame.step[0];
+    const int last_row    = frame.rows - 1;
+    const unsigned n_rows = static_cast<unsigned>(row_end - row_begin);
+    if (n_rows == static_cast<unsigned>(frame.rows)) {
+        for (auto it = it_begin; it != it_end; ++it) {
+            const int row = flip_y ? last_row - it->y : it->y;
+            reinterpret_cast<FramePixel<N> *>(data + row * step)[it->x] = off_on_colors[it->p];
+        }
+    } else {
+        for (auto it = it_begin; it != it_end; ++it) {
+            const int row = flip_y ? last_row - it->y : it->y;
+            // Single comparison for both bounds of the band
+            if (static_cast<unsigned>(row - row_begin) < n_rows) {
+                reinterpret_cast<FramePixel<N> *>(data + row * step)[it->x] = off_on_colors[it->p];
+            }
+        }
+    }
+}
+
+/// Renders the events in the frame, on top of the background color
+///
+/// Large event buffers are rendered by several threads, each one owning a band of rows: it clears its band and then
+/// goes through all the events to write the ones falling in it. Each pixel is thus written by a single thread in the
+/// order of the events, and the band a thread works on stays in its cache.
+template<int N, typename EventIt>
+void render_frame(EventIt it_begin, EventIt it_end, cv::Mat &frame, const cv::Vec4b &bg_color,
+                  const std::array<cv::Vec4b, 2> &off_on_colors, bool flip_y) {
+    const FramePixel<N> bg_pixel = frame_pixel<N>(bg_color);
+    const std::array<FramePixel<N>, 2> off_on_pixels{frame_pixel<N>(off_on_colors[0]),
+                                                     frame_pixel<N>(off_on_colors[1])};
+
+    const std::ptrdiff_t n_events = std::distance(it_begin, it_end);
+    const int n_bands = std::max(1, std::min({cv::getNumThreads(), frame.rows / frame_rendering_min_rows_per_band,
+                                              static_cast<int>(std::min<std::ptrdiff_t>(
+                                                  n_events / frame_rendering_min_events_per_band, frame.rows))}));
+    if (n_bands == 1) {
+        render_frame_rows<N>(it_begin, it_end, frame, 0, frame.rows, bg_pixel, off_on_pixels, flip_y);
+        return;
+    }
+
+    cv::parallel_for_(
+        cv::Range(0, n_bands),
+        [&](const cv::Range &bands) {
+            for (int band = bands.start; band < bands.end; ++band) {
+                render_frame_rows<N>(it_begin, it_end, frame, band * frame.rows / n_bands,
+                                     (band + 1) * frame.rows / n_bands, bg_pixel, off_on_pixels, flip_y);
+            }
+        },
+        n_bands);
+}
 } // namespace detail
 
 template<typename EventIt>
@@ -68,14 +171,11 @@ void BaseFrameGenerationAlgorithm::generate_frame_from_events(EventIt it_begin,
         throw std::invalid_argument(ss.str());
     }
 
+    const std::array<cv::Vec4b, 2> off_on_colors4{detail::bgra(off_on_colors[0]), detail::bgra(off_on_colors[1])};
     if (colored) {
-        frame.setTo(bg_color);
-        for (auto it = it_begin; it != it_end; ++it)
-            frame.at<cv::Vec3b>(it->y, it->x) = off_on_colors[it->p];
+        detail::render_frame<3>(it_begin, it_end, frame, detail::bgra(bg_color), off_on_colors4, false);
     } else {
-        frame.setTo(bg_color[0]);
-        for (auto it = it_begin; it != it_end; ++it)
-            frame.at<uint8_t>(it->y, it->x) = off_on_colors[it->p][0];
+        detail::render_frame<1>(it_begin, it_end, frame, detail::bgra(bg_color), off_on_colors4, false);
     }
 }
 
@@ -103,34 +203,27 @@ void BaseFrameGenerationAlgorithm::generate_frame_from_events(EventIt it_begin,
         throw std::invalid_argument(ss.str());
     }
 
-    cv::Vec3b _bg_color3;
+    // The colors are stored in BGRA order, the channels of the frame pixels are their first bytes once reordered
+    const bool flip_y = flags & Parameters::FLIP_Y;
+    if (flags & Parameters::GRAY) {
+        detail::render_frame<1>(it_begin, it_end, frame, bg_color, off_on_colors, flip_y);
+        return;
+    }
+
     cv::Vec4b _bg_color4;
-    std::array<cv::Vec3b, 2> _off_on_colors3;
     std::array<cv::Vec4b, 2> _off_on_colors4;
     if (flags & Parameters::BGR || flags & Parameters::BGRA) {
-        _bg_color3      = detail::bgr(bg_color);
-        _off_on_colors3 = {detail::bgr(off_on_colors[0]), detail::bgr(off_on_colors[1])};
         _bg_color4      = bg_color;
         _off_on_colors4 = off_on_colors;
     } else {
-        _bg_color3      = detail::rgb(bg_color);
-        _off_on_colors3 = {detail::rgb(off_on_colors[0]), detail::rgb(off_on_colors[1])};
         _bg_color4      = detail::rgba(bg_color);
         _off_on_colors4 = {detail::rgba(off_on_colors[0]), detail::rgba(off_on_colors[1])};
     }
 
-    if (flags & Parameters::GRAY) {
-        frame.setTo(bg_color[0]);
-        for (auto it = it_begin; it != it_end; ++it)
-            frame.at<uint8_t>(it->y, it->x) = off_on_colors[it->p][0];
-    } else if (flags & Parameters::RGB || flags & Parameters::BGR) {
-        frame.setTo(_bg_color3);
-        for (auto it = it_begin; it != it_end; ++it)
-            frame.at<cv::Vec3b>(it->y, it->x) = _off_on_colors3[it->p];
+    if (flags & Parameters::RGB || flags & Parameters::BGR) {
+        detail::render_frame<3>(it_begin, it_end, frame, _bg_color4, _off_on_colors4, flip_y);
     } else {
-        frame.setTo(_bg_color4);
-        for (auto it = it_begin; it != it_end; ++it)
-            frame.at<cv::Vec4b>(it->y, it->x) = _off_on_colors4[it->p];
+        detail::render_frame<4>(it_begin, it_end, frame, _bg_color4, _off_on_colors4, flip_y);
     }
 }
 
@@ -0,0 +1,183 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_CORE_DETAIL_BATCH_FRAME_GENERATION_ALGORITHM_IMPL_H
+#define METAVISION_SDK_CORE_DETAIL_BATCH_FRAME_GENERATION_ALGORITHM_IMPL_H
+
+#include <algorithm>
+#include <stdexcept>
+#include <opencv2/core/utility.hpp>
+
+namespace Metavision {
+
+namespace detail {
+
+/// Renders the frames [first_frame, last_frame[ in sequence, each one being updated from the previous one
+///
+/// @p counts holds the number of events of the current window at each pixel: a pixel goes back to the background color
+/// when the last of its events leaves the window. It must be zero at the beginning, and is zero again at the end.
+/// A frame is rendered from scratch when it is the first of the sequence, or when its window does not overlap the
+/// previous one or starts before it.
+template<int N, typename EventIt>
+void render_frames_sequence(EventIt it_begin, const std::vector<std::pair<size_t, size_t>> &windows,
+                            size_t first_frame, size_t last_frame, std::vector<cv::Mat> &frames,
+                            std::vector<uint32_t> &counts, const FramePixel<N> &bg_color,
+                            const std::array<FramePixel<N>, 2> &off_on_colors, bool flip_y) {
+    const int width    = frames[first_frame].cols;
+    const int last_row = frames[first_frame].rows - 1;
+    auto pixel         = [&](cv::Mat &frame, const auto &ev) -> FramePixel<N> & {
+        return reinterpret_cast<FramePixel<N> *>(frame.ptr(flip_y ? last_row - ev.y : ev.y))[ev.x];
+    };
+    auto count = [&](const auto &ev) -> uint32_t & { return counts[ev.y * width + ev.x]; };
+
+    size_t prev_begin = 0, prev_end = 0;
+    for (size_t k = first_frame; k < last_frame; ++k) {
+        const size_t begin = windows[k].first, end = windows[k].second;
+        cv::Mat &frame     = frames[k];
+        if (k == first_frame || begin < prev_begin || begin >= prev_end) {
+            for (size_t i = prev_begin; i < prev_end; ++i) {
+                --count(it_begin[i]);
+            }
+            render_frame_rows<N>(it_begin + begin, it_begin + end, frame, 0, frame.rows, bg_color, off_on_colors,
+                                 flip_y);
+            for (size_t i = begin; i < end; ++i) {
+                ++count(it_begin[i]);
+            }
+        } else {
+            frames[k - 1].copyTo(frame);
+            // Erase the events that left the window, unless a more recent one is still displayed at their pixel
+            for (size_t i = prev_begin; i < begin; ++i) {
+                const auto &ev = it_begin[i];
+                if (--count(ev) == 0) {
+                    pixel(frame, ev) = bg_color;
+                }
+            }
+            // Draw the events that entered the window, in order so that the last one of a pixel gives its color
+            for (size_t i = prev_end; i < end; ++i) {
+                const auto &ev = it_begin[i];
+                ++count(ev);
+                pixel(frame, ev) = off_on_colors[ev.p];
+            }
+        }
+        prev_begin = begin;
+        prev_end   = end;
+    }
+
+    for (size_t i = prev_begin; i < prev_end; ++i) {
+        --count(it_begin[i]);
+    }
+}
+
+} // namespace detail
+
+template<typename EventIt>
+void BatchFrameGenerationAlgorithm::generate(EventIt it_begin, EventIt it_end, const std::vector<timestamp> &frames_ts,
+                                             uint32_t accumulation_time_us, std::vector<cv::Mat> &frames) {
+    generate(it_begin, it_end, frames_ts, std::vector<uint32_t>(frames_ts.size(), accumulation_time_us), frames);
+}
+
+template<typename EventIt>
+void BatchFrameGenerationAlgorithm::generate(EventIt it_begin, EventIt it_end, const std::vector<timestamp> &frames_ts,
+                                             const std::vector<uint32_t> &accumulation_times_us,
+                                             std::vector<cv::Mat> &frames) {
+    if (accumulation_times_us.size() != frames_ts.size()) {
+        throw std::invalid_argument("There must be as many accumulation times as frame timestamps.");
+    }
+    if (!std::is_sorted(frames_ts.cbegin(), frames_ts.cend())) {
+        throw std::invalid_argument("Frame timestamps must be sorted in increasing order.");
+    }
+
+    // Find the events of each frame in a single pass, the ends of the windows being sorted too
+    const size_t n_frames = frames_ts.size();
+    const auto is_before  = [](const auto &ev, timestamp t) { return ev.t < t; };
+    windows_.resize(n_frames);
+    EventIt it_window_end = it_begin;
+    for (size_t k = 0; k < n_frames; ++k) {
+        const auto it_window_begin =
+            std::lower_bound(it_begin, it_end, frames_ts[k] - accumulation_times_us[k], is_before);
+        it_window_end = std::lower_bound(std::max(it_window_end, it_window_begin), it_end, frames_ts[k], is_before);
+        windows_[k]   = {static_cast<size_t>(std::distance(it_begin, it_window_begin)),
+                       static_cast<size_t>(std::distance(it_begin, it_window_end))};
+    }
+
+    int cv_type;
+    if (flags_ & Parameters::GRAY) {
+        cv_type = CV_8UC1;
+    } else if (flags_ & Parameters::RGB || flags_ & Parameters::BGR) {
+        cv_type = CV_8UC3;
+    } else {
+        cv_type = CV_8UC4;
+    }
+    frames.resize(n_frames);
+    for (auto &frame : frames) {
+        // Frames still referenced elsewhere (e.g. kept from the previous batch) must not be overwritten
+        if (frame.u && frame.u->refcount > 1) {
+            frame.release();
+        }
+        frame.create(height_, width_, cv_type);
+    }
+    if (n_frames == 0) {
+        return;
+    }
+
+    // Each sequence of frames needs its own counts, left to zero by the previous call
+    const int max_threads = max_threads_ > 0 ? max_threads_ : cv::getNumThreads();
+    const int n_sequences = std::max(1, std::min(max_threads, static_cast<int>(n_frames)));
+    if (counts_.size() < static_cast<size_t>(n_sequences)) {
+        counts_.resize(n_sequences);
+    }
+    for (int s = 0; s < n_sequences; ++s) {
+        counts_[s].resize(static_cast<size_t>(width_) * height_, 0);
+    }
+
+    cv::Vec4b bg_color4                     = bg_color_;
+    std::array<cv::Vec4b, 2> off_on_colors4 = off_on_colors_;
+    if (flags_ & Parameters::RGB || flags_ & Parameters::RGBA) {
+        bg_color4      = detail::rgba(bg_color_);
+        off_on_colors4 = {detail::rgba(off_on_colors_[0]), detail::rgba(off_on_colors_[1])};
+    }
+    const bool flip_y = flags_ & Parameters::FLIP_Y;
+
+    const auto render_sequences = [&](const cv::Range &sequences) {
+        for (int s = sequences.start; s < sequences.end; ++s) {
+            const size_t first_frame = s * n_frames / n_sequences, last_frame = (s + 1) * n_frames / n_sequences;
+            if (cv_type == CV_8UC1) {
+                detail::render_frames_sequence<1>(it_begin, windows_, first_frame, last_frame, frames, counts_[s],
+                                                  detail::frame_pixel<1>(bg_color4),
+                                                  {detail::frame_pixel<1>(off_on_colors4[0]),
+                                                   detail::frame_pixel<1>(off_on_colors4[1])},
+                                                  flip_y);
+            } else if (cv_type == CV_8UC3) {
+                detail::render_frames_sequence<3>(it_begin, windows_, first_frame, last_frame, frames, counts_[s],
+                                                  detail::frame_pixel<3>(bg_color4),
+                                                  {detail::frame_pixel<3>(off_on_colors4[0]),
+                                                   detail::frame_pixel<3>(off_on_colors4[1])},
+                                                  flip_y);
+            } else {
+                detail::render_frames_sequence<4>(it_begin, windows_, first_frame, last_frame, frames, counts_[s],
+                                                  detail::frame_pixel<4>(bg_color4),
+                                                  {detail::frame_pixel<4>(off_on_colors4[0]),
+                                                   detail::frame_pixel<4>(off_on_colors4[1])},
+                                                  flip_y);
+            }
+        }
+    };
+
+    if (n_sequences == 1) {
+        render_sequences(cv::Range(0, 1));
+    } else {
+        cv::parallel_for_(cv::Range(0, n_sequences), render_sequences);
+    }
+}
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_CORE_DETAIL_BATCH_FRAME_GENERATION_ALGORITHM_IMPL_H
@@ -0,0 +1,141 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_CORE_DETAIL_BURST_NOISE_FILTER_ALGORITHM_H
+#define METAVISION_SDK_CORE_DETAIL_BURST_NOISE_FILTER_ALGORITHM_H
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/base/utils/timestamp.h"
+#include "metavision/sdk/core/algorithms/detail/event_filter_kernels.h"
+
+namespace Metavision {
+namespace detail {
+
+/// Event of a burst propagated by @ref BurstNoiseFilterAlgorithm
+enum class BurstEventKept { First, Second };
+
+/// Base class of the noise filters working on bursts, i.e. on successive events of the same polarity at the same pixel
+/// that are less than a threshold apart
+///
+/// The state of a pixel is stored in 32 bits: the timestamp of its last event, with a resolution of at least 1/16th of
+/// the threshold, its polarity, and whether an event of the current burst has been propagated. Timestamps are stored
+/// modulo 2^29 times their resolution, so that a pixel silent for a multiple of this duration may be wrongly seen as
+/// part of a burst.
+template<BurstEventKept kept>
+class BurstNoiseFilterAlgorithm {
+public:
+    /// Builds a new filter for a sensor of the given size
+    /// @throw std::invalid_argument if the size of the sensor isn't strictly positive
+    BurstNoiseFilterAlgorithm(int width, int height, std::uint32_t threshold) : width_(width), height_(height) {
+        if (width <= 0 || height <= 0) {
+            throw std::invalid_argument("Noise filter expects a strictly positive sensor size.");
+        }
+        states_.resize(static_cast<std::size_t>(width) * height);
+        set_threshold(threshold);
+    }
+
+    template<class InputIt, class OutputIt>
+    inline OutputIt process_events(InputIt it_begin, InputIt it_end, OutputIt inserter) {
+        // Contiguous EventCD are written without branches
+        return Metavision::detail::filter_events(
+            it_begin, it_end, inserter,
+            [this](const EventCD *begin, const EventCD *end, EventCD *out) {
+                EventCD scratch;
+                for (; begin != end; ++begin) {
+                    const bool keep = update(*begin);
+                    EventCD *dst    = keep ? out : &scratch;
+                    *dst            = *begin;
+                    out += keep;
+                }
+                return out;
+            },
+            [this](InputIt it_begin, InputIt it_end, OutputIt inserter) {
+                for (; it_begin != it_end; ++it_begin) {
+                    if (update(*it_begin)) {
+                        *inserter = *it_begin;
+                        ++inserter;
+                    }
+                }
+                return inserter;
+            });
+    }
+
+    /// Sets the maximum duration between two events of a burst, which resets the state of the filter
+    void set_threshold(std::uint32_t threshold) {
+        threshold_ = threshold;
+        shift_     = 0;
+        while ((threshold >> (shift_ + 1)) >= 16) {
+            ++shift_;
+        }
+        threshold_units_ = ((threshold + ((1u << shift_) >> 1)) >> shift_) << time_offset_;
+        reset();
+    }
+
+    std::uint32_t get_threshold() const {
+        return threshold_;
+    }
+
+    int width() const {
+        return width_;
+    }
+
+    int height() const {
+        return height_;
+    }
+
+    /// Resets the state of all the pixels, to process events from another stream
+    void reset() {
+        std::fill(states_.begin(), states_.end(), 0);
+    }
+
+private:
+    static constexpr std::uint32_t valid_bit_    = 1;
+    static constexpr std::uint32_t polarity_bit_ = 2;
+    static constexpr std::uint32_t kept_bit_     = 4;
+    static constexpr std::uint32_t time_offset_  = 3;
+    static constexpr std::uint32_t time_mask_    = ~((1u << time_offset_) - 1);
+
+    /// Updates the state of the pixel of an event, and returns true if the event is propagated
+    template<typename Event>
+    inline bool update(const Event &ev) {
+        std::uint32_t &state         = states_[ev.y * width_ + ev.x];
+        const std::uint32_t now      = static_cast<std::uint32_t>(ev.t >> shift_) << time_offset_;
+        const std::uint32_t polarity = ev.p ? polarity_bit_ : 0;
+        const bool same_polarity     = ((state ^ polarity) & (valid_bit_ | polarity_bit_)) == valid_bit_;
+        const bool in_burst          = same_polarity & (now - (state & time_mask_) < threshold_units_);
+        bool keep;
+        if (kept == BurstEventKept::First) {
+            keep  = !in_burst;
+            state = now | polarity | valid_bit_;
+        } else {
+            keep  = in_burst && !(state & kept_bit_);
+            state = now | polarity | valid_bit_ | (in_burst ? kept_bit_ : 0);
+        }
+        return keep;
+    }
+
+    int width_;
+    int height_;
+    std::uint32_t threshold_{0};
+    std::uint32_t shift_{0};
+    std::uint32_t threshold_units_{0};
+    std::vector<std::uint32_t> states_;
+};
+
+} // namespace detail
+} // namespace Metavision
+
+#endif // METAVISION_SDK_CORE_DETAIL_BURST_NOISE_FILTER_ALGORITHM_H
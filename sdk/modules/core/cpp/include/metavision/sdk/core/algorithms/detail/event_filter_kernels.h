@@ -0,0 +1,139 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_CORE_DETAIL_EVENT_FILTER_KERNELS_H
+#define METAVISION_SDK_CORE_DETAIL_EVENT_FILTER_KERNELS_H
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+#include "metavision/sdk/base/events/event_cd.h"
+
+namespace Metavision {
+namespace detail {
+
+/// @brief Instruction sets the event filtering kernels are implemented with
+enum class SimdIsa {
+    Scalar, ///< Portable implementation
+    Neon,   ///< ARMv8 Advanced SIMD
+    Avx2,   ///< x86 AVX2
+    Avx512  ///< x86 AVX-512 F and BW
+};
+
+/// @brief Returns the most efficient instruction set supported by the CPU, detected once at runtime
+SimdIsa best_simd_isa();
+
+/// @brief Returns true if the kernels can run with the given instruction set on this CPU
+bool is_simd_isa_supported(SimdIsa isa);
+
+/// @brief Copies the events inside the ROI [x0, x1] x [y0, y1], in order
+///
+/// Only the accepted events are written, so @p out may be @p begin to filter the events in place.
+///
+/// @param begin Pointer to the first input event
+/// @param end Pointer to the past-the-end input event
+/// @param out Pointer to the first output event
+/// @param x0 X coordinate of the upper left corner of the ROI
+/// @param y0 Y coordinate of the upper left corner of the ROI
+/// @param x1 X coordinate of the lower right corner of the ROI
+/// @param y1 Y coordinate of the lower right corner of the ROI
+/// @param output_relative_coordinates If true, the output events are expressed in the ROI coordinates system
+/// @param isa Instruction set to use, which must be supported by the CPU
+/// @return Pointer to the past-the-end output event
+/// @throw std::invalid_argument if @p isa is not supported by the CPU
+EventCD *roi_filter_events(const EventCD *begin, const EventCD *end, EventCD *out, std::int32_t x0, std::int32_t y0,
+                           std::int32_t x1, std::int32_t y1, bool output_relative_coordinates,
+                           SimdIsa isa = best_simd_isa());
+
+/// @brief Copies the events of the given polarity, in order
+///
+/// Only the accepted events are written, so @p out may be @p begin to filter the events in place.
+///
+/// @param begin Pointer to the first input event
+/// @param end Pointer to the past-the-end input event
+/// @param out Pointer to the first output event
+/// @param polarity Polarity to keep
+/// @param isa Instruction set to use, which must be supported by the CPU
+/// @return Pointer to the past-the-end output event
+/// @throw std::invalid_argument if @p isa is not supported by the CPU
+EventCD *polarity_filter_events(const EventCD *begin, const EventCD *end, EventCD *out, std::int16_t polarity,
+                                SimdIsa isa = best_simd_isa());
+
+/// Checks whether an iterator points to contiguous @ref EventCD, which the kernels can process
+template<typename It>
+struct is_contiguous_event_cd_iterator
+    : std::integral_constant<bool, std::is_same<It, const EventCD *>::value || std::is_same<It, EventCD *>::value ||
+                                       std::is_same<It, std::vector<EventCD>::const_iterator>::value ||
+                                       std::is_same<It, std::vector<EventCD>::iterator>::value> {};
+
+/// Checks whether an output iterator is a pointer to @ref EventCD, which the kernels can write to directly
+///
+/// Vector iterators are not written to directly, as they can not be converted to pointers when they are past-the-end.
+template<typename It>
+struct is_contiguous_event_cd_output_iterator : std::is_same<It, EventCD *> {};
+
+/// Runs a kernel writing directly to the output
+template<typename OutputIt, typename Kernel>
+inline OutputIt run_event_filter_kernel(const EventCD *begin, const EventCD *end, OutputIt inserter, Kernel &kernel,
+                                        std::true_type) {
+    return kernel(begin, end, inserter);
+}
+
+/// Runs a kernel on blocks of events small enough for their output to stay in the L1 cache, before copying it to any
+/// kind of output iterator (e.g. a back inserter)
+template<typename OutputIt, typename Kernel>
+inline OutputIt run_event_filter_kernel(const EventCD *begin, const EventCD *end, OutputIt inserter, Kernel &kernel,
+                                        std::false_type) {
+    constexpr std::ptrdiff_t block_size = 256;
+    EventCD block[block_size];
+    while (begin != end) {
+        const EventCD *block_end = begin + std::min(block_size, end - begin);
+        inserter                 = std::copy(block, kernel(begin, block_end, block), inserter);
+        begin                    = block_end;
+    }
+    return inserter;
+}
+
+/// Filters events with a kernel when they are contiguous @ref EventCD, and with the given fallback otherwise
+///
+/// @param kernel Callable as kernel(const EventCD *begin, const EventCD *end, EventCD *out) -> EventCD *
+/// @param fallback Callable as fallback(it_begin, it_end, inserter) -> OutputIt
+template<typename InputIt, typename OutputIt, typename Kernel, typename Fallback>
+inline OutputIt filter_events(InputIt it_begin, InputIt it_end, OutputIt inserter, Kernel &&kernel,
+                              Fallback &&fallback, std::true_type) {
+    if (it_begin == it_end) {
+        return inserter;
+    }
+    const EventCD *begin = &*it_begin;
+    return run_event_filter_kernel(begin, begin + std::distance(it_begin, it_end), inserter, kernel,
+                                   is_contiguous_event_cd_output_iterator<OutputIt>());
+}
+
+template<typename InputIt, typename OutputIt, typename Kernel, typename Fallback>
+inline OutputIt filter_events(InputIt it_begin, InputIt it_end, OutputIt inserter, Kernel &&, Fallback &&fallback,
+                              std::false_type) {
+    return fallback(it_begin, it_end, inserter);
+}
+
+template<typename InputIt, typename OutputIt, typename Kernel, typename Fallback>
+inline OutputIt filter_events(InputIt it_begin, InputIt it_end, OutputIt inserter, Kernel &&kernel,
+                              Fallback &&fallback) {
+    return filter_events(it_begin, it_end, inserter, std::forward<Kernel>(kernel), std::forward<Fallback>(fallback),
+                         is_contiguous_event_cd_iterator<InputIt>());
+}
+
+} // namespace detail
+} // namespace Metavision
+
+#endif // METAVISION_SDK_CORE_DETAIL_EVENT_FILTER_KERNELS_H
@@ -0,0 +1,71 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_CORE_DETAIL_EVENT_RATE_CONTROLLER_ALGORITHM_IMPL_H
+#define METAVISION_SDK_CORE_DETAIL_EVENT_RATE_CONTROLLER_ALGORITHM_IMPL_H
+
+#include <algorithm>
+
+namespace Metavision {
+
+template<typename Event>
+inline std::uint32_t EventRateControllerAlgorithm::hash(const Event &ev) {
+    std::uint32_t h = (static_cast<std::uint32_t>(ev.x) * 0x9E3779B1u) ^
+                      (static_cast<std::uint32_t>(ev.y) * 0x85EBCA77u) ^
+                      (static_cast<std::uint32_t>(ev.t) * 0xC2B2AE3Du);
+    h ^= h >> 15;
+    h *= 0x2C1B3C6Du;
+    h ^= h >> 12;
+    h *= 0x297A2D39u;
+    h ^= h >> 15;
+    return h;
+}
+
+template<class InputIt, class OutputIt>
+inline OutputIt EventRateControllerAlgorithm::process_events(InputIt it_begin, InputIt it_end, OutputIt inserter) {
+    if (!enabled_) {
+        return std::copy(it_begin, it_end, inserter);
+    }
+
+    while (it_begin != it_end) {
+        if (!has_count_period_ || it_begin->t >= count_period_start_ + count_period_) {
+            start_count_period(it_begin->t);
+        }
+
+        // Block of events in the current count period
+        const timestamp count_period_end = count_period_start_ + count_period_;
+        std::size_t n_events             = 0;
+        for (InputIt it = it_begin; it != it_end && n_events < block_size_ && it->t < count_period_end; ++it) {
+            ++n_events;
+        }
+
+        // The decisions don't depend on each other, so that this loop is free of branches
+        const std::uint32_t threshold = threshold_;
+        InputIt it                    = it_begin;
+        for (std::size_t i = 0; i < n_events; ++i, ++it) {
+            keep_[i] = (hash(*it) >> 8) < threshold;
+        }
+        n_events_in_count_period_ += n_events;
+
+        for (std::size_t i = 0; i < n_events; ++i, ++it_begin) {
+            if (keep_[i] && n_kept_in_count_period_ < event_count_) {
+                *inserter = *it_begin;
+                ++inserter;
+                ++n_kept_in_count_period_;
+            }
+        }
+    }
+    return inserter;
+}
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_CORE_DETAIL_EVENT_RATE_CONTROLLER_ALGORITHM_IMPL_H
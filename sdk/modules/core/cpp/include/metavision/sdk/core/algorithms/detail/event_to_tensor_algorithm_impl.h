@@ -0,0 +1,201 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_CORE_DETAIL_EVENT_TO_TENSOR_ALGORITHM_IMPL_H
+#define METAVISION_SDK_CORE_DETAIL_EVENT_TO_TENSOR_ALGORITHM_IMPL_H
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+#include <opencv2/core/utility.hpp>
+
+namespace Metavision {
+
+namespace detail {
+
+/// Float32 tensors are filled in place, the other ones are accumulated in a temporary buffer and then converted
+inline float *tensor_accumulation_buffer(float *tensor, std::vector<float> &) {
+    return tensor;
+}
+
+inline float *tensor_accumulation_buffer(cv::float16_t *, std::vector<float> &buffer) {
+    return buffer.data();
+}
+
+inline void write_tensor_values(const float *, float *, std::size_t) {}
+
+inline void write_tensor_values(const float *values, cv::float16_t *tensor, std::size_t n_values) {
+    for (std::size_t i = 0; i < n_values; ++i) {
+        tensor[i] = cv::float16_t(values[i]);
+    }
+}
+
+inline std::size_t tensor_accumulation_buffer_size(const float *, std::size_t) {
+    return 0;
+}
+
+inline std::size_t tensor_accumulation_buffer_size(const cv::float16_t *, std::size_t n_values) {
+    return n_values;
+}
+
+} // namespace detail
+
+template<typename Impl>
+EventToTensorAlgorithm<Impl>::EventToTensorAlgorithm(int width, int height, int channels_per_time_bin,
+                                                     int time_bins_per_slice) :
+    width_(width),
+    height_(height),
+    channels_per_time_bin_(channels_per_time_bin),
+    time_bins_per_slice_(time_bins_per_slice) {
+    if (width <= 0 || height <= 0) {
+        throw std::invalid_argument("Tensor generation expects a strictly positive sensor size.");
+    }
+    if (channels_per_time_bin <= 0 || time_bins_per_slice <= 0) {
+        throw std::invalid_argument("Tensor generation expects a strictly positive number of channels.");
+    }
+}
+
+template<typename Impl>
+template<typename RandomIt>
+void EventToTensorAlgorithm<Impl>::find_events(RandomIt &it_begin, RandomIt &it_end, timestamp begin_ts,
+                                               timestamp end_ts) {
+    using Event = typename std::iterator_traits<RandomIt>::value_type;
+    it_begin    = std::lower_bound(it_begin, it_end, begin_ts, [](const Event &ev, timestamp t) { return ev.t < t; });
+    it_end      = std::lower_bound(it_begin, it_end, end_ts, [](const Event &ev, timestamp t) { return ev.t < t; });
+}
+
+template<typename Impl>
+template<typename RandomIt, typename T>
+void EventToTensorAlgorithm<Impl>::generate(RandomIt it_begin, RandomIt it_end, timestamp start_ts,
+                                            timestamp duration, T *tensor) const {
+    generate(it_begin, it_end, start_ts, duration, 1, tensor);
+}
+
+template<typename Impl>
+template<typename RandomIt, typename T>
+void EventToTensorAlgorithm<Impl>::generate(RandomIt it_begin, RandomIt it_end, timestamp start_ts,
+                                            timestamp slice_duration, int n_slices, T *tensors) const {
+    if (slice_duration <= 0) {
+        throw std::invalid_argument("Tensor generation expects a strictly positive slice duration.");
+    }
+    if (n_slices <= 0) {
+        throw std::invalid_argument("Tensor generation expects a strictly positive number of slices.");
+    }
+
+    // Consecutive time bins fill consecutive groups of channels, so that each one is written by a single thread
+    const int n_time_bins      = n_slices * time_bins_per_slice_;
+    const std::size_t bin_size = static_cast<std::size_t>(channels_per_time_bin_) * height_ * width_;
+    const int max_threads      = max_threads_ > 0 ? max_threads_ : cv::getNumThreads();
+    const int n_sequences      = std::max(1, std::min(max_threads, n_time_bins));
+
+    const auto fill_sequences = [&](const cv::Range &sequences) {
+        std::vector<float> buffer(detail::tensor_accumulation_buffer_size(tensors, bin_size));
+        for (int s = sequences.start; s < sequences.end; ++s) {
+            const int first_bin = s * n_time_bins / n_sequences, last_bin = (s + 1) * n_time_bins / n_sequences;
+            for (int bin = first_bin; bin < last_bin; ++bin) {
+                const int slice = bin / time_bins_per_slice_;
+                T *tensor_bin   = tensors + bin * bin_size;
+                float *values   = detail::tensor_accumulation_buffer(tensor_bin, buffer);
+                std::fill(values, values + bin_size, 0.f);
+                static_cast<const Impl *>(this)->fill_time_bin(it_begin, it_end, start_ts + slice * slice_duration,
+                                                               slice_duration, bin % time_bins_per_slice_, values);
+                detail::write_tensor_values(values, tensor_bin, bin_size);
+            }
+        }
+    };
+
+    if (n_sequences == 1) {
+        fill_sequences(cv::Range(0, 1));
+    } else {
+        cv::parallel_for_(cv::Range(0, n_sequences), fill_sequences, n_sequences);
+    }
+}
+
+template<typename RandomIt>
+void HistogramTensorAlgorithm::fill_time_bin(RandomIt it_begin, RandomIt it_end, timestamp slice_ts,
+                                             timestamp slice_duration, int, float *values) const {
+    find_events(it_begin, it_end, slice_ts, slice_ts + slice_duration);
+    const std::size_t n_pixels = static_cast<std::size_t>(width_) * height_;
+    for (; it_begin != it_end; ++it_begin) {
+        values[(it_begin->p > 0 ? n_pixels : 0) + it_begin->y * width_ + it_begin->x] += 1.f;
+    }
+    if (max_count_ > 0.f) {
+        const float scale = 1.f / max_count_;
+        for (std::size_t i = 0; i < 2 * n_pixels; ++i) {
+            values[i] = std::min(values[i], max_count_) * scale;
+        }
+    }
+}
+
+template<typename RandomIt>
+void DifferenceTensorAlgorithm::fill_time_bin(RandomIt it_begin, RandomIt it_end, timestamp slice_ts,
+                                              timestamp slice_duration, int, float *values) const {
+    find_events(it_begin, it_end, slice_ts, slice_ts + slice_duration);
+    for (; it_begin != it_end; ++it_begin) {
+        values[it_begin->y * width_ + it_begin->x] += it_begin->p > 0 ? 1.f : -1.f;
+    }
+    if (max_count_ > 0.f) {
+        const float scale          = 1.f / max_count_;
+        const std::size_t n_pixels = static_cast<std::size_t>(width_) * height_;
+        for (std::size_t i = 0; i < n_pixels; ++i) {
+            values[i] = std::max(-max_count_, std::min(values[i], max_count_)) * scale;
+        }
+    }
+}
+
+template<typename RandomIt>
+void VoxelGridTensorAlgorithm::fill_time_bin(RandomIt it_begin, RandomIt it_end, timestamp slice_ts,
+                                             timestamp slice_duration, int time_bin, float *values) const {
+    // An event contributes to the bin b if floor(t*), clamped to [0, B - 1], is b - 1 or b, i.e. if t* is in
+    // [b - 1, b + 1[. The events before the first bin center are clamped to the bin 0 and also contribute to the bin 1,
+    // and the ones after the last bin center only contribute to the bin B - 1. The bounds are widened by 1us to be
+    // robust to rounding, the events in the margins being discarded below.
+    const timestamp n_bins = n_bins_;
+    timestamp begin_ts     = slice_ts;
+    timestamp end_ts       = slice_ts + slice_duration;
+    if (time_bin > 1) {
+        begin_ts = std::max(begin_ts, slice_ts + (2 * time_bin - 1) * slice_duration / (2 * n_bins) - 1);
+    }
+    if (time_bin < n_bins_ - 1) {
+        end_ts = std::min(end_ts, slice_ts + ((2 * time_bin + 3) * slice_duration + 2 * n_bins - 1) / (2 * n_bins) + 1);
+    }
+    find_events(it_begin, it_end, begin_ts, end_ts);
+
+    const float bins_per_us = static_cast<float>(n_bins_) / static_cast<float>(slice_duration);
+    const float max_bin     = static_cast<float>(n_bins_ - 1);
+    const float bin         = static_cast<float>(time_bin);
+    for (; it_begin != it_end; ++it_begin) {
+        const float t_star = static_cast<float>(it_begin->t - slice_ts) * bins_per_us - 0.5f;
+        const float lbin   = std::min(std::max(std::floor(t_star), 0.f), max_bin);
+        const float rbin   = std::min(lbin + 1.f, max_bin);
+        const float lvalue = std::max(1.f - std::abs(lbin - t_star), 0.f);
+        const float weight = (lbin == bin ? lvalue : 0.f) + (rbin == bin ? 1.f - lvalue : 0.f);
+        values[it_begin->y * width_ + it_begin->x] += it_begin->p > 0 ? weight : -weight;
+    }
+}
+
+template<typename RandomIt>
+void TimestampTensorAlgorithm::fill_time_bin(RandomIt it_begin, RandomIt it_end, timestamp slice_ts,
+                                             timestamp slice_duration, int, float *values) const {
+    find_events(it_begin, it_end, slice_ts, slice_ts + slice_duration);
+    const std::size_t n_pixels = static_cast<std::size_t>(width_) * height_;
+    const float scale          = 1.f / static_cast<float>(slice_duration);
+    for (; it_begin != it_end; ++it_begin) {
+        values[(it_begin->p > 0 ? n_pixels : 0) + it_begin->y * width_ + it_begin->x] =
+            static_cast<float>(it_begin->t - slice_ts + 1) * scale;
+    }
+}
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_CORE_DETAIL_EVENT_TO_TENSOR_ALGORITHM_IMPL_H
@@ -0,0 +1,68 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_CORE_DETAIL_EVENTS_SLICER_ALGORITHM_IMPL_H
+#define METAVISION_SDK_CORE_DETAIL_EVENTS_SLICER_ALGORITHM_IMPL_H
+
+namespace Metavision {
+
+template<typename EventT>
+EventsSlicerAlgorithm<EventT>::EventsSlicerAlgorithm(SliceCallback slice_cb) : slice_cb_(slice_cb) {}
+
+template<typename EventT>
+void EventsSlicerAlgorithm<EventT>::process_events(const EventT *it_begin, const EventT *it_end) {
+    pending_begin_ = pending_end_ = it_begin;
+    AsyncAlgorithmT::process_events(it_begin, it_end);
+    carry_pending_events();
+}
+
+template<typename EventT>
+void EventsSlicerAlgorithm<EventT>::process_events(const timestamp ts, const EventT *it_begin,
+                                                   const EventT *it_end) {
+    pending_begin_ = pending_end_ = it_begin;
+    AsyncAlgorithmT::process_events(ts, it_begin, it_end);
+    carry_pending_events();
+}
+
+template<typename EventT>
+std::size_t EventsSlicerAlgorithm<EventT>::carried_events_count() const {
+    return carry_.size();
+}
+
+template<typename EventT>
+void EventsSlicerAlgorithm<EventT>::process_online(const EventT *it_begin, const EventT *it_end) {
+    // The ranges processed online are contiguous, the current slice thus ends at the last one
+    pending_end_ = it_end;
+}
+
+template<typename EventT>
+void EventsSlicerAlgorithm<EventT>::process_async(const timestamp processing_ts, const size_t n_processed_events) {
+    if (carry_.empty()) {
+        slice_cb_(Slice{pending_begin_, pending_end_, processing_ts});
+    } else {
+        // The slice started in a previous input buffer: it is stitched in the carry buffer
+        carry_.insert(carry_.end(), pending_begin_, pending_end_);
+        slice_cb_(Slice{carry_.data(), carry_.data() + carry_.size(), processing_ts});
+        carry_.clear();
+    }
+    pending_begin_ = pending_end_;
+}
+
+template<typename EventT>
+void EventsSlicerAlgorithm<EventT>::carry_pending_events() {
+    carry_.insert(carry_.end(), pending_begin_, pending_end_);
+    // process_async may be called out of process_events, e.g. by flush, when there is no input buffer
+    pending_begin_ = pending_end_ = nullptr;
+}
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_CORE_DETAIL_EVENTS_SLICER_ALGORITHM_IMPL_H
@@ -0,0 +1,130 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_CORE_DETAIL_FILTER_CHAIN_ALGORITHM_IMPL_H
+#define METAVISION_SDK_CORE_DETAIL_FILTER_CHAIN_ALGORITHM_IMPL_H
+
+namespace Metavision {
+
+namespace detail {
+
+/// Applies a predicate, i.e. a filter returning a bool when called on a const event
+template<typename Filter, typename Event>
+inline auto apply_filter(const Filter &filter, Event &ev)
+    -> std::enable_if_t<std::is_same<decltype(filter(static_cast<const Event &>(ev))), bool>::value, bool> {
+    return filter(static_cast<const Event &>(ev));
+}
+
+/// Applies a transform, i.e. a filter returning void when called on an event
+template<typename Filter, typename Event>
+inline auto apply_filter(const Filter &filter, Event &ev)
+    -> std::enable_if_t<std::is_same<decltype(filter(ev)), void>::value, bool> {
+    filter(ev);
+    return true;
+}
+
+/// The ROI filter is a predicate, followed by a transform when it outputs coordinates relative to the ROI
+template<typename Event>
+inline bool apply_filter(const RoiFilterAlgorithm &filter, Event &ev) {
+    if (!filter(static_cast<const Event &>(ev))) {
+        return false;
+    }
+    if (filter.is_resetting()) {
+        filter(ev);
+    }
+    return true;
+}
+
+/// Same as the ROI filter, with an arbitrary shape
+template<typename Event>
+inline bool apply_filter(const MaskFilterAlgorithm &filter, Event &ev) {
+    if (!filter(static_cast<const Event &>(ev))) {
+        return false;
+    }
+    if (filter.is_resetting()) {
+        filter(ev);
+    }
+    return true;
+}
+
+} // namespace detail
+
+template<typename... Filters>
+FilterChainAlgorithm<Filters...>::FilterChainAlgorithm(Filters... filters) : filters_(std::move(filters)...) {}
+
+template<typename... Filters>
+template<class InputIt, class OutputIt>
+inline OutputIt FilterChainAlgorithm<Filters...>::process_events(InputIt it_begin, InputIt it_end,
+                                                                 OutputIt inserter) const {
+    for (; it_begin != it_end; ++it_begin) {
+        auto ev = *it_begin;
+        if (apply(ev, std::integral_constant<std::size_t, 0>())) {
+            *inserter = ev;
+            ++inserter;
+        }
+    }
+    return inserter;
+}
+
+template<typename... Filters>
+template<class It>
+inline It FilterChainAlgorithm<Filters...>::process_events_in_place(It it_begin, It it_end) const {
+    It it_out = it_begin;
+    for (; it_begin != it_end; ++it_begin) {
+        auto ev = *it_begin;
+        if (apply(ev, std::integral_constant<std::size_t, 0>())) {
+            *it_out = ev;
+            ++it_out;
+        }
+    }
+    return it_out;
+}
+
+template<typename... Filters>
+template<typename Event>
+inline bool FilterChainAlgorithm<Filters...>::operator()(Event &ev) const {
+    return apply(ev, std::integral_constant<std::size_t, 0>());
+}
+
+template<typename... Filters>
+template<std::size_t I>
+inline std::tuple_element_t<I, std::tuple<Filters...>> &FilterChainAlgorithm<Filters...>::get() {
+    return std::get<I>(filters_);
+}
+
+template<typename... Filters>
+template<std::size_t I>
+inline const std::tuple_element_t<I, std::tuple<Filters...>> &FilterChainAlgorithm<Filters...>::get() const {
+    return std::get<I>(filters_);
+}
+
+template<typename... Filters>
+template<typename Event>
+inline bool FilterChainAlgorithm<Filters...>::apply(Event &,
+                                                    std::integral_constant<std::size_t, sizeof...(Filters)>) const {
+    return true;
+}
+
+template<typename... Filters>
+template<typename Event, std::size_t I>
+inline bool FilterChainAlgorithm<Filters...>::apply(Event &ev, std::integral_constant<std::size_t, I>) const {
+    return detail::apply_filter(std::get<I>(filters_), ev) &&
+           apply(ev, std::integral_constant<std::size_t, I + 1>());
+}
+
+template<typename... Filters>
+inline FilterChainAlgorithm<std::decay_t<Filters>...> make_filter_chain(Filters &&...filters) {
+    return FilterChainAlgorithm<std::decay_t<Filters>...>(std::forward<Filters>(filters)...);
+}
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_CORE_DETAIL_FILTER_CHAIN_ALGORITHM_IMPL_H
@@ -12,8 +12,33 @@
 #ifndef METAVISION_SDK_CORE_DETAIL_SHARED_EVENTS_BUFFER_PRODUCER_ALGORITHM_IMPL_H
 #define METAVISION_SDK_CORE_DETAIL_SHARED_EVENTS_BUFFER_PRODUCER_ALGORITHM_IMPL_H
 
+#include <cstdint>
+#ifdef __linux__
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
 namespace Metavision {
 
+namespace detail {
+
+/// @brief Hints the OS to back the pages fully contained in the given memory with huge pages
+///
+/// This is a no-op on the platforms without transparent huge pages.
+inline void advise_huge_pages(const void *data, size_t size) {
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+    const auto page_size = static_cast<std::uintptr_t>(sysconf(_SC_PAGESIZE));
+    const auto begin     = (reinterpret_cast<std::uintptr_t>(data) + page_size - 1) & ~(page_size - 1);
+    const auto end       = (reinterpret_cast<std::uintptr_t>(data) + size) & ~(page_size - 1);
+    if (begin < end) {
+        // The advice may be refused (e.g. huge pages disabled), which only leaves the memory backed by regular pages
+        madvise(reinterpret_cast<void *>(begin), end - begin, MADV_HUGEPAGE);
+    }
+#endif
+}
+
+} // namespace detail
+
 template<typename EventT>
 SharedEventsBufferProducerAlgorithm<EventT>::SharedEventsBufferProducerAlgorithm(
     SharedEventsBufferProducerParameters params, SharedEventsBufferProducedCb buffer_produced_cb) :
@@ -27,11 +52,15 @@ SharedEventsBufferProducerAlgorithm<EventT>::SharedEventsBufferProducerAlgorithm
         while (!buffers_pool_.empty()) {
             acquired_for_allocation.push_back(buffers_pool_.acquire());
             acquired_for_allocation.back()->reserve(params.buffers_preallocation_size_);
+            if (params.use_huge_pages_) {
+                detail::advise_huge_pages(acquired_for_allocation.back()->data(),
+                                          params.buffers_preallocation_size_ * sizeof(EventT));
+            }
         }
+        stats_.capacity_ = acquired_for_allocation.size();
     }
 
-    current_shared_buffer_ = buffers_pool_.acquire();
-    current_shared_buffer_->reserve(params_.buffers_preallocation_size_);
+    acquire_buffer();
 
     if (params.buffers_events_count_ == 0 && params.buffers_time_slice_us_ != 0) {
         this->set_processing_n_us(params.buffers_time_slice_us_);
@@ -54,6 +83,38 @@ void SharedEventsBufferProducerAlgorithm<EventT>::clear() {
     current_shared_buffer_->clear();
 }
 
+template<typename EventT>
+SharedEventsBufferPoolStats SharedEventsBufferProducerAlgorithm<EventT>::pool_stats() const {
+    SharedEventsBufferPoolStats stats = stats_;
+    stats.outstanding_buffers_        = stats.capacity_ - buffers_pool_.size();
+    return stats;
+}
+
+template<typename EventT>
+void SharedEventsBufferProducerAlgorithm<EventT>::acquire_buffer() {
+    // The producer is the only one to acquire buffers: if the pool isn't empty now, it won't be when acquiring
+    if (!buffers_pool_.is_bounded()) {
+        const size_t n_allocated = buffers_pool_.arrange(1);
+        stats_.allocations_ += n_allocated;
+        stats_.capacity_ += n_allocated;
+    } else if (buffers_pool_.empty()) {
+        ++stats_.blocking_acquisitions_;
+    }
+
+    current_shared_buffer_  = buffers_pool_.acquire();
+    stats_.high_water_mark_ = std::max(stats_.high_water_mark_, stats_.capacity_ - buffers_pool_.size());
+
+    // Only the buffers newly allocated by an unbounded pool need to be reserved
+    if (current_shared_buffer_->capacity() < params_.buffers_preallocation_size_) {
+        current_shared_buffer_->reserve(params_.buffers_preallocation_size_);
+        if (params_.use_huge_pages_) {
+            detail::advise_huge_pages(current_shared_buffer_->data(),
+                                      params_.buffers_preallocation_size_ * sizeof(EventT));
+        }
+    }
+    current_shared_buffer_->clear();
+}
+
 template<typename EventT>
 template<typename InputIt>
 void SharedEventsBufferProducerAlgorithm<EventT>::process_online(InputIt it_begin, InputIt it_end) {
@@ -63,15 +124,16 @@ void SharedEventsBufferProducerAlgorithm<EventT>::process_online(InputIt it_begi
 template<typename EventT>
 void SharedEventsBufferProducerAlgorithm<EventT>::process_async(const timestamp processing_ts,
                                                                 const size_t n_processed_events) {
-    buffer_produced_cb_(processing_ts, current_shared_buffer_);
-
-    current_shared_buffer_ = buffers_pool_.acquire();
+    if (params_.drop_buffers_if_pool_exhausted_ && buffers_pool_.is_bounded() && buffers_pool_.empty()) {
+        // No buffer to continue with: the produced one is reused instead of being passed to the callback
+        ++stats_.dropped_buffers_;
+        stats_.dropped_events_ += current_shared_buffer_->size();
+        current_shared_buffer_->clear();
+        return;
+    }
 
-    // In the bounded memory case, the memory is already allocated and this is equivalent to a single if if memory is
-    // already allocated.
-    // In the unbounded memory case, if needs to reallocate a new buffer, this will reserve the requested memory
-    current_shared_buffer_->reserve(params_.buffers_preallocation_size_);
-    current_shared_buffer_->clear();
+    buffer_produced_cb_(processing_ts, current_shared_buffer_);
+    acquire_buffer();
 }
 
 } // namespace Metavision
@@ -14,32 +14,44 @@
 
 namespace Metavision {
 
-template<int CHANNELS>
-TimeSurfaceProducerAlgorithm<CHANNELS>::TimeSurfaceProducerAlgorithm(int width, int height) :
+namespace detail {
+
+inline void update_time_surface(MostRecentTimestampBuffer &time_surface, int y, int x, int c, timestamp t) {
+    time_surface.at(y, x, c) = t;
+}
+
+inline void update_time_surface(CompactMostRecentTimestampBuffer &time_surface, int y, int x, int c, timestamp t) {
+    time_surface.set(y, x, c, t);
+}
+
+} // namespace detail
+
+template<int CHANNELS, typename TimeSurfaceT>
+TimeSurfaceProducerAlgorithm<CHANNELS, TimeSurfaceT>::TimeSurfaceProducerAlgorithm(int width, int height) :
     time_surface_(height, width, CHANNELS) {
     time_surface_.set_to(0);
 
-    output_cb_ = [](timestamp, const MostRecentTimestampBuffer &) {};
+    output_cb_ = [](timestamp, const TimeSurfaceT &) {};
 }
 
-template<int CHANNELS>
-void TimeSurfaceProducerAlgorithm<CHANNELS>::set_output_callback(const OutputCb &cb) {
+template<int CHANNELS, typename TimeSurfaceT>
+void TimeSurfaceProducerAlgorithm<CHANNELS, TimeSurfaceT>::set_output_callback(const OutputCb &cb) {
     output_cb_ = cb;
 }
 
-template<int CHANNELS>
+template<int CHANNELS, typename TimeSurfaceT>
 template<typename InputIt>
-inline void TimeSurfaceProducerAlgorithm<CHANNELS>::process_online(InputIt it_begin, InputIt it_end) {
+inline void TimeSurfaceProducerAlgorithm<CHANNELS, TimeSurfaceT>::process_online(InputIt it_begin, InputIt it_end) {
     for (auto it = it_begin; it != it_end; ++it) {
         assert(it->p == 0 || it->p == 1);
-        const auto c                      = (CHANNELS == 1) ? 0 : it->p;
-        time_surface_.at(it->y, it->x, c) = it->t;
+        const auto c = (CHANNELS == 1) ? 0 : it->p;
+        detail::update_time_surface(time_surface_, it->y, it->x, c, it->t);
     }
 }
 
-template<int CHANNELS>
-void TimeSurfaceProducerAlgorithm<CHANNELS>::process_async(const timestamp processing_ts,
-                                                           const size_t n_processed_events) {
+template<int CHANNELS, typename TimeSurfaceT>
+void TimeSurfaceProducerAlgorithm<CHANNELS, TimeSurfaceT>::process_async(const timestamp processing_ts,
+                                                                         const size_t n_processed_events) {
     output_cb_(processing_ts, time_surface_);
 }
 
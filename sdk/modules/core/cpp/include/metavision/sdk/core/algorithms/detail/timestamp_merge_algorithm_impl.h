@@ -0,0 +1,399 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_CORE_DETAIL_TIMESTAMP_MERGE_ALGORITHM_IMPL_H
+#define METAVISION_SDK_CORE_DETAIL_TIMESTAMP_MERGE_ALGORITHM_IMPL_H
+
+#include <algorithm>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace Metavision {
+
+namespace detail {
+
+/// Returns @p if_true if @p condition holds, @p if_false otherwise, with a mask rather than a branch that the compiler
+/// could keep and that would be mispredicted
+template<typename T>
+inline T select_without_branch(bool condition, T if_true, T if_false) {
+    const T mask = T(0) - static_cast<T>(condition);
+    return if_false ^ ((if_true ^ if_false) & mask);
+}
+
+/// Pointer overload of @ref select_without_branch
+template<typename T>
+inline T *select_without_branch(bool condition, T *if_true, T *if_false) {
+    return reinterpret_cast<T *>(select_without_branch(condition, reinterpret_cast<std::uintptr_t>(if_true),
+                                                       reinterpret_cast<std::uintptr_t>(if_false)));
+}
+
+/// Index of a type in a list of types, or the number of types if it is not in the list
+template<typename T, typename... Ts>
+struct merge_type_index : std::integral_constant<std::size_t, 0> {};
+
+template<typename T, typename... Ts>
+struct merge_type_index<T, T, Ts...> : std::integral_constant<std::size_t, 0> {};
+
+template<typename T, typename U, typename... Ts>
+struct merge_type_index<T, U, Ts...> : std::integral_constant<std::size_t, 1 + merge_type_index<T, Ts...>::value> {};
+
+} // namespace detail
+
+template<typename... Events>
+TimestampMergeAlgorithm<Events...>::OutputBatch::OutputBatch(const TimestampMergeAlgorithm &algo) : algo_(algo) {}
+
+template<typename... Events>
+std::size_t TimestampMergeAlgorithm<Events...>::OutputBatch::size() const {
+    return algo_.n_output_total_;
+}
+
+template<typename... Events>
+template<typename EventT>
+const EventT *TimestampMergeAlgorithm<Events...>::OutputBatch::begin() const {
+    constexpr std::size_t I = detail::merge_type_index<EventT, Events...>::value;
+    static_assert(I < n_event_types, "Timestamp merge does not merge this type of events.");
+    return std::get<I>(algo_.output_).data();
+}
+
+template<typename... Events>
+template<typename EventT>
+const EventT *TimestampMergeAlgorithm<Events...>::OutputBatch::end() const {
+    constexpr std::size_t I = detail::merge_type_index<EventT, Events...>::value;
+    return begin<EventT>() + algo_.n_output_events_[I];
+}
+
+template<typename... Events>
+const std::uint32_t *TimestampMergeAlgorithm<Events...>::OutputBatch::sources() const {
+    return algo_.tag_sources_ ? algo_.output_sources_.data() : nullptr;
+}
+
+template<typename... Events>
+template<typename Visitor>
+void TimestampMergeAlgorithm<Events...>::OutputBatch::visit(Visitor &&visitor) const {
+    std::array<std::size_t, n_event_types> positions{};
+    const std::uint32_t *sources = algo_.output_sources_.data();
+    for (std::size_t i = 0; i < algo_.n_output_total_; ++i) {
+        visit_event(visitor, sources[i], positions, std::integral_constant<std::size_t, 0>());
+    }
+}
+
+template<typename... Events>
+template<typename Visitor, std::size_t I>
+void TimestampMergeAlgorithm<Events...>::OutputBatch::visit_event(Visitor &visitor, std::uint32_t source,
+                                                                   std::array<std::size_t, n_event_types> &positions,
+                                                                   std::integral_constant<std::size_t, I>) const {
+    if (I + 1 < n_event_types && algo_.inputs_[source].type_ != I) {
+        visit_event(visitor, source, positions,
+                    std::integral_constant<std::size_t, std::min(I + 1, n_event_types - 1)>());
+        return;
+    }
+    visitor(std::get<I>(algo_.output_)[positions[I]++], source);
+}
+
+template<typename... Events>
+TimestampMergeAlgorithm<Events...>::TimestampMergeAlgorithm(const std::array<std::size_t, n_event_types> &n_inputs,
+                                                            const OutputCallback &output_cb,
+                                                            std::size_t output_batch_size, bool tag_sources) :
+    output_cb_(output_cb),
+    output_batch_size_(output_batch_size),
+    tag_sources_(tag_sources || n_event_types > 1) {
+    for (std::size_t type = 0; type < n_event_types; ++type) {
+        for (std::size_t i = 0; i < n_inputs[type]; ++i) {
+            inputs_.emplace_back();
+            inputs_.back().type_ = type;
+        }
+    }
+    if (inputs_.empty()) {
+        throw std::invalid_argument("Timestamp merge expects at least one input.");
+    }
+    if (output_batch_size == 0) {
+        throw std::invalid_argument("Timestamp merge expects a strictly positive output batch size.");
+    }
+
+    n_leaves_ = 1;
+    while (n_leaves_ < inputs_.size()) {
+        n_leaves_ *= 2;
+    }
+    ends_.resize(inputs_.size());
+    tree_.resize(n_leaves_);
+    leaves_.resize(n_leaves_);
+    winners_.resize(2 * n_leaves_);
+
+    // Any batch may be made of events of a single type
+    std::initializer_list<int>{(std::get<std::vector<Events>>(output_).resize(output_batch_size_), 0)...};
+    if (tag_sources_) {
+        output_sources_.resize(output_batch_size_);
+    }
+    reset();
+}
+
+template<typename... Events>
+TimestampMergeAlgorithm<Events...>::TimestampMergeAlgorithm(std::size_t n_inputs, const OutputCallback &output_cb,
+                                                            std::size_t output_batch_size, bool tag_sources) :
+    TimestampMergeAlgorithm(std::array<std::size_t, n_event_types>{{n_inputs}}, output_cb, output_batch_size,
+                            tag_sources) {
+    static_assert(n_event_types == 1, "The number of inputs must be given for each type of events.");
+}
+
+template<typename... Events>
+template<typename EventT>
+void TimestampMergeAlgorithm<Events...>::process_events(std::size_t input, const EventT *begin, const EventT *end) {
+    constexpr std::size_t type = detail::merge_type_index<EventT, Events...>::value;
+    static_assert(type < n_event_types, "Timestamp merge does not merge this type of events.");
+    if (input >= inputs_.size()) {
+        throw std::invalid_argument("Timestamp merge input index out of range.");
+    }
+    Input &in = inputs_[input];
+    if (in.closed_) {
+        throw std::invalid_argument("Timestamp merge input is closed.");
+    }
+    if (in.type_ != type) {
+        throw std::invalid_argument("Timestamp merge input expects another type of events.");
+    }
+    if (begin == end) {
+        return;
+    }
+    if (begin->t < in.bound_) {
+        throw std::invalid_argument("Timestamp merge expects the events of each input to be sorted by timestamps.");
+    }
+    if (begin->t == std::numeric_limits<timestamp>::min() ||
+        std::prev(end)->t == std::numeric_limits<timestamp>::max()) {
+        throw std::invalid_argument("Timestamp merge reserves the min and max timestamps.");
+    }
+
+    if (ends_[input] == nullptr) {
+        // The input had no events left, so the tree must be built again with its new head
+        if (tree_valid_) {
+            for (const Node &node : tree_) {
+                leaves_[node.leaf] = node;
+            }
+            tree_valid_ = false;
+        }
+        leaves_[input] = Node{begin->t, begin, input};
+        ends_[input]   = end;
+    } else {
+        in.queued_.push_back(Span{begin, end});
+    }
+    in.bound_ = std::prev(end)->t;
+    merge(get_watermark());
+}
+
+template<typename... Events>
+void TimestampMergeAlgorithm<Events...>::advance_input(std::size_t input, timestamp ts) {
+    if (input >= inputs_.size()) {
+        throw std::invalid_argument("Timestamp merge input index out of range.");
+    }
+    inputs_[input].bound_ = std::max(inputs_[input].bound_, ts);
+    merge(get_watermark());
+}
+
+template<typename... Events>
+void TimestampMergeAlgorithm<Events...>::close_input(std::size_t input) {
+    if (input >= inputs_.size()) {
+        throw std::invalid_argument("Timestamp merge input index out of range.");
+    }
+    inputs_[input].closed_ = true;
+    merge(get_watermark());
+}
+
+template<typename... Events>
+void TimestampMergeAlgorithm<Events...>::flush() {
+    merge(std::numeric_limits<timestamp>::max());
+    if (n_output_total_ > 0) {
+        output_batch();
+    }
+}
+
+template<typename... Events>
+void TimestampMergeAlgorithm<Events...>::reset() {
+    std::fill(ends_.begin(), ends_.end(), nullptr);
+    for (Input &in : inputs_) {
+        in.queued_.clear();
+        in.bound_  = std::numeric_limits<timestamp>::min();
+        in.closed_ = false;
+    }
+    for (std::size_t leaf = 0; leaf < n_leaves_; ++leaf) {
+        leaves_[leaf] = Node{std::numeric_limits<timestamp>::max(), nullptr, leaf};
+    }
+    tree_valid_ = false;
+    n_output_events_.fill(0);
+    n_output_total_ = 0;
+}
+
+template<typename... Events>
+timestamp TimestampMergeAlgorithm<Events...>::get_watermark() const {
+    timestamp watermark = std::numeric_limits<timestamp>::max();
+    for (const Input &in : inputs_) {
+        if (!in.closed_) {
+            watermark = std::min(watermark, in.bound_);
+        }
+    }
+    return watermark;
+}
+
+template<typename... Events>
+std::size_t TimestampMergeAlgorithm<Events...>::get_pending_events_count() const {
+    std::size_t n_events = 0;
+    for (const Node &node : tree_valid_ ? tree_ : leaves_) {
+        if (node.cursor == nullptr) {
+            continue;
+        }
+        const Input &in = inputs_[node.leaf];
+        n_events += count(in.type_, Span{node.cursor, ends_[node.leaf]}, std::integral_constant<std::size_t, 0>());
+    }
+    for (const Input &in : inputs_) {
+        for (const Span &span : in.queued_) {
+            n_events += count(in.type_, span, std::integral_constant<std::size_t, 0>());
+        }
+    }
+    return n_events;
+}
+
+template<typename... Events>
+template<std::size_t I>
+std::size_t TimestampMergeAlgorithm<Events...>::count(std::size_t type, const Span &span,
+                                                      std::integral_constant<std::size_t, I>) const {
+    if (type != I) {
+        return count(type, span, std::integral_constant<std::size_t, I + 1>());
+    }
+    return static_cast<const EventType<I> *>(span.end) - static_cast<const EventType<I> *>(span.begin);
+}
+
+template<typename... Events>
+std::size_t TimestampMergeAlgorithm<Events...>::count(std::size_t, const Span &,
+                                                      std::integral_constant<std::size_t, n_event_types>) const {
+    return 0;
+}
+
+template<typename... Events>
+void TimestampMergeAlgorithm<Events...>::build_tree() {
+    const auto precedes = [this](std::size_t lhs, std::size_t rhs) {
+        return leaves_[lhs].head < leaves_[rhs].head || (leaves_[lhs].head == leaves_[rhs].head && lhs < rhs);
+    };
+    std::iota(winners_.begin() + n_leaves_, winners_.end(), std::size_t(0));
+    for (std::size_t node = n_leaves_ - 1; node > 0; --node) {
+        const std::size_t lhs = winners_[2 * node], rhs = winners_[2 * node + 1];
+        const bool lhs_wins   = precedes(lhs, rhs);
+        winners_[node]        = lhs_wins ? lhs : rhs;
+        tree_[node]           = leaves_[lhs_wins ? rhs : lhs];
+    }
+    tree_[0]    = leaves_[winners_[1]];
+    tree_valid_ = true;
+}
+
+template<typename... Events>
+void TimestampMergeAlgorithm<Events...>::merge(timestamp watermark) {
+    if (!tree_valid_) {
+        build_tree();
+    }
+
+    // Merges the next event of the winner and replays the matches on its path. The order of the inputs is data
+    // dependent and changes at almost every event when the inputs are interleaved, so the matches are replayed without
+    // branches, the winner being kept out of memory. The tree is kept between calls: it only changes when an input
+    // without events left receives new ones
+    Node *const tree           = tree_.data();
+    const std::size_t n_leaves = n_leaves_;
+    Node winner                = tree[0];
+    OutputPosition position{n_output_events_, n_output_total_};
+    while (winner.head < watermark) {
+        pop(winner, position, std::integral_constant<std::size_t, 0>());
+
+        // The loser of a match comes from the other subtree than the winner, so it has the lower index and wins the
+        // ties if and only if the winner comes from the right subtree. No event has the min timestamp, so this is
+        // a single comparison
+        for (std::size_t child = winner.leaf + n_leaves; child > 1; child /= 2) {
+            Node &match      = tree[child / 2];
+            const Node loser = match;
+            const bool swap  = loser.head - static_cast<timestamp>(child & 1) < winner.head;
+            match.head       = detail::select_without_branch(swap, winner.head, loser.head);
+            match.cursor     = detail::select_without_branch(swap, winner.cursor, loser.cursor);
+            match.leaf       = detail::select_without_branch(swap, winner.leaf, loser.leaf);
+            winner.head      = detail::select_without_branch(swap, loser.head, winner.head);
+            winner.cursor    = detail::select_without_branch(swap, loser.cursor, winner.cursor);
+            winner.leaf      = detail::select_without_branch(swap, loser.leaf, winner.leaf);
+        }
+
+        if (position.n_total == output_batch_size_) {
+            n_output_events_ = position.n_events;
+            n_output_total_  = position.n_total;
+            output_batch();
+            position = OutputPosition{n_output_events_, n_output_total_};
+        }
+    }
+    tree[0]          = winner;
+    n_output_events_ = position.n_events;
+    n_output_total_  = position.n_total;
+}
+
+template<typename... Events>
+template<std::size_t I>
+void TimestampMergeAlgorithm<Events...>::pop(Node &node, OutputPosition &position,
+                                             std::integral_constant<std::size_t, I>) {
+    if (I + 1 < n_event_types && inputs_[node.leaf].type_ != I) {
+        pop(node, position, std::integral_constant<std::size_t, I + 1>());
+        return;
+    }
+
+    using EventT                                  = EventType<I>;
+    const EventT *ev                              = static_cast<const EventT *>(node.cursor);
+    std::get<I>(output_)[position.n_events[I]++] = *ev;
+    if (tag_sources_) {
+        output_sources_[position.n_total] = static_cast<std::uint32_t>(node.leaf);
+    }
+    ++position.n_total;
+
+    ++ev;
+    if (ev == ends_[node.leaf]) {
+        next_buffer<EventT>(node);
+        return;
+    }
+    node.cursor = ev;
+    node.head   = ev->t;
+}
+
+template<typename... Events>
+void TimestampMergeAlgorithm<Events...>::pop(Node &, OutputPosition &,
+                                             std::integral_constant<std::size_t, n_event_types>) {
+    // Never called, the type of an input being one of Events
+}
+
+template<typename... Events>
+template<typename EventT>
+void TimestampMergeAlgorithm<Events...>::next_buffer(Node &node) {
+    std::deque<Span> &queued = inputs_[node.leaf].queued_;
+    if (queued.empty()) {
+        node.head          = std::numeric_limits<timestamp>::max();
+        node.cursor        = nullptr;
+        ends_[node.leaf]   = nullptr;
+        return;
+    }
+    node.head        = static_cast<const EventT *>(queued.front().begin)->t;
+    node.cursor      = queued.front().begin;
+    ends_[node.leaf] = queued.front().end;
+    queued.pop_front();
+}
+
+template<typename... Events>
+void TimestampMergeAlgorithm<Events...>::output_batch() {
+    output_cb_(OutputBatch(*this));
+    n_output_events_.fill(0);
+    n_output_total_ = 0;
+}
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_CORE_DETAIL_TIMESTAMP_MERGE_ALGORITHM_IMPL_H
@@ -0,0 +1,117 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_CORE_EVENT_RATE_CONTROLLER_ALGORITHM_H
+#define METAVISION_SDK_CORE_EVENT_RATE_CONTROLLER_ALGORITHM_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "metavision/sdk/base/utils/timestamp.h"
+
+namespace Metavision {
+
+/// @brief Class that limits the rate of events, as the Event Rate Controller (ERC) of the sensors does in hardware
+///
+/// Time is split into count periods of fixed duration, in which at most @ref get_cd_event_count events are propagated.
+/// As on the sensor, the ratio of events to drop in a count period is derived from the number of events received
+/// during the previous one. Rather than truncating the count periods, the events are dropped uniformly in space and
+/// time: each event is kept or dropped depending on a hash of its coordinates and timestamp, compared to the ratio of
+/// events to keep. The output is thus deterministic, and doesn't depend on how the stream is split into buffers.
+///
+/// The number of events propagated in a count period is still capped to @ref get_cd_event_count, for the count periods
+/// following a sudden increase of the event rate.
+class EventRateControllerAlgorithm {
+public:
+    /// @brief Builds a new EventRateControllerAlgorithm object
+    /// @param events_per_sec Target event rate, expressed in events per second
+    /// @param count_period_us Duration of the count periods, in us
+    /// @throw std::invalid_argument if the count period is 0
+    EventRateControllerAlgorithm(std::uint32_t events_per_sec, std::uint32_t count_period_us = 200);
+
+    /// @brief Default destructor
+    ~EventRateControllerAlgorithm() = default;
+
+    /// @brief Propagates the events not dropped by the rate controller
+    /// @tparam InputIt Read-Only input event iterator type. Works for iterators over buffers of @ref EventCD
+    /// or equivalent
+    /// @tparam OutputIt Read-Write output event iterator type. Works for iterators over containers of @ref EventCD
+    /// or equivalent
+    /// @param it_begin Iterator to first input event
+    /// @param it_end Iterator to the past-the-end event
+    /// @param inserter Output iterator or back inserter
+    /// @return Iterator pointing to the past-the-end event added in the output
+    template<class InputIt, class OutputIt>
+    inline OutputIt process_events(InputIt it_begin, InputIt it_end, OutputIt inserter);
+
+    /// @brief Toggles the rate controller activation
+    /// @param b Desired state. When inactive, all the events are propagated
+    void enable(bool b);
+
+    /// @brief Returns the rate controller activation state
+    /// @return The rate controller state
+    bool is_enabled() const;
+
+    /// @brief Sets the target event rate
+    /// @param events_per_sec Event rate expressed in events per second
+    /// @note This method and @ref set_cd_event_count operate over the same parameter, converted with the count period
+    void set_cd_event_rate(std::uint32_t events_per_sec);
+
+    /// @brief Gets the target event rate
+    /// @return The event rate expressed in events per second
+    std::uint32_t get_cd_event_rate() const;
+
+    /// @brief Gets the count period
+    /// @return The count period duration expressed in microseconds
+    std::uint32_t get_count_period() const;
+
+    /// @brief Sets the maximum number of events to propagate over the count period
+    /// @param event_count The desired maximum number of events per count period
+    void set_cd_event_count(std::uint32_t event_count);
+
+    /// @brief Gets the maximum number of events propagated over the count period
+    /// @return The maximum event count
+    std::uint32_t get_cd_event_count() const;
+
+    /// @brief Resets the internal state, to process events from another stream
+    void reset();
+
+private:
+    /// Number of events processed at once, for which the decisions are computed in a branch-free loop
+    static constexpr std::size_t block_size_ = 256;
+
+    /// Ratio of events kept, as a fixed point number with 24 fractional bits
+    static constexpr std::uint32_t keep_all_threshold_ = 1u << 24;
+
+    /// Hash of the coordinates and timestamp of an event, whose 24 most significant bits are compared to the ratio of
+    /// events to keep
+    template<typename Event>
+    static inline std::uint32_t hash(const Event &ev);
+
+    void start_count_period(timestamp t);
+
+    bool enabled_{true};
+    std::uint32_t count_period_{0};
+    std::uint32_t event_count_{0};
+
+    bool has_count_period_{false};
+    timestamp count_period_start_{0};
+    std::uint64_t n_events_in_count_period_{0};
+    std::uint32_t n_kept_in_count_period_{0};
+    std::uint32_t threshold_{keep_all_threshold_};
+    std::uint8_t keep_[block_size_];
+};
+
+} // namespace Metavision
+
+#include "metavision/sdk/core/algorithms/detail/event_rate_controller_algorithm_impl.h"
+
+#endif // METAVISION_SDK_CORE_EVENT_RATE_CONTROLLER_ALGORITHM_H
@@ -0,0 +1,221 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_CORE_EVENT_TO_TENSOR_ALGORITHM_H
+#define METAVISION_SDK_CORE_EVENT_TO_TENSOR_ALGORITHM_H
+
+#include <cstddef>
+#include <opencv2/core/cvdef.h>
+
+#include "metavision/sdk/base/utils/timestamp.h"
+
+namespace Metavision {
+
+/// @brief Base class of the algorithms building tensors from events, to feed machine learning models
+///
+/// A tensor is built from the events of a time slice, and is stored in CHW order, i.e. as C channels of height x width
+/// float values, in a buffer provided by the caller. A sequence of T consecutive slices is stored as T such tensors,
+/// i.e. in TCHW order. The values can be stored as float32 (float) or float16 (cv::float16_t), and are always
+/// accumulated as float32.
+///
+/// The events must be sorted by timestamps and accessed through random access iterators, as the events of each time
+/// bin (the events contributing to a tensor, or to a group of channels of a tensor) are looked for by binary search.
+/// The time bins are then filled in parallel, each one by a single thread.
+///
+/// @tparam Impl Derived class, which defines how the time bins are filled
+template<typename Impl>
+class EventToTensorAlgorithm {
+public:
+    /// @brief Returns the sensor's width
+    int get_width() const {
+        return width_;
+    }
+
+    /// @brief Returns the sensor's height
+    int get_height() const {
+        return height_;
+    }
+
+    /// @brief Returns the number of channels of a tensor
+    int get_num_channels() const {
+        return channels_per_time_bin_ * time_bins_per_slice_;
+    }
+
+    /// @brief Returns the number of values of a tensor, i.e. channels x height x width
+    std::size_t get_tensor_size() const {
+        return static_cast<std::size_t>(get_num_channels()) * height_ * width_;
+    }
+
+    /// @brief Sets the maximum number of time bins filled in parallel
+    /// @param max_threads Maximum number of threads. If 0, the number of threads used by OpenCV is used (default)
+    void set_max_threads(int max_threads) {
+        max_threads_ = max_threads;
+    }
+
+    /// @brief Returns the maximum number of time bins filled in parallel
+    int get_max_threads() const {
+        return max_threads_;
+    }
+
+    /// @brief Builds the tensor of the events of [start_ts, start_ts + duration[
+    /// @tparam RandomIt Random access iterator on events sorted by timestamps
+    /// @tparam T Type of the values of the tensor, float or cv::float16_t
+    /// @param it_begin First event to process
+    /// @param it_end Past-the-end event to process
+    /// @param start_ts Start of the time slice
+    /// @param duration Duration of the time slice, in us
+    /// @param tensor Tensor to overwrite, of @ref get_tensor_size values
+    /// @throw std::invalid_argument if @p duration isn't strictly positive
+    template<typename RandomIt, typename T>
+    void generate(RandomIt it_begin, RandomIt it_end, timestamp start_ts, timestamp duration, T *tensor) const;
+
+    /// @brief Builds the tensors of the events of @p n_slices consecutive time slices, starting at @p start_ts
+    /// @tparam RandomIt Random access iterator on events sorted by timestamps
+    /// @tparam T Type of the values of the tensors, float or cv::float16_t
+    /// @param it_begin First event to process
+    /// @param it_end Past-the-end event to process
+    /// @param start_ts Start of the first time slice
+    /// @param slice_duration Duration of each time slice, in us
+    /// @param n_slices Number of time slices
+    /// @param tensors Tensors to overwrite, of @p n_slices x @ref get_tensor_size values
+    /// @throw std::invalid_argument if @p slice_duration or @p n_slices isn't strictly positive
+    template<typename RandomIt, typename T>
+    void generate(RandomIt it_begin, RandomIt it_end, timestamp start_ts, timestamp slice_duration, int n_slices,
+                  T *tensors) const;
+
+protected:
+    /// @brief Constructor
+    /// @param width Sensor's width
+    /// @param height Sensor's height
+    /// @param channels_per_time_bin Number of channels filled from the events of a time bin
+    /// @param time_bins_per_slice Number of time bins of a time slice
+    /// @throw std::invalid_argument if one of the parameters isn't strictly positive
+    EventToTensorAlgorithm(int width, int height, int channels_per_time_bin, int time_bins_per_slice);
+
+    /// @brief Returns the events of [begin_ts, end_ts[
+    template<typename RandomIt>
+    static void find_events(RandomIt &it_begin, RandomIt &it_end, timestamp begin_ts, timestamp end_ts);
+
+    int width_;
+    int height_;
+
+private:
+    int channels_per_time_bin_;
+    int time_bins_per_slice_;
+    int max_threads_{0};
+};
+
+/// @brief Builds 2-channel histograms: the number of OFF events (channel 0) and ON events (channel 1) at each pixel
+///
+/// When a maximum count is set, the counts are clipped to it and normalized to [0, 1].
+class HistogramTensorAlgorithm : public EventToTensorAlgorithm<HistogramTensorAlgorithm> {
+public:
+    /// @brief Constructor
+    /// @param width Sensor's width
+    /// @param height Sensor's height
+    /// @param max_count Maximum number of events counted at a pixel, or 0 to keep the raw counts
+    /// @throw std::invalid_argument if the size of the sensor isn't strictly positive, or if @p max_count is negative
+    HistogramTensorAlgorithm(int width, int height, float max_count = 0.f);
+
+    /// @brief Returns the maximum number of events counted at a pixel, or 0 if the raw counts are kept
+    float get_max_count() const;
+
+private:
+    friend class EventToTensorAlgorithm<HistogramTensorAlgorithm>;
+
+    template<typename RandomIt>
+    void fill_time_bin(RandomIt it_begin, RandomIt it_end, timestamp slice_ts, timestamp slice_duration, int time_bin,
+                       float *values) const;
+
+    float max_count_;
+};
+
+/// @brief Builds 1-channel difference images: the number of ON events minus the number of OFF events at each pixel
+///
+/// When a maximum count is set, the differences are clipped to [-max_count, max_count] and normalized to [-1, 1].
+class DifferenceTensorAlgorithm : public EventToTensorAlgorithm<DifferenceTensorAlgorithm> {
+public:
+    /// @brief Constructor
+    /// @param width Sensor's width
+    /// @param height Sensor's height
+    /// @param max_count Maximum absolute difference, or 0 to keep the raw differences
+    /// @throw std::invalid_argument if the size of the sensor isn't strictly positive, or if @p max_count is negative
+    DifferenceTensorAlgorithm(int width, int height, float max_count = 0.f);
+
+    /// @brief Returns the maximum absolute difference, or 0 if the raw differences are kept
+    float get_max_count() const;
+
+private:
+    friend class EventToTensorAlgorithm<DifferenceTensorAlgorithm>;
+
+    template<typename RandomIt>
+    void fill_time_bin(RandomIt it_begin, RandomIt it_end, timestamp slice_ts, timestamp slice_duration, int time_bin,
+                       float *values) const;
+
+    float max_count_;
+};
+
+/// @brief Builds voxel grids: the time slice is split in B bins, one per channel, and each event adds its polarity
+/// (-1 or 1) to the two bins closest to its timestamp, with linear interpolation weights
+///
+/// The values are the same as the ones of metavision_core_ml.preprocessing.event_to_tensor_torch.event_volume in
+/// bilinear mode: an event at t has a normalized time t* = (t - start_ts) * B / duration - 0.5, and contributes to
+/// the bins floor(t*) and floor(t*) + 1, both clamped to [0, B - 1].
+///
+/// The bins of a time slice are filled in parallel.
+class VoxelGridTensorAlgorithm : public EventToTensorAlgorithm<VoxelGridTensorAlgorithm> {
+public:
+    /// @brief Constructor
+    /// @param width Sensor's width
+    /// @param height Sensor's height
+    /// @param n_bins Number of time bins of a time slice
+    /// @throw std::invalid_argument if one of the parameters isn't strictly positive
+    VoxelGridTensorAlgorithm(int width, int height, int n_bins);
+
+    /// @brief Returns the number of time bins of a time slice
+    int get_num_bins() const;
+
+private:
+    friend class EventToTensorAlgorithm<VoxelGridTensorAlgorithm>;
+
+    template<typename RandomIt>
+    void fill_time_bin(RandomIt it_begin, RandomIt it_end, timestamp slice_ts, timestamp slice_duration, int time_bin,
+                       float *values) const;
+
+    int n_bins_;
+};
+
+/// @brief Builds 2-channel timestamp tensors: the normalized timestamp of the last OFF event (channel 0) and of the
+/// last ON event (channel 1) at each pixel
+///
+/// An event at t in [start_ts, start_ts + duration[ is stored as (t - start_ts + 1) / duration, in ]0, 1]. Pixels
+/// without events are set to 0.
+class TimestampTensorAlgorithm : public EventToTensorAlgorithm<TimestampTensorAlgorithm> {
+public:
+    /// @brief Constructor
+    /// @param width Sensor's width
+    /// @param height Sensor's height
+    /// @throw std::invalid_argument if the size of the sensor isn't strictly positive
+    TimestampTensorAlgorithm(int width, int height);
+
+private:
+    friend class EventToTensorAlgorithm<TimestampTensorAlgorithm>;
+
+    template<typename RandomIt>
+    void fill_time_bin(RandomIt it_begin, RandomIt it_end, timestamp slice_ts, timestamp slice_duration, int time_bin,
+                       float *values) const;
+};
+
+} // namespace Metavision
+
+#include "metavision/sdk/core/algorithms/detail/event_to_tensor_algorithm_impl.h"
+
+#endif // METAVISION_SDK_CORE_EVENT_TO_TENSOR_ALGORITHM_H
@@ -0,0 +1,116 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_CORE_EVENTS_SLICER_ALGORITHM_H
+#define METAVISION_SDK_CORE_EVENTS_SLICER_ALGORITHM_H
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+#include "metavision/sdk/base/utils/timestamp.h"
+#include "metavision/sdk/core/algorithms/async_algorithm.h"
+
+namespace Metavision {
+
+/// @brief Slice of events produced by @ref EventsSlicerAlgorithm
+///
+/// A slice doesn't own its events: it refers either to the buffer passed to
+/// @ref EventsSlicerAlgorithm::process_events, or to the internal buffer of the slicer when its events span several
+/// input buffers. It is only valid during the call to the slice callback.
+///
+/// @tparam EventT The type of events of the slice
+template<typename EventT>
+struct EventsSlice {
+    const EventT *begin_; ///< First event of the slice
+    const EventT *end_;   ///< Past-the-end event of the slice
+    timestamp ts_;        ///< Timestamp of the slice, as passed to process_async by @ref AsyncAlgorithm
+
+    const EventT *begin() const {
+        return begin_;
+    }
+
+    const EventT *end() const {
+        return end_;
+    }
+
+    std::size_t size() const {
+        return static_cast<std::size_t>(end_ - begin_);
+    }
+
+    bool empty() const {
+        return begin_ == end_;
+    }
+};
+
+/// @brief Class that slices buffers of events according to a processing policy (e.g. AsyncAlgorithm::Processing from
+/// @ref AsyncAlgorithm), without copying them
+///
+/// Each slice is passed to a callback as a view (@ref EventsSlice) on the input buffer. Only the events of a slice
+/// that spans several input buffers are copied: the events at the end of an input buffer that don't complete a slice
+/// are kept in a carry buffer, to which the beginning of the next input buffer is appended when the slice completes.
+///
+/// The slices are the same as the buffers produced by @ref SharedEventsBufferProducerAlgorithm with the same
+/// processing policy, and may be empty when a time slice holds no event.
+///
+/// @tparam EventT The type of events to slice
+template<typename EventT>
+class EventsSlicerAlgorithm : public AsyncAlgorithm<EventsSlicerAlgorithm<EventT>> {
+public:
+    using Slice           = EventsSlice<EventT>;
+    using SliceCallback   = std::function<void(const Slice &)>; ///< Alias of callback to process a slice
+    using AsyncAlgorithmT = AsyncAlgorithm<EventsSlicerAlgorithm<EventT>>;
+
+    /// @brief Constructor
+    ///
+    /// The processing policy is SYNC by default, and is set with the set_processing_* functions of
+    /// @ref AsyncAlgorithm.
+    ///
+    /// @param slice_cb Callback called whenever a slice is complete
+    EventsSlicerAlgorithm(SliceCallback slice_cb);
+
+    /// @brief Processes a buffer of events
+    /// @param it_begin First event to process
+    /// @param it_end Past-the-end event to process
+    inline void process_events(const EventT *it_begin, const EventT *it_end);
+
+    /// @brief Processes a buffer of events
+    /// @param ts End timestamp of the buffer. Used if higher than the timestamp of the last event
+    /// @param it_begin First event to process
+    /// @param it_end Past-the-end event to process
+    inline void process_events(const timestamp ts, const EventT *it_begin, const EventT *it_end);
+
+    /// @brief Returns the number of events of the incomplete slice copied in the carry buffer
+    std::size_t carried_events_count() const;
+
+private:
+    /// @brief Extends the current slice to the processed events
+    inline void process_online(const EventT *it_begin, const EventT *it_end);
+
+    /// @brief Calls the callback with the current slice
+    inline void process_async(const timestamp processing_ts, const size_t n_processed_events);
+
+    /// @brief Copies the events of the incomplete slice in the carry buffer, before the input buffer is released
+    inline void carry_pending_events();
+
+    SliceCallback slice_cb_;
+    std::vector<EventT> carry_;            ///< Events of the current slice from previous input buffers
+    const EventT *pending_begin_{nullptr}; ///< First event of the current slice in the input buffer
+    const EventT *pending_end_{nullptr};   ///< Past-the-end event of the current slice in the input buffer
+
+    friend AsyncAlgorithmT;
+};
+
+} // namespace Metavision
+
+#include "metavision/sdk/core/algorithms/detail/events_slicer_algorithm_impl.h"
+
+#endif // METAVISION_SDK_CORE_EVENTS_SLICER_ALGORITHM_H
@@ -0,0 +1,116 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_CORE_FILTER_CHAIN_ALGORITHM_H
+#define METAVISION_SDK_CORE_FILTER_CHAIN_ALGORITHM_H
+
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "metavision/sdk/core/algorithms/mask_filter_algorithm.h"
+#include "metavision/sdk/core/algorithms/roi_filter_algorithm.h"
+
+namespace Metavision {
+
+/// @brief Class that applies a sequence of filters to events in a single pass
+///
+/// Running e.g. @ref RoiFilterAlgorithm, @ref PolarityFilterAlgorithm and @ref FlipXAlgorithm one after the other
+/// requires a pass over the events and an intermediate buffer per algorithm. This class merges them at compile time so
+/// that each event is read once, goes through all the filters, and is written directly to the output if all of them
+/// accept it.
+///
+/// The filters are applied in the order they are given, each one seeing the event as modified by the previous ones.
+/// A filter can be:
+/// - a predicate, called with a const reference to the event and returning a bool: the event is dropped if it returns
+///   false (e.g. @ref PolarityFilterAlgorithm)
+/// - a transform, called with a reference to the event and returning void (e.g. @ref FlipXAlgorithm,
+///   @ref FlipYAlgorithm or @ref PolarityInverterAlgorithm)
+/// - a @ref RoiFilterAlgorithm or a @ref MaskFilterAlgorithm, which is a predicate followed by a transform when it
+///   outputs relative coordinates
+///
+/// @tparam Filters Types of the filters, stored by value
+template<typename... Filters>
+class FilterChainAlgorithm {
+public:
+    static_assert(sizeof...(Filters) > 0, "A filter chain needs at least one filter");
+
+    /// @brief Builds a new filter chain
+    /// @param filters Filters to apply, in order
+    explicit FilterChainAlgorithm(Filters... filters);
+
+    /// @brief Applies the filters to the given input buffer storing the result in the output buffer
+    /// @tparam InputIt Read-Only input event iterator type. Works for iterators over buffers of @ref EventCD
+    /// or equivalent
+    /// @tparam OutputIt Read-Write output event iterator type. Works for iterators over containers of @ref EventCD
+    /// or equivalent
+    /// @param it_begin Iterator to first input event
+    /// @param it_end Iterator to the past-the-end event
+    /// @param inserter Output iterator or back inserter
+    /// @return Iterator pointing to the past-the-end event added in the output
+    template<class InputIt, class OutputIt>
+    inline OutputIt process_events(InputIt it_begin, InputIt it_end, OutputIt inserter) const;
+
+    /// @brief Applies the filters to the given buffer, in place
+    ///
+    /// The accepted events are moved to the beginning of the buffer, in the same order, like with std::remove_if.
+    ///
+    /// @tparam It Read-Write event iterator type
+    /// @param it_begin Iterator to first event
+    /// @param it_end Iterator to the past-the-end event
+    /// @return Iterator pointing to the past-the-end accepted event
+    template<class It>
+    inline It process_events_in_place(It it_begin, It it_end) const;
+
+    /// @brief Applies the filters to a single event
+    /// @param ev Event to be updated
+    /// @return true if the event is accepted by all the filters, false otherwise
+    template<typename Event>
+    inline bool operator()(Event &ev) const;
+
+    /// @brief Returns the filter at the given position in the chain
+    /// @tparam I Position of the filter
+    /// @return The filter at position @p I
+    template<std::size_t I>
+    inline std::tuple_element_t<I, std::tuple<Filters...>> &get();
+
+    /// @brief Returns the filter at the given position in the chain
+    /// @tparam I Position of the filter
+    /// @return The filter at position @p I
+    template<std::size_t I>
+    inline const std::tuple_element_t<I, std::tuple<Filters...>> &get() const;
+
+private:
+    template<typename Event>
+    inline bool apply(Event &ev, std::integral_constant<std::size_t, sizeof...(Filters)>) const;
+
+    template<typename Event, std::size_t I>
+    inline bool apply(Event &ev, std::integral_constant<std::size_t, I>) const;
+
+    std::tuple<Filters...> filters_;
+};
+
+/// @brief Builds a filter chain from the given filters
+///
+/// For example, make_filter_chain(RoiFilterAlgorithm(0, 0, 319, 239), PolarityFilterAlgorithm(1),
+/// FlipXAlgorithm(319)) keeps the positive events of the ROI, then flips them.
+///
+/// @param filters Filters to apply, in order
+/// @return The filter chain
+template<typename... Filters>
+inline FilterChainAlgorithm<std::decay_t<Filters>...> make_filter_chain(Filters &&...filters);
+
+} // namespace Metavision
+
+#include "metavision/sdk/core/algorithms/detail/filter_chain_algorithm_impl.h"
+
+#endif // METAVISION_SDK_CORE_FILTER_CHAIN_ALGORITHM_H
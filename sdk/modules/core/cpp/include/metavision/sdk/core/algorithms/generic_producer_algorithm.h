@@ -12,6 +12,7 @@
 #ifndef METAVISION_SDK_CORE_GENERIC_PRODUCER_ALGORITHM_H
 #define METAVISION_SDK_CORE_GENERIC_PRODUCER_ALGORITHM_H
 
+#include <algorithm>
 #include <limits>
 #include <mutex>
 #include <atomic>
@@ -59,7 +60,6 @@ public:
     GenericProducerAlgorithm(timestamp timeout = 0, uint32_t max_events_per_second = 0,
                              timestamp max_duration_stored   = std::numeric_limits<timestamp>::max(),
                              bool allow_drop_when_overfilled = false) :
-        ring_event_(256, false),
         timeout_(timeout),
         max_events_per_microseconds_(static_cast<float>(max_events_per_second) / 1000000),
         max_duration_stored_(max_duration_stored),
@@ -96,7 +96,7 @@ public:
                     if (allow_drop_when_overfilled_) {
                         // consider increasing the `max_duration_stored` if this message shows up too often
                         MV_SDK_LOG_WARNING() << "Too many events already queued, dropping the oldest ones...";
-                        clear_and_enqueue(start, end, (end - 1)->t - max_duration_stored_);
+                        drop_and_enqueue(start, end);
                     } else {
                         throw std::runtime_error(
                             "Range of events to insert is too big : max_duration < diff(start, end). max_duration = " +
@@ -109,17 +109,16 @@ public:
                                           "fit in the ring";
                     MV_SDK_LOG_DEBUG() << "GenericProducerAlgorithm: ring.data_available():"
                                        << ring_event_.data_available();
-                    MV_SDK_LOG_DEBUG() << "GenericProducerAlgorithm: ring first time:" << ring_event_.get_first_time()
+                    MV_SDK_LOG_DEBUG() << "GenericProducerAlgorithm: ring first time:" << get_first_time_stored()
                                        << "ring last time:" << ring_event_.get_last_time();
                     MV_SDK_LOG_DEBUG() << "GenericProducerAlgorithm: diff from ring first to last event to add:"
-                                       << (end - 1)->t - ring_event_.get_first_time();
-                    if (ring_event_.data_available() &&
-                        (end - 1)->t - ring_event_.get_first_time() > max_duration_stored_) {
+                                       << (end - 1)->t - get_first_time_stored();
+                    if (ring_event_.data_available() && (end - 1)->t - get_first_time_stored() > max_duration_stored_) {
                         // ... but there are already too many events
                         if (allow_drop_when_overfilled_) {
                             // consider increasing the `max_duration_stored` if this message shows up too often
                             MV_SDK_LOG_TRACE() << "Too many events already queued, dropping the oldest ones...";
-                            clear_and_enqueue(start, end);
+                            drop_and_enqueue(start, end);
                         } else {
                             // we can't drop, the range is OK but there are too many elements already inserted ...
                             // wait until we can insert the whole range
@@ -167,16 +166,20 @@ public:
                 wait_to_dequeue(ts);
             }
         }
-        float max_events_per_deltat = max_events_per_microseconds_;
-        if (max_events_per_deltat > 0) {
-            max_events_per_deltat *= ts - last_processed_ts_;
-            dequeue_with_drop(inserter, ts, max_events_per_deltat);
-        } else {
-            dequeue(inserter, ts);
+        {
+            std::unique_lock<std::mutex> lock(consumer_mut_);
+            drop_if_requested();
+            float max_events_per_deltat = max_events_per_microseconds_;
+            if (max_events_per_deltat > 0) {
+                max_events_per_deltat *= ts - last_processed_ts_;
+                ring_event_.fill_buffer_to_drop_max_events(inserter, ts, max_events_per_deltat);
+            } else {
+                ring_event_.fill_buffer_to(inserter, ts);
+            }
         }
         last_processed_ts_ = ts;
         MV_SDK_LOG_DEBUG() << "GenericProducerAlgorithm: before overfilled_wait_cond_.notify_all()";
-        overfilled_wait_cond_.notify_all();
+        notify_producer();
         MV_SDK_LOG_DEBUG() << "--> GenericProducerAlgorithm::process() with ts:" << ts;
     }
 
@@ -277,65 +280,94 @@ private:
             if (Metavision::LogLevel::Debug >= getLogLevel()) {
                 bool ring_event_data_not_available = !ring_event_.data_available();
                 bool last_minus_first_smaller_than_max_duration_stored =
-                    ((end - 1)->t - ring_event_.get_first_time() <= max_duration_stored_);
+                    ((end - 1)->t - get_first_time_stored() <= max_duration_stored_);
                 bool source_is_done = this->source_is_done_;
                 MV_SDK_LOG_DEBUG() << Log::function << "ring_event_data_not_available:" << ring_event_data_not_available
                                    << "last_minus_first_smaller_than_max_duration_stored:"
                                    << last_minus_first_smaller_than_max_duration_stored
-                                   << "ring_event_.get_first_time():" << ring_event_.get_first_time()
-                                   << "(end - 1)->t:" << (end - 1)->t
-                                   << "diff:" << (end - 1)->t - ring_event_.get_first_time()
+                                   << "first time stored:" << get_first_time_stored() << "(end - 1)->t:" << (end - 1)->t
+                                   << "diff:" << (end - 1)->t - get_first_time_stored()
                                    << "max_duration_stored_:" << max_duration_stored_
                                    << "source_is_done:" << source_is_done;
             }
-            return !ring_event_.data_available() ||
-                   (end - 1)->t - ring_event_.get_first_time() <= max_duration_stored_ || this->source_is_done_;
+            return !ring_event_.data_available() || (end - 1)->t - get_first_time_stored() <= max_duration_stored_ ||
+                   this->source_is_done_;
         });
 
         return !this->source_is_done_;
     }
 
-    // empty the ring, then insert from the range [start, end) all events e
-    // such that e.t >= min_start_time
+    // insert from the range [start, end) the events e such that e.t >= (end - 1)->t - max_duration_stored_, and drop
+    // the older events of the ring
     template<typename IteratorEv>
-    void clear_and_enqueue(IteratorEv start, IteratorEv end, timestamp min_start_time = -1) {
-        if (min_start_time >= 0) {
-            EventType ev;
-            ev.t  = min_start_time;
-            start = std::lower_bound(start, end, ev, [](const EventType &ev1, const EventType &ev2) {
-                return Metavision::detail::get_time(ev1) < Metavision::detail::get_time(ev2);
-            });
-        }
+    void drop_and_enqueue(IteratorEv start, IteratorEv end) {
+        const timestamp min_start_time = (end - 1)->t - max_duration_stored_;
+        EventType ev;
+        ev.t  = min_start_time;
+        start = std::lower_bound(start, end, ev, [](const EventType &ev1, const EventType &ev2) {
+            return Metavision::detail::get_time(ev1) < Metavision::detail::get_time(ev2);
+        });
 
+        // Events can only be removed from the ring by the consumer side: the request is made once the events are
+        // added, so that the ring holds events from the requested timestamp when it is handled. It is handled right
+        // away if the consumer is not processing events, so that the ring does not grow while the consumer is stalled,
+        // or by the consumer before it processes events otherwise. The requested timestamp only increases, so that a
+        // request is never replaced by an older one before being handled
+        ring_event_.add(start, end);
+        if (min_start_time > drop_requested_ts_.load(std::memory_order_relaxed)) {
+            drop_requested_ts_.store(min_start_time, std::memory_order_release);
+        }
         {
-            std::unique_lock<std::mutex> lock(underfilled_wait_mut_);
-            std::unique_lock<std::mutex> lock2(overfilled_wait_mut_);
-            ring_event_.drop();
-            ring_event_.add(start, end);
+            std::unique_lock<std::mutex> lock(consumer_mut_, std::try_to_lock);
+            if (lock.owns_lock()) {
+                drop_if_requested();
+            }
         }
         notify_if_needed();
     }
 
     template<typename IteratorEv>
     void enqueue(IteratorEv start, IteratorEv end) {
-        {
-            std::unique_lock<std::mutex> lock(underfilled_wait_mut_);
-            std::unique_lock<std::mutex> lock2(overfilled_wait_mut_);
-            ring_event_.add(start, end);
-        }
+        ring_event_.add(start, end);
         notify_if_needed();
     }
 
+    // The ring is lock free: the mutexes only make sure that a thread can not miss a notification between checking the
+    // ring and starting to wait
     void notify_if_needed() {
-        Metavision::timestamp last_ts   = ring_event_.get_last_time();
-        Metavision::timestamp wanted_ts = wanted_ts_;
-        bool already_notified           = last_notified_ts_ >= wanted_ts;
-        if (!already_notified && wanted_ts <= last_ts) {
+        Metavision::timestamp last_ts = ring_event_.get_last_time();
+        bool notify                   = false;
+        {
+            std::unique_lock<std::mutex> lock(underfilled_wait_mut_);
+            Metavision::timestamp wanted_ts = wanted_ts_;
+            bool already_notified           = last_notified_ts_ >= wanted_ts;
+            notify                          = !already_notified && wanted_ts <= last_ts;
+        }
+        if (notify) {
             underfilled_wait_cond_.notify_all();
             last_notified_ts_ = last_ts;
         }
     }
 
+    void notify_producer() {
+        { std::unique_lock<std::mutex> lock(overfilled_wait_mut_); }
+        overfilled_wait_cond_.notify_all();
+    }
+
+    // Must be called with consumer_mut_ locked
+    void drop_if_requested() {
+        const timestamp ts = drop_requested_ts_.load(std::memory_order_acquire);
+        if (ts > dropped_ts_) {
+            ring_event_.drop_to(ts);
+            dropped_ts_ = ts;
+        }
+    }
+
+    // Timestamp of the first event stored, once the events older than the ones requested to be dropped are dropped
+    timestamp get_first_time_stored() const {
+        return std::max(ring_event_.get_first_time(), drop_requested_ts_.load(std::memory_order_acquire));
+    }
+
     bool wait_to_dequeue_with_timeout(timestamp ts, timestamp timeout) {
         std::unique_lock<std::mutex> lock(underfilled_wait_mut_);
         underfilled_wait_cond_.wait_for(lock, std::chrono::duration<timestamp, std::micro>(timeout_), [this, &ts] {
@@ -356,25 +388,15 @@ private:
                                     [this, &ts] { return ring_event_.get_last_time() >= ts || this->source_is_done_; });
         return !this->source_is_done_;
     }
-    template<typename OutputIt>
-    void dequeue_with_drop(OutputIt inserter, timestamp ts, float max_events_per_deltat) {
-        std::unique_lock<std::mutex> lock(underfilled_wait_mut_);
-        std::unique_lock<std::mutex> lock2(overfilled_wait_mut_);
-        ring_event_.fill_buffer_to_drop_max_events(inserter, ts, max_events_per_deltat);
-    }
-
-    template<typename OutputIt>
-    void dequeue(OutputIt inserter, timestamp ts) {
-        std::unique_lock<std::mutex> lock(underfilled_wait_mut_);
-        std::unique_lock<std::mutex> lock2(overfilled_wait_mut_);
-        ring_event_.fill_buffer_to(inserter, ts);
-    }
 
     Metavision::detail::Ring<EventType> ring_event_;
     std::condition_variable underfilled_wait_cond_;
     mutable std::mutex underfilled_wait_mut_;
     std::condition_variable overfilled_wait_cond_;
     mutable std::mutex overfilled_wait_mut_;
+    // Serializes the functions reading or dropping events from the ring, which are called by the consumer, or by the
+    // producer when the consumer is not processing events
+    std::mutex consumer_mut_;
 
     timestamp last_notified_ts_  = 0;
     timestamp last_processed_ts_ = 0;
@@ -383,6 +405,10 @@ private:
     std::atomic<float> max_events_per_microseconds_{-1};
     std::atomic<timestamp> max_duration_stored_{0};
     std::atomic<bool> allow_drop_when_overfilled_{false};
+    // Timestamp before which the events must be dropped, requested by the producer
+    std::atomic<timestamp> drop_requested_ts_{std::numeric_limits<timestamp>::min()};
+    // Timestamp before which the events have been dropped, guarded by consumer_mut_
+    timestamp dropped_ts_ = std::numeric_limits<timestamp>::min();
 
     bool source_is_done_ = false;
     friend class ::GenericProducerAlgorithm_GTest;
@@ -0,0 +1,208 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_CORE_MASK_FILTER_ALGORITHM_H
+#define METAVISION_SDK_CORE_MASK_FILTER_ALGORITHM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <opencv2/core/types.hpp>
+#include <opencv2/core/mat.hpp>
+
+#include "metavision/sdk/core/algorithms/detail/internal_algorithms.h"
+
+namespace Metavision {
+
+/// @brief Class that only propagates events which are contained in a region of arbitrary shape, defined by a mask
+///
+/// Unlike @ref RoiFilterAlgorithm, which is limited to a single rectangle, the region can be any set of pixels, for
+/// instance the union of several rectangles as set on a device with Metavision::I_ROI. This makes it possible to apply
+/// the same filtering to recordings or devices that don't support hardware ROIs.
+///
+/// The mask is stored with one bit per pixel, over the bounding box of the region only, so that its rows stay in cache
+/// and testing an event costs a single load and a bit test.
+///
+/// When output_relative_coordinates is true, the accepted events are expressed in the coordinates system of the
+/// bounding box of the region, i.e. in a frame of size @ref crop_width x @ref crop_height.
+class MaskFilterAlgorithm {
+public:
+    /// @brief Builds a new MaskFilterAlgorithm object from an image mask
+    /// @param mask Mask of type CV_8UC1 and of the size of the sensor, the events at non-zero pixels are propagated
+    /// @param output_relative_coordinates If false, events that passed the filter are expressed in the whole image
+    ///                                    coordinates.
+    ///                                    If true, they are expressed in the coordinates system of the bounding box
+    ///                                    of the mask
+    /// @throw std::invalid_argument if the mask is empty or isn't of type CV_8UC1
+    MaskFilterAlgorithm(const cv::Mat &mask, bool output_relative_coordinates = false);
+
+    /// @brief Builds a new MaskFilterAlgorithm object which propagates events in the union of the given rectangles
+    /// @param width Sensor's width
+    /// @param height Sensor's height
+    /// @param rois Rectangles to propagate events in, clipped to the sensor's size
+    /// @param output_relative_coordinates If false, events that passed the filter are expressed in the whole image
+    ///                                    coordinates.
+    ///                                    If true, they are expressed in the coordinates system of the bounding box
+    ///                                    of the rectangles
+    /// @throw std::invalid_argument if the sensor's size isn't strictly positive
+    MaskFilterAlgorithm(int width, int height, const std::vector<cv::Rect> &rois,
+                        bool output_relative_coordinates = false);
+
+    /// @brief Builds a new MaskFilterAlgorithm object which propagates events in the union of the given ROIs
+    ///
+    /// This overload accepts the ROIs set on a device, e.g. a list of Metavision::DeviceRoi
+    ///
+    /// @tparam DeviceRoiType Type of the ROIs, with public fields x_, y_, width_ and height_
+    /// @param width Sensor's width
+    /// @param height Sensor's height
+    /// @param rois ROIs to propagate events in, clipped to the sensor's size
+    /// @param output_relative_coordinates If false, events that passed the filter are expressed in the whole image
+    ///                                    coordinates.
+    ///                                    If true, they are expressed in the coordinates system of the bounding box
+    ///                                    of the ROIs
+    /// @throw std::invalid_argument if the sensor's size isn't strictly positive
+    template<typename DeviceRoiType>
+    MaskFilterAlgorithm(int width, int height, const std::vector<DeviceRoiType> &rois,
+                        bool output_relative_coordinates = false) :
+        MaskFilterAlgorithm(width, height, to_rects(rois), output_relative_coordinates) {}
+
+    /// @brief Default destructor
+    ~MaskFilterAlgorithm() = default;
+
+    /// @brief Applies the mask filter to the given input buffer storing the result in the output buffer.
+    /// @tparam InputIt Read-Only input event iterator type. Works for iterators over buffers of @ref EventCD
+    /// or equivalent
+    /// @tparam OutputIt Read-Write output event iterator type. Works for iterators over containers of @ref EventCD
+    /// or equivalent
+    /// @param it_begin Iterator to first input event
+    /// @param it_end Iterator to the past-the-end event
+    /// @param inserter Output iterator or back inserter
+    /// @return Iterator pointing to the past-the-end event added in the output
+    template<class InputIt, class OutputIt>
+    inline OutputIt process_events(InputIt it_begin, InputIt it_end, OutputIt inserter) const;
+
+    /// @brief Returns true if the algorithm returns events expressed in coordinates relative to the bounding box of
+    /// the mask
+    /// @return true if the algorithm is resetting the filtered events
+    inline bool is_resetting() const;
+
+    /// @brief Returns true if the given pixel is in the mask
+    /// @param x X coordinate of the pixel
+    /// @param y Y coordinate of the pixel
+    /// @return true if the events at this pixel are propagated
+    inline bool is_in_mask(int x, int y) const;
+
+    /// @brief Returns the width of the sensor
+    /// @return Width of the sensor
+    int width() const;
+
+    /// @brief Returns the height of the sensor
+    /// @return Height of the sensor
+    int height() const;
+
+    /// @brief Returns the x coordinate of the upper left corner of the bounding box of the mask
+    /// @return X coordinate of the upper left corner, subtracted to the events when output_relative_coordinates is
+    /// true
+    int crop_x0() const;
+
+    /// @brief Returns the y coordinate of the upper left corner of the bounding box of the mask
+    /// @return Y coordinate of the upper left corner, subtracted to the events when output_relative_coordinates is
+    /// true
+    int crop_y0() const;
+
+    /// @brief Returns the width of the bounding box of the mask
+    /// @return Width of the frame the events are expressed in when output_relative_coordinates is true
+    int crop_width() const;
+
+    /// @brief Returns the height of the bounding box of the mask
+    /// @return Height of the frame the events are expressed in when output_relative_coordinates is true
+    int crop_height() const;
+
+    /// @brief Fills an image with the mask
+    /// @param mask Image of type CV_8UC1 and of the size of the sensor, set to 255 where events are propagated and
+    /// to 0 elsewhere
+    void get_mask(cv::Mat &mask) const;
+
+    /// @brief Operator to check if an event is accepted
+    /// @param ev Event to be tested
+    template<typename T>
+    inline bool operator()(const T &ev) const;
+
+    /// @brief Operator applied when output_relative_coordinates is true, and the event is accepted
+    /// @param ev Event to be updated
+    template<typename T>
+    inline void operator()(T &ev) const;
+
+private:
+    template<typename DeviceRoiType>
+    static std::vector<cv::Rect> to_rects(const std::vector<DeviceRoiType> &rois) {
+        std::vector<cv::Rect> rects;
+        rects.reserve(rois.size());
+        for (const auto &roi : rois) {
+            rects.emplace_back(roi.x_, roi.y_, roi.width_, roi.height_);
+        }
+        return rects;
+    }
+
+    void allocate(const cv::Rect &bounding_box);
+    void set_bits(int x_begin, int x_end, int y);
+
+    int width_{0};
+    int height_{0};
+    int crop_x0_{0};
+    int crop_y0_{0};
+    unsigned int crop_width_{0};
+    unsigned int crop_height_{0};
+    std::size_t words_per_row_{0};
+    std::vector<std::uint64_t> bits_; ///< Rows of the bounding box, with the bit x % 64 of the word x / 64 for pixel x
+    bool output_relative_coordinates_{false};
+};
+
+template<class InputIt, class OutputIt>
+inline OutputIt MaskFilterAlgorithm::process_events(InputIt it_begin, InputIt it_end, OutputIt inserter) const {
+    if (is_resetting()) {
+        return Metavision::detail::transform_if(
+            it_begin, it_end, inserter, [&](const auto &event) { return this->operator()(event); }, std::cref(*this));
+    } else {
+        return Metavision::detail::insert_if(it_begin, it_end, inserter,
+                                             [&](const auto &event) { return this->operator()(event); });
+    }
+}
+
+inline bool MaskFilterAlgorithm::is_resetting() const {
+    return output_relative_coordinates_;
+}
+
+inline bool MaskFilterAlgorithm::is_in_mask(int x, int y) const {
+    // Coordinates are made relative to the bounding box, so that a single unsigned comparison rejects the pixels on
+    // both sides of it
+    const unsigned int cx = static_cast<unsigned int>(x - crop_x0_);
+    const unsigned int cy = static_cast<unsigned int>(y - crop_y0_);
+    if (cx >= crop_width_ || cy >= crop_height_) {
+        return false;
+    }
+    return (bits_[cy * words_per_row_ + (cx >> 6)] >> (cx & 63)) & 1;
+}
+
+template<typename T>
+inline bool MaskFilterAlgorithm::operator()(const T &ev) const {
+    return is_in_mask(ev.x, ev.y);
+}
+
+template<typename T>
+inline void MaskFilterAlgorithm::operator()(T &ev) const {
+    ev.x -= crop_x0_;
+    ev.y -= crop_y0_;
+}
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_CORE_MASK_FILTER_ALGORITHM_H
@@ -13,9 +13,12 @@
 #define METAVISION_SDK_CORE_ON_DEMAND_FRAME_GENERATION_ALGORITHM_H
 
 #include <assert.h>
-#include <deque>
+#include <iterator>
+#include <memory>
+#include <vector>
 
 #include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/base/utils/object_pool.h"
 #include "metavision/sdk/core/algorithms/base_frame_generation_algorithm.h"
 
 namespace Metavision {
@@ -32,6 +35,11 @@ namespace Metavision {
 /// @note It's possible to generate a frame at any timestamp even though more recent events have already been provided.
 /// It allows the user not to worry about the event buffers he or she is sending.
 ///
+/// The events are kept in a ring of chunks sorted by timestamp, each one referencing a range of an events buffer. The
+/// buffers passed as shared pointers are referenced as is, while the other ones are copied in buffers taken from an
+/// internal pool. Events are neither copied nor moved afterwards: frames are generated straight from the chunks, and
+/// the events that are not needed anymore are released chunk per chunk.
+///
 /// @warning This class shouldn't be used in case the user prefers to register to an output callback rather than having
 /// to manually ask the algorithm to generate the frames (See @ref PeriodicFrameGenerationAlgorithm).
 class OnDemandFrameGenerationAlgorithm : public BaseFrameGenerationAlgorithm {
@@ -55,6 +63,15 @@ public:
     template<typename EventIt>
     void process_events(EventIt it_begin, EventIt it_end);
 
+    /// @brief Processes a shared buffer of events, without copying it
+    ///
+    /// A reference to the buffer is kept until all its events are older than the ones needed to generate the next
+    /// frame, so that buffers taken from a pool (e.g. produced by a @ref SharedEventsBufferProducerAlgorithm) can be
+    /// used without any copy.
+    /// @param events Buffer of events to process. It must not be modified as long as it is referenced
+    /// @warning This method is expected to be called with timestamps increasing monotonically and events from the past
+    void process_events(const std::shared_ptr<const std::vector<EventCD>> &events);
+
     /// @brief Generates a frame
     /// @param ts Timestamp at which to generate the frame
     /// @param frame Frame that will be filled with CD events
@@ -86,14 +103,72 @@ public:
     void reset();
 
 private:
-    uint32_t accumulation_time_us_; ///< Accumulation time of the events to generate the frame
-    timestamp last_frame_ts_us_;    ///< Timestamp of the last generated frame
-    std::deque<EventCD> events_queue_;
+    using EventsBuffer     = std::vector<EventCD>;
+    using EventsBufferPool = SharedObjectPool<EventsBuffer>;
+
+    /// Non-empty range of events in a buffer that is kept alive as long as the chunk exists
+    struct EventsChunk {
+        std::shared_ptr<const EventsBuffer> buffer;
+        const EventCD *begin;
+        const EventCD *end;
+    };
+
+    /// Position of an event in the ring: index of its chunk and pointer to it. The past-the-end position is the end of
+    /// the last chunk, all the others point to an event of their chunk
+    struct EventPosition {
+        size_t chunk;
+        const EventCD *event;
+    };
+
+    /// Forward iterator over the events between two positions of the ring
+    class ChunkedEventsIterator;
+
+    /// Minimum number of events of the pooled buffers in which events are copied, so that small input buffers end up
+    /// in the same chunk
+    static constexpr size_t min_copied_chunk_size_ = 16384;
+
+    /// Returns the i-th oldest chunk of the ring
+    const EventsChunk &chunk(size_t i) const {
+        return chunks_[(first_chunk_ + i) & (chunks_.size() - 1)];
+    }
+    EventsChunk &chunk(size_t i) {
+        return chunks_[(first_chunk_ + i) & (chunks_.size() - 1)];
+    }
+
+    /// Adds a chunk at the end of the ring, growing it if needed
+    void push_chunk(std::shared_ptr<const EventsBuffer> buffer, const EventCD *begin, const EventCD *end);
+
+    /// Returns the pooled buffer in which @p n_events events can be copied without being reallocated
+    EventsBuffer &prepare_copy(size_t n_events);
+
+    /// Extends the last chunk, or adds a new one, with the events copied in the buffer returned by @ref prepare_copy
+    void commit_copy();
+
+    /// Finds the first event with a timestamp greater or equal (resp. strictly greater if @p strict is true) than
+    /// @p ts, with a binary search on the chunks and then in the chunk
+    EventPosition find_event(timestamp ts, bool strict) const;
+
+    /// Releases all the events before a position, removing the chunks that are entirely before it
+    void release_events_before(const EventPosition &pos);
+
+    uint32_t accumulation_time_us_;             ///< Accumulation time of the events to generate the frame
+    timestamp last_frame_ts_us_;                ///< Timestamp of the last generated frame
+    std::vector<EventsChunk> chunks_;           ///< Ring of chunks sorted by timestamp, its size is a power of 2
+    size_t first_chunk_{0};                     ///< Index in @ref chunks_ of the oldest chunk
+    size_t n_chunks_{0};                        ///< Number of chunks in the ring
+    EventsBufferPool copies_pool_;              ///< Pool of the buffers in which input events are copied
+    std::shared_ptr<EventsBuffer> copy_buffer_; ///< Pooled buffer in which input events are currently copied
 };
 
 template<typename EventIt>
 inline void OnDemandFrameGenerationAlgorithm::process_events(EventIt it_begin, EventIt it_end) {
-    events_queue_.insert(events_queue_.end(), it_begin, it_end);
+    const auto n_events = std::distance(it_begin, it_end);
+    if (n_events <= 0) {
+        return;
+    }
+    auto &buffer = prepare_copy(static_cast<size_t>(n_events));
+    buffer.insert(buffer.end(), it_begin, it_end);
+    commit_copy();
 }
 
 } // namespace Metavision
@@ -12,7 +12,10 @@
 #ifndef METAVISION_SDK_CORE_PERIODIC_FRAME_GENERATION_ALGORITHM_H
 #define METAVISION_SDK_CORE_PERIODIC_FRAME_GENERATION_ALGORITHM_H
 
+#include <array>
+#include <cstdint>
 #include <functional>
+#include <vector>
 
 #include "metavision/sdk/core/algorithms/async_algorithm.h"
 #include "metavision/sdk/core/algorithms/base_frame_generation_algorithm.h"
@@ -101,6 +104,18 @@ public:
     /// before this timestamp
     void skip_frames_up_to(timestamp ts);
 
+    /// @brief Enables or disables the incremental update of the frame
+    ///
+    /// When enabled, the frame is not regenerated as a whole: only its tiles that displayed events in the previous
+    /// frame, or where events occurred since then, are updated, the other ones still holding the background color.
+    /// The generated frames are identical to the ones obtained with a full update, which is done anyway when the
+    /// previous frame can not be reused (e.g. the colors or the accumulation time changed, or the frame has been
+    /// swapped in the output callback).
+    ///
+    /// @warning The frame passed to the output callback must not be modified in place when this mode is enabled
+    /// @param enabled True to update only the tiles that may have changed, false to regenerate the whole frame (default)
+    void set_incremental_update(bool enabled);
+
     /// @brief Resets the internal states
     void reset();
 
@@ -135,6 +150,19 @@ private:
                                                          ///< last events data that occurred at a given pixel
     timestamp ts_offset_{0}; ///< State variable to handle time overflow in the time surface. This is to minimize the
                              ///< memory footprint of the time surface access
+
+    // Incremental update, the frame is divided in tiles of 2^tile_shift_x_ x 2^tile_shift_y_ pixels
+    static constexpr int tile_shift_x_ = 5;
+    static constexpr int tile_shift_y_ = 3;
+    bool incremental_update_{false};               ///< If true, only the tiles that may have changed are updated
+    int n_tiles_x_{0};                             ///< Number of tiles in a row of the frame
+    std::vector<uint8_t> active_tiles_;            ///< Tiles where events occurred since the last generated frame
+    std::vector<uint8_t> painted_tiles_;           ///< Tiles displaying events in the last generated frame
+    const uint8_t *last_frame_data_{nullptr};      ///< Buffer of the last generated frame, to detect it was swapped
+    int last_flags_{0};                            ///< Parameters used to generate the last frame
+    cv::Vec4b last_bg_color_;                      ///< Background color used to generate the last frame
+    std::array<cv::Vec4b, 2> last_off_on_colors_; ///< Events colors used to generate the last frame
+    timestamp last_min_display_ts_{0};             ///< Oldest timestamp of the events displayed in the last frame
 };
 
 template<typename EventIt>
@@ -171,9 +199,17 @@ void PeriodicFrameGenerationAlgorithm::process_online(EventIt it_begin, EventIt
     }
 
     // Refresh the time-surface using the event buffer
-    for (auto it = it_begin; it != it_end; ++it) {
-        const int32_t it_t                    = static_cast<int32_t>(it->t - ts_offset_);
-        time_surface_[it->y * width_ + it->x] = {it_t, it->p};
+    if (incremental_update_) {
+        for (auto it = it_begin; it != it_end; ++it) {
+            const int32_t it_t                    = static_cast<int32_t>(it->t - ts_offset_);
+            time_surface_[it->y * width_ + it->x] = {it_t, it->p};
+            active_tiles_[(it->y >> tile_shift_y_) * n_tiles_x_ + (it->x >> tile_shift_x_)] = 1;
+        }
+    } else {
+        for (auto it = it_begin; it != it_end; ++it) {
+            const int32_t it_t                    = static_cast<int32_t>(it->t - ts_offset_);
+            time_surface_[it->y * width_ + it->x] = {it_t, it->p};
+        }
     }
 }
 
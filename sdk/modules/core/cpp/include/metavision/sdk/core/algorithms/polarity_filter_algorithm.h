@@ -15,6 +15,7 @@
 #include <memory>
 
 #include "metavision/sdk/base/utils/sdk_log.h"
+#include "metavision/sdk/core/algorithms/detail/event_filter_kernels.h"
 #include "metavision/sdk/core/algorithms/detail/internal_algorithms.h"
 #include "metavision/sdk/base/events/event2d.h"
 
@@ -41,7 +42,15 @@ public:
     /// @return Iterator pointing to the past-the-end event added in the output
     template<class InputIt, class OutputIt>
     inline OutputIt process_events(InputIt it_begin, InputIt it_end, OutputIt inserter) {
-        return Metavision::detail::insert_if(it_begin, it_end, inserter, std::ref(*this));
+        // Contiguous EventCD are filtered with the SIMD kernels
+        return Metavision::detail::filter_events(
+            it_begin, it_end, inserter,
+            [this](const EventCD *begin, const EventCD *end, EventCD *out) {
+                return Metavision::detail::polarity_filter_events(begin, end, out, pol_);
+            },
+            [this](InputIt it_begin, InputIt it_end, OutputIt inserter) {
+                return Metavision::detail::insert_if(it_begin, it_end, inserter, std::ref(*this));
+            });
     }
 
     /// @brief Basic operator to check if an event is accepted
@@ -15,6 +15,7 @@
 #include <memory>
 
 #include "metavision/sdk/base/utils/sdk_log.h"
+#include "metavision/sdk/core/algorithms/detail/event_filter_kernels.h"
 #include "metavision/sdk/core/algorithms/detail/internal_algorithms.h"
 
 namespace Metavision {
@@ -110,13 +111,23 @@ inline RoiFilterAlgorithm::RoiFilterAlgorithm(std::int32_t x0, std::int32_t y0,
 
 template<class InputIt, class OutputIt>
 inline OutputIt RoiFilterAlgorithm::process_events(InputIt it_begin, InputIt it_end, OutputIt inserter) {
-    if (is_resetting()) {
-        return Metavision::detail::transform_if(
-            it_begin, it_end, inserter, [&](const auto &event) { return this->operator()(event); }, std::cref(*this));
-    } else {
-        return Metavision::detail::insert_if(it_begin, it_end, inserter,
-                                             [&](const auto &event) { return this->operator()(event); });
-    }
+    // Contiguous EventCD are filtered with the SIMD kernels
+    return Metavision::detail::filter_events(
+        it_begin, it_end, inserter,
+        [this](const EventCD *begin, const EventCD *end, EventCD *out) {
+            return Metavision::detail::roi_filter_events(begin, end, out, x0_, y0_, x1_, y1_,
+                                                         output_relative_coordinates_);
+        },
+        [this](InputIt it_begin, InputIt it_end, OutputIt inserter) {
+            if (is_resetting()) {
+                return Metavision::detail::transform_if(
+                    it_begin, it_end, inserter, [&](const auto &event) { return this->operator()(event); },
+                    std::cref(*this));
+            } else {
+                return Metavision::detail::insert_if(it_begin, it_end, inserter,
+                                                     [&](const auto &event) { return this->operator()(event); });
+            }
+        });
 }
 
 inline bool RoiFilterAlgorithm::is_resetting() const {
@@ -29,7 +29,22 @@ struct SharedEventsBufferProducerParameters {
     uint32_t buffers_pool_size_{32};
     uint32_t buffers_preallocation_size_{
         0}; ///< number of events to preallocate buffer with for efficiency purpose at insertion
-    bool bounded_memory_pool_{true};
+    bool bounded_memory_pool_{true}; ///< if false, new buffers are allocated when all the buffers are in use
+    bool drop_buffers_if_pool_exhausted_{
+        false}; ///< if true and the pool is bounded, the events of a produced buffer are dropped when all the other
+                ///< buffers are in use, instead of waiting for one of them to be released
+    bool use_huge_pages_{false}; ///< if true, hints the OS to back the preallocated buffers with huge pages (Linux)
+};
+
+/// @brief Statistics of the memory pool of a @ref SharedEventsBufferProducerAlgorithm
+struct SharedEventsBufferPoolStats {
+    size_t capacity_{0};              ///< Number of buffers allocated by the pool
+    size_t outstanding_buffers_{0};   ///< Number of buffers in use, including the one being filled
+    size_t high_water_mark_{0};       ///< Maximum number of buffers in use so far
+    size_t allocations_{0};           ///< Number of buffers allocated because the pool was exhausted
+    size_t blocking_acquisitions_{0}; ///< Number of times the producer waited for a buffer to be released
+    size_t dropped_buffers_{0};       ///< Number of buffers whose events were dropped because the pool was exhausted
+    size_t dropped_events_{0};        ///< Number of events dropped because the pool was exhausted
 };
 
 /// @brief A utility class to generate shared ptr around a vector of events according to a processing policy
@@ -38,6 +53,11 @@ struct SharedEventsBufferProducerParameters {
 /// The events buffers are allocated within a bounded memory pool (@ref SharedObjectPool) to reuse the memory and
 /// avoid memory allocation.
 ///
+/// When all the buffers of the pool are held downstream, the producer either waits for one of them to be released
+/// (bounded pool, default), allocates a new one (unbounded pool), or drops the events of the buffer it has just
+/// produced and reuses it (bounded pool with @ref SharedEventsBufferProducerParameters::drop_buffers_if_pool_exhausted_
+/// set). How often this happens, and how close the pool is to being exhausted, is reported by @ref pool_stats.
+///
 /// @tparam EventT The type of events contained in the buffer.
 template<typename EventT>
 class SharedEventsBufferProducerAlgorithm : public AsyncAlgorithm<SharedEventsBufferProducerAlgorithm<EventT>> {
@@ -82,6 +102,12 @@ public:
     /// @brief Resets the internal states of the policy
     inline void clear();
 
+    /// @brief Returns the statistics of the memory pool
+    ///
+    /// The number of buffers in use is sampled when calling this function, the other statistics are updated each time
+    /// a buffer is produced. This function must be called from the thread processing the events.
+    inline SharedEventsBufferPoolStats pool_stats() const;
+
 private:
     /// @brief Function to process directly the events
     template<typename InputIt>
@@ -90,10 +116,14 @@ private:
     /// @brief Function to process the state that is called every n_events or n_us
     inline void process_async(const timestamp processing_ts, const size_t n_processed_events);
 
+    /// @brief Acquires the buffer to fill from the pool, allocating it if needed
+    inline void acquire_buffer();
+
     SharedEventsBufferProducedCb buffer_produced_cb_;
     EventsBufferPool buffers_pool_;
     SharedEventsBuffer current_shared_buffer_;
     SharedEventsBufferProducerParameters params_;
+    SharedEventsBufferPoolStats stats_;
 
     friend AsyncAlgorithm<SharedEventsBufferProducerAlgorithm>;
 };
@@ -16,6 +16,7 @@
 #include <type_traits>
 
 #include "metavision/sdk/core/algorithms/async_algorithm.h"
+#include "metavision/sdk/core/utils/compact_mostrecent_timestamp_buffer.h"
 #include "metavision/sdk/core/utils/mostrecent_timestamp_buffer.h"
 
 namespace Metavision {
@@ -34,12 +35,14 @@ namespace Metavision {
 /// @tparam CHANNELS Number of channels to use for producing the time surface. Only two values are possible for now: 1
 /// or 2. When a 1-channel time surface is used, events with different polarities are stored all together while they are
 /// stored separately when using a 2-channels time surface.
-template<int CHANNELS = 1>
-class TimeSurfaceProducerAlgorithm : public AsyncAlgorithm<TimeSurfaceProducerAlgorithm<CHANNELS>> {
+/// @tparam TimeSurfaceT Type of the time surface: @ref MostRecentTimestampBuffer, or
+/// @ref CompactMostRecentTimestampBuffer to halve the memory footprint of the time surface
+template<int CHANNELS = 1, typename TimeSurfaceT = MostRecentTimestampBuffer>
+class TimeSurfaceProducerAlgorithm : public AsyncAlgorithm<TimeSurfaceProducerAlgorithm<CHANNELS, TimeSurfaceT>> {
 public:
     static_assert(CHANNELS == 1 || CHANNELS == 2, "The timesurface producer is only compatible with 1 or 2 channels");
 
-    using OutputCb = std::function<void(timestamp, const MostRecentTimestampBuffer &)>;
+    using OutputCb = std::function<void(timestamp, const TimeSurfaceT &)>;
 
     /// @brief Constructs a new time surface producer
     /// @param width Sensor's width
@@ -56,7 +59,7 @@ public:
     void set_output_callback(const OutputCb &cb);
 
 private:
-    friend class AsyncAlgorithm<TimeSurfaceProducerAlgorithm<CHANNELS>>;
+    friend class AsyncAlgorithm<TimeSurfaceProducerAlgorithm<CHANNELS, TimeSurfaceT>>;
 
     /// @brief Updates the time surface with the input events
     /// @tparam InputIt Type of the iterators pointing to the events
@@ -68,8 +71,8 @@ private:
     /// @brief Calls the output callback when the time surface is ready (the output condition is satisfied)
     void process_async(const timestamp processing_ts, const size_t n_processed_events);
 
-    MostRecentTimestampBuffer time_surface_; ///< Time surface updated internally
-    OutputCb output_cb_;                     ///< Callback called when the time surface is ready
+    TimeSurfaceT time_surface_; ///< Time surface updated internally
+    OutputCb output_cb_;        ///< Callback called when the time surface is ready
 };
 } // namespace Metavision
 
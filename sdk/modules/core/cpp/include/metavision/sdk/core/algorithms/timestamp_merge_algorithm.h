@@ -0,0 +1,229 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_CORE_TIMESTAMP_MERGE_ALGORITHM_H
+#define METAVISION_SDK_CORE_TIMESTAMP_MERGE_ALGORITHM_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "metavision/sdk/base/utils/timestamp.h"
+
+namespace Metavision {
+
+/// @brief Class that merges several streams of events sorted by timestamps into a single sorted stream
+///
+/// Each input is a queue of sorted buffers of events, e.g. the events of a camera, of a file or of a trigger source.
+/// The inputs may hold events of different types, e.g. @ref EventCD and @ref EventExtTrigger: the inputs of the first
+/// type of @p Events come first, then the ones of the second type and so on.
+///
+/// The merged events are the ones before the watermark, i.e. the timestamp up to which all the open inputs are known to
+/// have provided their events: the last timestamp received from an input, or the one given to @ref advance_input. The
+/// inputs are merged with a loser tree, which selects each merged event in log2(N) comparisons for N inputs. Events
+/// with the same timestamp are ordered by input index.
+///
+/// The buffers are not copied: the events are merged from the buffers of the caller, which must keep them valid until
+/// they are merged. The merged events are passed to the output callback by batches of a fixed size (see
+/// @ref OutputBatch). The last batch is output by @ref flush.
+///
+/// @tparam Events The types of events to merge, with a timestamp field t
+template<typename... Events>
+class TimestampMergeAlgorithm {
+public:
+    static_assert(sizeof...(Events) > 0, "Timestamp merge expects at least one type of events.");
+
+    /// @brief Number of types of events merged
+    static constexpr std::size_t n_event_types = sizeof...(Events);
+
+    /// @brief Batch of merged events passed to the output callback
+    ///
+    /// The events of each type are stored contiguously, in the merged order. The order of the events of different types
+    /// is given by the input index of each event, which is always available when several types of events are merged.
+    class OutputBatch {
+    public:
+        /// @brief Returns the number of events of the batch
+        std::size_t size() const;
+
+        /// @brief Returns the first merged event of a type
+        template<typename EventT>
+        const EventT *begin() const;
+
+        /// @brief Returns the past-the-end merged event of a type
+        template<typename EventT>
+        const EventT *end() const;
+
+        /// @brief Returns the input index of each merged event, or nullptr if sources are not tagged
+        const std::uint32_t *sources() const;
+
+        /// @brief Calls a visitor on each event of the batch, in the merged order
+        /// @param visitor Callable as visitor(const EventT &ev, std::uint32_t source) for each type of @p Events
+        /// @warning Sources must be tagged, which they always are when several types of events are merged
+        template<typename Visitor>
+        void visit(Visitor &&visitor) const;
+
+    private:
+        friend class TimestampMergeAlgorithm;
+
+        explicit OutputBatch(const TimestampMergeAlgorithm &algo);
+
+        template<typename Visitor, std::size_t I>
+        void visit_event(Visitor &visitor, std::uint32_t source, std::array<std::size_t, n_event_types> &positions,
+                         std::integral_constant<std::size_t, I>) const;
+
+        const TimestampMergeAlgorithm &algo_;
+    };
+
+    /// @brief Type of the callback called with each batch of merged events
+    ///
+    /// The batch is only valid during the call. The callback must not call the functions of the algorithm.
+    using OutputCallback = std::function<void(const OutputBatch &batch)>;
+
+    /// @brief Constructor
+    /// @param n_inputs Number of input streams of each type of events
+    /// @param output_cb Callback called with each batch of merged events
+    /// @param output_batch_size Number of events of the output batches
+    /// @param tag_sources If true, the input index of each event is passed to the output callback. Sources are always
+    /// tagged when several types of events are merged
+    /// @throw std::invalid_argument if there is no input or if @p output_batch_size is 0
+    TimestampMergeAlgorithm(const std::array<std::size_t, n_event_types> &n_inputs, const OutputCallback &output_cb,
+                            std::size_t output_batch_size = 16384, bool tag_sources = false);
+
+    /// @brief Constructor, for a single type of events
+    /// @param n_inputs Number of input streams
+    /// @param output_cb Callback called with each batch of merged events
+    /// @param output_batch_size Number of events of the output batches
+    /// @param tag_sources If true, the input index of each event is passed to the output callback
+    /// @throw std::invalid_argument if @p n_inputs or @p output_batch_size is 0
+    TimestampMergeAlgorithm(std::size_t n_inputs, const OutputCallback &output_cb,
+                            std::size_t output_batch_size = 16384, bool tag_sources = false);
+
+    /// @brief Adds a buffer of events to an input, and merges the events before the new watermark
+    ///
+    /// The events are not copied: the buffer must stay valid until all its events are merged, i.e. until the watermark
+    /// is greater than the timestamp of its last event, or until @ref flush or @ref reset is called.
+    ///
+    /// @param input Index of the input
+    /// @param begin First event of the buffer, sorted by timestamps
+    /// @param end Past-the-end event of the buffer
+    /// @throw std::invalid_argument if @p input is out of range, closed or of another type of events, if the buffer
+    /// starts before the last event of the input, or if it holds the min or max timestamp, which are reserved
+    template<typename EventT>
+    void process_events(std::size_t input, const EventT *begin, const EventT *end);
+
+    /// @brief Notifies that an input has no events before a timestamp, and merges the events before the new watermark
+    ///
+    /// This lets the merge go on when an input produces events rarely, e.g. triggers.
+    ///
+    /// @param input Index of the input
+    /// @param ts Timestamp before which the input won't produce events anymore
+    /// @throw std::invalid_argument if @p input is out of range
+    void advance_input(std::size_t input, timestamp ts);
+
+    /// @brief Closes an input, whose events are no longer waited for, and merges the events before the new watermark
+    /// @param input Index of the input
+    /// @throw std::invalid_argument if @p input is out of range
+    void close_input(std::size_t input);
+
+    /// @brief Merges all the pending events regardless of the watermark, and outputs the last batch
+    ///
+    /// The events added afterwards must not be before the last merged event.
+    void flush();
+
+    /// @brief Drops the pending events and reopens all the inputs
+    void reset();
+
+    /// @brief Returns the timestamp before which the events are merged
+    timestamp get_watermark() const;
+
+    /// @brief Returns the number of events waiting for the watermark to be merged
+    std::size_t get_pending_events_count() const;
+
+private:
+    /// Range of events of any type
+    struct Span {
+        const void *begin;
+        const void *end;
+    };
+
+    struct Input {
+        std::size_t type_;        ///< Index of the type of the events in Events
+        std::deque<Span> queued_; ///< Buffers received after the one being merged
+        timestamp bound_;         ///< Timestamp before which the input has provided all its events
+        bool closed_{false};
+    };
+
+    /// Next event of an input, at a leaf or a match of the tree
+    struct Node {
+        timestamp head;     ///< Timestamp of the next event, or the max timestamp if none
+        const void *cursor; ///< Next event, or nullptr if none
+        std::size_t leaf;   ///< Index of the input
+    };
+
+    /// Number of merged events in the batch, kept out of the members while merging
+    struct OutputPosition {
+        std::array<std::size_t, n_event_types> n_events; ///< Number of merged events of each type
+        std::size_t n_total;                             ///< Number of merged events
+    };
+
+    template<std::size_t I>
+    using EventType = typename std::tuple_element<I, std::tuple<Events...>>::type;
+
+    /// @brief Merges the events before @p watermark
+    void merge(timestamp watermark);
+
+    /// @brief Builds the tree from the heads of the inputs
+    void build_tree();
+
+    /// @brief Outputs the next event of an input and moves to the following one
+    template<std::size_t I>
+    void pop(Node &node, OutputPosition &position, std::integral_constant<std::size_t, I>);
+    void pop(Node &node, OutputPosition &position, std::integral_constant<std::size_t, n_event_types>);
+
+    /// @brief Moves an input to its next buffer, once the current one is merged
+    template<typename EventT>
+    void next_buffer(Node &node);
+
+    /// @brief Returns the number of events of a range of events of the type of index @p type
+    template<std::size_t I>
+    std::size_t count(std::size_t type, const Span &span, std::integral_constant<std::size_t, I>) const;
+    std::size_t count(std::size_t type, const Span &span, std::integral_constant<std::size_t, n_event_types>) const;
+
+    /// @brief Outputs the merged events and clears the batch
+    void output_batch();
+
+    std::vector<Input> inputs_;
+    std::vector<const void *> ends_;   ///< End of the buffer being merged of each input, or nullptr if none
+    std::vector<Node> tree_;           ///< Loser of the match at each node of the tree, and the winner at index 0
+    std::vector<Node> leaves_;         ///< Next event of each input while the tree is not built
+    std::vector<std::size_t> winners_; ///< Winner of the match at each node and leaf, used to build the tree
+    std::size_t n_leaves_;             ///< Number of inputs, rounded up to a power of 2
+    bool tree_valid_{false};           ///< Whether the tree matches the heads of the inputs
+
+    OutputCallback output_cb_;
+    std::size_t output_batch_size_;
+    bool tag_sources_;
+    std::tuple<std::vector<Events>...> output_;              ///< Batch of merged events of each type
+    std::array<std::size_t, n_event_types> n_output_events_; ///< Number of merged events of each type in the batch
+    std::vector<std::uint32_t> output_sources_;              ///< Input index of each merged event, if tagged
+    std::size_t n_output_total_{0};                          ///< Number of merged events in the batch
+};
+
+} // namespace Metavision
+
+#include "metavision/sdk/core/algorithms/detail/timestamp_merge_algorithm_impl.h"
+
+#endif // METAVISION_SDK_CORE_TIMESTAMP_MERGE_ALGORITHM_H
@@ -0,0 +1,73 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_CORE_TRAIL_FILTER_ALGORITHM_H
+#define METAVISION_SDK_CORE_TRAIL_FILTER_ALGORITHM_H
+
+#include <cstdint>
+
+#include "metavision/sdk/core/algorithms/detail/burst_noise_filter_algorithm.h"
+
+namespace Metavision {
+
+/// @brief Class that filters the trails of events following contrast changes
+///
+/// An event is propagated if it is the first one of a burst, i.e. unless the previous event at the same pixel has the
+/// same polarity and is less than a threshold older. Only the event marking the contrast change is thus kept, and the
+/// rest of the burst, which mostly reflects the latency of the pixel, is dropped.
+///
+/// This is the software equivalent of the TRAIL mode of Metavision::I_NoiseFilterModule, for sensors without this
+/// hardware block and for recordings.
+class TrailFilterAlgorithm : public detail::BurstNoiseFilterAlgorithm<detail::BurstEventKept::First> {
+public:
+    /// @brief Builds a new TrailFilterAlgorithm object
+    /// @param width Sensor's width
+    /// @param height Sensor's height
+    /// @param threshold Maximum duration between two events of a burst, in us
+    /// @throw std::invalid_argument if the sensor's size isn't strictly positive
+    TrailFilterAlgorithm(int width, int height, std::uint32_t threshold) :
+        detail::BurstNoiseFilterAlgorithm<detail::BurstEventKept::First>(width, height, threshold) {}
+
+    /// @brief Applies the filter to the given input buffer storing the result in the output buffer
+    /// @tparam InputIt Read-Only input event iterator type. Works for iterators over buffers of @ref EventCD
+    /// or equivalent
+    /// @tparam OutputIt Read-Write output event iterator type. Works for iterators over containers of @ref EventCD
+    /// or equivalent
+    /// @param it_begin Iterator to first input event
+    /// @param it_end Iterator to the past-the-end event
+    /// @param inserter Output iterator or back inserter
+    /// @return Iterator pointing to the past-the-end event added in the output
+    template<class InputIt, class OutputIt>
+    inline OutputIt process_events(InputIt it_begin, InputIt it_end, OutputIt inserter) {
+        return BurstNoiseFilterAlgorithm::process_events(it_begin, it_end, inserter);
+    }
+
+    /// @brief Sets the maximum duration between two events of a burst, which resets the state of the filter
+    /// @param threshold Maximum duration between two events of a burst, in us
+    void set_threshold(std::uint32_t threshold) {
+        BurstNoiseFilterAlgorithm::set_threshold(threshold);
+    }
+
+    /// @brief Returns the maximum duration between two events of a burst
+    /// @return Maximum duration between two events of a burst, in us
+    std::uint32_t get_threshold() const {
+        return BurstNoiseFilterAlgorithm::get_threshold();
+    }
+
+    /// @brief Resets the state of the filter, to process events from another stream
+    void reset() {
+        BurstNoiseFilterAlgorithm::reset();
+    }
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_CORE_TRAIL_FILTER_ALGORITHM_H
@@ -21,7 +21,10 @@ inline bool FrameCompositionStage::SourceInfo::can_copy(timestamp next_frame_ts,
 inline void FrameCompositionStage::SourceInfo::add_frame(timestamp ts, FrameCompositionStage::FramePtr &ptr,
                                                          timestamp next_frame_ts, timestamp max_ts_range) {
     if (can_copy(next_frame_ts, max_ts_range)) {
-        saved_frames_queue_.push({ts, ptr->clone()});
+        // The frame is converted into the sub-image, which is a copy in general smaller than the frame and makes the
+        // update of the composed image a mere copy
+        saved_frames_queue_.push({ts, cv::Mat()});
+        frame_composer->convert_subimage(frame_ref, *ptr, saved_frames_queue_.back().second);
     } else {
         references_to_input_frames_queue_.push({ts, ptr});
     }
@@ -120,6 +123,10 @@ void FrameCompositionStage::add_previous_frame_stage(BaseStage &prev_frame_stage
     const int ref                  = frame_composer_.add_new_subimage_parameters(x, y, resize_o, gray_to_color_options);
     stages_map_[&prev_frame_stage] = ref;
     sources_info_map_[ref]         = SourceInfo();
+
+    // The frames saved for later compositions are converted as soon as they are received
+    sources_info_map_[ref].frame_composer = &frame_composer_;
+    sources_info_map_[ref].frame_ref      = ref;
     set_consuming_callback(prev_frame_stage, [this, ref](const boost::any &data) { consume_frame(ref, data); });
 }
 
@@ -191,6 +198,9 @@ void FrameCompositionStage::set_stage_status(BaseStage &stage, const boost::any
 
 inline bool FrameCompositionStage::update_composed_image() {
     bool still_have_frames_to_consume = false;
+    subimage_updates_.clear();
+    saved_frames_updated_.clear();
+    referenced_frames_updated_.clear();
     for (auto &p : sources_info_map_) {
         if (!p.second.saved_frames_queue_.empty()) {
             still_have_frames_to_consume = true; // Regardless of whether or not we enter the if condition below, if
@@ -198,8 +208,8 @@ inline bool FrameCompositionStage::update_composed_image() {
                                                  // consume all the frames of the source
             auto &next_frame_saved_in_queue = p.second.saved_frames_queue_.front();
             if (next_frame_saved_in_queue.first == next_frame_ts_) {
-                frame_composer_.update_subimage(p.first, next_frame_saved_in_queue.second);
-                p.second.saved_frames_queue_.pop();
+                subimage_updates_.emplace_back(p.first, next_frame_saved_in_queue.second);
+                saved_frames_updated_.push_back(&p.second);
                 continue; // No need to look in the queue with the shared ptr: skip to next source
             }
         }
@@ -209,11 +219,19 @@ inline bool FrameCompositionStage::update_composed_image() {
                                                  // consume all the frames of the source
             auto &next_in_queue = p.second.references_to_input_frames_queue_.front();
             if (next_in_queue.first == next_frame_ts_) {
-                frame_composer_.update_subimage(p.first, *(next_in_queue.second));
-                p.second.references_to_input_frames_queue_.pop();
+                subimage_updates_.emplace_back(p.first, *(next_in_queue.second));
+                referenced_frames_updated_.push_back(&p.second);
             }
         }
     }
+
+    // The frames are released once the sub-images are updated, as the referenced ones go back to the input pools
+    frame_composer_.update_subimages(subimage_updates_);
+    subimage_updates_.clear();
+    for (SourceInfo *source_info : saved_frames_updated_)
+        source_info->saved_frames_queue_.pop();
+    for (SourceInfo *source_info : referenced_frames_updated_)
+        source_info->references_to_input_frames_queue_.pop();
     return still_have_frames_to_consume;
 }
 
@@ -0,0 +1,90 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_CORE_FILTER_CHAIN_STAGE_H
+#define METAVISION_SDK_CORE_FILTER_CHAIN_STAGE_H
+
+#include <iterator>
+#include <memory>
+#include <vector>
+#include <boost/any.hpp>
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/base/utils/object_pool.h"
+#include "metavision/sdk/core/pipeline/base_stage.h"
+#include "metavision/sdk/core/algorithms/filter_chain_algorithm.h"
+
+namespace Metavision {
+
+/// @brief Stage that runs a @ref FilterChainAlgorithm
+///
+/// The whole chain of filters is applied in a single pass over each input buffer, writing the accepted events directly
+/// in the produced buffer.
+///
+/// @tparam EventType Type of events consumed and produced by this stage
+/// @tparam Filters Types of the filters of the chain
+template<typename EventType, typename... Filters>
+class FilterChainStage : public BaseStage {
+public:
+    using EventBuffer     = std::vector<EventType>;
+    using EventBufferPool = SharedObjectPool<EventBuffer>;
+    using EventBufferPtr  = typename EventBufferPool::ptr_type;
+
+    /// @brief Constructor
+    /// @param filter_chain Chain of filters to apply
+    FilterChainStage(const FilterChainAlgorithm<Filters...> &filter_chain) :
+        algo_(filter_chain), event_buffer_pool_(EventBufferPool::make_bounded()) {
+        set_consuming_callback([this](const boost::any &data) {
+            try {
+                auto buffer     = boost::any_cast<EventBufferPtr>(data);
+                auto out_buffer = event_buffer_pool_.acquire();
+                // The output can not be larger than the input: reserving it once avoids any reallocation while the
+                // accepted events are appended, without initializing the events that are then overwritten
+                out_buffer->clear();
+                out_buffer->reserve(buffer->size());
+                algo_.process_events(buffer->cbegin(), buffer->cend(), std::back_inserter(*out_buffer));
+                produce(out_buffer);
+            } catch (boost::bad_any_cast &) {}
+        });
+    }
+
+    /// @brief Constructor
+    /// @param filter_chain Chain of filters to apply
+    /// @param prev_stage Previous stage
+    FilterChainStage(const FilterChainAlgorithm<Filters...> &filter_chain, BaseStage &prev_stage) :
+        FilterChainStage(filter_chain) {
+        set_previous_stage(prev_stage);
+    }
+
+    /// @brief Gets algo
+    /// @return Algorithm class associated to this stage
+    FilterChainAlgorithm<Filters...> &algo() {
+        return algo_;
+    }
+
+private:
+    FilterChainAlgorithm<Filters...> algo_;
+    EventBufferPool event_buffer_pool_;
+};
+
+/// @brief Makes a stage running the given filter chain
+/// @tparam EventType Type of events consumed and produced by the stage, defaults to @ref EventCD
+/// @param filter_chain Chain of filters to apply
+/// @return The stage
+template<typename EventType = EventCD, typename... Filters>
+std::unique_ptr<FilterChainStage<EventType, Filters...>>
+    make_filter_chain_stage(const FilterChainAlgorithm<Filters...> &filter_chain) {
+    return std::make_unique<FilterChainStage<EventType, Filters...>>(filter_chain);
+}
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_CORE_FILTER_CHAIN_STAGE_H
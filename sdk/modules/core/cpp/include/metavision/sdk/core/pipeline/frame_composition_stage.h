@@ -33,6 +33,9 @@ namespace Metavision {
 /// Nullptrs images can be used as temporal markers, so that input stages can let the class know there are no
 /// available data to display for this input at time ts. In that case, the corresponding part in the whole image won't
 /// be updated.
+///
+/// The frames that can't be composed right away are converted into their sub-images when received, so that the frames
+/// of the input stages are released early, and all the sub-images of a composed frame are updated in parallel.
 class FrameCompositionStage : public BaseStage {
 public:
     using FramePool = SharedObjectPool<cv::Mat>;
@@ -67,9 +70,13 @@ private:
         // Reference to the last frame received from the source
         FramePtr ptr_to_last_frame_received = nullptr;
 
-        // Queue containing the copied frames
+        // Queue containing the copied frames, already converted into the source's sub-image
         std::queue<std::pair<timestamp, cv::Mat>> saved_frames_queue_;
 
+        // Frame composer converting the copied frames, and reference of the source's sub-image
+        FrameComposer *frame_composer = nullptr;
+        int frame_ref                 = -1;
+
         // More recent timestamp for which both:
         //  - an update of the composed frame is required (i.e. multiple of the composer's period), and
         //  - the needed information has been received from the source
@@ -133,6 +140,10 @@ private:
 
     std::unordered_map<int, SourceInfo> sources_info_map_;
 
+    // Sub-images to update for the next composed frame, and sources whose queues hold them
+    std::vector<std::pair<unsigned int, cv::Mat>> subimage_updates_;
+    std::vector<SourceInfo *> saved_frames_updated_, referenced_frames_updated_;
+
     FramePool output_frame_pool_;
     FramePtr produced_frame_ptr_;
 };
@@ -0,0 +1,89 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_CORE_NOISE_FILTER_STAGE_H
+#define METAVISION_SDK_CORE_NOISE_FILTER_STAGE_H
+
+#include <cstdint>
+#include <iterator>
+#include <vector>
+#include <boost/any.hpp>
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/base/utils/object_pool.h"
+#include "metavision/sdk/core/pipeline/base_stage.h"
+#include "metavision/sdk/core/algorithms/activity_noise_filter_algorithm.h"
+#include "metavision/sdk/core/algorithms/trail_filter_algorithm.h"
+
+namespace Metavision {
+
+/// @brief Stage that runs a noise filter, @ref ActivityNoiseFilterAlgorithm or @ref TrailFilterAlgorithm
+///
+/// The accepted events are filtered by blocks that stay in the L1 cache, and appended to the produced buffer.
+///
+/// @tparam NoiseFilterAlgorithm Type of the noise filter
+template<typename NoiseFilterAlgorithm>
+class NoiseFilterStage : public BaseStage {
+public:
+    using EventBuffer     = std::vector<EventCD>;
+    using EventBufferPool = SharedObjectPool<EventBuffer>;
+    using EventBufferPtr  = typename EventBufferPool::ptr_type;
+
+    /// @brief Constructor
+    /// @param width Sensor's width
+    /// @param height Sensor's height
+    /// @param threshold Maximum duration between two events of a burst, in us
+    NoiseFilterStage(int width, int height, std::uint32_t threshold) :
+        algo_(width, height, threshold), event_buffer_pool_(EventBufferPool::make_bounded()) {
+        set_consuming_callback([this](const boost::any &data) {
+            try {
+                auto buffer     = boost::any_cast<EventBufferPtr>(data);
+                auto out_buffer = event_buffer_pool_.acquire();
+                // The output can not be larger than the input, so the accepted events are appended without any
+                // reallocation
+                out_buffer->clear();
+                out_buffer->reserve(buffer->size());
+                algo_.process_events(buffer->data(), buffer->data() + buffer->size(), std::back_inserter(*out_buffer));
+                produce(out_buffer);
+            } catch (boost::bad_any_cast &) {}
+        });
+    }
+
+    /// @brief Constructor
+    /// @param width Sensor's width
+    /// @param height Sensor's height
+    /// @param threshold Maximum duration between two events of a burst, in us
+    /// @param prev_stage Previous stage
+    NoiseFilterStage(int width, int height, std::uint32_t threshold, BaseStage &prev_stage) :
+        NoiseFilterStage(width, height, threshold) {
+        set_previous_stage(prev_stage);
+    }
+
+    /// @brief Gets algo
+    /// @return Algorithm class associated to this stage
+    NoiseFilterAlgorithm &algo() {
+        return algo_;
+    }
+
+private:
+    NoiseFilterAlgorithm algo_;
+    EventBufferPool event_buffer_pool_;
+};
+
+/// @brief Stage that runs @ref ActivityNoiseFilterAlgorithm
+using ActivityNoiseFilterStage = NoiseFilterStage<ActivityNoiseFilterAlgorithm>;
+
+/// @brief Stage that runs @ref TrailFilterAlgorithm
+using TrailFilterStage = NoiseFilterStage<TrailFilterAlgorithm>;
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_CORE_NOISE_FILTER_STAGE_H
@@ -55,14 +55,22 @@ public:
         if (cbs_vec_dirty_) {
             std::unique_lock<std::mutex> lock(cbs_mutex_);
             cbs_vec_.clear();
+            cbs_ids_vec_.clear();
             for (auto &&p : cbs_map_) {
                 cbs_vec_.push_back(p.second);
+                cbs_ids_vec_.push_back(p.first);
             }
             cbs_vec_dirty_ = false;
         }
         return cbs_vec_;
     }
 
+    /// @brief Gets the ids of the registered callbacks, in the same order as the callbacks returned by @ref get_cbs
+    const std::vector<size_t> &get_cb_ids() const {
+        get_cbs();
+        return cbs_ids_vec_;
+    }
+
     template<typename... Args>
     void operator()(Args &&...params) {
         auto cbs = get_cbs();
@@ -78,6 +86,7 @@ private:
     mutable std::atomic<bool> cbs_vec_dirty_{false};
     std::map<size_t, EventsCallback> cbs_map_;
     mutable std::vector<EventsCallback> cbs_vec_;
+    mutable std::vector<size_t> cbs_ids_vec_;
 };
 
 } // namespace Metavision
@@ -12,6 +12,13 @@
 #ifndef METAVISION_SDK_CORE_CD_FRAME_GENERATOR_H
 #define METAVISION_SDK_CORE_CD_FRAME_GENERATOR_H
 
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
 #include "metavision/sdk/base/events/event_cd.h"
 #include "metavision/sdk/core/algorithms/periodic_frame_generation_algorithm.h"
 #include "metavision/sdk/core/utils/threaded_process.h"
@@ -20,6 +27,12 @@ namespace Metavision {
 
 /// @brief Utility class to display CD events that handles multithreading and is built on the top
 /// of PeriodicFrameGenerator
+///
+/// The events are handed over to the generation thread without locks, through three buffers: the one filled by
+/// @ref add_events, the one rendered by the generation thread, and a shared one they exchange. At each notification
+/// tick, the filled buffer is published if the generation thread has consumed the previous one, otherwise the events
+/// keep being appended to it until it can be. Events are thus never dropped when the rendering can't keep up but,
+/// unless all frames are to be processed, only the latest frame of the published events is generated.
 class CDFrameGenerator {
 public:
     /// @brief Default constructor
@@ -53,6 +66,10 @@ public:
     void set_color_palette(const Metavision::ColorPalette &palette);
 
     /// @brief Adds the buffer of events to be displayed
+    ///
+    /// The events are copied without locking, hence this function must always be called from the same thread, and
+    /// not concurrently with @ref stop.
+    ///
     /// @param begin Beginning of the buffer of events
     /// @param end End of the buffer of events
     void add_events(const Metavision::EventCD *begin, const Metavision::EventCD *end);
@@ -83,11 +100,31 @@ public:
     bool stop();
 
     /// @brief Resets the frame generator state
+    ///
+    /// The reset is applied by the next calls to @ref add_events and by the generation thread, so that it can be
+    /// requested from any thread. The events added before the reset are discarded.
     void reset();
 
 private:
     bool generate();
 
+    /// @brief Appends events to the write buffer
+    /// @return true if the events reach the next time slice, in which case the buffer should be published
+    bool append_events(const EventCD *begin, const EventCD *end);
+
+    /// @brief Publishes the write buffer if the shared buffer has been consumed by the generation thread
+    /// @return true if the buffer was published
+    bool publish_write_buffer();
+
+    /// @brief Publishes the write buffer from the generation thread, if add_events could not publish it
+    void collect_pending_buffer();
+
+    /// @brief Waits until a buffer of events is published or the generator is stopped
+    void wait_for_published_events();
+
+    /// @brief Renders a buffer of events, unless it was filled before the last reset
+    void process_buffer(std::vector<EventCD> &events, std::uint32_t reset_count);
+
     // Image to display
     PeriodicFrameGenerationAlgorithm::OutputCb frame_cb_;
 
@@ -96,22 +133,41 @@ private:
         timestamp ts_us_;
     };
     std::vector<FrameEvent> frames_;
-    std::vector<EventCD> events_front_, events_back_;
     size_t frames_count_{0};
 
+    // Events to display
+    struct EventsBuffer {
+        std::vector<EventCD> events_;
+        std::uint32_t reset_count_{0}; ///< Number of resets requested when the buffer was filled
+    };
+    static constexpr int published_flag_ = 4; ///< Set in shared_buffer_ when it holds events to render
+    std::array<EventsBuffer, 3> buffers_;
+    int write_buffer_{0};               ///< Buffer filled by add_events
+    int read_buffer_{1};                ///< Buffer rendered by the generation thread
+    std::atomic<int> shared_buffer_{2}; ///< Buffer exchanged by both threads, flagged with published_flag_
+    /// Whether a tick occurred while the shared buffer was not yet consumed. While it is set, the write buffer is only
+    /// accessed with pending_mutex_ locked, as the generation thread may publish it
+    std::atomic<bool> publish_pending_{false};
+    std::mutex pending_mutex_;
+    std::atomic<std::uint32_t> reset_count_{0};
+    std::uint32_t write_reset_count_{0};  ///< Resets applied by add_events
+    std::uint32_t render_reset_count_{0}; ///< Resets applied by the generation thread
+
     // Is frame dropping allowed?
     bool process_all_frames_ = false;
-    bool events_available_   = false;
-    timestamp notify_slice_us_{0};
+    std::atomic<timestamp> notify_slice_us_{0};
     timestamp next_notify_us_;
 
-    // Events to display
-    std::mutex processing_mutex_;
+    // The generation thread only sleeps when no events are published, add_events notifies it only in that case
     std::atomic<bool> stop_{true};
+    std::atomic<bool> waiting_for_events_{false};
+    std::mutex wait_mutex_;
     std::condition_variable events_available_cond_;
 
     std::unique_ptr<PeriodicFrameGenerationAlgorithm> frame_generation_algo_;
-    // Shadow params
+    // Shadow params, applied by the generation thread when changed
+    std::mutex params_mutex_;
+    std::atomic<bool> params_changed_{false};
     timestamp accumulation_time_us_;
     cv::Scalar background_color_, on_color_, off_color_;
     bool colored_;
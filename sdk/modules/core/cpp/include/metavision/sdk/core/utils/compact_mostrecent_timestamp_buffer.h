@@ -0,0 +1,181 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_CORE_COMPACT_MOSTRECENT_TIMESTAMP_BUFFER_H
+#define METAVISION_SDK_CORE_COMPACT_MOSTRECENT_TIMESTAMP_BUFFER_H
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include <boost/assert.hpp>
+#include <opencv2/core/mat.hpp>
+
+#include "metavision/sdk/base/utils/timestamp.h"
+#include "metavision/sdk/core/utils/mostrecent_timestamp_buffer.h"
+
+namespace Metavision {
+
+/// @brief Buffer of the most recent timestamps observed at each pixel of the camera, stored on 32 bits
+///
+/// This class is a compact alternative to @ref MostRecentTimestampBuffer, taking half the memory so that larger time
+/// surfaces fit in the caches. Timestamps are stored relatively to an epoch, which slides forward when a timestamp too
+/// far from it is set: the buffer is then rebased, the timestamps more than 2^31 us older than the new one being
+/// clamped to the new epoch. Timestamps older than the epoch are read as the epoch.
+///
+/// Pixels can be stored row after row, or by tiles of @ref tile_size x @ref tile_size pixels, which keeps close
+/// pixels in the same cache lines when the buffer is updated in a random order.
+///
+/// The time surface images are generated using SIMD instructions when available.
+class CompactMostRecentTimestampBuffer {
+public:
+    /// @brief Order of the pixels in memory
+    enum class Layout {
+        RowMajor, ///< Row after row
+        Tiled     ///< Tile after tile, row after row in each tile
+    };
+
+    /// Width and height of the tiles in pixels, when the tiled layout is used
+    static constexpr int tile_size = 8;
+
+    /// @brief Default constructor
+    CompactMostRecentTimestampBuffer() = default;
+
+    /// @brief Initialization constructor
+    /// @param rows Sensor's height
+    /// @param cols Sensor's width
+    /// @param channels Number of channels
+    /// @param layout Order of the pixels in memory
+    CompactMostRecentTimestampBuffer(int rows, int cols, int channels = 1, Layout layout = Layout::RowMajor);
+
+    /// @brief Allocates the buffer, with all timestamps set to 0
+    /// @param rows Sensor's height
+    /// @param cols Sensor's width
+    /// @param channels Number of channels
+    /// @param layout Order of the pixels in memory
+    void create(int rows, int cols, int channels = 1, Layout layout = Layout::RowMajor);
+
+    /// @brief Deallocates the buffer
+    void release();
+
+    /// @brief Gets the number of rows of the buffer
+    int rows() const;
+
+    /// @brief Gets the number of columns of the buffer
+    int cols() const;
+
+    /// @brief Gets the size of the buffer (i.e. Sensor's size as well)
+    cv::Size size() const;
+
+    /// @brief Gets the number of channels of the buffer
+    int channels() const;
+
+    /// @brief Gets the order of the pixels in memory
+    Layout layout() const;
+
+    /// @brief Checks whether the buffer is empty
+    bool empty() const;
+
+    /// @brief Gets the timestamp the stored timestamps are relative to
+    timestamp epoch() const;
+
+    /// @brief Sets all elements of the timestamp buffer to a constant, which becomes the epoch
+    /// @param ts The constant timestamp value
+    void set_to(timestamp ts);
+
+    /// @brief Sets the timestamp at the specified pixel, rebasing the buffer if needed
+    /// @param y The pixel's ordinate
+    /// @param x The pixel's abscissa
+    /// @param c The channel to set the timestamp to
+    /// @param ts The timestamp
+    inline void set(int y, int x, int c, timestamp ts);
+
+    /// @brief Retrieves the timestamp at the specified pixel
+    /// @param y The pixel's ordinate
+    /// @param x The pixel's abscissa
+    /// @param c The channel to retrieve the timestamp from
+    /// @return The timestamp at the given pixel
+    inline timestamp at(int y, int x, int c = 0) const;
+
+    /// @brief Retrieves the maximum timestamp across channels at the specified pixel
+    /// @param y The pixel's ordinate
+    /// @param x The pixel's abscissa
+    /// @return The maximum timestamp at that pixel across all the channels in the buffer
+    timestamp max_across_channels_at(int y, int x) const;
+
+    /// @brief Copies this timestamp buffer into a @ref MostRecentTimestampBuffer
+    /// @param other The timestamp buffer to copy to
+    void copy_to(MostRecentTimestampBuffer &other) const;
+
+    /// @brief Generates a CV_8UC1 image of the time surface for all the channels
+    ///
+    /// Side-by-side: one time surface per channel, e.g. negative then positive polarity
+    /// The time surface is normalized between last_ts (255) and last_ts - delta_t (0)
+    ///
+    /// @param last_ts Last timestamp value stored in the buffer
+    /// @param delta_t Delta time, with respect to @p last_t, above which timestamps are not considered for the image
+    /// generation
+    /// @param out The produced image
+    void generate_img_time_surface(timestamp last_ts, timestamp delta_t, cv::Mat &out) const;
+
+    /// @brief Generates a CV_8UC1 image of the time surface, merging the channels
+    ///
+    /// The time surface is normalized between last_ts (255) and last_ts - delta_t (0)
+    ///
+    /// @param last_ts Last timestamp value stored in the buffer
+    /// @param delta_t Delta time, with respect to @p last_t, above which timestamps are not considered for the image
+    /// generation
+    /// @param out The produced image
+    void generate_img_time_surface_collapsing_channels(timestamp last_ts, timestamp delta_t, cv::Mat &out) const;
+
+private:
+    /// Index in the buffer of the first channel of a pixel
+    inline size_t index(int y, int x) const;
+
+    /// Moves the epoch so that @p ts can be stored, shifting all the stored timestamps
+    void rebase(timestamp ts);
+
+    /// Calls @p f(x, n, ts) for each run of n pixels of row @p y stored contiguously, starting at column x
+    template<typename F>
+    void for_each_row_run(int y, F &&f) const;
+
+    int rows_{0}, cols_{0}, channels_{0}; ///< Dimensions of the buffer
+    Layout layout_{Layout::RowMajor};     ///< Order of the pixels in memory
+    int tiles_per_row_{0};                ///< Number of tiles in a row of tiles, when the tiled layout is used
+    timestamp epoch_{0};                  ///< Timestamp the stored timestamps are relative to
+    std::vector<uint32_t> tsbuffer_;      ///< Buffer of the most recent timestamps, relative to the epoch
+};
+
+inline size_t CompactMostRecentTimestampBuffer::index(int y, int x) const {
+    if (layout_ == Layout::RowMajor) {
+        return (static_cast<size_t>(y) * cols_ + x) * channels_;
+    }
+    const size_t tile = static_cast<size_t>(y / tile_size) * tiles_per_row_ + x / tile_size;
+    return (tile * tile_size * tile_size + (y % tile_size) * tile_size + x % tile_size) * channels_;
+}
+
+inline void CompactMostRecentTimestampBuffer::set(int y, int x, int c, timestamp ts) {
+    BOOST_ASSERT_MSG(x >= 0 && x < cols_ && y >= 0 && y < rows_ && c >= 0 && c < channels_,
+                     "Input coordinates are outside the bounds of the buffer!");
+    if (ts - epoch_ > std::numeric_limits<uint32_t>::max()) {
+        rebase(ts);
+    }
+    tsbuffer_[index(y, x) + c] = ts > epoch_ ? static_cast<uint32_t>(ts - epoch_) : 0;
+}
+
+inline timestamp CompactMostRecentTimestampBuffer::at(int y, int x, int c) const {
+    BOOST_ASSERT_MSG(x >= 0 && x < cols_ && y >= 0 && y < rows_ && c >= 0 && c < channels_,
+                     "Input coordinates are outside the bounds of the buffer!");
+    return epoch_ + tsbuffer_[index(y, x) + c];
+}
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_CORE_COMPACT_MOSTRECENT_TIMESTAMP_BUFFER_H
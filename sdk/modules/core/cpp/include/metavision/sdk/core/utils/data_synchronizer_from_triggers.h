@@ -12,15 +12,17 @@
 #ifndef METAVISION_SDK_CORE_DATA_SYNCHRONIZER_FROM_TRIGGERS_H
 #define METAVISION_SDK_CORE_DATA_SYNCHRONIZER_FROM_TRIGGERS_H
 
+#include <atomic>
 #include <stdexcept>
-#include <deque>
 #include <condition_variable>
 #include <cmath>
 #include <functional>
+#include <mutex>
 
 #include "metavision/sdk/base/events/event_ext_trigger.h"
 #include "metavision/sdk/base/utils/timestamp.h"
 #include "metavision/sdk/core/utils/detail/iterator_traits.h"
+#include "metavision/sdk/core/utils/detail/spsc_queue.h"
 
 namespace Metavision {
 
@@ -48,7 +50,10 @@ namespace Metavision {
 /// Only one polarity is used for the synchronization (i.e. up or down, chosen by the user) as it is
 /// considered that each external data generates a pair of triggers (i.e. one data for two triggers).
 ///
-/// The synchronization routines are blocking and thread safe.
+/// The synchronization routines are blocking and thread safe: the triggers can be indexed from one thread while the
+/// data is synchronized from another one. The synchronization information is handed over through a lock-free single
+/// producer, single consumer queue, published once per call to @ref index_triggers, so that neither thread locks as
+/// long as the synchronization doesn't need to wait for triggers.
 ///
 class DataSynchronizerFromTriggers {
 public:
@@ -77,6 +82,13 @@ public:
         bool reference_polarity_{0};   ///< The trigger's polarity to use.
     };
 
+    /// @brief Statistics of the latency between the indexing of the triggers and the synchronization of the data
+    struct LatencyStatistics {
+        uint64_t count_{0};    ///< Number of synchronized data
+        timestamp mean_us_{0}; ///< Mean latency, in us
+        timestamp max_us_{0};  ///< Maximum latency, in us
+    };
+
 public:
     /// @brief Constructor
     /// @param parameters The @ref Parameters to use to configure this object.
@@ -88,6 +100,7 @@ public:
 
     /// @brief Resets the synchronization states variables.
     /// Unlocks any pending synchronization before clearing the synchronization information remaining to be used.
+    /// @warning Must not be called while triggers are being indexed or data is being synchronized
     void reset_synchronization();
 
     /// @brief Notifies this object that the synchronization is done
@@ -154,9 +167,35 @@ public:
     /// @param max_remaining_to_be_consumed The maximum number of pending external triggers
     void wait_for_triggers_consumed(uint32_t max_remaining_to_be_consumed = 0);
 
+    /// @brief Returns the statistics of the latency between the indexing of the triggers and the synchronization of
+    /// the data, since the last reset
+    LatencyStatistics get_latency_statistics() const;
+
 private:
+    /// Synchronization information, and the time at which it was indexed to compute the latency
+    struct PendingSynchronizationInformation {
+        SynchronizationInformation information;
+        timestamp indexing_time_us;
+    };
+
+    /// Returns the current system time, in us
+    static timestamp system_time_us();
+
+    /// Removes the synchronization information older than the data to synchronize, and returns true if some remains
+    bool has_synchronization_information(uint32_t data_index);
+
+    /// Waits until synchronization information is available for the data to synchronize or the source is done, and
+    /// returns true in the former case
+    bool wait_for_synchronization_information(uint32_t data_index);
+
+    /// Unlocks @ref wait_for_triggers_consumed if it is waiting
+    void notify_triggers_consumed();
+
+    /// Updates the latency statistics with the latency of a synchronized data
+    void add_latency(timestamp latency_us);
+
     /// Queue of synchronization information generated from received external triggers
-    std::deque<SynchronizationInformation> synchronization_information_deque_;
+    detail::SpscQueue<PendingSynchronizationInformation> synchronization_information_queue_;
 
     /// Parameters
     Parameters parameters_;
@@ -165,7 +204,7 @@ private:
     bool first_trigger_indexed_;
 
     /// Sets this triggers source as done i.e. we don't expect to receive anymore events
-    bool triggers_source_is_done_;
+    std::atomic<bool> triggers_source_is_done_;
 
     /// State variable to keep the count of the last generated index
     uint32_t last_synchronization_index_;
@@ -173,10 +212,17 @@ private:
     /// Last received trigger's timestamp
     timestamp last_synchronization_ts_us_;
 
-    /// Safety variable
+    /// Latency statistics, written by the synchronization thread only
+    std::atomic<uint64_t> latency_count_;
+    std::atomic<timestamp> latency_sum_us_;
+    std::atomic<timestamp> latency_max_us_;
+
+    /// Used to wait, only when the synchronization needs triggers or when waiting for them to be consumed
     std::mutex triggers_updated_mutex_;
     std::condition_variable wait_for_triggers_cond_;
     std::condition_variable wait_for_triggers_consumed_cond_;
+    std::atomic<int> waiting_for_triggers_count_{0};
+    std::atomic<int> waiting_for_triggers_consumed_count_{0};
 };
 
 } // namespace Metavision
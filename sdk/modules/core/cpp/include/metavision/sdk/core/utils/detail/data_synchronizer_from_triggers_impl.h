@@ -37,7 +37,7 @@ void DataSynchronizerFromTriggers::index_triggers(ExtTriggerIterator trigger_it,
         std::is_same<typename iterator_traits<IndexTriggerInserterIterator>::value_type, EventExtTrigger>::value,
         "Requires an output back inserter iterator over EventExtTrigger element.");
 
-    std::lock_guard<std::mutex> lock(triggers_updated_mutex_);
+    const timestamp indexing_time_us = system_time_us();
     for (; trigger_it != trigger_it_end; ++trigger_it, ++indexed_trigger_inserter_it) {
         // Consider the trigger only if polarity matches the reference one
         if (trigger_it->p != parameters_.reference_polarity_) {
@@ -74,7 +74,8 @@ void DataSynchronizerFromTriggers::index_triggers(ExtTriggerIterator trigger_it,
                 last_synchronization_ts_us_ += parameters_.period_us_;
 
                 // Push the trigger in the queue for synchronization
-                synchronization_information_deque_.push_back({last_synchronization_ts_us_, interpolated_index});
+                synchronization_information_queue_.push(
+                    {{last_synchronization_ts_us_, interpolated_index}, indexing_time_us});
                 *indexed_trigger_inserter_it =
                     EventExtTrigger(trigger_it->p, last_synchronization_ts_us_, trigger_it->id);
             }
@@ -89,11 +90,19 @@ void DataSynchronizerFromTriggers::index_triggers(ExtTriggerIterator trigger_it,
         }
 
         last_synchronization_ts_us_ = trigger_it->t;
-        synchronization_information_deque_.push_back({last_synchronization_ts_us_, last_synchronization_index_});
+        synchronization_information_queue_.push(
+            {{last_synchronization_ts_us_, last_synchronization_index_}, indexing_time_us});
         *indexed_trigger_inserter_it = EventExtTrigger(trigger_it->p, last_synchronization_ts_us_, trigger_it->id);
     }
 
-    wait_for_triggers_cond_.notify_all();
+    // All the triggers of the call are handed over at once, and the synchronization only needs to be woken up if it
+    // is waiting for them
+    synchronization_information_queue_.publish();
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiting_for_triggers_count_.load(std::memory_order_relaxed) > 0) {
+        std::lock_guard<std::mutex> lock(triggers_updated_mutex_);
+        wait_for_triggers_cond_.notify_all();
+    }
 }
 
 template<typename DataIterator>
@@ -102,8 +111,6 @@ uint32_t DataSynchronizerFromTriggers::synchronize_data_from_triggers(
     std::function<timestamp &(detail::value_t<DataIterator> &)> data_timestamp_accessor,
     std::function<uint32_t(const detail::value_t<DataIterator> &)> data_index_accessor) {
     auto data_it = data_it_begin;
-    std::unique_lock<std::mutex> lock(triggers_updated_mutex_);
-
     for (; data_it != data_it_end; ++data_it) {
         // ------------------------------
         // Check if the last sync info is older than the one to be synchronized.
@@ -114,61 +121,34 @@ uint32_t DataSynchronizerFromTriggers::synchronize_data_from_triggers(
         // synchronize
         // 4- Sync info are available in the queue but the oldest one's index is greater than the input data to
         // synchronize
+        //
+        // The sync info older than the current data is useless for the next data as well, as the indices are
+        // strictly increasing: it's consumed, which turns case 3 into case 2 and leaves the matching sync info in
+        // front in case 1
 
         // Cases 2 & 3 -> Need to wait for sync info
-        bool has_synchronization_info = false;
-
-        // We wait for new synchronization information if needed.
-        wait_for_triggers_cond_.wait(lock, [&]() {
-            // We check here if we have enough information to proceed with the synchronization
-            has_synchronization_info = !synchronization_information_deque_.empty() &&
-                                       last_synchronization_index_ >= data_index_accessor(*data_it);
-
-            if (!has_synchronization_info) {
-                if (!synchronization_information_deque_.empty()) {
-                    // The last index is lower than the idx that we are searching. We consume the triggers to avoid
-                    // a deadlock
-                    synchronization_information_deque_.clear();
-                }
-
-                // If not, all triggers have been used for synchronization. We notify to unlock any process
-                // waiting on this condition
-                wait_for_triggers_consumed_cond_.notify_all();
-            }
-            return has_synchronization_info || triggers_source_is_done_;
-        });
-
-        if (!has_synchronization_info) {
+        const uint32_t data_index = data_index_accessor(*data_it);
+        if (!has_synchronization_information(data_index) && !wait_for_synchronization_information(data_index)) {
             // Source is done and no sync info remains
             break;
         }
         // Here, even if source is done but we have triggers to synchronize, we use all we have.
 
-        // Case 4 -> interpolates sync info in the past
-        if (data_index_accessor(*data_it) < synchronization_information_deque_.front().index) {
-            SynchronizationInformation sync_info_past_interpolated = synchronization_information_deque_.front();
-            const auto data_index                                  = data_index_accessor(*data_it);
-            while (data_index < sync_info_past_interpolated.index) {
-                --sync_info_past_interpolated.index;
-                sync_info_past_interpolated.t -= parameters_.period_us_;
-                synchronization_information_deque_.push_front(sync_info_past_interpolated);
-            }
-        }
-
-        // Case 1 -> We have enough triggers
-        SynchronizationInformation sync_information = synchronization_information_deque_.front();
-        synchronization_information_deque_.pop_front();
-        while (data_index_accessor(*data_it) !=
-               sync_information.index) { // No need to check on size: the above checks ensure that the
-            // synchronization information is in the queue.
-            sync_information = synchronization_information_deque_.front();
-            synchronization_information_deque_.pop_front();
+        const PendingSynchronizationInformation &pending = synchronization_information_queue_.front();
+        add_latency(system_time_us() - pending.indexing_time_us);
+        if (data_index < pending.information.index) {
+            // Case 4 -> interpolates sync info in the past
+            data_timestamp_accessor(*data_it) =
+                pending.information.t -
+                static_cast<timestamp>(pending.information.index - data_index) * parameters_.period_us_;
+        } else {
+            // Case 1 -> We have enough triggers
+            data_timestamp_accessor(*data_it) = pending.information.t;
+            synchronization_information_queue_.pop();
         }
-
-        data_timestamp_accessor(*data_it) = sync_information.t;
     }
 
-    wait_for_triggers_consumed_cond_.notify_all();
+    notify_triggers_consumed();
 
     // compute the amount of data synchronized
     return std::distance(data_it_begin, data_it);
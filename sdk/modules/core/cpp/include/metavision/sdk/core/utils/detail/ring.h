@@ -12,12 +12,15 @@
 #ifndef METAVISION_SDK_CORE_DETAIL_RING_H
 #define METAVISION_SDK_CORE_DETAIL_RING_H
 
-#include <mutex>
-#include <vector>
-#include <iostream>
 #include <algorithm>
-#include <functional>
-#include <condition_variable>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <vector>
 
 #include "metavision/sdk/base/utils/timestamp.h"
 #include "metavision/sdk/core/utils/detail/iterator_traits.h"
@@ -30,485 +33,397 @@ inline timestamp get_time(const Event &ev) {
     return ev.t;
 }
 
-// accumulate events in the given range as long as num_events + diff(start, end) < max_events
-// returns true when (updated) num_events == max_events
-template<class Iterator>
-inline bool keep_upto_max_events(Iterator start_it, unsigned int &start_offset_incl, unsigned int end_offset_excl,
-                                 int &num_events, int max_events) {
-    int cur_num_events = static_cast<int>(std::distance(start_it + start_offset_incl, start_it + end_offset_excl));
-    bool ret           = (num_events + cur_num_events > max_events);
-    if (ret) {
-        unsigned int rem_events = max_events - num_events;
-        start_offset_incl += cur_num_events - rem_events;
-        cur_num_events = rem_events;
-    }
-    num_events += cur_num_events;
-    return ret;
-}
-
+/// Single producer, single consumer ring of events sorted by timestamps
+///
+/// The events are stored contiguously in a preallocated, cache-line aligned circular buffer, and each call to @ref add
+/// writes a chunk, whose header holds its position and the timestamp of its last event. The consumer finds the events
+/// before a timestamp with a binary search on the headers, then in the chunk, and copies them without any lock: the
+/// positions published by the producer and by the consumer are atomic, and on different cache lines.
+///
+/// When the producer runs out of space, the storage is doubled: the unread events are copied to a new storage, the
+/// previous one being kept alive until the consumer switches to the new one.
+///
+/// @ref add must be called from the producer thread, the functions reading or dropping events from the consumer
+/// thread (or serialized with it), the other functions from either thread.
 template<typename Event>
 class Ring {
 public:
     typedef Event type_data;
     typedef std::vector<Event> type_eventsadd;
 
-    Ring(unsigned int min_ring_capacity = 8, bool auto_shrink = true) :
-        min_ring_capacity_(min_ring_capacity), auto_shrink_(auto_shrink) {
-        ring_buffer_ = std::vector<std::vector<Event> *>(min_ring_capacity_);
-        for (unsigned int i = 0; i < min_ring_capacity_; i++) {
-            ring_buffer_[i] = new std::vector<Event>(1024);
+    static_assert(std::is_trivially_copyable<Event>::value, "Ring expects trivially copyable events.");
+
+    /// Events of the ring, in at most two contiguous ranges as the storage wraps around
+    ///
+    /// A view returned by @ref view_to or @ref view_remaining is valid until the next call of a consumer function.
+    struct View {
+        const Event *first_begin  = nullptr;
+        const Event *first_end    = nullptr;
+        const Event *second_begin = nullptr;
+        const Event *second_end   = nullptr;
+
+        std::size_t size() const {
+            return (first_end - first_begin) + (second_end - second_begin);
         }
-        ring_size_       = ring_buffer_.capacity();
-        ring_head_       = 0;
-        ring_next_       = 0;
-        next_buffer_ind_ = 0;
-        max_ring_size_   = 0;
-    }
-    ~Ring() {
-        std::unique_lock<std::mutex> lock(ring_mut_);
-        for (unsigned int i = 0; i < ring_size_; i++) {
-            delete ring_buffer_[i];
+
+        bool empty() const {
+            return size() == 0;
         }
-    }
-    void set_max_ring_size(unsigned int s) {
-        max_ring_size_ = s;
+
+        template<typename OutputIt>
+        OutputIt copy_to(OutputIt d_first) const {
+            return std::copy(second_begin, second_end, std::copy(first_begin, first_end, d_first));
+        }
+    };
+
+    /// Builds a ring
+    /// @param capacity Number of events preallocated, rounded up to a power of 2
+    /// @param chunk_capacity Number of chunk headers preallocated, rounded up to a power of 2
+    explicit Ring(std::size_t capacity = 1 << 16, std::size_t chunk_capacity = 256) {
+        storage_owner_.reset(new Storage(round_up_to_power_of_2(capacity), round_up_to_power_of_2(chunk_capacity)));
+        storage_.store(storage_owner_.get());
     }
 
+    Ring(const Ring &) = delete;
+    Ring &operator=(const Ring &) = delete;
+
+    /// Copies the events before @p ts, and removes them from the ring
     template<typename OutputIt>
     void fill_buffer_to(OutputIt d_first, timestamp ts) {
         static_assert(std::is_same<Event, typename iterator_traits<OutputIt>::value_type>::value,
                       "fill_buffer_to called with invalid type of events.");
 
-        std::unique_lock<std::mutex> lock(ring_mut_);
-        if (!data_available_internal()) {
-            return;
-        }
-
-        if (get_time(ring_buffer_[ring_head_]->back()) < ts) {
-            std::copy(ring_buffer_[ring_head_]->cbegin() + next_buffer_ind_, ring_buffer_[ring_head_]->cend(), d_first);
-            ring_head_       = (ring_head_ + 1) % ring_size_;
-            next_buffer_ind_ = 0;
-
-            while (data_available_internal() && get_time(ring_buffer_[ring_head_]->back()) < ts) {
-                std::copy(ring_buffer_[ring_head_]->cbegin(), ring_buffer_[ring_head_]->cend(), d_first);
-                ring_head_ = (ring_head_ + 1) % ring_size_;
-                if (ring_buffer_[ring_head_]->empty())
-                    return;
-            }
-        }
-        if (!data_available_internal())
-            return;
-        Event ev_ts;
-        ev_ts.t    = ts;
-        auto first = ring_buffer_[ring_head_]->cbegin() + next_buffer_ind_;
-        auto it_ts = std::lower_bound(first, ring_buffer_[ring_head_]->cend(), ev_ts,
-                                      [](const Event &ev1, const Event &ev2) { return get_time(ev1) < get_time(ev2); });
-        std::copy(first, it_ts, d_first);
-        next_buffer_ind_ = static_cast<unsigned int>(std::distance(ring_buffer_[ring_head_]->cbegin(), it_ts));
+        const Unread unread     = get_unread();
+        const std::uint64_t end = find(unread, ts);
+        make_view(*unread.storage, read_pos_.load(std::memory_order_relaxed), end).copy_to(d_first);
+        consume_to(unread, end);
+        release();
     }
 
-    // Fill the buffer with max_events events strictly before timestamp ts
+    /// Copies the last @p max_events events before @p ts, and removes all the events before @p ts from the ring
     template<typename OutputIt>
     void fill_buffer_to_drop_max_events(OutputIt d_first, timestamp ts, int max_events) {
         static_assert(std::is_same<Event, typename iterator_traits<OutputIt>::value_type>::value,
                       "fill_buffer_to_drop_max_events called with invalid type of events.");
 
-        std::unique_lock<std::mutex> lock(ring_mut_);
-        if (!data_available_internal()) {
-            return;
-        }
-
-        // ----------------- FIND BOUNDS ---------------------
-        Event ev_ts;
-        ev_ts.t = ts;
-        // all the events to keep are in the range :
-        // (ring_buffer[p_first]->begin() + first_start_incl, ring_buffer[p_last]->begin() + last_end_excl]
-        unsigned int p_first, p_last, p_cur;
-        unsigned int p_first_start_incl = 0, p_last_end_excl = 0;
-        int num_events = 0;
-
-        // find the last vector which contains events before requested ts using binary search
-        unsigned int count = buffer_delay(), cur_index, step;
-        p_last             = ring_head_;
-        while (count > 0) {
-            step      = count / 2;
-            cur_index = (p_last + step) % ring_size_;
-            if (get_time(ring_buffer_[cur_index]->front()) < ts) {
-                p_last = (cur_index + 1) % ring_size_;
-                count -= step + 1;
-            } else {
-                count = step;
-            }
-        }
-        if (p_last != ring_head_)
-            p_last = (p_last + ring_size_ - 1) % ring_size_;
-
-        // find last event with t >= ts
-        auto it_beg     = ring_buffer_[p_last]->begin() + (p_last == ring_head_ ? next_buffer_ind_ : 0);
-        auto it_end     = ring_buffer_[p_last]->end();
-        auto it_ts      = std::lower_bound(it_beg, it_end, ev_ts,
-                                      [](const Event &ev1, const Event &ev2) { return get_time(ev1) < get_time(ev2); });
-        p_last_end_excl = std::distance(ring_buffer_[p_last]->begin(), it_ts);
-
-        // from there, keep at most max_events events
-        p_first = p_last;
-        it_end  = ring_buffer_[p_last]->begin() + p_last_end_excl;
-        if (p_first == ring_head_) {
-            p_first_start_incl = next_buffer_ind_;
-            keep_upto_max_events(ring_buffer_[p_first]->begin(), p_first_start_incl, p_last_end_excl, num_events,
-                                 max_events);
-        } else {
-            p_first_start_incl = 0;
-            if (!keep_upto_max_events(ring_buffer_[p_first]->begin(), p_first_start_incl, p_last_end_excl, num_events,
-                                      max_events)) {
-                do {
-                    p_first = (p_first + ring_size_ - 1) % ring_size_;
-                } while (!keep_upto_max_events(ring_buffer_[p_first]->begin(), p_first_start_incl,
-                                               ring_buffer_[p_first]->size(), num_events, max_events) &&
-                         p_first != ring_head_);
-                if (num_events < max_events) {
-                    // p_first == ring_head_
-                    p_first_start_incl = next_buffer_ind_;
-                    keep_upto_max_events(ring_buffer_[p_first]->begin(), p_first_start_incl,
-                                         ring_buffer_[p_first]->size(), num_events, max_events);
-                }
-            }
-        }
-
-        // ----------------- FILL BUFFER ---------------------
-        p_cur = p_first;
-        if (p_cur != p_last) {
-            it_beg = ring_buffer_[p_first]->begin() + p_first_start_incl;
-            it_end = ring_buffer_[p_first]->end();
-            std::copy(it_beg, it_end, d_first);
-            p_cur = (p_cur + 1) % ring_size_;
-
-            while (p_cur != p_last) {
-                it_beg = ring_buffer_[p_cur]->begin();
-                it_end = ring_buffer_[p_cur]->end();
-                std::copy(it_beg, it_end, d_first);
-                p_cur = (p_cur + 1) % ring_size_;
-            }
-        }
-
-        // last vector to be added
-        it_beg = ring_buffer_[p_last]->begin() + (p_last == p_first ? p_first_start_incl : 0);
-        it_end = ring_buffer_[p_last]->begin() + p_last_end_excl;
-        std::copy(it_beg, it_end, d_first);
-
-        // update first vector of ring
-        next_buffer_ind_ = p_last_end_excl;
-        ring_head_       = p_last;
-        if (p_last_end_excl == ring_buffer_[p_last]->size()) {
-            next_buffer_ind_ = 0;
-            ring_head_       = (ring_head_ + 1) % ring_size_;
-        }
+        const Unread unread       = get_unread();
+        const std::uint64_t begin = read_pos_.load(std::memory_order_relaxed);
+        const std::uint64_t end   = find(unread, ts);
+        const std::uint64_t kept  = std::min<std::uint64_t>(end - begin, std::max(max_events, 0));
+        make_view(*unread.storage, end - kept, end).copy_to(d_first);
+        consume_to(unread, end);
+        release();
     }
 
+    /// Copies all the events, and removes them from the ring
     template<typename OutputIt>
     void fill_buffer_remaining(OutputIt d_first) {
         static_assert(std::is_same<Event, typename iterator_traits<OutputIt>::value_type>::value,
                       "fill_buffer_remaining called with invalid type of events.");
 
-        std::unique_lock<std::mutex> lock(ring_mut_);
-        if (ring_head_ != ring_next_) {
-            std::copy(ring_buffer_[ring_head_]->cbegin() + next_buffer_ind_, ring_buffer_[ring_head_]->cend(), d_first);
-            ring_head_       = (ring_head_ + 1) % ring_size_;
-            next_buffer_ind_ = 0;
-        }
-        while (ring_head_ != ring_next_) {
-            std::copy(ring_buffer_[ring_head_]->cbegin(), ring_buffer_[ring_head_]->cend(), d_first);
-            ring_head_ = (ring_head_ + 1) % ring_size_;
-            if (ring_buffer_[ring_head_]->empty())
-                break;
-        }
+        const Unread unread = get_unread();
+        make_view(*unread.storage, read_pos_.load(std::memory_order_relaxed), unread.end).copy_to(d_first);
+        consume_to(unread, unread.end);
+        release();
     }
 
-    void drop() {
-        std::unique_lock<std::mutex> lock(ring_mut_);
-        ring_head_       = ring_next_;
-        next_buffer_ind_ = 0;
+    /// Returns the events before @p ts without copying them, and removes them from the ring
+    ///
+    /// The events are only given back to the producer at the next call of a consumer function.
+    View view_to(timestamp ts) {
+        release();
+        const Unread unread     = get_unread();
+        const std::uint64_t end = find(unread, ts);
+        const View view         = make_view(*unread.storage, read_pos_.load(std::memory_order_relaxed), end);
+        consume_to(unread, end);
+        return view;
     }
 
-    void drop_max_events(int max_events) {
-        if (!data_available()) {
-            return;
-        }
-
-        std::unique_lock<std::mutex> lock(ring_mut_);
-        unsigned int start_buffer = ring_next_;
-
-        int num_events = 0;
-        while (start_buffer != ring_head_ && num_events < max_events) {
-            start_buffer = start_buffer > 0 ? start_buffer - 1 : ring_size_ - 1;
-            num_events += ring_buffer_[start_buffer]->size();
-        }
-        int num_events_pre = num_events - ring_buffer_[start_buffer]->size();
-        if (start_buffer == ring_head_)
-            num_events -= next_buffer_ind_;
-        else
-            next_buffer_ind_ = 0;
+    /// Returns all the events without copying them, and removes them from the ring
+    ///
+    /// The events are only given back to the producer at the next call of a consumer function.
+    View view_remaining() {
+        release();
+        const Unread unread = get_unread();
+        const View view     = make_view(*unread.storage, read_pos_.load(std::memory_order_relaxed), unread.end);
+        consume_to(unread, unread.end);
+        return view;
+    }
 
-        ring_head_ = start_buffer;
+    /// Removes all the events
+    void drop() {
+        const Unread unread = get_unread();
+        consume_to(unread, unread.end);
+        release();
+    }
 
-        if (num_events > max_events) {
-            next_buffer_ind_ = ring_buffer_[ring_head_]->size() - (max_events - num_events_pre);
-        }
+    /// Removes all the events but the last @p max_events ones
+    void drop_max_events(int max_events) {
+        const Unread unread       = get_unread();
+        const std::uint64_t begin = read_pos_.load(std::memory_order_relaxed);
+        const std::uint64_t kept  = std::min<std::uint64_t>(unread.end - begin, std::max(max_events, 0));
+        consume_to(unread, unread.end - kept);
+        release();
     }
 
+    /// Removes the events before @p ts, if the ring holds events at or after @p ts
     void drop_to(timestamp ts) {
-        if (!data_available(ts))
+        if (!data_available(ts)) {
             return;
-        std::unique_lock<std::mutex> lock(ring_mut_);
-
-        if (get_time(ring_buffer_[ring_head_]->back()) < ts) {
-            ring_head_       = (ring_head_ + 1) % ring_size_;
-            next_buffer_ind_ = 0;
-
-            while (get_time(ring_buffer_[ring_head_]->back()) < ts) {
-                ring_head_ = (ring_head_ + 1) % ring_size_;
-                if (ring_buffer_[ring_head_]->empty())
-                    break;
-            }
         }
-        Event ev_ts;
-        ev_ts.t          = ts;
-        auto cbegin      = ring_buffer_[ring_head_]->cbegin();
-        auto it_ts       = std::lower_bound(cbegin + next_buffer_ind_, ring_buffer_[ring_head_]->cend(), ev_ts,
-                                      [](const Event &ev1, const Event &ev2) { return get_time(ev1) < get_time(ev2); });
-        next_buffer_ind_ = static_cast<unsigned int>(std::distance(cbegin, it_ts));
+        const Unread unread = get_unread();
+        consume_to(unread, find(unread, ts));
+        release();
     }
 
-    void add(std::function<void(std::vector<Event> *)> &adder) {
-        std::unique_lock<std::mutex> lock(ring_mut_);
-        bool ovflow = false;
-        if (ring_head_ == (ring_next_ + 1) % ring_size_) {
-            if (max_ring_size_ && ring_size_ >= max_ring_size_) {
-                ovflow = true;
-            } else {
-                double_ring();
-            }
-        } else {
-            if (auto_shrink_ && buffer_delay() * 3 < ring_buffer_.capacity()) {
-                shrink_ring();
-            }
-        }
-        std::vector<Event> *buffer_to_write = ring_buffer_[ring_next_];
-        if (!ovflow) {
-            if (auto_shrink_ && buffer_to_write->size() * 3 < buffer_to_write->capacity()) {
-                std::vector<Event>().swap(*buffer_to_write);
-            } else {
-                buffer_to_write->clear();
-            }
+    /// Adds a chunk of events, whose timestamps must not be lower than the ones already added
+    template<class IteratorEv>
+    void add(IteratorEv start, IteratorEv end) {
+        const std::size_t n_events = static_cast<std::size_t>(std::distance(start, end));
+        if (n_events == 0) {
+            return;
         }
-        try {
-            adder(buffer_to_write);
-        } catch (std::bad_alloc &) {}
 
-        ring_next_ = (ring_next_ + 1) % ring_size_;
-    }
+        const std::uint64_t pos   = write_pos_.load(std::memory_order_relaxed);
+        const std::uint64_t chunk = write_chunk_.load(std::memory_order_relaxed);
+        Storage *storage          = storage_owner_.get();
+        if (pos + n_events - released_pos_.load(std::memory_order_acquire) > storage->capacity() ||
+            chunk + 1 - released_chunk_.load(std::memory_order_acquire) > storage->chunks.size()) {
+            storage = grow(n_events);
+        }
 
-    template<class IteratorEv>
-    void add(IteratorEv start, IteratorEv end) {
-        std::function<void(std::vector<Event> *)> adder = [start, end](std::vector<Event> *buf) {
-            buf->insert(buf->end(), start, end);
-        };
-        add(adder);
+        const std::size_t offset  = static_cast<std::size_t>(pos & storage->event_mask);
+        const std::size_t n_first = std::min(n_events, storage->capacity() - offset);
+        IteratorEv middle         = std::next(start, n_first);
+        std::copy(start, middle, storage->events + offset);
+        std::copy(middle, end, storage->events);
+
+        const timestamp last_t                       = get_time(storage->event(pos + n_events - 1));
+        storage->chunks[chunk & storage->chunk_mask] = Chunk{pos, pos + n_events, last_t};
+        last_time_.store(last_t, std::memory_order_relaxed);
+        write_pos_.store(pos + n_events, std::memory_order_release);
+        write_chunk_.store(chunk + 1, std::memory_order_release);
     }
 
-    void add(type_eventsadd &events) {
-        std::function<void(std::vector<Event> *)> adder = [&events](std::vector<Event> *buf) {
-            if (buf->size() != 0) {
-                buf->insert(buf->end(), events.begin(), events.end());
-            } else {
-                std::swap(*buf, events);
-            }
-        };
-        add(adder);
+    void add(const type_eventsadd &events) {
+        add(events.cbegin(), events.cend());
     }
 
     bool data_available() const {
-        std::unique_lock<std::mutex> lock(ring_mut_);
-        return data_available_internal();
+        return size() > 0;
     }
 
+    /// Returns true if the ring holds events at or after @p ts
     bool data_available(timestamp ts) const {
-        std::unique_lock<std::mutex> lock(ring_mut_);
-        if (ring_head_ == ring_next_) {
-            return false;
-        }
-        unsigned int last_buf_filled = (ring_next_ + ring_size_ - 1) % ring_size_;
-
-        if (ring_buffer_[last_buf_filled]->empty()) {
-            return false;
-        }
-
-        return get_time(ring_buffer_[last_buf_filled]->back()) >= ts;
+        return size() > 0 && last_time_.load(std::memory_order_relaxed) >= ts;
     }
 
     size_t size() const {
-        std::unique_lock<std::mutex> lock(ring_mut_);
-        size_t s       = 0;
-        unsigned int p = ring_head_;
-        if (p != ring_next_) {
-            s += std::distance(ring_buffer_[p]->begin() + next_buffer_ind_, ring_buffer_[p]->end());
-            p = (p + 1) % ring_size_;
-        }
-        while (p != ring_next_) {
-            s += std::distance(ring_buffer_[p]->begin(), ring_buffer_[p]->end());
-            p = (p + 1) % ring_size_;
-        }
-        return s;
+        const std::uint64_t read_pos = read_pos_.load(std::memory_order_acquire);
+        return static_cast<size_t>(write_pos_.load(std::memory_order_acquire) - read_pos);
     }
 
     timestamp get_first_time() const {
-        std::unique_lock<std::mutex> lock(ring_mut_);
-        if (ring_head_ == ring_next_)
-            return -1;
-
-        if (ring_buffer_[ring_head_]->empty())
+        const std::uint64_t read_pos = read_pos_.load(std::memory_order_acquire);
+        if (write_pos_.load(std::memory_order_acquire) == read_pos) {
             return -1;
-
-        return get_time(*(ring_buffer_[ring_head_]->begin() + next_buffer_ind_));
+        }
+        return get_time(storage_.load(std::memory_order_acquire)->event(read_pos));
     }
 
     timestamp get_last_time() const {
-        std::unique_lock<std::mutex> lock(ring_mut_);
-        if (ring_head_ == ring_next_)
-            return -1;
-
-        unsigned int last_buf_filled = (ring_next_ + ring_size_ - 1) % ring_size_;
-
-        if (ring_buffer_[last_buf_filled]->empty())
-            return -1;
-
-        return get_time(ring_buffer_[last_buf_filled]->back());
+        return data_available() ? last_time_.load(std::memory_order_relaxed) : -1;
     }
 
+    /// Removes all the events, and must not be called while events are added or read
     void clear() {
-        std::unique_lock<std::mutex> lock(ring_mut_);
-        for (auto v : ring_buffer_) {
-            v->clear();
-            ring_head_       = 0;
-            ring_next_       = 0;
-            next_buffer_ind_ = 0;
-        }
+        storage_owner_->previous.reset();
+        write_pos_.store(0);
+        write_chunk_.store(0);
+        read_pos_.store(0);
+        read_chunk_ = 0;
+        released_pos_.store(0);
+        released_chunk_.store(0);
+        last_time_.store(-1);
     }
+
     void stat_ring(std::ostream &os) {
-        os << std::dec << "RD : " << ring_buffer_.size() << " " << ring_buffer_.capacity() << " ";
-        long t_cap = 0;
-        long t_siz = 0;
-        for (auto v : ring_buffer_) {
-            if (v) {
-                t_cap += v->capacity();
-                t_siz += v->size();
-            }
+        const Storage *storage = storage_.load(std::memory_order_acquire);
+        os << std::dec << "CAP : " << storage->capacity() << " " << storage->chunks.size() << " ";
+        os << "RD : " << read_pos_.load() << " " << read_chunk_ << " ";
+        os << "WR : " << write_pos_.load() << " " << write_chunk_.load() << " ";
+        os << "EV : " << size() << " " << get_first_time() << " " << get_last_time() << std::endl;
+    }
+
+private:
+    static constexpr std::size_t cache_line_size_ = 64;
+
+    /// Header of the events added by a call to @ref add
+    struct Chunk {
+        std::uint64_t begin; ///< Position of the first event
+        std::uint64_t end;   ///< Position past the last event
+        timestamp last_t;    ///< Timestamp of the last event
+    };
+
+    /// Circular buffers of events and chunk headers, indexed by positions increasing since the ring was built
+    struct Storage {
+        Storage(std::size_t capacity, std::size_t chunk_capacity) :
+            event_mask(capacity - 1),
+            chunk_mask(chunk_capacity - 1),
+            bytes(new unsigned char[capacity * sizeof(Event) + cache_line_size_]),
+            chunks(chunk_capacity) {
+            void *ptr         = bytes.get();
+            std::size_t space = capacity * sizeof(Event) + cache_line_size_;
+            events = static_cast<Event *>(std::align(cache_line_size_, capacity * sizeof(Event), ptr, space));
         }
-        os << "IU : " << buffer_delay() << " ";
-        os << " RH " << ring_head_ << " RN " << ring_next_ << " IDX " << next_buffer_ind_ << " ";
-        if (ring_head_ == ring_next_)
-            os << " E1 ";
-        else {
-            unsigned int last_buf_filled = (ring_next_ + ring_size_ - 1) % ring_size_;
 
-            if (ring_buffer_[last_buf_filled]->empty())
-                os << " E2 ";
+        std::size_t capacity() const {
+            return static_cast<std::size_t>(event_mask + 1);
+        }
 
-            os << get_time(ring_buffer_[last_buf_filled]->back()) << " ";
+        const Event &event(std::uint64_t pos) const {
+            return events[pos & event_mask];
         }
-        os << "EV : " << t_cap << " " << t_siz << " " << std::endl;
-    }
 
-private:
-    unsigned int ring_size_       = 0;
-    unsigned int ring_head_       = 0;
-    unsigned int ring_next_       = 0;
-    unsigned int next_buffer_ind_ = 0;
-    std::vector<std::vector<Event> *> ring_buffer_;
-    unsigned int max_ring_size_ = 0;
-
-    bool data_available_internal() const {
-        return ring_head_ != ring_next_;
-    }
+        const Chunk &chunk(std::uint64_t index) const {
+            return chunks[index & chunk_mask];
+        }
 
-    unsigned int buffer_delay() {
-        if (ring_next_ > ring_head_) {
-            return ring_next_ - ring_head_;
-        } else {
-            return ring_next_ + ring_size_ - ring_head_;
+        std::uint64_t event_mask;
+        std::uint64_t chunk_mask;
+        std::unique_ptr<unsigned char[]> bytes;
+        Event *events;
+        std::vector<Chunk> chunks;
+        std::unique_ptr<Storage> previous; ///< Storage replaced by this one, freed once the consumer uses this one
+    };
+
+    /// Events published by the producer and not consumed yet, as seen by the consumer
+    struct Unread {
+        const Storage *storage;
+        std::uint64_t end_chunk;
+        std::uint64_t end;
+    };
+
+    static std::size_t round_up_to_power_of_2(std::size_t n) {
+        std::size_t p = 1;
+        while (p < n) {
+            p <<= 1;
         }
+        return p;
     }
 
-    void double_ring() {
-        //        std::unique_lock<std::mutex> lock(ring_mut_);
+    static View make_view(const Storage &storage, std::uint64_t begin, std::uint64_t end) {
+        const std::size_t n_events = static_cast<std::size_t>(end - begin);
+        const std::size_t offset   = static_cast<std::size_t>(begin & storage.event_mask);
+        const std::size_t n_first  = std::min(n_events, storage.capacity() - offset);
+        View view;
+        view.first_begin  = storage.events + offset;
+        view.first_end    = view.first_begin + n_first;
+        view.second_begin = storage.events;
+        view.second_end   = storage.events + (n_events - n_first);
+        return view;
+    }
 
-        // Save current size of the buffer
-        size_t old_size = ring_buffer_.capacity();
+    Unread get_unread() {
+        // The chunks are loaded first: the storage they were written in has been published before them
+        Unread unread;
+        unread.end_chunk = write_chunk_.load(std::memory_order_acquire);
+        Storage *storage = storage_.load(std::memory_order_acquire);
+        storage->previous.reset();
+        unread.storage = storage;
+        unread.end     = unread.end_chunk == read_chunk_ ? read_pos_.load(std::memory_order_relaxed) :
+                                                           storage->chunk(unread.end_chunk - 1).end;
+        return unread;
+    }
 
-        // Increase ring buffer size
-        ring_buffer_.resize(2 * old_size, nullptr);
-        // Regroup data if the space was inserted in the middle of it
-        if (ring_next_ < ring_head_) {
-            for (unsigned int i = 0; i < ring_next_; i++) {
-                ring_buffer_[old_size + i] = ring_buffer_[i];
-                ring_buffer_[i]            = nullptr;
+    /// Returns the position of the first unread event at or after @p ts
+    std::uint64_t find(const Unread &unread, timestamp ts) const {
+        // First chunk whose last event is at or after ts
+        std::uint64_t first = read_chunk_, last = unread.end_chunk;
+        while (first < last) {
+            const std::uint64_t middle = first + (last - first) / 2;
+            if (unread.storage->chunk(middle).last_t < ts) {
+                first = middle + 1;
+            } else {
+                last = middle;
             }
-            ring_next_ += old_size;
+        }
+        if (first == unread.end_chunk) {
+            return unread.end;
         }
 
-        // Update size
-        ring_size_ = ring_buffer_.capacity();
+        // First event of this chunk at or after ts
+        const Chunk &chunk  = unread.storage->chunk(first);
+        std::uint64_t begin = std::max(chunk.begin, read_pos_.load(std::memory_order_relaxed)), end = chunk.end;
+        while (begin < end) {
+            const std::uint64_t middle = begin + (end - begin) / 2;
+            if (get_time(unread.storage->event(middle)) < ts) {
+                begin = middle + 1;
+            } else {
+                end = middle;
+            }
+        }
+        return begin;
+    }
 
-        // Create buffers in empty spots
-        for (unsigned int i = 0; i < ring_size_; i++) {
-            if (ring_buffer_[i] == nullptr)
-                ring_buffer_[i] = new std::vector<Event>();
+    void consume_to(const Unread &unread, std::uint64_t pos) {
+        while (read_chunk_ < unread.end_chunk && unread.storage->chunk(read_chunk_).end <= pos) {
+            ++read_chunk_;
         }
+        read_pos_.store(pos, std::memory_order_release);
     }
 
-    void shrink_ring() {
-        //        std::unique_lock<std::mutex> lock(ring_next_mut_);
+    /// Gives the consumed events back to the producer
+    void release() {
+        released_chunk_.store(read_chunk_, std::memory_order_release);
+        released_pos_.store(read_pos_.load(std::memory_order_relaxed), std::memory_order_release);
+    }
 
-        // Save current size of the buffer
-        unsigned int old_size = ring_buffer_.capacity();
-        unsigned int new_size = (old_size + 1) / 2;
-        if (new_size < min_ring_capacity_ || new_size == ring_buffer_.capacity())
-            return;
-        std::vector<std::vector<Event> *> new_ring_buffer(new_size, nullptr);
-
-        // Increase ring buffer size
-        unsigned int idx           = ring_head_;
-        unsigned int new_ring_next = 0;
-        for (unsigned int i = 0; i < new_size; ++i) {
-            new_ring_buffer[i] = ring_buffer_[idx];
-            ring_buffer_[idx]  = 0;
-            if (idx == ring_next_)
-                new_ring_next = i;
-
-            idx = (idx + 1) % old_size;
+    /// Replaces the storage by a larger one, able to hold @p n_events more events and one more chunk
+    Storage *grow(std::size_t n_events) {
+        const std::uint64_t pos            = write_pos_.load(std::memory_order_relaxed);
+        const std::uint64_t chunk          = write_chunk_.load(std::memory_order_relaxed);
+        const std::uint64_t released_pos   = released_pos_.load(std::memory_order_acquire);
+        const std::uint64_t released_chunk = released_chunk_.load(std::memory_order_acquire);
+        const Storage &storage             = *storage_owner_;
+
+        std::size_t capacity = storage.capacity(), chunk_capacity = storage.chunks.size();
+        while (pos + n_events - released_pos > capacity) {
+            capacity *= 2;
         }
-
-        for (unsigned int i = 0; i < ring_size_; i++) {
-            if (ring_buffer_[i])
-                delete ring_buffer_[i];
+        while (chunk + 1 - released_chunk > chunk_capacity) {
+            chunk_capacity *= 2;
         }
 
-        ring_buffer_.swap(new_ring_buffer);
-        ring_head_ = 0;
-        ring_next_ = new_ring_next;
-        ring_size_ = new_size;
-
-        // Create buffers in empty spots
-        for (unsigned int i = 0; i < ring_size_; i++) {
-            if (ring_buffer_[i] == nullptr)
-                ring_buffer_[i] = new std::vector<Event>();
+        // The events released while copying are copied too, which is harmless
+        std::unique_ptr<Storage> new_storage(new Storage(capacity, chunk_capacity));
+        for (std::uint64_t p = released_pos; p < pos; ++p) {
+            new_storage->events[p & new_storage->event_mask] = storage.event(p);
+        }
+        for (std::uint64_t c = released_chunk; c < chunk; ++c) {
+            new_storage->chunks[c & new_storage->chunk_mask] = storage.chunk(c);
         }
+
+        new_storage->previous = std::move(storage_owner_);
+        storage_owner_        = std::move(new_storage);
+        storage_.store(storage_owner_.get(), std::memory_order_release);
+        return storage_owner_.get();
     }
 
-    mutable std::mutex ring_mut_;
-    unsigned int min_ring_capacity_;
-    bool auto_shrink_;
-    //    mutable std::mutex ring_next_mut_;
+    // Producer side
+    std::unique_ptr<Storage> storage_owner_;
+    std::atomic<Storage *> storage_{nullptr};
+    std::atomic<std::uint64_t> write_pos_{0};
+    std::atomic<std::uint64_t> write_chunk_{0};
+    std::atomic<timestamp> last_time_{-1};
+    char producer_padding_[cache_line_size_];
+
+    // Consumer side
+    std::atomic<std::uint64_t> read_pos_{0};
+    std::uint64_t read_chunk_{0};
+    std::atomic<std::uint64_t> released_pos_{0};
+    std::atomic<std::uint64_t> released_chunk_{0};
+    char consumer_padding_[cache_line_size_];
 };
 
 } // namespace detail
@@ -0,0 +1,133 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_CORE_DETAIL_SPSC_QUEUE_H
+#define METAVISION_SDK_CORE_DETAIL_SPSC_QUEUE_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace Metavision {
+namespace detail {
+
+/// Unbounded single producer, single consumer queue
+///
+/// The values are stored in linked blocks of @p BlockSize values. The producer pushes values without making them
+/// visible, and publishes them in a batch with @ref publish. The numbers of values published by the producer and
+/// removed by the consumer are atomic, and on different cache lines, so that neither side ever locks. A block left by
+/// the consumer is kept aside to be reused by the producer, so that no memory is allocated in steady state.
+///
+/// @ref push and @ref publish must be called from the producer thread, @ref front, @ref pop and @ref clear from the
+/// consumer thread, the other functions from either thread.
+template<typename T, std::size_t BlockSize = 1024>
+class SpscQueue {
+public:
+    SpscQueue() : head_block_(new Block), tail_block_(head_block_) {}
+
+    SpscQueue(const SpscQueue &) = delete;
+    SpscQueue &operator=(const SpscQueue &) = delete;
+
+    ~SpscQueue() {
+        while (head_block_ != nullptr) {
+            Block *next = head_block_->next;
+            delete head_block_;
+            head_block_ = next;
+        }
+        delete spare_block_.load();
+    }
+
+    /// Adds a value, which is not visible to the consumer until the next call to @ref publish
+    void push(const T &value) {
+        if (tail_pos_ == BlockSize) {
+            Block *block = spare_block_.exchange(nullptr);
+            if (block == nullptr) {
+                block = new Block;
+            }
+            block->next       = nullptr;
+            tail_block_->next = block;
+            tail_block_       = block;
+            tail_pos_         = 0;
+        }
+        tail_block_->values[tail_pos_++] = value;
+        ++pushed_;
+    }
+
+    /// Makes the values pushed so far visible to the consumer
+    void publish() {
+        published_.store(pushed_, std::memory_order_release);
+    }
+
+    /// Returns the number of published values not removed yet
+    std::size_t size() const {
+        const std::uint64_t popped = popped_.load(std::memory_order_acquire);
+        return static_cast<std::size_t>(published_.load(std::memory_order_acquire) - popped);
+    }
+
+    bool empty() const {
+        return size() == 0;
+    }
+
+    /// Returns the oldest published value, the queue must not be empty
+    const T &front() {
+        if (head_pos_ == BlockSize) {
+            // The producer linked the next block before publishing its first value
+            Block *block = head_block_;
+            head_block_  = head_block_->next;
+            head_pos_    = 0;
+            delete spare_block_.exchange(block);
+        }
+        return head_block_->values[head_pos_];
+    }
+
+    /// Removes the oldest published value, the queue must not be empty
+    void pop() {
+        front();
+        ++head_pos_;
+        popped_.store(popped_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    /// Removes all the published values
+    void clear() {
+        for (std::size_t n = size(); n > 0; --n) {
+            pop();
+        }
+    }
+
+private:
+    static constexpr std::size_t cache_line_size_ = 64;
+
+    struct Block {
+        std::array<T, BlockSize> values;
+        Block *next = nullptr;
+    };
+
+    // Consumer side
+    Block *head_block_;
+    std::size_t head_pos_{0};
+    std::atomic<std::uint64_t> popped_{0};
+    char consumer_padding_[cache_line_size_];
+
+    // Producer side
+    Block *tail_block_;
+    std::size_t tail_pos_{0};
+    std::uint64_t pushed_{0};
+    std::atomic<std::uint64_t> published_{0};
+    char producer_padding_[cache_line_size_];
+
+    std::atomic<Block *> spare_block_{nullptr};
+};
+
+} // namespace detail
+} // namespace Metavision
+
+#endif // METAVISION_SDK_CORE_DETAIL_SPSC_QUEUE_H
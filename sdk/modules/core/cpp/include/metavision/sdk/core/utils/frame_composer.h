@@ -12,7 +12,9 @@
 #ifndef METAVISION_SDK_CORE_FRAME_COMPOSER_H
 #define METAVISION_SDK_CORE_FRAME_COMPOSER_H
 
+#include <algorithm>
 #include <string>
+#include <utility>
 #include <vector>
 #include <opencv2/opencv.hpp>
 #include <opencv2/imgproc.hpp>
@@ -32,6 +34,11 @@ namespace Metavision {
 ///
 /// Ideally the class takes integer pixels as inputs (CV_8UC1 or CV_8UC3). In case of floating point values, the cv::Mat
 /// is converted to an int type, which might slightly slow down the process.
+///
+/// Each sub-image is converted and resized directly into its region of the big image. The grey levels are mapped to
+/// colors through a single lookup table combining the rescaling and the colormap, and the nearest neighbor resizing
+/// uses lookup tables of source pixels cached for the last input size. Several sub-images can be updated in parallel
+/// with @ref FrameComposer::update_subimages.
 class FrameComposer {
 public:
     enum InterpolationType { Nearest = cv::INTER_NEAREST, Linear = cv::INTER_LINEAR, Area = cv::INTER_AREA };
@@ -99,6 +106,25 @@ public:
     /// If the type is different than CV_8UC3 or CV_8UC1, then a conversion is performed
     bool update_subimage(unsigned int img_ref, const cv::Mat &image);
 
+    /// @brief Updates several sub-parts of the final image, as @ref update_subimage does for each of them
+    ///
+    /// The sub-images are converted in parallel, unless their regions overlap, in which case they are updated in the
+    /// order of @p updates.
+    ///
+    /// @param updates Reference IDs of the sub-images, along with the images to display at their location
+    /// @return false if one of the sub-images couldn't be updated
+    bool update_subimages(const std::vector<std::pair<unsigned int, cv::Mat>> &updates);
+
+    /// @brief Converts an image as it would be displayed in the sub-part corresponding to the reference @p img_ref,
+    /// without updating the final image
+    ///
+    /// Passing the result to @ref update_subimage later on then amounts to a copy.
+    ///
+    /// @param img_ref Reference ID of the sub-image, defined in the function @ref add_new_subimage_parameters
+    /// @param image Image to convert
+    /// @param output Converted CV_8UC3 image, of the size of the sub-image
+    bool convert_subimage(unsigned int img_ref, const cv::Mat &image, cv::Mat &output);
+
     /// @brief Gets the full image
     /// @return The composed image
     const cv::Mat &get_full_image() const;
@@ -115,14 +141,16 @@ private:
     /// @brief Struct containing an image alongside with its preprocessing options and relative position inside the
     /// final composed image
     struct ImageParams {
-        cv::Mat image, image_grey_tmp, image_copy_tmp;
+        cv::Mat image, image_resized_tmp, image_copy_tmp;
         cv::Point position;
         cv::Size size;
         cv::Rect roi;
-        int cmap;
         InterpolationType interp_type;
         bool enable_crop;
-        cv::Mat rescaling_lut;
+        cv::Mat grey_to_bgr_lut;        ///< Color of each grey level (CV_8UC3), empty if grey levels are kept
+        cv::Size nearest_lut_size;      ///< Size of the input image the nearest neighbor lookup tables are built for
+        std::vector<int> nearest_x_ofs; ///< Source column of each column of the sub-image
+        std::vector<int> nearest_y_ofs; ///< Source row of each row of the sub-image
     };
 
     /// @brief Fits the size of the FrameComposer canvas to the minimum englobing size, after adding a new subimage
@@ -130,20 +158,40 @@ private:
     /// @param new_subimage_id ID of the subimage that has just been added
     void fit_size(const unsigned int new_subimage_id);
 
-    /// @brief Processes the source image @p src according to the setting from @p params and saves it inside @p params
+    /// @brief Converts, crops and resizes the input image @p image according to the settings from @p params, and
+    /// writes the result in @p dst
+    /// @param image Input image
+    /// @param params Struct containing the subimage alongside with its preprocessing options and relative position
+    /// inside the final composed image
+    /// @param dst CV_8UC3 image of the size of the sub-image
+    bool process_subimage(const cv::Mat &image, ImageParams &params, cv::Mat &dst);
+
+    /// @brief Processes the source image @p src according to the setting from @p params and saves it inside @p dst
     ///
     /// If needed, the grey image is rescaled between the two extreme intensity values defined in @p params
     ///
-    /// @param src CV_8U or CV_8UC3 original input image
+    /// @param src CV_8U or CV_8UC3 original input image, of the size of the sub-image
     /// @param params Struct containing the subimage alongside with its preprocessing options and relative position
     /// inside the final composed image
-    void img_convert(const cv::Mat &src, ImageParams &params);
+    /// @param dst CV_8UC3 image of the size of the sub-image
+    void img_convert(const cv::Mat &src, const ImageParams &params, cv::Mat &dst);
 
-    /// @brief Applies a colormap on the grey image @p src and saves it inside @p params
+    /// @brief Applies the rescaling and the colormap on the grey image @p src and saves it inside @p dst
     /// @param src CV_8U original input image
     /// @param params Struct containing the subimage alongside with its preprocessing options and relative position
     /// inside the final composed image
-    void grey_to_bgr(const cv::Mat &src, ImageParams &params);
+    /// @param dst CV_8UC3 image of the size of the sub-image
+    void grey_to_bgr(const cv::Mat &src, const ImageParams &params, cv::Mat &dst);
+
+    /// @brief Resizes the image @p src with the nearest neighbor interpolation, and converts it to BGR if needed
+    ///
+    /// The source pixels are the same as the ones selected by cv::resize.
+    ///
+    /// @param src CV_8U or CV_8UC3 original input image
+    /// @param params Struct containing the subimage alongside with its preprocessing options and relative position
+    /// inside the final composed image
+    /// @param dst CV_8UC3 image of the size of the sub-image
+    void resize_nearest(const cv::Mat &src, ImageParams &params, cv::Mat &dst);
 
     unsigned int width_, height_;
     cv::Vec3b back_color_;
@@ -169,19 +217,29 @@ inline unsigned int FrameComposer::add_new_subimage_parameters(int top_left_x, i
     params.interp_type = resize_options.interp_type;
 
     // Rescaling and Colormap
-    params.cmap                  = gray_to_color_options.color_map_id; // Negative means no colormap
+    const int cmap               = gray_to_color_options.color_map_id; // Negative means no colormap
     const unsigned char &min_val = gray_to_color_options.min_rescaling_value;
     const unsigned char &max_val = gray_to_color_options.max_rescaling_value;
+    const bool rescale           = min_val < max_val && (min_val != 0 || max_val != 255);
 
-    if (min_val < max_val && (min_val != 0 || max_val != 255)) {
-        const double scale  = 255. / (max_val - min_val);
-        const double offset = -min_val * scale;
-
-        params.rescaling_lut = cv::Mat(1, 256, CV_8UC1);
-        uchar *p             = params.rescaling_lut.ptr();
+    if (rescale || cmap >= 0) {
+        // Both the rescaling and the colormap map each grey level to a value: they are combined in a single table
+        cv::Mat grey_lut(1, 256, CV_8UC1);
+        uchar *p = grey_lut.ptr();
         for (int i = 0; i < 256; ++i) {
-            p[i] = std::min(255, std::max(0, int(offset + scale * i))); // clamp
+            p[i] = i;
+        }
+        if (rescale) {
+            const double scale  = 255. / (max_val - min_val);
+            const double offset = -min_val * scale;
+            for (int i = 0; i < 256; ++i) {
+                p[i] = std::min(255, std::max(0, int(offset + scale * i))); // clamp
+            }
         }
+        if (cmap >= 0)
+            cv::applyColorMap(grey_lut, params.grey_to_bgr_lut, cmap);
+        else
+            cv::cvtColor(grey_lut, params.grey_to_bgr_lut, cv::COLOR_GRAY2BGR, 3);
     }
     srcs_.push_back(params);
     const unsigned int id = static_cast<unsigned int>(srcs_.size() - 1);
@@ -194,7 +252,46 @@ inline bool FrameComposer::update_subimage(unsigned int img_ref, const cv::Mat &
         return false;
 
     ImageParams &params = srcs_[img_ref];
+    return process_subimage(image, params, params.image);
+}
+
+inline bool FrameComposer::update_subimages(const std::vector<std::pair<unsigned int, cv::Mat>> &updates) {
+    // Each sub-image only writes in its own region and its own buffers, hence the sub-images can be processed in
+    // parallel as long as their regions don't overlap
+    bool parallel = updates.size() > 1;
+    for (size_t i = 0; parallel && i < updates.size(); ++i) {
+        parallel = updates[i].first < srcs_.size();
+        for (size_t j = 0; parallel && j < i; ++j) {
+            parallel = updates[j].first != updates[i].first &&
+                       (srcs_[updates[j].first].roi & srcs_[updates[i].first].roi).area() == 0;
+        }
+    }
+
+    if (!parallel) {
+        bool updated = true;
+        for (const auto &update : updates)
+            updated = update_subimage(update.first, update.second) && updated;
+        return updated;
+    }
+
+    std::vector<uchar> updated(updates.size(), 0);
+    cv::parallel_for_(cv::Range(0, static_cast<int>(updates.size())), [&](const cv::Range &range) {
+        for (int i = range.start; i < range.end; ++i)
+            updated[i] = update_subimage(updates[i].first, updates[i].second);
+    });
+    return std::all_of(updated.cbegin(), updated.cend(), [](uchar u) { return u != 0; });
+}
+
+inline bool FrameComposer::convert_subimage(unsigned int img_ref, const cv::Mat &image, cv::Mat &output) {
+    if (img_ref >= srcs_.size() || image.empty())
+        return false;
+
+    ImageParams &params = srcs_[img_ref];
+    output.create(params.size, CV_8UC3);
+    return process_subimage(image, params, output);
+}
 
+inline bool FrameComposer::process_subimage(const cv::Mat &image, ImageParams &params, cv::Mat &dst) {
     // Ideally the class takes integer pixels as inputs
     // In case of floating point values, they're converted to integers
     if (image.type() != CV_8UC1 && image.type() != CV_8UC3) {
@@ -209,47 +306,87 @@ inline bool FrameComposer::update_subimage(unsigned int img_ref, const cv::Mat &
             MV_SDK_LOG_ERROR() << "Frames must have either 1 or 3 channels, not " << image.channels();
             return false;
         }
-        return update_subimage(img_ref, params.image_copy_tmp);
+        return process_subimage(params.image_copy_tmp, params, dst);
     }
 
     // Resize if needed
     if (image.size() == params.size)
-        img_convert(image, params);
+        img_convert(image, params, dst);
     else if (params.enable_crop && image.cols >= params.size.width && image.rows >= params.size.height) {
         const cv::Rect crop_rect((image.cols - params.size.width) / 2, (image.rows - params.size.height) / 2,
                                  params.size.width, params.size.height);
-        img_convert(image(crop_rect), params);
-    } else {
-        cv::resize(image, params.image, params.size, 0., 0., params.interp_type);
-        if (image.channels() != 3) // Otherwise the color image is already in params.image
-            img_convert(params.image, params);
+        img_convert(image(crop_rect), params, dst);
+    } else if (params.interp_type == Nearest)
+        resize_nearest(image, params, dst);
+    else if (image.channels() == 3)
+        cv::resize(image, dst, params.size, 0., 0., params.interp_type);
+    else {
+        cv::resize(image, params.image_resized_tmp, params.size, 0., 0., params.interp_type);
+        img_convert(params.image_resized_tmp, params, dst);
     }
-    assert(!params.image.empty());
+    assert(!dst.empty());
     return true;
 }
 
-inline void FrameComposer::img_convert(const cv::Mat &src, ImageParams &params) {
+inline void FrameComposer::img_convert(const cv::Mat &src, const ImageParams &params, cv::Mat &dst) {
     if (src.channels() == 3) {
-        src.copyTo(params.image);
+        src.copyTo(dst);
         return;
     }
 
     assert(src.channels() == 1);
-    // Apply Rescaling if needed
-    if (params.rescaling_lut.empty())
-        grey_to_bgr(src, params);
-    else {
-        cv::LUT(src, params.rescaling_lut, params.image_grey_tmp);
-        grey_to_bgr(params.image_grey_tmp, params);
+    grey_to_bgr(src, params, dst);
+}
+
+inline void FrameComposer::grey_to_bgr(const cv::Mat &src, const ImageParams &params, cv::Mat &dst) {
+    // Apply rescaling and colormap if needed
+    if (params.grey_to_bgr_lut.empty()) {
+        cv::cvtColor(src, dst, cv::COLOR_GRAY2BGR, 3);
+        return;
+    }
+
+    const cv::Vec3b *lut = params.grey_to_bgr_lut.ptr<cv::Vec3b>();
+    for (int y = 0; y < src.rows; ++y) {
+        const uchar *src_row = src.ptr<uchar>(y);
+        cv::Vec3b *dst_row   = dst.ptr<cv::Vec3b>(y);
+        for (int x = 0; x < src.cols; ++x)
+            dst_row[x] = lut[src_row[x]];
     }
 }
 
-inline void FrameComposer::grey_to_bgr(const cv::Mat &src, ImageParams &params) {
-    // Apply colormap if needed
-    if (params.cmap >= 0)
-        cv::applyColorMap(src, params.image, params.cmap);
-    else
-        cv::cvtColor(src, params.image, cv::COLOR_GRAY2BGR, 3);
+inline void FrameComposer::resize_nearest(const cv::Mat &src, ImageParams &params, cv::Mat &dst) {
+    if (params.nearest_lut_size != src.size()) {
+        // Same source pixels as cv::resize with cv::INTER_NEAREST
+        const double ifx = 1. / (static_cast<double>(params.size.width) / src.cols);
+        const double ify = 1. / (static_cast<double>(params.size.height) / src.rows);
+        params.nearest_x_ofs.resize(params.size.width);
+        params.nearest_y_ofs.resize(params.size.height);
+        for (int x = 0; x < params.size.width; ++x)
+            params.nearest_x_ofs[x] = std::min(cvFloor(x * ifx), src.cols - 1);
+        for (int y = 0; y < params.size.height; ++y)
+            params.nearest_y_ofs[y] = std::min(cvFloor(y * ify), src.rows - 1);
+        params.nearest_lut_size = src.size();
+    }
+
+    const int *x_ofs = params.nearest_x_ofs.data();
+    for (int y = 0; y < params.size.height; ++y) {
+        const uchar *src_row = src.ptr<uchar>(params.nearest_y_ofs[y]);
+        cv::Vec3b *dst_row   = dst.ptr<cv::Vec3b>(y);
+        if (src.channels() == 3) {
+            const cv::Vec3b *src_bgr_row = reinterpret_cast<const cv::Vec3b *>(src_row);
+            for (int x = 0; x < params.size.width; ++x)
+                dst_row[x] = src_bgr_row[x_ofs[x]];
+        } else if (!params.grey_to_bgr_lut.empty()) {
+            const cv::Vec3b *lut = params.grey_to_bgr_lut.ptr<cv::Vec3b>();
+            for (int x = 0; x < params.size.width; ++x)
+                dst_row[x] = lut[src_row[x_ofs[x]]];
+        } else {
+            for (int x = 0; x < params.size.width; ++x) {
+                const uchar grey = src_row[x_ofs[x]];
+                dst_row[x]       = cv::Vec3b(grey, grey, grey);
+            }
+        }
+    }
 }
 
 inline void FrameComposer::fit_size(const unsigned int new_subimage_id) {
@@ -12,9 +12,9 @@
 #ifndef METAVISION_SDK_CORE_RATE_ESTIMATOR_H
 #define METAVISION_SDK_CORE_RATE_ESTIMATOR_H
 
-#include <mutex>
 #include <functional>
 #include <deque>
+#include <vector>
 
 #include "metavision/sdk/base/utils/timestamp.h"
 
@@ -30,6 +30,10 @@ namespace Metavision {
 ///  duration</em> during last <em>window duration</em> (thus, peak duration must always be less or equal to window
 ///  duration)
 ///
+/// The samples are accumulated in buckets of <em>peak duration</em>, aligned on multiples of it, so that both rates
+/// are updated in constant time whatever the number of samples in the window. The window is thus rounded to whole
+/// buckets, which has no effect when the step and window durations are multiples of the peak duration.
+///
 /// The average and peak rate are then output via a callback which is called :
 /// - every <em>step duration</em> of system time, if @c system_time_flag is true
 /// - everytime a sample with a timestamp > (last callback time + <em>step duration</em>) is added,
@@ -53,6 +57,7 @@ public:
     /// @param window_time Time window used to compute the average and peak rates
     /// @param system_time_flag If true, the callback will be called when the sytem time becomes higher than current
     ///                         multiple of @p step_time, otherwise the sample time is used
+    /// @throw std::invalid_argument if @p step_time or @p window_time is not strictly positive
     RateEstimator(const Callback &cb = Callback(), timestamp step_time = 100000, timestamp window_time = 1000000,
                   bool system_time_flag = false);
 
@@ -64,6 +69,8 @@ public:
     ///           peak rates over the counts added in the @p window_time span
     /// @param system_time_flag If true, the callback will be called when the sytem time becomes higher than current
     ///                         multiple of @p step_time, otherwise the sample time is used
+    /// @throw std::invalid_argument if @p step_time or @p peak_time is not strictly positive
+    /// @throw std::runtime_error if @p peak_time is not lower than @p window_time
     RateEstimator(timestamp step_time, timestamp window_time, timestamp peak_time, const Callback &cb,
                   bool system_time_flag = false);
 
@@ -98,9 +105,28 @@ public:
     timestamp peak_time() const;
 
 private:
+    struct Bucket {
+        timestamp index; ///< Index of the bucket, holding the samples of ](index - 1) * peak_time, index * peak_time]
+        size_t count;    ///< Sum of the counts of the samples of the bucket
+    };
+
+    /// @brief Returns the i-th oldest bucket
+    Bucket &bucket(size_t i);
+
+    /// @brief Removes the oldest bucket
+    void pop_bucket();
+
+    /// @brief Updates the window to end at @p callback_time, and returns the sum and maximum of its bucket counts
+    std::pair<size_t, size_t> update_window(timestamp callback_time);
+
     Callback cb_;
     timestamp window_time_, step_time_, peak_time_, next_time_;
-    std::deque<std::pair<timestamp, size_t>> counts_;
+    std::vector<Bucket> buckets_;     ///< Ring of the buckets with samples, from the oldest to the newest
+    size_t first_bucket_{0};          ///< Position of the oldest bucket in the ring
+    size_t n_buckets_{0};             ///< Number of buckets in the ring
+    size_t n_window_buckets_{0};      ///< Number of buckets, from the oldest, accounted in the window below
+    size_t window_count_{0};          ///< Sum of the counts of the buckets accounted in the window
+    std::deque<Bucket> peak_buckets_; ///< Buckets of the window with decreasing counts, the first one being the peak
     bool system_time_flag_;
 };
 
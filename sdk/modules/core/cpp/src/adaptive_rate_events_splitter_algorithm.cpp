@@ -10,6 +10,7 @@
  **********************************************************************************************************************/
 
 #include "metavision/sdk/core/algorithms/adaptive_rate_events_splitter_algorithm.h"
+#include "metavision/sdk/core/utils/detail/bitinstructions.h"
 
 namespace Metavision {
 
@@ -31,10 +32,17 @@ AdaptiveRateEventsSplitterAlgorithm::AdaptiveRateEventsSplitterAlgorithm(int hei
 }
 
 void AdaptiveRateEventsSplitterAlgorithm::reset_local_variables() {
-    img_pos_.resize(height_ * width_);
-    img_neg_.resize(height_ * width_);
-    std::fill(img_pos_.begin(), img_pos_.end(), 0);
-    std::fill(img_neg_.begin(), img_neg_.end(), 0);
+    if (img_counts_.empty()) {
+        img_counts_.resize(height_ * width_, {{0, 0}});
+        active_pixels_.resize((img_counts_.size() + 31) / 32, 0);
+    }
+    // Only the counters of the pixels with events are reset, instead of the full images
+    for (std::size_t i = 0; i < active_pixels_.size(); ++i) {
+        for (std::uint32_t word = active_pixels_[i]; word != 0; word &= word - 1) {
+            img_counts_[32 * i + ctz(word)] = {{0, 0}};
+        }
+        active_pixels_[i] = 0;
+    }
 
     nb_pos_                 = 0;
     mean_pos_               = 0.f;
@@ -55,4 +63,29 @@ void AdaptiveRateEventsSplitterAlgorithm::reset_local_variables() {
     events_.clear();
 }
 
+bool AdaptiveRateEventsSplitterAlgorithm::is_slice_ready() {
+    float var_per_event_pos = 0.f;
+    if (nb_pos_ == 0) {
+        assert(var_pos_ == 0.f);
+    } else {
+        var_per_event_pos = var_pos_ / nb_pos_;
+    }
+    float var_per_event_neg = 0.f;
+    if (nb_neg_ == 0) {
+        assert(var_neg_ == 0.f);
+    } else {
+        var_per_event_neg = var_neg_ / nb_neg_;
+    }
+    const float ratio_pix_both = nb_both_pos_and_neg_pix_ / (nb_pos_pix_ + nb_neg_pix_ + 1e-5f);
+
+    if ((ratio_pix_both >= kMaxRatioBothPix) ||
+        ((var_per_event_neg < prev_var_per_event_neg_) && (var_per_event_neg > thr_var_per_event_)) ||
+        ((var_per_event_pos < prev_var_per_event_pos_) && (var_per_event_pos > thr_var_per_event_))) {
+        return true;
+    }
+    prev_var_per_event_neg_ = var_per_event_neg;
+    prev_var_per_event_pos_ = var_per_event_pos;
+    return false;
+}
+
 } // namespace Metavision
\ No newline at end of file
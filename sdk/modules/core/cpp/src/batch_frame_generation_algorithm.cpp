@@ -0,0 +1,28 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include "metavision/sdk/core/algorithms/batch_frame_generation_algorithm.h"
+
+namespace Metavision {
+
+BatchFrameGenerationAlgorithm::BatchFrameGenerationAlgorithm(int sensor_width, int sensor_height,
+                                                             const Metavision::ColorPalette &palette) :
+    BaseFrameGenerationAlgorithm(sensor_width, sensor_height, palette) {}
+
+void BatchFrameGenerationAlgorithm::set_max_threads(int max_threads) {
+    max_threads_ = max_threads;
+}
+
+int BatchFrameGenerationAlgorithm::get_max_threads() const {
+    return max_threads_;
+}
+
+} // namespace Metavision
@@ -39,19 +39,21 @@ CDFrameGenerator::~CDFrameGenerator() {
 
 void CDFrameGenerator::set_colors(const cv::Scalar &background_color, const cv::Scalar &on_color,
                                   const cv::Scalar &off_color, bool colored) {
-    std::lock_guard<std::mutex> lock(processing_mutex_);
+    std::lock_guard<std::mutex> lock(params_mutex_);
     off_color_        = off_color;
     on_color_         = on_color;
     background_color_ = background_color;
     colored_          = colored;
+    params_changed_   = true;
 }
 
 void CDFrameGenerator::set_color_palette(const Metavision::ColorPalette &palette) {
-    std::lock_guard<std::mutex> lock(processing_mutex_);
+    std::lock_guard<std::mutex> lock(params_mutex_);
     off_color_        = BaseFrameGenerationAlgorithm::get_cv_color(palette, ColorType::Negative);
     on_color_         = BaseFrameGenerationAlgorithm::get_cv_color(palette, ColorType::Positive);
     background_color_ = BaseFrameGenerationAlgorithm::get_cv_color(palette, ColorType::Background);
     colored_          = palette != ColorPalette::Gray;
+    params_changed_   = true;
 }
 
 void CDFrameGenerator::add_events(const EventCD *begin, const EventCD *end) {
@@ -64,42 +66,145 @@ void CDFrameGenerator::add_events(const EventCD *begin, const EventCD *end) {
         return;
     }
 
-    std::lock_guard<std::mutex> lock(processing_mutex_);
+    if (publish_pending_) {
+        // The generation thread may publish the write buffer itself, see collect_pending_buffer
+        std::lock_guard<std::mutex> lock(pending_mutex_);
+        if (append_events(begin, end)) {
+            publish_pending_ = true;
+        }
+        if (publish_pending_) {
+            publish_write_buffer();
+        }
+        return;
+    }
+
+    if (!append_events(begin, end) || publish_write_buffer()) {
+        return;
+    }
+
+    // The generation thread has not consumed the shared buffer yet: it will publish the write buffer once it does, in
+    // case no more events are added. Publishing is retried once the request is made, as the shared buffer may have
+    // been consumed in the meantime, before the generation thread could see the request
+    std::lock_guard<std::mutex> lock(pending_mutex_);
+    publish_pending_ = true;
+    publish_write_buffer();
+}
+
+bool CDFrameGenerator::append_events(const EventCD *begin, const EventCD *end) {
+    const std::uint32_t reset_count = reset_count_.load(std::memory_order_acquire);
+    if (reset_count != write_reset_count_) {
+        buffers_[write_buffer_].events_.clear();
+        next_notify_us_    = notify_slice_us_;
+        publish_pending_   = false;
+        write_reset_count_ = reset_count;
+    }
+
     // Note: one could call frame_generation_algorithm->process_events directly but it may have a high overhead
     // depending on the inputs.and decreases the performance. Better ensure that bigger chunks of data are processed
-    events_back_.insert(events_back_.end(), begin, end);
+    EventsBuffer &buffer = buffers_[write_buffer_];
+    if (buffer.events_.empty()) {
+        buffer.reset_count_ = write_reset_count_;
+    }
+    buffer.events_.insert(buffer.events_.end(), begin, end);
     if (std::prev(end)->t > next_notify_us_) {
-        events_available_ = true;
-        next_notify_us_   = notify_slice_us_ * (1 + begin->t / notify_slice_us_);
+        const timestamp notify_slice_us = notify_slice_us_;
+        next_notify_us_                 = notify_slice_us * (1 + begin->t / notify_slice_us);
+        return true;
+    }
+    return false;
+}
+
+bool CDFrameGenerator::publish_write_buffer() {
+    // The shared buffer is only flagged by the producer and unflagged by the generation thread: if it is not flagged,
+    // the generation thread is done with it and it can be swapped with the filled one
+    const int shared_buffer = shared_buffer_.load();
+    if (shared_buffer & published_flag_) {
+        return false;
+    }
+    shared_buffer_.store(write_buffer_ | published_flag_);
+    write_buffer_    = shared_buffer;
+    publish_pending_ = false;
+
+    // Pairs with the check of shared_buffer_ after waiting_for_events_ is set in wait_for_published_events: either the
+    // generation thread sees the published buffer, or this thread sees it waiting
+    if (waiting_for_events_.load()) {
+        std::lock_guard<std::mutex> lock(wait_mutex_);
         events_available_cond_.notify_all();
     }
+    return true;
+}
+
+void CDFrameGenerator::collect_pending_buffer() {
+    // Pairs with the check of shared_buffer_ after publish_pending_ is set in add_events: either add_events sees the
+    // shared buffer consumed, or this thread sees the request
+    if (!publish_pending_) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(pending_mutex_);
+    if (publish_pending_) {
+        publish_write_buffer();
+    }
 }
 
 void CDFrameGenerator::set_display_accumulation_time_us(timestamp display_accumulation_time_us) {
-    std::lock_guard<std::mutex> lock(processing_mutex_);
+    std::lock_guard<std::mutex> lock(params_mutex_);
     accumulation_time_us_ = display_accumulation_time_us;
     notify_slice_us_      = std::max(timestamp(100), display_accumulation_time_us / 3);
+    params_changed_       = true;
+}
+
+void CDFrameGenerator::wait_for_published_events() {
+    if (shared_buffer_.load() & published_flag_) {
+        return;
+    }
+    std::unique_lock<std::mutex> lock(wait_mutex_);
+    waiting_for_events_ = true;
+    events_available_cond_.wait(lock, [this]() { return (shared_buffer_.load() & published_flag_) || stop_; });
+    waiting_for_events_ = false;
+}
+
+void CDFrameGenerator::process_buffer(std::vector<EventCD> &events, std::uint32_t reset_count) {
+    if (reset_count == render_reset_count_) {
+        if (!process_all_frames_ && !events.empty()) {
+            // Generates only the last possible frame
+            frame_generation_algo_->skip_frames_up_to(events.back().t);
+        }
+        frame_generation_algo_->process_events(events.cbegin(), events.cend());
+    }
+    events.clear();
 }
 
 bool CDFrameGenerator::generate() {
-    {
-        std::unique_lock<std::mutex> lock(processing_mutex_);
-        events_available_cond_.wait(lock, [this]() { return events_available_ || stop_; });
-        events_front_.clear();
-        events_front_.swap(events_back_);
-        events_available_ = false;
+    wait_for_published_events();
+    const bool stop = stop_;
 
-        frame_generation_algo_->set_accumulation_time_us(accumulation_time_us_);
-        frame_generation_algo_->set_colors(background_color_, on_color_, off_color_, colored_);
+    const int shared_buffer = shared_buffer_.load();
+    if (shared_buffer & published_flag_) {
+        shared_buffer_.store(read_buffer_);
+        read_buffer_ = shared_buffer & ~published_flag_;
+        if (!stop) {
+            // When stopping, the write buffer is flushed below
+            collect_pending_buffer();
+        }
     }
 
-    if (!process_all_frames_ && !events_front_.empty()) {
-        // Generates only the last possible frame
-        frame_generation_algo_->skip_frames_up_to(events_front_.back().t);
+    const std::uint32_t reset_count = reset_count_.load(std::memory_order_acquire);
+    if (reset_count != render_reset_count_) {
+        frame_generation_algo_->reset();
+        render_reset_count_ = reset_count;
     }
 
-    frame_generation_algo_->process_events(events_front_.cbegin(), events_front_.cend());
-    if (stop_) {
+    if (params_changed_.exchange(false)) {
+        std::lock_guard<std::mutex> lock(params_mutex_);
+        frame_generation_algo_->set_accumulation_time_us(accumulation_time_us_);
+        frame_generation_algo_->set_colors(background_color_, on_color_, off_color_, colored_);
+    }
+
+    process_buffer(buffers_[read_buffer_].events_, buffers_[read_buffer_].reset_count_);
+    if (stop) {
+        // add_events is not called concurrently with stop, the events not yet published can be flushed
+        process_buffer(buffers_[write_buffer_].events_, buffers_[write_buffer_].reset_count_);
+        publish_pending_ = false;
         frame_generation_algo_->force_generate();
     }
 
@@ -109,7 +214,7 @@ bool CDFrameGenerator::generate() {
     }
     frames_count_ = 0;
 
-    return !stop_;
+    return !stop;
 }
 
 bool CDFrameGenerator::start(std::uint16_t fps, const PeriodicFrameGenerationAlgorithm::OutputCb &cb) {
@@ -140,7 +245,10 @@ bool CDFrameGenerator::start(std::uint16_t fps, const PeriodicFrameGenerationAlg
 }
 
 bool CDFrameGenerator::stop() {
-    stop_ = true;
+    {
+        std::lock_guard<std::mutex> lock(wait_mutex_);
+        stop_ = true;
+    }
     events_available_cond_.notify_all();
     if (process_all_frames_) {
         processing_thread_.stop();
@@ -156,10 +264,7 @@ bool CDFrameGenerator::stop() {
 }
 
 void CDFrameGenerator::reset() {
-    std::lock_guard<std::mutex> lock(processing_mutex_);
-    frame_generation_algo_->reset();
-    events_back_.clear();
-    next_notify_us_ = notify_slice_us_;
+    reset_count_.fetch_add(1, std::memory_order_release);
 }
 
 } // namespace Metavision
@@ -0,0 +1,267 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <opencv2/core/hal/intrin.hpp>
+
+#include "metavision/sdk/core/utils/compact_mostrecent_timestamp_buffer.h"
+
+namespace Metavision {
+
+namespace {
+
+// Normalization of the relative timestamps into [0, 255]: a timestamp ts is displayed if ts >= min_ts, with the value
+// (min(ts - min_ts, max_diff) + offset) * ratio, offset being non-zero when last_ts - delta_t is before the epoch
+struct Normalization {
+    uint32_t min_ts;
+    uint32_t max_diff;
+    uint32_t offset;
+    float ratio;
+};
+
+inline uint8_t normalize(uint32_t ts, const Normalization &n) {
+    if (ts < n.min_ts) {
+        return 0;
+    }
+    const int32_t diff = static_cast<int32_t>(std::min(ts - n.min_ts, n.max_diff) + n.offset);
+    return static_cast<uint8_t>(std::min(static_cast<int32_t>(static_cast<float>(diff) * n.ratio), 255));
+}
+
+#if CV_SIMD128
+// Same computation as normalize, on 8 timestamps at once
+inline void normalize_8(const cv::v_uint32x4 &ts0, const cv::v_uint32x4 &ts1, uint8_t *out, const Normalization &n) {
+    const cv::v_uint32x4 min_ts   = cv::v_setall_u32(n.min_ts);
+    const cv::v_uint32x4 max_diff = cv::v_setall_u32(n.max_diff);
+    const cv::v_uint32x4 offset   = cv::v_setall_u32(n.offset);
+    const cv::v_float32x4 ratio   = cv::v_setall_f32(n.ratio);
+    const cv::v_int32x4 max_value = cv::v_setall_s32(255);
+    const auto normalize_4        = [&](const cv::v_uint32x4 &ts) {
+        const cv::v_uint32x4 diff = cv::v_min(ts - min_ts, max_diff) + offset;
+        const cv::v_int32x4 value =
+            cv::v_min(cv::v_trunc(cv::v_cvt_f32(cv::v_reinterpret_as_s32(diff)) * ratio), max_value);
+        return value & cv::v_reinterpret_as_s32(ts >= min_ts);
+    };
+    cv::v_pack_u_store(out, cv::v_pack(normalize_4(ts0), normalize_4(ts1)));
+}
+#endif
+
+// Normalizes the channel c of n consecutive pixels
+void normalize_channel(const uint32_t *ts, int channels, int c, int n, uint8_t *out, const Normalization &norm) {
+    int i = 0;
+#if CV_SIMD128
+    if (channels == 1) {
+        for (; i + 8 <= n; i += 8) {
+            normalize_8(cv::v_load(ts + i), cv::v_load(ts + i + 4), out + i, norm);
+        }
+    } else if (channels == 2) {
+        for (; i + 8 <= n; i += 8) {
+            cv::v_uint32x4 ts0[2], ts1[2];
+            cv::v_load_deinterleave(ts + 2 * i, ts0[0], ts0[1]);
+            cv::v_load_deinterleave(ts + 2 * i + 8, ts1[0], ts1[1]);
+            normalize_8(ts0[c], ts1[c], out + i, norm);
+        }
+    }
+#endif
+    for (; i < n; ++i) {
+        out[i] = normalize(ts[i * channels + c], norm);
+    }
+}
+
+// Normalizes the maximum across channels of n consecutive pixels
+void normalize_max_across_channels(const uint32_t *ts, int channels, int n, uint8_t *out, const Normalization &norm) {
+    int i = 0;
+#if CV_SIMD128
+    if (channels == 1) {
+        normalize_channel(ts, channels, 0, n, out, norm);
+        return;
+    } else if (channels == 2) {
+        for (; i + 8 <= n; i += 8) {
+            cv::v_uint32x4 ts0[2], ts1[2];
+            cv::v_load_deinterleave(ts + 2 * i, ts0[0], ts0[1]);
+            cv::v_load_deinterleave(ts + 2 * i + 8, ts1[0], ts1[1]);
+            normalize_8(cv::v_max(ts0[0], ts0[1]), cv::v_max(ts1[0], ts1[1]), out + i, norm);
+        }
+    }
+#endif
+    for (; i < n; ++i) {
+        const uint32_t *pixel_ts = ts + i * channels;
+        out[i]                   = normalize(*std::max_element(pixel_ts, pixel_ts + channels), norm);
+    }
+}
+
+// Computes the normalization of the timestamps relative to epoch, returns false if none of them can be displayed
+bool make_normalization(timestamp epoch, timestamp last_ts, timestamp delta_t, Normalization &norm) {
+    const timestamp min_ts = last_ts - delta_t - epoch;
+    if (min_ts > std::numeric_limits<uint32_t>::max()) {
+        return false;
+    }
+    // Differences above delta_t are those of timestamps after last_ts, displayed with the maximum value
+    const uint32_t max_diff = static_cast<uint32_t>(std::min<timestamp>(delta_t, std::numeric_limits<int32_t>::max()));
+    norm.min_ts             = static_cast<uint32_t>(std::max<timestamp>(min_ts, 0));
+    norm.offset             = static_cast<uint32_t>(std::min<timestamp>(std::max<timestamp>(-min_ts, 0), max_diff));
+    norm.max_diff           = max_diff - norm.offset;
+    norm.ratio              = 255.f / delta_t;
+    return true;
+}
+
+} // namespace
+
+constexpr int CompactMostRecentTimestampBuffer::tile_size;
+
+CompactMostRecentTimestampBuffer::CompactMostRecentTimestampBuffer(int rows, int cols, int channels, Layout layout) {
+    create(rows, cols, channels, layout);
+}
+
+void CompactMostRecentTimestampBuffer::create(int rows, int cols, int channels, Layout layout) {
+    rows_          = rows;
+    cols_          = cols;
+    channels_      = channels;
+    layout_        = layout;
+    tiles_per_row_ = (cols + tile_size - 1) / tile_size;
+    epoch_         = 0;
+
+    // With the tiled layout, the tiles on the right and bottom borders are padded
+    const size_t n_pixels = layout == Layout::RowMajor ?
+                                static_cast<size_t>(rows) * cols :
+                                static_cast<size_t>(tiles_per_row_) * ((rows + tile_size - 1) / tile_size) *
+                                    tile_size * tile_size;
+    tsbuffer_.clear();
+    tsbuffer_.resize(n_pixels * channels, 0);
+}
+
+void CompactMostRecentTimestampBuffer::release() {
+    std::vector<uint32_t>().swap(tsbuffer_);
+    rows_          = 0;
+    cols_          = 0;
+    channels_      = 0;
+    tiles_per_row_ = 0;
+    epoch_         = 0;
+}
+
+int CompactMostRecentTimestampBuffer::rows() const {
+    return rows_;
+}
+
+int CompactMostRecentTimestampBuffer::cols() const {
+    return cols_;
+}
+
+cv::Size CompactMostRecentTimestampBuffer::size() const {
+    return cv::Size(cols_, rows_);
+}
+
+int CompactMostRecentTimestampBuffer::channels() const {
+    return channels_;
+}
+
+CompactMostRecentTimestampBuffer::Layout CompactMostRecentTimestampBuffer::layout() const {
+    return layout_;
+}
+
+bool CompactMostRecentTimestampBuffer::empty() const {
+    return (rows_ * cols_ == 0);
+}
+
+timestamp CompactMostRecentTimestampBuffer::epoch() const {
+    return epoch_;
+}
+
+void CompactMostRecentTimestampBuffer::set_to(timestamp ts) {
+    epoch_ = ts;
+    std::fill(tsbuffer_.begin(), tsbuffer_.end(), 0);
+}
+
+timestamp CompactMostRecentTimestampBuffer::max_across_channels_at(int y, int x) const {
+    BOOST_ASSERT_MSG(x >= 0 && x < cols_ && y >= 0 && y < rows_,
+                     "Input coordinates are outside the bounds of the buffer!");
+    const uint32_t *pbuff_ts = &tsbuffer_[index(y, x)];
+    return epoch_ + *std::max_element(pbuff_ts, pbuff_ts + channels_);
+}
+
+void CompactMostRecentTimestampBuffer::copy_to(MostRecentTimestampBuffer &other) const {
+    other.create(rows_, cols_, channels_);
+    for (int y = 0; y < rows_; ++y) {
+        for (int x = 0; x < cols_; ++x) {
+            const uint32_t *pbuff_ts = &tsbuffer_[index(y, x)];
+            timestamp *other_ts      = other.ptr(y, x);
+            for (int c = 0; c < channels_; ++c) {
+                other_ts[c] = epoch_ + pbuff_ts[c];
+            }
+        }
+    }
+}
+
+void CompactMostRecentTimestampBuffer::rebase(timestamp ts) {
+    // Leave as much room for the timestamps to come as for the past ones
+    const timestamp epoch = ts - (timestamp(1) << 31);
+    const timestamp shift = epoch - epoch_;
+    if (shift > std::numeric_limits<uint32_t>::max()) {
+        std::fill(tsbuffer_.begin(), tsbuffer_.end(), 0);
+    } else {
+        const uint32_t shift32 = static_cast<uint32_t>(shift);
+        for (auto &rel_ts : tsbuffer_) {
+            rel_ts = rel_ts > shift32 ? rel_ts - shift32 : 0;
+        }
+    }
+    epoch_ = epoch;
+}
+
+template<typename F>
+void CompactMostRecentTimestampBuffer::for_each_row_run(int y, F &&f) const {
+    if (layout_ == Layout::RowMajor) {
+        f(0, cols_, &tsbuffer_[index(y, 0)]);
+        return;
+    }
+    for (int x = 0; x < cols_; x += tile_size) {
+        f(x, std::min(tile_size, cols_ - x), &tsbuffer_[index(y, x)]);
+    }
+}
+
+void CompactMostRecentTimestampBuffer::generate_img_time_surface(timestamp last_ts, timestamp delta_t,
+                                                                 cv::Mat &out) const {
+    out.create(rows_, channels_ * cols_, CV_8UC1);
+
+    Normalization norm;
+    if (!make_normalization(epoch_, last_ts, delta_t, norm)) {
+        out.setTo(cv::Scalar::all(0));
+        return;
+    }
+
+    for (int y = 0; y < rows_; ++y) {
+        uint8_t *img_ptr = out.ptr<uint8_t>(y);
+        for_each_row_run(y, [&](int x, int n, const uint32_t *ts) {
+            for (int c = 0; c < channels_; ++c) {
+                normalize_channel(ts, channels_, c, n, img_ptr + c * cols_ + x, norm);
+            }
+        });
+    }
+}
+
+void CompactMostRecentTimestampBuffer::generate_img_time_surface_collapsing_channels(timestamp last_ts,
+                                                                                     timestamp delta_t,
+                                                                                     cv::Mat &out) const {
+    out.create(rows_, cols_, CV_8UC1);
+
+    Normalization norm;
+    if (!make_normalization(epoch_, last_ts, delta_t, norm)) {
+        out.setTo(cv::Scalar::all(0));
+        return;
+    }
+
+    for (int y = 0; y < rows_; ++y) {
+        uint8_t *img_ptr = out.ptr<uint8_t>(y);
+        for_each_row_run(y, [&](int x, int n, const uint32_t *ts) {
+            normalize_max_across_channels(ts, channels_, n, img_ptr + x, norm);
+        });
+    }
+}
+
+} // namespace Metavision
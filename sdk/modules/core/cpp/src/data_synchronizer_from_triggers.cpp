@@ -9,6 +9,9 @@
  * See the License for the specific language governing permissions and limitations under the License.                 *
  **********************************************************************************************************************/
 
+#include <algorithm>
+#include <chrono>
+
 #include "metavision/sdk/core/utils/data_synchronizer_from_triggers.h"
 
 namespace Metavision {
@@ -29,11 +32,14 @@ DataSynchronizerFromTriggers::~DataSynchronizerFromTriggers() {
 void DataSynchronizerFromTriggers::reset_synchronization() {
     set_synchronization_as_done();
     std::lock_guard<std::mutex> lock(triggers_updated_mutex_);
-    synchronization_information_deque_.clear();
+    synchronization_information_queue_.clear();
     first_trigger_indexed_      = false;
     triggers_source_is_done_    = false;
     last_synchronization_index_ = 0;
     last_synchronization_ts_us_ = 0;
+    latency_count_              = 0;
+    latency_sum_us_             = 0;
+    latency_max_us_             = 0;
 }
 
 void DataSynchronizerFromTriggers::set_synchronization_as_done() {
@@ -44,11 +50,75 @@ void DataSynchronizerFromTriggers::set_synchronization_as_done() {
 }
 
 void DataSynchronizerFromTriggers::wait_for_triggers_consumed(uint32_t max_remaining_to_be_consumed) {
-    std::unique_lock<std::mutex> lock(triggers_updated_mutex_);
-    if (triggers_source_is_done_)
+    const auto is_consumed = [this, max_remaining_to_be_consumed]() {
+        return triggers_source_is_done_ || synchronization_information_queue_.size() <= max_remaining_to_be_consumed;
+    };
+    if (is_consumed()) {
         return;
-    wait_for_triggers_consumed_cond_.wait(lock, [this, max_remaining_to_be_consumed]() {
-        return triggers_source_is_done_ || synchronization_information_deque_.size() <= max_remaining_to_be_consumed;
+    }
+
+    std::unique_lock<std::mutex> lock(triggers_updated_mutex_);
+    ++waiting_for_triggers_consumed_count_;
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    wait_for_triggers_consumed_cond_.wait(lock, is_consumed);
+    --waiting_for_triggers_consumed_count_;
+}
+
+DataSynchronizerFromTriggers::LatencyStatistics DataSynchronizerFromTriggers::get_latency_statistics() const {
+    LatencyStatistics stats;
+    stats.count_   = latency_count_.load(std::memory_order_relaxed);
+    stats.mean_us_ = stats.count_ == 0 ? 0 : latency_sum_us_.load(std::memory_order_relaxed) / stats.count_;
+    stats.max_us_  = latency_max_us_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+timestamp DataSynchronizerFromTriggers::system_time_us() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+bool DataSynchronizerFromTriggers::has_synchronization_information(uint32_t data_index) {
+    for (size_t n = synchronization_information_queue_.size(); n > 0; --n) {
+        if (synchronization_information_queue_.front().information.index >= data_index) {
+            return true;
+        }
+        synchronization_information_queue_.pop();
+    }
+    return false;
+}
+
+bool DataSynchronizerFromTriggers::wait_for_synchronization_information(uint32_t data_index) {
+    // All triggers have been used for synchronization. We notify to unlock any process waiting for it
+    notify_triggers_consumed();
+
+    std::unique_lock<std::mutex> lock(triggers_updated_mutex_);
+    ++waiting_for_triggers_count_;
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    bool has_information = false;
+    wait_for_triggers_cond_.wait(lock, [&]() {
+        has_information = has_synchronization_information(data_index);
+        if (!has_information) {
+            wait_for_triggers_consumed_cond_.notify_all();
+        }
+        return has_information || triggers_source_is_done_;
     });
+    --waiting_for_triggers_count_;
+    return has_information;
+}
+
+void DataSynchronizerFromTriggers::notify_triggers_consumed() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiting_for_triggers_consumed_count_.load(std::memory_order_relaxed) > 0) {
+        std::lock_guard<std::mutex> lock(triggers_updated_mutex_);
+        wait_for_triggers_consumed_cond_.notify_all();
+    }
+}
+
+void DataSynchronizerFromTriggers::add_latency(timestamp latency_us) {
+    latency_count_.store(latency_count_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    latency_sum_us_.store(latency_sum_us_.load(std::memory_order_relaxed) + latency_us, std::memory_order_relaxed);
+    if (latency_us > latency_max_us_.load(std::memory_order_relaxed)) {
+        latency_max_us_.store(latency_us, std::memory_order_relaxed);
+    }
 }
 } // namespace Metavision
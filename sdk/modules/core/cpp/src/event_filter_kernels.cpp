@@ -0,0 +1,319 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+
+#include "metavision/sdk/core/algorithms/detail/event_filter_kernels.h"
+
+// The x86 kernels are compiled for their instruction set with function attributes, and selected at runtime, so that
+// the library itself does not require more than the baseline instruction set
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define METAVISION_EVENT_FILTER_KERNELS_X86
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#define METAVISION_EVENT_FILTER_KERNELS_NEON
+#include <arm_neon.h>
+#endif
+
+namespace Metavision {
+namespace detail {
+
+// The kernels load events as 8 lanes of 16 bits: x, y, p, padding, then the 4 words of the timestamp
+static_assert(sizeof(EventCD) == 16, "The event filter kernels expect 16-byte events");
+static_assert(offsetof(EventCD, x) == 0 && offsetof(EventCD, y) == 2 && offsetof(EventCD, p) == 4 &&
+                  offsetof(EventCD, t) == 8,
+              "The event filter kernels expect events laid out as x, y, p, t");
+
+namespace {
+
+// ROI bounds in the range of the events coordinates, and shift applied to the accepted events
+struct RoiBounds {
+    std::uint16_t x0, y0, x1, y1;
+    std::uint16_t shift_x, shift_y;
+};
+
+// Accepted events are written at out, rejected ones to a scratch event: the output pointer is selected without any
+// branch, and nothing is ever written past the accepted events
+EventCD *roi_filter_scalar(const EventCD *begin, const EventCD *end, EventCD *out, const RoiBounds &b) {
+    EventCD scratch;
+    for (; begin != end; ++begin) {
+        const bool keep = (begin->x >= b.x0) & (begin->x <= b.x1) & (begin->y >= b.y0) & (begin->y <= b.y1);
+        EventCD *dst    = keep ? out : &scratch;
+        *dst            = *begin;
+        dst->x          = static_cast<std::uint16_t>(dst->x - b.shift_x);
+        dst->y          = static_cast<std::uint16_t>(dst->y - b.shift_y);
+        out += keep;
+    }
+    return out;
+}
+
+EventCD *polarity_filter_scalar(const EventCD *begin, const EventCD *end, EventCD *out, std::int16_t polarity) {
+    EventCD scratch;
+    for (; begin != end; ++begin) {
+        const bool keep = begin->p == polarity;
+        *(keep ? out : &scratch) = *begin;
+        out += keep;
+    }
+    return out;
+}
+
+#ifdef METAVISION_EVENT_FILTER_KERNELS_X86
+
+// AVX2: 2 events per register, loaded as they are in memory. The coordinates are compared as unsigned 16-bit lanes,
+// bounds of the other lanes being set so that they always pass. Each accepted event is then stored with a single
+// 16-byte store.
+__attribute__((target("avx2"))) inline void store_if_avx2(__m128i ev, bool keep, EventCD *&out, EventCD &scratch) {
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(keep ? out : &scratch), ev);
+    out += keep;
+}
+
+__attribute__((target("avx2"))) inline void store_accepted_avx2(__m256i evs, std::uint32_t mask, EventCD *&out,
+                                                                  EventCD &scratch) {
+    store_if_avx2(_mm256_castsi256_si128(evs), (mask & 0xFFFF) == 0xFFFF, out, scratch);
+    store_if_avx2(_mm256_extracti128_si256(evs, 1), (mask >> 16) == 0xFFFF, out, scratch);
+}
+
+// Returns the mask of the bytes of the lanes within [lo, hi]
+__attribute__((target("avx2"))) inline std::uint32_t in_bounds_avx2(__m256i evs, __m256i lo, __m256i hi) {
+    const __m256i in = _mm256_and_si256(_mm256_cmpeq_epi16(_mm256_max_epu16(evs, lo), evs),
+                                        _mm256_cmpeq_epi16(_mm256_min_epu16(evs, hi), evs));
+    return static_cast<std::uint32_t>(_mm256_movemask_epi8(in));
+}
+
+// Returns the mask of the bytes of the lanes equal to those of values, or ignored
+__attribute__((target("avx2"))) inline std::uint32_t equal_avx2(__m256i evs, __m256i values, __m256i ignored) {
+    return static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi16(evs, values), ignored)));
+}
+
+__attribute__((target("avx2"))) EventCD *roi_filter_avx2(const EventCD *begin, const EventCD *end, EventCD *out,
+                                                          const RoiBounds &b) {
+    const short x0 = static_cast<short>(b.x0), y0 = static_cast<short>(b.y0);
+    const short x1 = static_cast<short>(b.x1), y1 = static_cast<short>(b.y1);
+    const short sx = static_cast<short>(b.shift_x), sy = static_cast<short>(b.shift_y);
+    const __m256i lo    = _mm256_setr_epi16(x0, y0, 0, 0, 0, 0, 0, 0, x0, y0, 0, 0, 0, 0, 0, 0);
+    const __m256i hi    = _mm256_setr_epi16(x1, y1, -1, -1, -1, -1, -1, -1, x1, y1, -1, -1, -1, -1, -1, -1);
+    const __m256i shift = _mm256_setr_epi16(sx, sy, 0, 0, 0, 0, 0, 0, sx, sy, 0, 0, 0, 0, 0, 0);
+
+    EventCD scratch;
+    for (; end - begin >= 4; begin += 4) {
+        const __m256i evs0        = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(begin));
+        const __m256i evs1        = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(begin + 2));
+        const std::uint32_t mask0 = in_bounds_avx2(evs0, lo, hi), mask1 = in_bounds_avx2(evs1, lo, hi);
+        store_accepted_avx2(_mm256_sub_epi16(evs0, shift), mask0, out, scratch);
+        store_accepted_avx2(_mm256_sub_epi16(evs1, shift), mask1, out, scratch);
+    }
+    return roi_filter_scalar(begin, end, out, b);
+}
+
+__attribute__((target("avx2"))) EventCD *polarity_filter_avx2(const EventCD *begin, const EventCD *end, EventCD *out,
+                                                               std::int16_t polarity) {
+    const __m256i p = _mm256_setr_epi16(0, 0, polarity, 0, 0, 0, 0, 0, 0, 0, polarity, 0, 0, 0, 0, 0);
+    const __m256i ignored = _mm256_setr_epi16(-1, -1, 0, -1, -1, -1, -1, -1, -1, -1, 0, -1, -1, -1, -1, -1);
+
+    EventCD scratch;
+    for (; end - begin >= 4; begin += 4) {
+        const __m256i evs0        = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(begin));
+        const __m256i evs1        = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(begin + 2));
+        const std::uint32_t mask0 = equal_avx2(evs0, p, ignored), mask1 = equal_avx2(evs1, p, ignored);
+        store_accepted_avx2(evs0, mask0, out, scratch);
+        store_accepted_avx2(evs1, mask1, out, scratch);
+    }
+    return polarity_filter_scalar(begin, end, out, polarity);
+}
+
+// AVX-512: 4 events per register. The lanes comparisons give 8 mask bits per event, which are reduced to one bit per
+// event, then expanded to the 2 quadwords of each event for the compress store.
+__attribute__((target("avx512f,avx512bw"))) inline void compress_store_avx512(__m512i evs, std::uint32_t lanes_mask,
+                                                                              EventCD *&out) {
+    static const std::uint8_t quadwords_masks[16] = {0x00, 0x03, 0x0C, 0x0F, 0x30, 0x33, 0x3C, 0x3F,
+                                                     0xC0, 0xC3, 0xCC, 0xCF, 0xF0, 0xF3, 0xFC, 0xFF};
+    // Bit i of the events mask is set if the 8 lanes of event i pass
+    std::uint32_t m = lanes_mask & (lanes_mask >> 4);
+    m &= m >> 2;
+    m &= m >> 1;
+    const unsigned events_mask = (m & 1) | ((m >> 7) & 2) | ((m >> 14) & 4) | ((m >> 21) & 8);
+    _mm512_mask_compressstoreu_epi64(out, quadwords_masks[events_mask], evs);
+    out += __builtin_popcount(events_mask);
+}
+
+__attribute__((target("avx512f,avx512bw"))) EventCD *roi_filter_avx512(const EventCD *begin, const EventCD *end,
+                                                                        EventCD *out, const RoiBounds &b) {
+    const __m512i x0 = _mm512_set1_epi64(b.x0 | (std::uint64_t(b.y0) << 16));
+    const __m512i x1 = _mm512_set1_epi64(b.x1 | (std::uint64_t(b.y1) << 16) | 0xFFFFFFFF00000000ull);
+    const __m512i shift = _mm512_set1_epi64(b.shift_x | (std::uint64_t(b.shift_y) << 16));
+    // Quadwords alternate between (x, y, p, padding) and t: only the first ones are compared
+    const __m512i lo = _mm512_mask_blend_epi64(0x55, _mm512_setzero_si512(), x0);
+    const __m512i hi = _mm512_mask_blend_epi64(0x55, _mm512_set1_epi64(-1), x1);
+    const __m512i sh = _mm512_mask_blend_epi64(0x55, _mm512_setzero_si512(), shift);
+
+    for (; end - begin >= 4; begin += 4) {
+        const __m512i evs = _mm512_loadu_si512(begin);
+        const std::uint32_t in = _mm512_cmpge_epu16_mask(evs, lo) & _mm512_cmple_epu16_mask(evs, hi);
+        compress_store_avx512(_mm512_sub_epi16(evs, sh), in, out);
+    }
+    return roi_filter_scalar(begin, end, out, b);
+}
+
+__attribute__((target("avx512f,avx512bw"))) EventCD *polarity_filter_avx512(const EventCD *begin, const EventCD *end,
+                                                                             EventCD *out, std::int16_t polarity) {
+    const __m512i p = _mm512_set1_epi16(polarity);
+    // Only the polarity lane of each event, i.e. lane 2 out of 8, is compared
+    const std::uint32_t ignored = ~0x04040404u;
+    for (; end - begin >= 4; begin += 4) {
+        const __m512i evs = _mm512_loadu_si512(begin);
+        compress_store_avx512(evs, _mm512_cmpeq_epi16_mask(evs, p) | ignored, out);
+    }
+    return polarity_filter_scalar(begin, end, out, polarity);
+}
+
+#endif // METAVISION_EVENT_FILTER_KERNELS_X86
+
+#ifdef METAVISION_EVENT_FILTER_KERNELS_NEON
+
+// NEON: 1 event per register, the coordinates being compared as unsigned 16-bit lanes like with AVX2
+inline void store_if_neon(uint16x8_t ev, bool keep, EventCD *&out, EventCD &scratch) {
+    vst1q_u16(reinterpret_cast<std::uint16_t *>(keep ? out : &scratch), ev);
+    out += keep;
+}
+
+EventCD *roi_filter_neon(const EventCD *begin, const EventCD *end, EventCD *out, const RoiBounds &b) {
+    const std::uint16_t lo_lanes[8] = {b.x0, b.y0, 0, 0, 0, 0, 0, 0};
+    const std::uint16_t hi_lanes[8] = {b.x1, b.y1, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF};
+    const std::uint16_t shift_lanes[8] = {b.shift_x, b.shift_y, 0, 0, 0, 0, 0, 0};
+    const uint16x8_t lo = vld1q_u16(lo_lanes), hi = vld1q_u16(hi_lanes), shift = vld1q_u16(shift_lanes);
+
+    EventCD scratch;
+    for (; end - begin >= 2; begin += 2) {
+        const uint16x8_t ev0 = vld1q_u16(reinterpret_cast<const std::uint16_t *>(begin));
+        const uint16x8_t ev1 = vld1q_u16(reinterpret_cast<const std::uint16_t *>(begin + 1));
+        const bool keep0     = vminvq_u16(vandq_u16(vcgeq_u16(ev0, lo), vcleq_u16(ev0, hi))) == 0xFFFF;
+        const bool keep1     = vminvq_u16(vandq_u16(vcgeq_u16(ev1, lo), vcleq_u16(ev1, hi))) == 0xFFFF;
+        store_if_neon(vsubq_u16(ev0, shift), keep0, out, scratch);
+        store_if_neon(vsubq_u16(ev1, shift), keep1, out, scratch);
+    }
+    return roi_filter_scalar(begin, end, out, b);
+}
+
+EventCD *polarity_filter_neon(const EventCD *begin, const EventCD *end, EventCD *out, std::int16_t polarity) {
+    const std::uint16_t p                = static_cast<std::uint16_t>(polarity);
+    const std::uint16_t p_lanes[8]       = {0, 0, p, 0, 0, 0, 0, 0};
+    const std::uint16_t ignored_lanes[8] = {0xFFFF, 0xFFFF, 0, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF};
+    const uint16x8_t pol = vld1q_u16(p_lanes), ignored = vld1q_u16(ignored_lanes);
+
+    EventCD scratch;
+    for (; end - begin >= 2; begin += 2) {
+        const uint16x8_t ev0 = vld1q_u16(reinterpret_cast<const std::uint16_t *>(begin));
+        const uint16x8_t ev1 = vld1q_u16(reinterpret_cast<const std::uint16_t *>(begin + 1));
+        store_if_neon(ev0, vminvq_u16(vorrq_u16(vceqq_u16(ev0, pol), ignored)) == 0xFFFF, out, scratch);
+        store_if_neon(ev1, vminvq_u16(vorrq_u16(vceqq_u16(ev1, pol), ignored)) == 0xFFFF, out, scratch);
+    }
+    return polarity_filter_scalar(begin, end, out, polarity);
+}
+
+#endif // METAVISION_EVENT_FILTER_KERNELS_NEON
+
+void check_simd_isa(SimdIsa isa) {
+    if (!is_simd_isa_supported(isa)) {
+        throw std::invalid_argument("The instruction set is not supported by this CPU.");
+    }
+}
+
+} // namespace
+
+bool is_simd_isa_supported(SimdIsa isa) {
+    switch (isa) {
+    case SimdIsa::Scalar:
+        return true;
+#ifdef METAVISION_EVENT_FILTER_KERNELS_X86
+    case SimdIsa::Avx2:
+        return __builtin_cpu_supports("avx2");
+    case SimdIsa::Avx512:
+        return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw");
+#endif
+#ifdef METAVISION_EVENT_FILTER_KERNELS_NEON
+    case SimdIsa::Neon:
+        return true;
+#endif
+    default:
+        return false;
+    }
+}
+
+SimdIsa best_simd_isa() {
+    static const SimdIsa isa = [] {
+        for (SimdIsa isa : {SimdIsa::Avx512, SimdIsa::Avx2, SimdIsa::Neon}) {
+            if (is_simd_isa_supported(isa)) {
+                return isa;
+            }
+        }
+        return SimdIsa::Scalar;
+    }();
+    return isa;
+}
+
+EventCD *roi_filter_events(const EventCD *begin, const EventCD *end, EventCD *out, std::int32_t x0, std::int32_t y0,
+                           std::int32_t x1, std::int32_t y1, bool output_relative_coordinates, SimdIsa isa) {
+    check_simd_isa(isa);
+
+    // Bring the ROI in the range of the coordinates, out of which no event can be accepted
+    constexpr std::int32_t max_coord = std::numeric_limits<std::uint16_t>::max();
+    if (x1 < 0 || y1 < 0 || x0 > max_coord || y0 > max_coord || x0 > x1 || y0 > y1) {
+        return out;
+    }
+    RoiBounds b;
+    b.x0 = static_cast<std::uint16_t>(std::max(x0, 0));
+    b.y0 = static_cast<std::uint16_t>(std::max(y0, 0));
+    b.x1 = static_cast<std::uint16_t>(std::min(x1, max_coord));
+    b.y1 = static_cast<std::uint16_t>(std::min(y1, max_coord));
+    // Same wrap-around as RoiFilterAlgorithm, which subtracts the corner from the unsigned coordinates
+    b.shift_x = output_relative_coordinates ? static_cast<std::uint16_t>(x0) : 0;
+    b.shift_y = output_relative_coordinates ? static_cast<std::uint16_t>(y0) : 0;
+
+    switch (isa) {
+#ifdef METAVISION_EVENT_FILTER_KERNELS_X86
+    case SimdIsa::Avx512:
+        return roi_filter_avx512(begin, end, out, b);
+    case SimdIsa::Avx2:
+        return roi_filter_avx2(begin, end, out, b);
+#endif
+#ifdef METAVISION_EVENT_FILTER_KERNELS_NEON
+    case SimdIsa::Neon:
+        return roi_filter_neon(begin, end, out, b);
+#endif
+    default:
+        return roi_filter_scalar(begin, end, out, b);
+    }
+}
+
+EventCD *polarity_filter_events(const EventCD *begin, const EventCD *end, EventCD *out, std::int16_t polarity,
+                                SimdIsa isa) {
+    check_simd_isa(isa);
+
+    switch (isa) {
+#ifdef METAVISION_EVENT_FILTER_KERNELS_X86
+    case SimdIsa::Avx512:
+        return polarity_filter_avx512(begin, end, out, polarity);
+    case SimdIsa::Avx2:
+        return polarity_filter_avx2(begin, end, out, polarity);
+#endif
+#ifdef METAVISION_EVENT_FILTER_KERNELS_NEON
+    case SimdIsa::Neon:
+        return polarity_filter_neon(begin, end, out, polarity);
+#endif
+    default:
+        return polarity_filter_scalar(begin, end, out, polarity);
+    }
+}
+
+} // namespace detail
+} // namespace Metavision
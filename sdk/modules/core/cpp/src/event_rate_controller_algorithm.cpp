@@ -0,0 +1,87 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <stdexcept>
+
+#include "metavision/sdk/core/algorithms/event_rate_controller_algorithm.h"
+
+namespace Metavision {
+
+constexpr std::size_t EventRateControllerAlgorithm::block_size_;
+constexpr std::uint32_t EventRateControllerAlgorithm::keep_all_threshold_;
+
+EventRateControllerAlgorithm::EventRateControllerAlgorithm(std::uint32_t events_per_sec,
+                                                           std::uint32_t count_period_us) :
+    count_period_(count_period_us) {
+    if (count_period_us == 0) {
+        throw std::invalid_argument("Event rate controller expects a strictly positive count period.");
+    }
+    set_cd_event_rate(events_per_sec);
+}
+
+void EventRateControllerAlgorithm::enable(bool b) {
+    enabled_ = b;
+    reset();
+}
+
+bool EventRateControllerAlgorithm::is_enabled() const {
+    return enabled_;
+}
+
+void EventRateControllerAlgorithm::set_cd_event_rate(std::uint32_t events_per_sec) {
+    event_count_ = static_cast<std::uint32_t>(static_cast<std::uint64_t>(events_per_sec) * count_period_ / 1000000);
+}
+
+std::uint32_t EventRateControllerAlgorithm::get_cd_event_rate() const {
+    return static_cast<std::uint32_t>(static_cast<std::uint64_t>(event_count_) * 1000000 / count_period_);
+}
+
+std::uint32_t EventRateControllerAlgorithm::get_count_period() const {
+    return count_period_;
+}
+
+void EventRateControllerAlgorithm::set_cd_event_count(std::uint32_t event_count) {
+    event_count_ = event_count;
+}
+
+std::uint32_t EventRateControllerAlgorithm::get_cd_event_count() const {
+    return event_count_;
+}
+
+void EventRateControllerAlgorithm::reset() {
+    has_count_period_         = false;
+    n_events_in_count_period_ = 0;
+    n_kept_in_count_period_   = 0;
+    threshold_                = keep_all_threshold_;
+}
+
+void EventRateControllerAlgorithm::start_count_period(timestamp t) {
+    const timestamp count_period_start = t - t % count_period_;
+
+    // The ratio of events to keep is derived from the previous count period, if there were events in it
+    std::uint64_t n_events_in_previous_count_period = 0;
+    if (has_count_period_ && count_period_start == count_period_start_ + count_period_) {
+        n_events_in_previous_count_period = n_events_in_count_period_;
+    }
+    if (n_events_in_previous_count_period <= event_count_) {
+        threshold_ = keep_all_threshold_;
+    } else {
+        threshold_ = static_cast<std::uint32_t>((static_cast<std::uint64_t>(event_count_) << 24) /
+                                                n_events_in_previous_count_period);
+    }
+
+    has_count_period_         = true;
+    count_period_start_       = count_period_start;
+    n_events_in_count_period_ = 0;
+    n_kept_in_count_period_   = 0;
+}
+
+} // namespace Metavision
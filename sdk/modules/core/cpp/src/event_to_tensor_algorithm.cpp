@@ -0,0 +1,50 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <stdexcept>
+
+#include "metavision/sdk/core/algorithms/event_to_tensor_algorithm.h"
+
+namespace Metavision {
+
+HistogramTensorAlgorithm::HistogramTensorAlgorithm(int width, int height, float max_count) :
+    EventToTensorAlgorithm(width, height, 2, 1), max_count_(max_count) {
+    if (max_count < 0.f) {
+        throw std::invalid_argument("Histogram tensor expects a positive maximum count.");
+    }
+}
+
+float HistogramTensorAlgorithm::get_max_count() const {
+    return max_count_;
+}
+
+DifferenceTensorAlgorithm::DifferenceTensorAlgorithm(int width, int height, float max_count) :
+    EventToTensorAlgorithm(width, height, 1, 1), max_count_(max_count) {
+    if (max_count < 0.f) {
+        throw std::invalid_argument("Difference tensor expects a positive maximum count.");
+    }
+}
+
+float DifferenceTensorAlgorithm::get_max_count() const {
+    return max_count_;
+}
+
+VoxelGridTensorAlgorithm::VoxelGridTensorAlgorithm(int width, int height, int n_bins) :
+    EventToTensorAlgorithm(width, height, 1, n_bins), n_bins_(n_bins) {}
+
+int VoxelGridTensorAlgorithm::get_num_bins() const {
+    return n_bins_;
+}
+
+TimestampTensorAlgorithm::TimestampTensorAlgorithm(int width, int height) :
+    EventToTensorAlgorithm(width, height, 2, 1) {}
+
+} // namespace Metavision
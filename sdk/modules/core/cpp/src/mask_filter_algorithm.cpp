@@ -0,0 +1,142 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "metavision/sdk/core/algorithms/mask_filter_algorithm.h"
+
+namespace Metavision {
+
+MaskFilterAlgorithm::MaskFilterAlgorithm(const cv::Mat &mask, bool output_relative_coordinates) :
+    output_relative_coordinates_(output_relative_coordinates) {
+    if (mask.empty() || mask.type() != CV_8UC1) {
+        throw std::invalid_argument("Mask filter expects a non empty mask of type CV_8UC1.");
+    }
+    width_  = mask.cols;
+    height_ = mask.rows;
+
+    // Bounding box of the non-zero pixels
+    int x0 = width_, y0 = height_, x1 = -1, y1 = -1;
+    for (int y = 0; y < height_; ++y) {
+        const std::uint8_t *row = mask.ptr<std::uint8_t>(y);
+        for (int x = 0; x < width_; ++x) {
+            if (row[x]) {
+                x0 = std::min(x0, x);
+                x1 = std::max(x1, x);
+                y0 = std::min(y0, y);
+                y1 = y;
+            }
+        }
+    }
+    if (x1 < 0) {
+        return;
+    }
+
+    allocate(cv::Rect(x0, y0, x1 - x0 + 1, y1 - y0 + 1));
+    for (int y = y0; y <= y1; ++y) {
+        const std::uint8_t *row = mask.ptr<std::uint8_t>(y);
+        for (int x = x0; x <= x1;) {
+            // Sets the runs of non-zero pixels at once
+            for (; x <= x1 && !row[x]; ++x) {}
+            const int run_begin = x;
+            for (; x <= x1 && row[x]; ++x) {}
+            set_bits(run_begin, x, y);
+        }
+    }
+}
+
+MaskFilterAlgorithm::MaskFilterAlgorithm(int width, int height, const std::vector<cv::Rect> &rois,
+                                         bool output_relative_coordinates) :
+    width_(width), height_(height), output_relative_coordinates_(output_relative_coordinates) {
+    if (width <= 0 || height <= 0) {
+        throw std::invalid_argument("Mask filter expects a strictly positive sensor size.");
+    }
+
+    const cv::Rect sensor(0, 0, width, height);
+    std::vector<cv::Rect> clipped_rois;
+    cv::Rect bounding_box;
+    for (const auto &roi : rois) {
+        const cv::Rect clipped_roi = roi & sensor;
+        if (clipped_roi.empty()) {
+            continue;
+        }
+        bounding_box = clipped_rois.empty() ? clipped_roi : (bounding_box | clipped_roi);
+        clipped_rois.push_back(clipped_roi);
+    }
+    if (clipped_rois.empty()) {
+        return;
+    }
+
+    allocate(bounding_box);
+    for (const auto &roi : clipped_rois) {
+        for (int y = roi.y; y < roi.y + roi.height; ++y) {
+            set_bits(roi.x, roi.x + roi.width, y);
+        }
+    }
+}
+
+int MaskFilterAlgorithm::width() const {
+    return width_;
+}
+
+int MaskFilterAlgorithm::height() const {
+    return height_;
+}
+
+int MaskFilterAlgorithm::crop_x0() const {
+    return crop_x0_;
+}
+
+int MaskFilterAlgorithm::crop_y0() const {
+    return crop_y0_;
+}
+
+int MaskFilterAlgorithm::crop_width() const {
+    return static_cast<int>(crop_width_);
+}
+
+int MaskFilterAlgorithm::crop_height() const {
+    return static_cast<int>(crop_height_);
+}
+
+void MaskFilterAlgorithm::get_mask(cv::Mat &mask) const {
+    mask.create(height_, width_, CV_8UC1);
+    for (int y = 0; y < height_; ++y) {
+        std::uint8_t *row = mask.ptr<std::uint8_t>(y);
+        for (int x = 0; x < width_; ++x) {
+            row[x] = is_in_mask(x, y) ? 255 : 0;
+        }
+    }
+}
+
+void MaskFilterAlgorithm::allocate(const cv::Rect &bounding_box) {
+    crop_x0_       = bounding_box.x;
+    crop_y0_       = bounding_box.y;
+    crop_width_    = bounding_box.width;
+    crop_height_   = bounding_box.height;
+    words_per_row_ = (crop_width_ + 63) / 64;
+    bits_.assign(words_per_row_ * crop_height_, 0);
+}
+
+void MaskFilterAlgorithm::set_bits(int x_begin, int x_end, int y) {
+    std::uint64_t *row = bits_.data() + (y - crop_y0_) * words_per_row_;
+    for (int x = x_begin - crop_x0_; x < x_end - crop_x0_;) {
+        // Sets as many bits as possible in the current word
+        const int bit            = x & 63;
+        const int n_bits         = std::min(64 - bit, x_end - crop_x0_ - x);
+        const std::uint64_t bits = n_bits == 64 ? ~std::uint64_t(0) : ((std::uint64_t(1) << n_bits) - 1) << bit;
+        row[x >> 6] |= bits;
+        x += n_bits;
+    }
+}
+
+} // namespace Metavision
@@ -9,18 +9,74 @@
  * See the License for the specific language governing permissions and limitations under the License.                 *
  **********************************************************************************************************************/
 
+#include <algorithm>
 #include <sstream>
 
 #include "metavision/sdk/core/algorithms/on_demand_frame_generation_algorithm.h"
 
 namespace Metavision {
 
+class OnDemandFrameGenerationAlgorithm::ChunkedEventsIterator {
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type        = EventCD;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = const EventCD *;
+    using reference         = const EventCD &;
+
+    ChunkedEventsIterator(const OnDemandFrameGenerationAlgorithm &algo, const EventPosition &pos) :
+        algo_(&algo), pos_(pos) {}
+
+    reference operator*() const {
+        return *pos_.event;
+    }
+
+    pointer operator->() const {
+        return pos_.event;
+    }
+
+    ChunkedEventsIterator &operator++() {
+        if (++pos_.event == algo_->chunk(pos_.chunk).end && pos_.chunk + 1 < algo_->n_chunks_) {
+            pos_.event = algo_->chunk(++pos_.chunk).begin;
+        }
+        return *this;
+    }
+
+    ChunkedEventsIterator operator++(int) {
+        ChunkedEventsIterator it = *this;
+        ++(*this);
+        return it;
+    }
+
+    bool operator==(const ChunkedEventsIterator &other) const {
+        return pos_.chunk == other.pos_.chunk && pos_.event == other.pos_.event;
+    }
+
+    bool operator!=(const ChunkedEventsIterator &other) const {
+        return !(*this == other);
+    }
+
+private:
+    const OnDemandFrameGenerationAlgorithm *algo_;
+    EventPosition pos_;
+};
+
+constexpr size_t OnDemandFrameGenerationAlgorithm::min_copied_chunk_size_;
+
 OnDemandFrameGenerationAlgorithm::OnDemandFrameGenerationAlgorithm(int width, int height, uint32_t accumulation_time_us,
                                                                    const Metavision::ColorPalette &palette) :
-    BaseFrameGenerationAlgorithm(width, height, palette), accumulation_time_us_(accumulation_time_us) {
+    BaseFrameGenerationAlgorithm(width, height, palette),
+    accumulation_time_us_(accumulation_time_us),
+    copies_pool_(EventsBufferPool::make_unbounded(4)) {
     reset();
 }
 
+void OnDemandFrameGenerationAlgorithm::process_events(const std::shared_ptr<const std::vector<EventCD>> &events) {
+    if (events && !events->empty()) {
+        push_chunk(events, events->data(), events->data() + events->size());
+    }
+}
+
 void OnDemandFrameGenerationAlgorithm::generate(timestamp ts, cv::Mat &frame, bool allocate) {
     if (allocate) {
         if (flags_ & Parameters::GRAY) {
@@ -45,16 +101,15 @@ void OnDemandFrameGenerationAlgorithm::generate(timestamp ts, cv::Mat &frame, bo
     }
 
     const timestamp ts_min = accumulation_time_us_ == 0 ? last_frame_ts_us_ + 1 : ts - accumulation_time_us_ + 1;
-    const auto begin       = std::lower_bound(events_queue_.begin(), events_queue_.end(), ts_min,
-                                        [](const auto &ev, timestamp t) { return ev.t < t; });
-    const auto end =
-        std::upper_bound(begin, events_queue_.end(), ts, [](timestamp t, const auto &ev) { return t < ev.t; });
+    const EventPosition begin = find_event(ts_min, false);
+    const EventPosition end   = find_event(ts, true);
 
-    // Generate frame using events from the queue
-    generate_frame_from_events(begin, end, frame, bg_color_, off_on_colors_, flags_);
+    // Generate frame using events from the chunks
+    generate_frame_from_events(ChunkedEventsIterator(*this, begin), ChunkedEventsIterator(*this, end), frame,
+                               bg_color_, off_on_colors_, flags_);
     // Remove events older than ts - accumulation_time,
     // Or remove all the processed events if the accumulation time is null
-    events_queue_.erase(events_queue_.begin(), (accumulation_time_us_ == 0 ? end : begin));
+    release_events_before(accumulation_time_us_ == 0 ? end : begin);
 
     last_frame_ts_us_ = ts;
 }
@@ -71,8 +126,86 @@ uint32_t OnDemandFrameGenerationAlgorithm::get_accumulation_time_us() const {
 }
 
 void OnDemandFrameGenerationAlgorithm::reset() {
-    events_queue_.clear();
+    release_events_before({n_chunks_, nullptr});
+    copy_buffer_.reset();
     last_frame_ts_us_ = 0;
 }
 
+void OnDemandFrameGenerationAlgorithm::push_chunk(std::shared_ptr<const EventsBuffer> buffer, const EventCD *begin,
+                                                  const EventCD *end) {
+    if (n_chunks_ == chunks_.size()) {
+        // The ring is full, move its chunks in a twice larger one
+        std::vector<EventsChunk> chunks(std::max<size_t>(16, 2 * chunks_.size()));
+        for (size_t i = 0; i < n_chunks_; ++i) {
+            chunks[i] = std::move(chunk(i));
+        }
+        chunks_.swap(chunks);
+        first_chunk_ = 0;
+    }
+    chunk(n_chunks_++) = {std::move(buffer), begin, end};
+}
+
+OnDemandFrameGenerationAlgorithm::EventsBuffer &OnDemandFrameGenerationAlgorithm::prepare_copy(size_t n_events) {
+    // Events are appended to the current buffer as long as it is the last one of the ring and it has enough capacity
+    // left, since reallocating it would invalidate the chunks referencing it
+    const bool last_chunk = n_chunks_ != 0 && chunk(n_chunks_ - 1).buffer == copy_buffer_;
+    if (!copy_buffer_ || !last_chunk || copy_buffer_->capacity() - copy_buffer_->size() < n_events) {
+        copy_buffer_ = copies_pool_.acquire();
+        copy_buffer_->clear();
+        copy_buffer_->reserve(std::max(n_events, min_copied_chunk_size_));
+    }
+    return *copy_buffer_;
+}
+
+void OnDemandFrameGenerationAlgorithm::commit_copy() {
+    const EventCD *data = copy_buffer_->data();
+    if (n_chunks_ != 0 && chunk(n_chunks_ - 1).buffer == copy_buffer_) {
+        chunk(n_chunks_ - 1).end = data + copy_buffer_->size();
+    } else {
+        push_chunk(copy_buffer_, data, data + copy_buffer_->size());
+    }
+}
+
+OnDemandFrameGenerationAlgorithm::EventPosition OnDemandFrameGenerationAlgorithm::find_event(timestamp ts,
+                                                                                           bool strict) const {
+    const auto is_before = [ts, strict](const EventCD &ev) { return strict ? ev.t <= ts : ev.t < ts; };
+
+    // Finds the first chunk whose last event is not before ts
+    size_t first = 0, count = n_chunks_;
+    while (count > 0) {
+        const size_t step = count / 2;
+        if (is_before(*(chunk(first + step).end - 1))) {
+            first += step + 1;
+            count -= step + 1;
+        } else {
+            count = step;
+        }
+    }
+    if (first == n_chunks_) {
+        return n_chunks_ == 0 ? EventPosition{0, nullptr} : EventPosition{n_chunks_ - 1, chunk(n_chunks_ - 1).end};
+    }
+
+    const EventsChunk &c = chunk(first);
+    return {first, std::partition_point(c.begin, c.end, is_before)};
+}
+
+void OnDemandFrameGenerationAlgorithm::release_events_before(const EventPosition &pos) {
+    const size_t n_released = std::min(pos.chunk, n_chunks_);
+    for (size_t i = 0; i < n_released; ++i) {
+        chunk(i).buffer.reset();
+    }
+    first_chunk_ = n_chunks_ == 0 ? 0 : (first_chunk_ + n_released) & (chunks_.size() - 1);
+    n_chunks_ -= n_released;
+
+    if (n_chunks_ != 0) {
+        chunk(0).begin = pos.event;
+        if (chunk(0).begin == chunk(0).end) {
+            // Only the last chunk can be entirely released this way
+            chunk(0).buffer.reset();
+            first_chunk_ = 0;
+            n_chunks_    = 0;
+        }
+    }
+}
+
 } // namespace Metavision
\ No newline at end of file
@@ -9,11 +9,35 @@
  * See the License for the specific language governing permissions and limitations under the License.                 *
  **********************************************************************************************************************/
 
+#include <algorithm>
 #include <stdexcept>
 #include "metavision/sdk/core/algorithms/periodic_frame_generation_algorithm.h"
 
 namespace Metavision {
 
+namespace {
+// Updates the pixels of the frame in [x_begin, x_end[ x [y_begin, y_end[ from the time surface, and returns whether
+// any of them displays an event
+template<typename Pixel>
+bool update_frame_tile(const std::vector<std::pair<int32_t, bool>> &time_surface, cv::Mat &frame, size_t x_begin,
+                       size_t x_end, size_t y_begin, size_t y_end, int32_t min_display_event_ts, const Pixel &bg_color,
+                       const std::array<Pixel, 2> &off_on_colors, bool flip_y) {
+    const size_t width  = static_cast<size_t>(frame.cols);
+    const size_t height = static_cast<size_t>(frame.rows);
+    bool painted        = false;
+    for (size_t y = y_begin; y < y_end; ++y) {
+        const auto last_pix_data_ptr = &time_surface[y * width];
+        auto img_ptr                 = frame.ptr<Pixel>(flip_y ? height - 1 - y : y);
+        for (size_t x = x_begin; x < x_end; ++x) {
+            const bool displayed = last_pix_data_ptr[x].first >= min_display_event_ts;
+            img_ptr[x]           = displayed ? off_on_colors[last_pix_data_ptr[x].second] : bg_color;
+            painted |= displayed;
+        }
+    }
+    return painted;
+}
+} // namespace
+
 PeriodicFrameGenerationAlgorithm::PeriodicFrameGenerationAlgorithm(int sensor_width, int sensor_height,
                                                                    uint32_t accumulation_time_us, double fps,
                                                                    const Metavision::ColorPalette &palette) :
@@ -110,41 +134,49 @@ void PeriodicFrameGenerationAlgorithm::process_async(const timestamp processing_
         _off_on_colors4 = {detail::rgba(off_on_colors_[0]), detail::rgba(off_on_colors_[1])};
     }
 
-    // Fill the frame from the time surface
-    const size_t height = static_cast<size_t>(frame_.rows);
-    const size_t width  = static_cast<size_t>(frame_.cols);
-    // Matrices allocated with the create() method are always continuous in memory
-    if (flags_ & Parameters::GRAY) {
-        for (size_t y = 0; y < height; ++y) {
-            const auto last_pix_data_ptr = &time_surface_[y * width];
-            auto img_ptr                 = frame_.ptr<uint8_t>(flags_ & Parameters::FLIP_Y ? height - 1 - y : y);
-            for (size_t x = 0; x < width; ++x) {
-                img_ptr[x] = last_pix_data_ptr[x].first < min_display_event_ts ?
-                                 bg_color_[0] :
-                                 off_on_colors_[last_pix_data_ptr[x].second][0];
-            }
-        }
-    } else if (flags_ & Parameters::RGB || flags_ & Parameters::BGR) {
-        for (size_t y = 0; y < height; ++y) {
-            const auto last_pix_data_ptr = &time_surface_[y * width];
-            auto img_ptr                 = frame_.ptr<cv::Vec3b>(flags_ & Parameters::FLIP_Y ? height - 1 - y : y);
-            for (size_t x = 0; x < width; ++x) {
-                img_ptr[x] = last_pix_data_ptr[x].first < min_display_event_ts ?
-                                 _bg_color3 :
-                                 _off_on_colors3[last_pix_data_ptr[x].second];
+    // The previous frame can be updated incrementally only if it has been generated with the same parameters and if
+    // all the pixels it displayed as background still have to be
+    const timestamp min_display_ts = processing_ts - accumulation_time_us_;
+    const bool incremental = incremental_update_ && frame_.data == last_frame_data_ && flags_ == last_flags_ &&
+                             bg_color_ == last_bg_color_ && off_on_colors_ == last_off_on_colors_ &&
+                             min_display_ts >= last_min_display_ts_;
+
+    // Fill the frame from the time surface, tile per tile
+    const size_t height      = static_cast<size_t>(frame_.rows);
+    const size_t width       = static_cast<size_t>(frame_.cols);
+    const size_t tile_width  = size_t(1) << tile_shift_x_;
+    const size_t tile_height = size_t(1) << tile_shift_y_;
+    const bool flip_y        = flags_ & Parameters::FLIP_Y;
+    size_t tile              = 0;
+    for (size_t y = 0; y < height; y += tile_height) {
+        const size_t y_end = std::min(y + tile_height, height);
+        for (size_t x = 0; x < width; x += tile_width, ++tile) {
+            // A tile that displayed only background and did not receive any event since still does
+            if (incremental && !painted_tiles_[tile] && !active_tiles_[tile]) {
+                continue;
             }
-        }
-    } else {
-        for (size_t y = 0; y < height; ++y) {
-            const auto last_pix_data_ptr = &time_surface_[y * width];
-            auto img_ptr                 = frame_.ptr<cv::Vec4b>(flags_ & Parameters::FLIP_Y ? height - 1 - y : y);
-            for (size_t x = 0; x < width; ++x) {
-                img_ptr[x] = last_pix_data_ptr[x].first < min_display_event_ts ?
-                                 _bg_color4 :
-                                 _off_on_colors4[last_pix_data_ptr[x].second];
+            const size_t x_end = std::min(x + tile_width, width);
+            // Matrices allocated with the create() method are always continuous in memory
+            if (flags_ & Parameters::GRAY) {
+                painted_tiles_[tile] = update_frame_tile<uint8_t>(time_surface_, frame_, x, x_end, y, y_end,
+                                                                  min_display_event_ts, bg_color_[0],
+                                                                  {off_on_colors_[0][0], off_on_colors_[1][0]}, flip_y);
+            } else if (flags_ & Parameters::RGB || flags_ & Parameters::BGR) {
+                painted_tiles_[tile] = update_frame_tile(time_surface_, frame_, x, x_end, y, y_end,
+                                                         min_display_event_ts, _bg_color3, _off_on_colors3, flip_y);
+            } else {
+                painted_tiles_[tile] = update_frame_tile(time_surface_, frame_, x, x_end, y, y_end,
+                                                         min_display_event_ts, _bg_color4, _off_on_colors4, flip_y);
             }
         }
     }
+    std::fill(active_tiles_.begin(), active_tiles_.end(), 0);
+
+    last_frame_data_     = frame_.data;
+    last_flags_          = flags_;
+    last_bg_color_       = bg_color_;
+    last_off_on_colors_  = off_on_colors_;
+    last_min_display_ts_ = min_display_ts;
 
     // Return generate frame through the output callback
     output_cb_(processing_ts, frame_);
@@ -161,10 +193,22 @@ void PeriodicFrameGenerationAlgorithm::skip_frames_up_to(timestamp ts) {
     min_event_ts_us_to_use_ = next_frame_ts_us_ - accumulation_time_us_;
 }
 
+void PeriodicFrameGenerationAlgorithm::set_incremental_update(bool enabled) {
+    incremental_update_ = enabled;
+    // Events processed so far have not been tracked, the next frame must be fully generated
+    last_frame_data_ = nullptr;
+}
+
 void PeriodicFrameGenerationAlgorithm::reset_time_surface() {
     time_surface_.resize(width_ * height_);
     std::fill(time_surface_.begin(), time_surface_.end(), std::make_pair(std::numeric_limits<int32_t>::min(), false));
     ts_offset_ = 0;
+
+    n_tiles_x_ = (width_ + (1 << tile_shift_x_) - 1) >> tile_shift_x_;
+    const int n_tiles_y = (height_ + (1 << tile_shift_y_) - 1) >> tile_shift_y_;
+    active_tiles_.assign(n_tiles_x_ * n_tiles_y, 0);
+    painted_tiles_.assign(n_tiles_x_ * n_tiles_y, 0);
+    last_frame_data_ = nullptr;
 }
 
 } // namespace Metavision
\ No newline at end of file
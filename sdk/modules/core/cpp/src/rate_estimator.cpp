@@ -16,17 +16,42 @@
 
 namespace Metavision {
 
+namespace {
+timestamp floor_div(timestamp a, timestamp b) {
+    return a / b - (a % b != 0 && (a < 0) != (b < 0) ? 1 : 0);
+}
+
+timestamp ceil_div(timestamp a, timestamp b) {
+    return -floor_div(-a, b);
+}
+} // namespace
+
 RateEstimator::RateEstimator(const Callback &cb, timestamp step_time, timestamp window_time, bool system_time_flag) {
+    if (step_time <= 0) {
+        throw std::invalid_argument("Rate estimator expects a strictly positive step time.");
+    }
+    if (window_time <= 0) {
+        throw std::invalid_argument("Rate estimator expects a strictly positive window time.");
+    }
     cb_               = cb;
     step_time_        = step_time;
     window_time_      = window_time;
     peak_time_        = step_time;
     next_time_        = step_time;
     system_time_flag_ = system_time_flag;
+
+    // The buckets of a window, and the ones of the samples added since its end, i.e. up to a step later
+    buckets_.resize((window_time_ + step_time_) / peak_time_ + 3);
 }
 
 RateEstimator::RateEstimator(timestamp step_time, timestamp window_time, timestamp peak_time, const Callback &cb,
                              bool system_time_flag) {
+    if (step_time <= 0) {
+        throw std::invalid_argument("Rate estimator expects a strictly positive step time.");
+    }
+    if (peak_time <= 0) {
+        throw std::invalid_argument("Rate estimator expects a strictly positive peak time.");
+    }
     cb_          = cb;
     step_time_   = step_time;
     window_time_ = window_time;
@@ -37,14 +62,62 @@ RateEstimator::RateEstimator(timestamp step_time, timestamp window_time, timesta
     }
     next_time_        = step_time;
     system_time_flag_ = system_time_flag;
+    buckets_.resize((window_time_ + step_time_) / peak_time_ + 3);
+}
+
+RateEstimator::Bucket &RateEstimator::bucket(size_t i) {
+    return buckets_[(first_bucket_ + i) % buckets_.size()];
+}
+
+void RateEstimator::pop_bucket() {
+    if (n_window_buckets_ > 0) {
+        window_count_ -= bucket(0).count;
+        --n_window_buckets_;
+        if (!peak_buckets_.empty() && peak_buckets_.front().index == bucket(0).index) {
+            peak_buckets_.pop_front();
+        }
+    }
+    first_bucket_ = (first_bucket_ + 1) % buckets_.size();
+    --n_buckets_;
+}
+
+std::pair<size_t, size_t> RateEstimator::update_window(timestamp callback_time) {
+    const timestamp first_index = floor_div(callback_time - window_time_, peak_time_) + 1;
+    const timestamp last_index  = ceil_div(callback_time, peak_time_);
+    while (n_buckets_ > 0 && bucket(0).index < first_index) {
+        pop_bucket();
+    }
+
+    // Only the buckets that can't receive samples anymore, i.e. all but the newest one, are accounted in the window
+    while (n_window_buckets_ + 1 < n_buckets_ && bucket(n_window_buckets_).index <= last_index) {
+        const Bucket &b = bucket(n_window_buckets_++);
+        window_count_ += b.count;
+        while (!peak_buckets_.empty() && peak_buckets_.back().count <= b.count) {
+            peak_buckets_.pop_back();
+        }
+        peak_buckets_.push_back(b);
+    }
+
+    size_t count = window_count_, peak_count = peak_buckets_.empty() ? 0 : peak_buckets_.front().count;
+    if (n_window_buckets_ < n_buckets_ && bucket(n_window_buckets_).index <= last_index) {
+        count += bucket(n_window_buckets_).count;
+        peak_count = std::max(peak_count, bucket(n_window_buckets_).count);
+    }
+    return {count, peak_count};
 }
 
 void RateEstimator::add_data(timestamp time, size_t count) {
     long long current_time = time;
-    if (!counts_.empty() && counts_.back().first == time) {
-        counts_.back().second += count;
+    const timestamp index  = ceil_div(time, peak_time_);
+    if (n_buckets_ > 0 && bucket(n_buckets_ - 1).index == index) {
+        bucket(n_buckets_ - 1).count += count;
     } else {
-        counts_.emplace_back(time, count);
+        // The ring only overflows when no callback removes the old buckets, or after a gap in the samples: the
+        // oldest bucket is then out of the next window anyway
+        if (n_buckets_ == buckets_.size()) {
+            pop_bucket();
+        }
+        bucket(n_buckets_++) = {index, count};
     }
 
     if (system_time_flag_) {
@@ -60,39 +133,24 @@ void RateEstimator::add_data(timestamp time, size_t count) {
             next_time_ += step_time_;
         }
         if (cb_) {
-            timestamp next_peak_time = peak_time_;
-            timestamp callback_time  = (system_time_flag_ ? time : next_time_);
-            double cur_peak_rate = 0., peak_rate = 0., avg_rate = 0.;
-
-            // find the first count corresponding to the next callback timestamp minus the time window
-            auto begin_it = std::lower_bound(counts_.begin(), counts_.end(), callback_time - window_time_ + 1,
-                                             [](const auto &p, const timestamp &t) { return p.first < t; }),
-                 end_it   = std::lower_bound(counts_.begin(), counts_.end(), callback_time + 1,
-                                           [](const auto &p, const timestamp &t) { return p.first < t; });
-
-            // update the average and peak rate from counts in the window timespan
-            for (auto it = begin_it; it != end_it; ++it) {
-                avg_rate += it->second;
-                cur_peak_rate += it->second;
-                if (it->first >= next_peak_time) {
-                    cur_peak_rate /= peak_time_;
-                    peak_rate      = std::max(peak_rate, cur_peak_rate);
-                    cur_peak_rate  = 0;
-                    next_peak_time = static_cast<timestamp>(1 + it->first / peak_time_) * peak_time_;
-                }
-            }
+            const timestamp callback_time = (system_time_flag_ ? time : next_time_);
+            const auto counts             = update_window(callback_time);
+
+            double avg_rate        = static_cast<double>(counts.first);
+            const double peak_rate = static_cast<double>(counts.second) / peak_time_;
             avg_rate /= std::min(callback_time, window_time_);
             cb_(callback_time, avg_rate * 1.e6, peak_rate * 1.e6);
-
-            // remove older countime from the map, they won't be needed anymore
-            counts_.erase(counts_.begin(), begin_it);
         }
         next_time_ += step_time_;
     }
 }
 
 void RateEstimator::reset_data() {
-    counts_.clear();
+    first_bucket_     = 0;
+    n_buckets_        = 0;
+    n_window_buckets_ = 0;
+    window_count_     = 0;
+    peak_buckets_.clear();
     next_time_ = step_time_;
 }
 
@@ -0,0 +1,113 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/core/algorithms/adaptive_rate_events_splitter_algorithm.h"
+
+using namespace Metavision;
+
+namespace {
+constexpr int width = 320, height = 240;
+
+// Events of a bar moving across the sensor, positive at its front and negative at its back, with noise
+std::vector<EventCD> make_events(size_t n_events) {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> x_dist(0, width - 1), y_dist(0, height - 1), dx_dist(0, 7), noise_dist(0, 9);
+    std::vector<EventCD> events;
+    for (size_t i = 0; i < n_events; ++i) {
+        if (noise_dist(gen) == 0) {
+            events.emplace_back(x_dist(gen), y_dist(gen), noise_dist(gen) % 2, static_cast<timestamp>(i));
+        } else {
+            const int dx = dx_dist(gen);
+            events.emplace_back(static_cast<int>((i / 200 + dx) % width), y_dist(gen), dx >= 4,
+                                static_cast<timestamp>(i));
+        }
+    }
+    return events;
+}
+
+// Sizes of the slices found by split_events, when processing the events by buffers of buffer_size events
+std::vector<size_t> split_sizes(AdaptiveRateEventsSplitterAlgorithm &splitter, const std::vector<EventCD> &events,
+                                size_t buffer_size, size_t n_events_per_check) {
+    std::vector<size_t> sizes, split_offsets;
+    size_t slice_begin = 0;
+    for (size_t begin = 0; begin < events.size(); begin += buffer_size) {
+        const size_t end = std::min(events.size(), begin + buffer_size);
+        splitter.split_events(events.cbegin() + begin, events.cbegin() + end, split_offsets, n_events_per_check);
+        for (size_t offset : split_offsets) {
+            EXPECT_LT(0u, offset);
+            EXPECT_LE(offset, end - begin);
+            sizes.push_back(begin + offset - slice_begin);
+            slice_begin = begin + offset;
+        }
+    }
+    return sizes;
+}
+} // namespace
+
+TEST(AdaptiveRateEventsSplitterAlgorithm_GTest, split_events_as_process_events) {
+    // GIVEN a stream of events processed by buffers of 1000 events
+    const auto events = make_events(200000);
+
+    // WHEN the events are gathered by the splitter, or split in place
+    AdaptiveRateEventsSplitterAlgorithm gathering_splitter(height, width, 1e-4f, 1);
+    std::vector<size_t> gathered_sizes;
+    std::vector<EventCD> slice;
+    for (size_t begin = 0; begin < events.size(); begin += 1000) {
+        if (gathering_splitter.process_events(events.cbegin() + begin, events.cbegin() + begin + 1000)) {
+            gathering_splitter.retrieve_events(slice);
+            gathered_sizes.push_back(slice.size());
+        }
+    }
+
+    AdaptiveRateEventsSplitterAlgorithm splitter(height, width, 1e-4f, 1);
+    const auto sizes = split_sizes(splitter, events, 1000, 0);
+
+    // THEN the slices are the same
+    ASSERT_LT(10u, sizes.size());
+    ASSERT_EQ(gathered_sizes, sizes);
+}
+
+TEST(AdaptiveRateEventsSplitterAlgorithm_GTest, split_events_within_buffers) {
+    // GIVEN a stream of events
+    const auto events = make_events(200000);
+
+    // WHEN the criteria are checked every 100 events in buffers of 1000 events, or at the end of buffers of 100 events
+    AdaptiveRateEventsSplitterAlgorithm splitter(height, width, 1e-4f, 1);
+    const auto sizes = split_sizes(splitter, events, 1000, 100);
+
+    AdaptiveRateEventsSplitterAlgorithm ref_splitter(height, width, 1e-4f, 1);
+    const auto ref_sizes = split_sizes(ref_splitter, events, 100, 0);
+
+    // THEN the slices are the same, and end within the buffers
+    ASSERT_EQ(ref_sizes, sizes);
+    ASSERT_TRUE(std::any_of(sizes.cbegin(), sizes.cend(), [](size_t size) { return size % 1000 != 0; }));
+}
+
+TEST(AdaptiveRateEventsSplitterAlgorithm_GTest, reset) {
+    // GIVEN a splitter that processed a part of a slice
+    const auto events = make_events(100000);
+    AdaptiveRateEventsSplitterAlgorithm splitter(height, width, 1e-4f, 1);
+    std::vector<size_t> split_offsets;
+    splitter.split_events(events.cbegin(), events.cbegin() + 10, split_offsets);
+    ASSERT_TRUE(split_offsets.empty());
+
+    // WHEN it is reset
+    splitter.reset();
+
+    // THEN it splits the stream as a new splitter does
+    AdaptiveRateEventsSplitterAlgorithm ref_splitter(height, width, 1e-4f, 1);
+    ASSERT_EQ(split_sizes(ref_splitter, events, 500, 50), split_sizes(splitter, events, 500, 50));
+}
@@ -10,6 +10,7 @@
  **********************************************************************************************************************/
 
 #include <gtest/gtest.h>
+#include <random>
 #include <vector>
 #include <opencv2/core.hpp>
 
@@ -18,6 +19,55 @@
 
 using namespace Metavision;
 
+namespace {
+// Gives access to the frame generation with flags
+struct FrameGenerationWithFlags : public BaseFrameGenerationAlgorithm {
+    using BaseFrameGenerationAlgorithm::generate_frame_from_events;
+};
+
+std::vector<EventCD> make_random_events(int width, int height, size_t n_events) {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> x_dist(0, width - 1), y_dist(0, height - 1), p_dist(0, 1);
+    std::vector<EventCD> events;
+    for (size_t i = 0; i < n_events; ++i) {
+        events.emplace_back(x_dist(gen), y_dist(gen), p_dist(gen), static_cast<timestamp>(i));
+    }
+    return events;
+}
+
+// Straightforward frame generation, pixel per pixel
+cv::Mat make_expected_frame(const std::vector<EventCD> &events, int width, int height, const cv::Vec4b &bg_color,
+                            const std::array<cv::Vec4b, 2> &off_on_colors, int flags) {
+    const bool rgb_order = (flags & (BaseFrameGenerationAlgorithm::RGB | BaseFrameGenerationAlgorithm::RGBA)) != 0;
+    const auto to_pixel  = [rgb_order](const cv::Vec4b &c) {
+        return rgb_order ? cv::Vec4b(c[2], c[1], c[0], c[3]) : c;
+    };
+    int channels = 4;
+    if (flags & BaseFrameGenerationAlgorithm::GRAY) {
+        channels = 1;
+    } else if (flags & (BaseFrameGenerationAlgorithm::RGB | BaseFrameGenerationAlgorithm::BGR)) {
+        channels = 3;
+    }
+
+    cv::Mat frame(height, width, CV_8UC(channels));
+    const auto set_pixel = [&](int y, int x, const cv::Vec4b &c) {
+        for (int i = 0; i < channels; ++i) {
+            frame.ptr<uint8_t>(y)[x * channels + i] = c[i];
+        }
+    };
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            set_pixel(y, x, to_pixel(bg_color));
+        }
+    }
+    for (const auto &ev : events) {
+        const int y = (flags & BaseFrameGenerationAlgorithm::FLIP_Y) ? height - 1 - ev.y : ev.y;
+        set_pixel(y, ev.x, to_pixel(off_on_colors[ev.p]));
+    }
+    return frame;
+}
+} // namespace
+
 class BaseFrameGenerationAlgorithm_GTest : public ::testing::Test {
 public:
     BaseFrameGenerationAlgorithm_GTest() {}
@@ -107,3 +157,61 @@ TEST(BaseFrameGenerationAlgorithm_GTest, static_frame_generation_with_accumulati
     ASSERT_EQ(expected_frame.size(), frame.size());
     ASSERT_TRUE(std::equal(expected_frame.begin<uint8_t>(), expected_frame.end<uint8_t>(), frame.begin<uint8_t>()));
 }
+
+TEST(BaseFrameGenerationAlgorithm_GTest, frame_generation_with_flags) {
+    const int width = 64, height = 48;
+    const cv::Vec4b bg_color(10, 20, 30, 40);
+    const std::array<cv::Vec4b, 2> off_on_colors{cv::Vec4b(50, 60, 70, 80), cv::Vec4b(90, 100, 110, 120)};
+    // Many more events than pixels, so that most pixels are written several times
+    const auto events = make_random_events(width, height, 10 * width * height);
+
+    using Base = BaseFrameGenerationAlgorithm;
+    for (int format : {Base::GRAY, Base::RGB, Base::BGR, Base::RGBA, Base::BGRA}) {
+        for (int flip : {0, static_cast<int>(Base::FLIP_Y)}) {
+            const int flags  = format | flip;
+            cv::Mat expected = make_expected_frame(events, width, height, bg_color, off_on_colors, flags);
+            cv::Mat frame(height, width, expected.type(), cv::Scalar::all(0));
+            FrameGenerationWithFlags::generate_frame_from_events(events.cbegin(), events.cend(), frame, bg_color,
+                                                                 off_on_colors, flags);
+            ASSERT_EQ(0, cv::norm(expected, frame, cv::NORM_INF)) << "flags: " << flags;
+        }
+    }
+}
+
+TEST(BaseFrameGenerationAlgorithm_GTest, multithreaded_frame_generation_keeps_last_event_per_pixel) {
+    const int width = 1280, height = 720;
+    const cv::Vec4b bg_color(10, 20, 30, 40);
+    const std::array<cv::Vec4b, 2> off_on_colors{cv::Vec4b(50, 60, 70, 80), cv::Vec4b(90, 100, 110, 120)};
+    // Large enough to be split into bands rendered by different threads
+    const auto events = make_random_events(width, height, 4 * width * height);
+
+    using Base = BaseFrameGenerationAlgorithm;
+    for (int flags : {static_cast<int>(Base::BGR), Base::RGBA | Base::FLIP_Y}) {
+        cv::Mat expected = make_expected_frame(events, width, height, bg_color, off_on_colors, flags);
+        cv::Mat frame(height, width, expected.type(), cv::Scalar::all(0));
+        FrameGenerationWithFlags::generate_frame_from_events(events.cbegin(), events.cend(), frame, bg_color,
+                                                             off_on_colors, flags);
+        ASSERT_EQ(0, cv::norm(expected, frame, cv::NORM_INF)) << "flags: " << flags;
+    }
+}
+
+TEST(BaseFrameGenerationAlgorithm_GTest, frame_generation_in_sub_matrix) {
+    const int width = 16, height = 12;
+    const auto events = make_random_events(width, height, 100);
+
+    // The frame rows are not contiguous in memory
+    cv::Mat parent(2 * height, 2 * width, CV_8UC3, cv::Scalar::all(0));
+    cv::Mat frame = parent(cv::Rect(width / 2, height / 2, width, height));
+    BaseFrameGenerationAlgorithm::generate_frame_from_events(events.cbegin(), events.cend(), frame);
+
+    const cv::Vec4b bg_color = detail::bgra(BaseFrameGenerationAlgorithm::bg_color_default());
+    const std::array<cv::Vec4b, 2> off_on_colors{detail::bgra(BaseFrameGenerationAlgorithm::off_color_default()),
+                                                 detail::bgra(BaseFrameGenerationAlgorithm::on_color_default())};
+    cv::Mat expected =
+        make_expected_frame(events, width, height, bg_color, off_on_colors, BaseFrameGenerationAlgorithm::BGR);
+    ASSERT_EQ(0, cv::norm(expected, frame, cv::NORM_INF));
+
+    // The pixels around the frame are untouched
+    EXPECT_EQ(0, cv::countNonZero(parent.row(0).reshape(1)));
+    EXPECT_EQ(0, cv::countNonZero(parent.row(2 * height - 1).reshape(1)));
+}
@@ -0,0 +1,212 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+#include <opencv2/core.hpp>
+
+#include "metavision/sdk/core/algorithms/batch_frame_generation_algorithm.h"
+#include "metavision/sdk/base/events/event_cd.h"
+
+using namespace Metavision;
+
+namespace {
+const int sensor_width  = 64;
+const int sensor_height = 48;
+
+// Events with random positions, a few per microsecond on average
+std::vector<EventCD> make_random_events(timestamp duration_us) {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> x_dist(0, sensor_width - 1), y_dist(0, sensor_height - 1), p_dist(0, 1),
+        dt_dist(0, 1);
+    std::vector<EventCD> events;
+    for (timestamp t = 0; t < duration_us; t += dt_dist(gen)) {
+        events.emplace_back(x_dist(gen), y_dist(gen), p_dist(gen), t);
+    }
+    return events;
+}
+
+// Straightforward frame generation from the events in [ts - accumulation_time_us, ts[, pixel per pixel
+cv::Mat make_expected_frame(const std::vector<EventCD> &events, timestamp ts, uint32_t accumulation_time_us,
+                            int flags) {
+    const cv::Vec4b bg_color = detail::bgra(BaseFrameGenerationAlgorithm::bg_color_default());
+    const std::array<cv::Vec4b, 2> off_on_colors{detail::bgra(BaseFrameGenerationAlgorithm::off_color_default()),
+                                                 detail::bgra(BaseFrameGenerationAlgorithm::on_color_default())};
+    const bool rgb_order = (flags & (BaseFrameGenerationAlgorithm::RGB | BaseFrameGenerationAlgorithm::RGBA)) != 0;
+    const auto to_pixel  = [rgb_order](const cv::Vec4b &c) {
+        return rgb_order ? cv::Vec4b(c[2], c[1], c[0], c[3]) : c;
+    };
+    int channels = 4;
+    if (flags & BaseFrameGenerationAlgorithm::GRAY) {
+        channels = 1;
+    } else if (flags & (BaseFrameGenerationAlgorithm::RGB | BaseFrameGenerationAlgorithm::BGR)) {
+        channels = 3;
+    }
+
+    cv::Mat frame(sensor_height, sensor_width, CV_8UC(channels));
+    const auto set_pixel = [&](int y, int x, const cv::Vec4b &c) {
+        for (int i = 0; i < channels; ++i) {
+            frame.ptr<uint8_t>(y)[x * channels + i] = c[i];
+        }
+    };
+    for (int y = 0; y < sensor_height; ++y) {
+        for (int x = 0; x < sensor_width; ++x) {
+            set_pixel(y, x, to_pixel(bg_color));
+        }
+    }
+    for (const auto &ev : events) {
+        if (ev.t >= ts - accumulation_time_us && ev.t < ts) {
+            const int y = (flags & BaseFrameGenerationAlgorithm::FLIP_Y) ? sensor_height - 1 - ev.y : ev.y;
+            set_pixel(y, ev.x, to_pixel(off_on_colors[ev.p]));
+        }
+    }
+    return frame;
+}
+
+bool are_equal(const cv::Mat &lhs, const cv::Mat &rhs) {
+    if (lhs.type() != rhs.type() || lhs.size() != rhs.size()) {
+        return false;
+    }
+    for (int y = 0; y < lhs.rows; ++y) {
+        if (!std::equal(lhs.ptr<uint8_t>(y), lhs.ptr<uint8_t>(y) + lhs.cols * lhs.elemSize(), rhs.ptr<uint8_t>(y))) {
+            return false;
+        }
+    }
+    return true;
+}
+} // namespace
+
+class BatchFrameGenerationAlgorithm_GTest : public ::testing::Test {
+public:
+    BatchFrameGenerationAlgorithm_GTest() {}
+
+    virtual ~BatchFrameGenerationAlgorithm_GTest() {}
+
+protected:
+    virtual void SetUp() override {}
+
+    virtual void TearDown() override {}
+};
+
+TEST(BatchFrameGenerationAlgorithm_GTest, overlapping_frames) {
+    // GIVEN random events and frames whose accumulation windows overlap a lot
+    const auto events                   = make_random_events(20000);
+    const uint32_t accumulation_time_us = 2000;
+    std::vector<timestamp> frames_ts;
+    for (timestamp ts = 100; ts <= 21000; ts += 100) {
+        frames_ts.push_back(ts);
+    }
+
+    BatchFrameGenerationAlgorithm frame_generation(sensor_width, sensor_height);
+    for (int flags :
+         {static_cast<int>(BaseFrameGenerationAlgorithm::BGR), static_cast<int>(BaseFrameGenerationAlgorithm::GRAY),
+          BaseFrameGenerationAlgorithm::RGBA | BaseFrameGenerationAlgorithm::FLIP_Y}) {
+        frame_generation.set_parameters(detail::bgra(BaseFrameGenerationAlgorithm::bg_color_default()),
+                                        detail::bgra(BaseFrameGenerationAlgorithm::on_color_default()),
+                                        detail::bgra(BaseFrameGenerationAlgorithm::off_color_default()), flags);
+        for (int max_threads : {1, 4}) {
+            frame_generation.set_max_threads(max_threads);
+
+            // WHEN we generate all the frames at once
+            std::vector<cv::Mat> frames;
+            frame_generation.generate(events.cbegin(), events.cend(), frames_ts, accumulation_time_us, frames);
+
+            // THEN each frame holds the events in its accumulation window
+            ASSERT_EQ(frames_ts.size(), frames.size());
+            for (size_t k = 0; k < frames.size(); ++k) {
+                ASSERT_TRUE(
+                    are_equal(make_expected_frame(events, frames_ts[k], accumulation_time_us, flags), frames[k]))
+                    << "Frame " << k << ", flags " << flags << ", " << max_threads << " threads";
+            }
+        }
+    }
+}
+
+TEST(BatchFrameGenerationAlgorithm_GTest, varying_accumulation_times) {
+    // GIVEN random events and frames with random accumulation times, so that windows may grow, shrink, or not overlap
+    const auto events = make_random_events(20000);
+    std::mt19937 gen(0);
+    std::uniform_int_distribution<uint32_t> accumulation_dist(1, 3000);
+    std::vector<timestamp> frames_ts;
+    std::vector<uint32_t> accumulation_times_us;
+    for (timestamp ts = 0; ts <= 20000; ts += 150) {
+        frames_ts.push_back(ts);
+        accumulation_times_us.push_back(accumulation_dist(gen));
+    }
+
+    BatchFrameGenerationAlgorithm frame_generation(sensor_width, sensor_height);
+    for (int max_threads : {1, 3}) {
+        frame_generation.set_max_threads(max_threads);
+
+        // WHEN we generate all the frames at once
+        std::vector<cv::Mat> frames;
+        frame_generation.generate(events.cbegin(), events.cend(), frames_ts, accumulation_times_us, frames);
+
+        // THEN each frame holds the events in its accumulation window
+        ASSERT_EQ(frames_ts.size(), frames.size());
+        for (size_t k = 0; k < frames.size(); ++k) {
+            ASSERT_TRUE(are_equal(make_expected_frame(events, frames_ts[k], accumulation_times_us[k],
+                                                      BaseFrameGenerationAlgorithm::BGR),
+                                  frames[k]))
+                << "Frame " << k << ", " << max_threads << " threads";
+        }
+    }
+}
+
+TEST(BatchFrameGenerationAlgorithm_GTest, frames_reused_unless_shared) {
+    const auto events                   = make_random_events(5000);
+    const uint32_t accumulation_time_us = 1000;
+    const std::vector<timestamp> first_frames_ts{1000, 1500, 2000}, next_frames_ts{3000, 3500, 4000};
+
+    BatchFrameGenerationAlgorithm frame_generation(sensor_width, sensor_height);
+    frame_generation.set_max_threads(1);
+
+    // GIVEN frames generated by a first batch, one of them being kept aside
+    std::vector<cv::Mat> frames;
+    frame_generation.generate(events.cbegin(), events.cend(), first_frames_ts, accumulation_time_us, frames);
+    std::vector<const uint8_t *> frames_data;
+    for (const auto &frame : frames) {
+        frames_data.push_back(frame.data);
+    }
+    const cv::Mat kept_frame = frames[1];
+
+    // WHEN we generate the next batch with the same vector of frames
+    frame_generation.generate(events.cbegin(), events.cend(), next_frames_ts, accumulation_time_us, frames);
+
+    // THEN the frames that are not shared are reused, and the kept frame is left untouched
+    ASSERT_EQ(frames_data[0], frames[0].data);
+    ASSERT_NE(frames_data[1], frames[1].data);
+    ASSERT_EQ(frames_data[2], frames[2].data);
+    ASSERT_TRUE(are_equal(
+        make_expected_frame(events, first_frames_ts[1], accumulation_time_us, BaseFrameGenerationAlgorithm::BGR),
+        kept_frame));
+    for (size_t k = 0; k < frames.size(); ++k) {
+        ASSERT_TRUE(are_equal(
+            make_expected_frame(events, next_frames_ts[k], accumulation_time_us, BaseFrameGenerationAlgorithm::BGR),
+            frames[k]));
+    }
+}
+
+TEST(BatchFrameGenerationAlgorithm_GTest, invalid_arguments) {
+    const auto events = make_random_events(1000);
+    BatchFrameGenerationAlgorithm frame_generation(sensor_width, sensor_height);
+    std::vector<cv::Mat> frames;
+
+    // Timestamps must be sorted
+    EXPECT_THROW(frame_generation.generate(events.cbegin(), events.cend(), {200, 100}, 100, frames),
+                 std::invalid_argument);
+
+    // There must be one accumulation time per frame
+    EXPECT_THROW(frame_generation.generate(events.cbegin(), events.cend(), {100, 200}, std::vector<uint32_t>{100},
+                                           frames),
+                 std::invalid_argument);
+}
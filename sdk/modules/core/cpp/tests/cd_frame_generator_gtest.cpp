@@ -10,6 +10,7 @@
  **********************************************************************************************************************/
 
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <atomic>
 
 #include "metavision/sdk/core/utils/cd_frame_generator.h"
@@ -187,3 +188,84 @@ TEST_F(CDFrameGenerator_GTest, generate_all_frames) {
     ASSERT_TRUE(std::equal(expected_cd_frames.back().begin<uint8_t>(), expected_cd_frames.back().end<uint8_t>(),
                            cd_frames.back().begin<uint8_t>()));
 }
+
+TEST_F(CDFrameGenerator_GTest, generate_all_frames_from_small_buffers) {
+    int width         = 100;
+    int height        = 50;
+    std::uint16_t fps = 100;
+
+    Metavision::CDFrameGenerator cd_frame_generator(width, height, true);
+    cd_frame_generator.set_display_accumulation_time_us(10000);
+    cd_frame_generator.set_colors(cv::Scalar::all(128), cv::Scalar::all(255), cv::Scalar::all(0), false);
+
+    std::vector<int> n_events_per_frame;
+    std::vector<Metavision::timestamp> time_cb;
+    cd_frame_generator.start(fps, [&](const Metavision::timestamp &ts, const cv::Mat &frame) {
+        n_events_per_frame.push_back(static_cast<int>(
+            std::count_if(frame.begin<uint8_t>(), frame.end<uint8_t>(), [](uint8_t v) { return v != 128; })));
+        time_cb.push_back(ts);
+    });
+
+    // One event every ms at a different pixel, added by buffers of 3 events, i.e. 10 events per frame of 10ms
+    const int n_events = 2000;
+    std::vector<Metavision::EventCD> events;
+    for (int i = 0; i < n_events; ++i) {
+        events.emplace_back(i % width, (i / width) % height, 1, 1000 * i);
+    }
+    for (int i = 0; i < n_events; i += 3) {
+        cd_frame_generator.add_events(events.data() + i, events.data() + std::min(i + 3, n_events));
+    }
+    cd_frame_generator.stop();
+
+    // All the frames are generated from the events of each slice, the last one during the flush
+    ASSERT_EQ(n_events / 10, time_cb.size());
+    for (int i = 0; i < n_events / 10 - 1; ++i) {
+        ASSERT_EQ((i + 1) * 10000, time_cb[i]);
+        ASSERT_EQ(10, n_events_per_frame[i]);
+    }
+    ASSERT_EQ(events.back().t + 1, time_cb.back());
+    ASSERT_EQ(10, n_events_per_frame.back());
+}
+
+TEST_F(CDFrameGenerator_GTest, generate_frame_published_while_generation_is_busy) {
+    int width         = 100;
+    int height        = 50;
+    std::uint16_t fps = 100;
+
+    Metavision::CDFrameGenerator cd_frame_generator(width, height, true);
+    cd_frame_generator.set_display_accumulation_time_us(10000);
+
+    // The first frame is rendered slowly, while more events are added
+    std::atomic<bool> in_first_cb{false}, release_first_cb{false};
+    std::atomic<Metavision::timestamp> last_ts{0};
+    cd_frame_generator.start(fps, [&](const Metavision::timestamp &ts, const cv::Mat &) {
+        if (!in_first_cb.exchange(true)) {
+            while (!release_first_cb) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+        last_ts = ts;
+    });
+
+    // One event every ms
+    std::vector<Metavision::EventCD> events;
+    for (int i = 0; i < 35; ++i) {
+        events.emplace_back(i % width, 0, 1, 1000 * i);
+    }
+    cd_frame_generator.add_events(events.data(), events.data() + 15);
+    while (!in_first_cb) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    // The first buffer is published, but the second one can not be as the generation thread is busy
+    cd_frame_generator.add_events(events.data() + 15, events.data() + 25);
+    cd_frame_generator.add_events(events.data() + 25, events.data() + 35);
+    release_first_cb = true;
+
+    // No more events are added: the last buffer is still rendered, without waiting for the generator to be stopped
+    for (int i = 0; i < 5000 && last_ts < 30000; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(30000, last_ts);
+    cd_frame_generator.stop();
+}
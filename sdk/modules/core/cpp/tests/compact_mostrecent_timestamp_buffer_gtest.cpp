@@ -0,0 +1,203 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <cstdlib>
+#include <random>
+#include <gtest/gtest.h>
+#include <opencv2/core.hpp>
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/core/algorithms/time_surface_producer_algorithm.h"
+#include "metavision/sdk/core/utils/compact_mostrecent_timestamp_buffer.h"
+
+using namespace Metavision;
+
+namespace {
+using Layout = CompactMostRecentTimestampBuffer::Layout;
+
+// Width not multiple of the tile size nor of the SIMD register size, to check the borders
+const int width  = 37;
+const int height = 21;
+
+// Sets random timestamps in [first_ts, last_ts] in both buffers
+void fill_randomly(CompactMostRecentTimestampBuffer &compact, MostRecentTimestampBuffer &reference, timestamp first_ts,
+                   timestamp last_ts) {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<timestamp> ts_dist(first_ts, last_ts);
+    for (int y = 0; y < compact.rows(); ++y) {
+        for (int x = 0; x < compact.cols(); ++x) {
+            for (int c = 0; c < compact.channels(); ++c) {
+                const timestamp ts = ts_dist(gen);
+                compact.set(y, x, c, ts);
+                reference.at(y, x, c) = ts;
+            }
+        }
+    }
+}
+
+// Checks that the images are equal, up to a rounding difference
+void expect_near(const cv::Mat &expected, const cv::Mat &img) {
+    ASSERT_EQ(expected.size(), img.size());
+    ASSERT_EQ(expected.type(), img.type());
+    for (int y = 0; y < img.rows; ++y) {
+        for (int x = 0; x < img.cols; ++x) {
+            EXPECT_LE(std::abs(expected.at<uint8_t>(y, x) - img.at<uint8_t>(y, x)), 1)
+                << "At (" << x << ", " << y << ")";
+        }
+    }
+}
+} // namespace
+
+TEST(CompactMostRecentTimestampBuffer_GTest, set_and_get) {
+    for (Layout layout : {Layout::RowMajor, Layout::Tiled}) {
+        // GIVEN a 2-channels buffer
+        CompactMostRecentTimestampBuffer buffer(height, width, 2, layout);
+        buffer.set_to(1000);
+
+        // WHEN setting timestamps at a few pixels
+        buffer.set(0, 0, 0, 1500);
+        buffer.set(0, 0, 1, 1200);
+        buffer.set(height - 1, width - 1, 1, 4000);
+        buffer.set(8, 9, 0, 500);
+
+        // THEN they are read back, timestamps older than the epoch being read as the epoch
+        EXPECT_EQ(1500, buffer.at(0, 0, 0));
+        EXPECT_EQ(1200, buffer.at(0, 0, 1));
+        EXPECT_EQ(1500, buffer.max_across_channels_at(0, 0));
+        EXPECT_EQ(4000, buffer.at(height - 1, width - 1, 1));
+        EXPECT_EQ(1000, buffer.at(height - 1, width - 1, 0));
+        EXPECT_EQ(1000, buffer.at(8, 9, 0));
+        EXPECT_EQ(1000, buffer.at(5, 5, 1));
+    }
+}
+
+TEST(CompactMostRecentTimestampBuffer_GTest, rebase_on_distant_timestamp) {
+    // GIVEN a buffer with a few timestamps
+    CompactMostRecentTimestampBuffer buffer(height, width);
+    buffer.set_to(0);
+    buffer.set(0, 0, 0, 100);
+    buffer.set(1, 1, 0, 3000000000);
+
+    // WHEN setting a timestamp that does not fit on 32 bits relatively to the epoch
+    const timestamp ts = 5000000000;
+    buffer.set(2, 2, 0, ts);
+
+    // THEN the buffer is rebased, the timestamps too old for the new epoch being clamped to it
+    EXPECT_EQ(ts, buffer.at(2, 2, 0));
+    EXPECT_EQ(3000000000, buffer.at(1, 1, 0));
+    EXPECT_EQ(buffer.epoch(), buffer.at(0, 0, 0));
+    EXPECT_LE(buffer.epoch(), ts - (timestamp(1) << 31));
+
+    // WHEN setting a timestamp far after all the others
+    buffer.set(3, 3, 0, 100000000000);
+
+    // THEN all the previous timestamps are clamped to the new epoch
+    EXPECT_EQ(100000000000, buffer.at(3, 3, 0));
+    EXPECT_EQ(buffer.epoch(), buffer.at(2, 2, 0));
+    EXPECT_EQ(buffer.epoch(), buffer.at(1, 1, 0));
+}
+
+TEST(CompactMostRecentTimestampBuffer_GTest, copy_to_timestamp_buffer) {
+    for (Layout layout : {Layout::RowMajor, Layout::Tiled}) {
+        // GIVEN a compact buffer and a regular buffer with the same timestamps
+        CompactMostRecentTimestampBuffer compact(height, width, 2, layout);
+        MostRecentTimestampBuffer reference(height, width, 2);
+        compact.set_to(10000);
+        fill_randomly(compact, reference, 10000, 200000);
+
+        // WHEN copying the compact buffer
+        MostRecentTimestampBuffer copy;
+        compact.copy_to(copy);
+
+        // THEN the copy holds the same timestamps
+        ASSERT_EQ(reference.size(), copy.size());
+        ASSERT_EQ(reference.channels(), copy.channels());
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                for (int c = 0; c < 2; ++c) {
+                    ASSERT_EQ(reference.at(y, x, c), copy.at(y, x, c));
+                }
+            }
+        }
+    }
+}
+
+TEST(CompactMostRecentTimestampBuffer_GTest, same_images_as_timestamp_buffer) {
+    for (int channels : {1, 2}) {
+        for (Layout layout : {Layout::RowMajor, Layout::Tiled}) {
+            // GIVEN a compact buffer and a regular buffer with the same timestamps, far from 0 so that the compact
+            // buffer has been rebased
+            const timestamp first_ts = 10000000000, last_ts = first_ts + 100000;
+            CompactMostRecentTimestampBuffer compact(height, width, channels, layout);
+            MostRecentTimestampBuffer reference(height, width, channels);
+            compact.set_to(first_ts - 5000000000);
+            reference.set_to(0);
+            fill_randomly(compact, reference, first_ts, last_ts);
+
+            // WHEN generating the time surface images, with windows partly or fully before the timestamps
+            for (timestamp delta_t : {1000, 50000, 200000}) {
+                cv::Mat expected, img;
+                reference.generate_img_time_surface(last_ts, delta_t, expected);
+                compact.generate_img_time_surface(last_ts, delta_t, img);
+
+                // THEN the images are the same, up to a rounding difference
+                expect_near(expected, img);
+
+                reference.generate_img_time_surface_collapsing_channels(last_ts, delta_t, expected);
+                compact.generate_img_time_surface_collapsing_channels(last_ts, delta_t, img);
+                expect_near(expected, img);
+            }
+        }
+    }
+}
+
+TEST(CompactMostRecentTimestampBuffer_GTest, time_surface_window_before_epoch) {
+    // GIVEN a buffer whose epoch is after the beginning of the time surface window
+    CompactMostRecentTimestampBuffer compact(height, width);
+    MostRecentTimestampBuffer reference(height, width);
+    compact.set_to(1000);
+    reference.set_to(1000);
+    fill_randomly(compact, reference, 1000, 3000);
+
+    // WHEN generating the time surface image
+    cv::Mat expected, img;
+    reference.generate_img_time_surface(3000, 10000, expected);
+    compact.generate_img_time_surface(3000, 10000, img);
+
+    // THEN the timestamps are normalized relatively to the beginning of the window, not to the epoch
+    expect_near(expected, img);
+}
+
+TEST(CompactMostRecentTimestampBuffer_GTest, producer_with_compact_time_surface) {
+    // GIVEN a producer of compact time surfaces, every 5 events
+    TimeSurfaceProducerAlgorithm<2, CompactMostRecentTimestampBuffer> producer(3, 3);
+    timestamp ts = -1;
+    MostRecentTimestampBuffer timesurface;
+    producer.set_output_callback([&](timestamp output_ts, const CompactMostRecentTimestampBuffer &output_timesurface) {
+        ts = output_ts;
+        output_timesurface.copy_to(timesurface);
+    });
+    producer.set_processing_n_events(5);
+
+    std::vector<EventCD> events = {{0, 0, 1, 0}, {1, 0, 0, 1}, {2, 0, 1, 2}, {0, 1, 0, 3}, {0, 0, 0, 4}, {2, 1, 1, 5}};
+
+    // WHEN we process the events
+    producer.process_events(events.cbegin(), events.cend());
+
+    // THEN one time surface is produced, with the events of each polarity in their own channel
+    ASSERT_EQ(4, ts);
+    EXPECT_EQ(4, timesurface.at(0, 0, 0));
+    EXPECT_EQ(0, timesurface.at(0, 0, 1));
+    EXPECT_EQ(1, timesurface.at(0, 1, 0));
+    EXPECT_EQ(2, timesurface.at(0, 2, 1));
+    EXPECT_EQ(3, timesurface.at(1, 0, 0));
+    EXPECT_EQ(0, timesurface.at(1, 2, 1));
+}
@@ -427,4 +427,53 @@ TEST_F(DataSynchronizerFromTriggers_GTest, LostTriggersThreaded) {
     trigger_thread.join();
 }
 
+TEST_F(DataSynchronizerFromTriggers_GTest, HighRateThreaded) {
+    // Checks that we synchronize correctly many data in threaded context, the triggers being indexed in batches while
+    // the data is synchronized in batches of a different size
+
+    const int32_t period_us = 33;
+    DataSynchronizerFromTriggers::Parameters param(period_us);
+    param.reference_polarity_ = 1;
+    DataSynchronizerFromTriggers sync(param);
+
+    const uint32_t n_data = 10000;
+    std::vector<uint32_t> indices(n_data);
+    std::vector<Event2dIndex> to_index(n_data);
+    for (uint32_t i = 0; i < n_data; ++i) {
+        indices[i]        = i;
+        to_index[i].index = i;
+    }
+    const auto trigger_buffer = create_trigger_buffer(indices, period_us, 0);
+
+    std::thread trigger_thread([&]() {
+        for (size_t i = 0; i < trigger_buffer.size(); i += 2 * 37) {
+            EXPECT_TRUE(sync.index_triggers(trigger_buffer.cbegin() + i,
+                                            trigger_buffer.cbegin() + std::min(i + 2 * 37, trigger_buffer.size())));
+            // Slows down the indexing so that the queue doesn't hold too many triggers
+            sync.wait_for_triggers_consumed(2000);
+        }
+    });
+
+    for (uint32_t i = 0; i < n_data; i += 101) {
+        const uint32_t n = std::min(101u, n_data - i);
+        EXPECT_EQ(n, sync.synchronize_data_from_triggers(to_index.begin() + i, to_index.begin() + i + n,
+                                                         &Event2dIndex::timestamp_accessor,
+                                                         &Event2dIndex::index_accessor));
+    }
+    trigger_thread.join();
+
+    for (uint32_t i = 0; i < n_data; ++i) {
+        ASSERT_EQ(trigger_buffer[2 * i + !param.reference_polarity_].t, to_index[i].t);
+    }
+
+    // The latency of each synchronized data is accounted
+    const auto stats = sync.get_latency_statistics();
+    EXPECT_EQ(n_data, stats.count_);
+    EXPECT_LE(0, stats.mean_us_);
+    EXPECT_LE(stats.mean_us_, stats.max_us_);
+
+    sync.reset_synchronization();
+    EXPECT_EQ(0, sync.get_latency_statistics().count_);
+}
+
 } // namespace Metavision
@@ -0,0 +1,129 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+// Compares the throughput of the ROI and polarity filtering kernels with the per-event predicates used before, on
+// buffers of EventCD as produced by a 1280x720 sensor
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/core/algorithms/detail/event_filter_kernels.h"
+#include "metavision/sdk/core/algorithms/detail/internal_algorithms.h"
+
+using namespace Metavision;
+using detail::SimdIsa;
+
+namespace {
+const size_t n_events      = 1 << 22;
+const size_t events_buffer = 1 << 14; // Typical size of the buffers decoded from a camera
+const int n_runs           = 20;
+
+std::vector<EventCD> make_events() {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> x_dist(0, 1279), y_dist(0, 719), p_dist(0, 1);
+    std::vector<EventCD> events;
+    events.reserve(n_events);
+    for (size_t i = 0; i < n_events; ++i) {
+        events.emplace_back(x_dist(gen), y_dist(gen), p_dist(gen), static_cast<timestamp>(i / 16));
+    }
+    return events;
+}
+
+// Runs the filter over the events buffer after buffer, and prints the best throughput over all runs
+template<typename Filter>
+void benchmark(const std::string &name, const std::vector<EventCD> &events, Filter &&filter) {
+    std::vector<EventCD> output(events_buffer);
+    double best_s = 1e9;
+    size_t n_out  = 0;
+    for (int run = 0; run < n_runs; ++run) {
+        n_out           = 0;
+        const auto t0   = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < events.size(); i += events_buffer) {
+            n_out += filter(events.data() + i, events.data() + i + events_buffer, output.data()) - output.data();
+        }
+        const auto t1 = std::chrono::steady_clock::now();
+        best_s        = std::min(best_s, std::chrono::duration<double>(t1 - t0).count());
+    }
+    std::cout << std::left << std::setw(36) << name << std::right << std::setw(10) << std::fixed
+              << std::setprecision(1) << events.size() / best_s * 1e-6 << " Mev/s  (" << n_out << " events kept)"
+              << std::endl;
+}
+
+std::string isa_name(SimdIsa isa) {
+    switch (isa) {
+    case SimdIsa::Scalar:
+        return "scalar";
+    case SimdIsa::Neon:
+        return "neon";
+    case SimdIsa::Avx2:
+        return "avx2";
+    case SimdIsa::Avx512:
+        return "avx512";
+    }
+    return "";
+}
+} // namespace
+
+int main() {
+    const auto events = make_events();
+
+    struct Roi {
+        std::string name;
+        std::int32_t x0, y0, x1, y1;
+    };
+    for (const Roi &roi : {Roi{"roi 10%", 400, 200, 799, 415}, Roi{"roi 50%", 320, 0, 959, 719},
+                           Roi{"roi 90%", 32, 18, 1247, 701}}) {
+        for (bool relative : {false, true}) {
+            const std::string name = roi.name + (relative ? " relative" : "");
+            benchmark(name + " / per-event predicate", events,
+                      [&](const EventCD *begin, const EventCD *end, EventCD *out) {
+                          const auto in_roi = [&](const EventCD &ev) {
+                              return ev.x >= roi.x0 && ev.x <= roi.x1 && ev.y >= roi.y0 && ev.y <= roi.y1;
+                          };
+                          if (!relative) {
+                              return detail::insert_if(begin, end, out, in_roi);
+                          }
+                          return detail::transform_if(begin, end, out, in_roi, [&](EventCD &ev) {
+                              ev.x -= roi.x0;
+                              ev.y -= roi.y0;
+                          });
+                      });
+            for (SimdIsa isa : {SimdIsa::Scalar, SimdIsa::Neon, SimdIsa::Avx2, SimdIsa::Avx512}) {
+                if (detail::is_simd_isa_supported(isa)) {
+                    benchmark(name + " / " + isa_name(isa), events,
+                              [&](const EventCD *begin, const EventCD *end, EventCD *out) {
+                                  return detail::roi_filter_events(begin, end, out, roi.x0, roi.y0, roi.x1, roi.y1,
+                                                                   relative, isa);
+                              });
+                }
+            }
+        }
+    }
+
+    benchmark("polarity / per-event predicate", events, [](const EventCD *begin, const EventCD *end, EventCD *out) {
+        return detail::insert_if(begin, end, out, [](const EventCD &ev) { return ev.p == 1; });
+    });
+    for (SimdIsa isa : {SimdIsa::Scalar, SimdIsa::Neon, SimdIsa::Avx2, SimdIsa::Avx512}) {
+        if (detail::is_simd_isa_supported(isa)) {
+            benchmark("polarity / " + isa_name(isa), events,
+                      [isa](const EventCD *begin, const EventCD *end, EventCD *out) {
+                          return detail::polarity_filter_events(begin, end, out, 1, isa);
+                      });
+        }
+    }
+
+    return 0;
+}
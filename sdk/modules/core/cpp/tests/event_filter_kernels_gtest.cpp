@@ -0,0 +1,175 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <array>
+#include <iterator>
+#include <list>
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/core/algorithms/detail/event_filter_kernels.h"
+#include "metavision/sdk/core/algorithms/polarity_filter_algorithm.h"
+#include "metavision/sdk/core/algorithms/roi_filter_algorithm.h"
+
+using namespace Metavision;
+using detail::SimdIsa;
+
+namespace {
+std::vector<EventCD> make_random_events(size_t n_events) {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> x_dist(0, 1279), y_dist(0, 719), p_dist(0, 1);
+    std::vector<EventCD> events;
+    for (size_t i = 0; i < n_events; ++i) {
+        events.emplace_back(x_dist(gen), y_dist(gen), p_dist(gen), static_cast<timestamp>(i) << 20);
+    }
+    // A few events with extreme coordinates
+    events.emplace_back(0, 0, 0, 1);
+    events.emplace_back(65535, 65535, -1, 2);
+    events.emplace_back(32768, 100, 1, 3);
+    return events;
+}
+
+std::vector<SimdIsa> supported_isas() {
+    std::vector<SimdIsa> isas;
+    for (SimdIsa isa : {SimdIsa::Scalar, SimdIsa::Neon, SimdIsa::Avx2, SimdIsa::Avx512}) {
+        if (detail::is_simd_isa_supported(isa)) {
+            isas.push_back(isa);
+        }
+    }
+    return isas;
+}
+
+bool are_equal(const EventCD &lhs, const EventCD &rhs) {
+    return lhs.x == rhs.x && lhs.y == rhs.y && lhs.p == rhs.p && lhs.t == rhs.t;
+}
+} // namespace
+
+TEST(EventFilterKernels_GTest, roi_filter_same_as_scalar_filter) {
+    const auto events = make_random_events(10001);
+    const std::vector<std::array<std::int32_t, 4>> rois{
+        {100, 50, 699, 449}, {0, 0, 1279, 719}, {-10, -20, 30, 40}, {1000, 0, 70000, 100000}, {30, 30, 10, 10},
+        {-100, 0, -1, 719},  {70000, 0, 80000, 719}, {5, 5, 5, 5}};
+
+    for (const auto &roi : rois) {
+        for (bool relative : {false, true}) {
+            // GIVEN the events expected with a straightforward implementation
+            std::vector<EventCD> expected;
+            for (auto ev : events) {
+                if (ev.x >= roi[0] && ev.x <= roi[2] && ev.y >= roi[1] && ev.y <= roi[3]) {
+                    if (relative) {
+                        ev.x -= roi[0];
+                        ev.y -= roi[1];
+                    }
+                    expected.push_back(ev);
+                }
+            }
+
+            for (SimdIsa isa : supported_isas()) {
+                // WHEN we filter the events with the kernel
+                std::vector<EventCD> output(events.size());
+                output.resize(detail::roi_filter_events(events.data(), events.data() + events.size(), output.data(),
+                                                        roi[0], roi[1], roi[2], roi[3], relative, isa) -
+                              output.data());
+
+                // THEN we get the same events
+                ASSERT_EQ(expected.size(), output.size()) << "ISA " << static_cast<int>(isa);
+                ASSERT_TRUE(std::equal(expected.cbegin(), expected.cend(), output.cbegin(), are_equal))
+                    << "ISA " << static_cast<int>(isa);
+            }
+        }
+    }
+}
+
+TEST(EventFilterKernels_GTest, polarity_filter_same_as_scalar_filter) {
+    const auto events = make_random_events(10001);
+    for (std::int16_t polarity : {0, 1, -1, 2}) {
+        std::vector<EventCD> expected;
+        std::copy_if(events.cbegin(), events.cend(), std::back_inserter(expected),
+                     [polarity](const EventCD &ev) { return ev.p == polarity; });
+
+        for (SimdIsa isa : supported_isas()) {
+            std::vector<EventCD> output(events.size());
+            output.resize(detail::polarity_filter_events(events.data(), events.data() + events.size(), output.data(),
+                                                         polarity, isa) -
+                          output.data());
+
+            ASSERT_EQ(expected.size(), output.size()) << "ISA " << static_cast<int>(isa);
+            ASSERT_TRUE(std::equal(expected.cbegin(), expected.cend(), output.cbegin(), are_equal))
+                << "ISA " << static_cast<int>(isa);
+        }
+    }
+}
+
+TEST(EventFilterKernels_GTest, in_place_and_exact_output) {
+    const auto events = make_random_events(1000);
+    std::vector<EventCD> expected;
+    std::copy_if(events.cbegin(), events.cend(), std::back_inserter(expected),
+                 [](const EventCD &ev) { return ev.p == 1; });
+
+    for (SimdIsa isa : supported_isas()) {
+        // GIVEN a buffer filtered in place
+        std::vector<EventCD> in_place = events;
+        EventCD *in_place_end = detail::polarity_filter_events(in_place.data(), in_place.data() + in_place.size(),
+                                                               in_place.data(), 1, isa);
+        in_place.resize(in_place_end - in_place.data());
+
+        // AND a buffer with the exact room for the accepted events, followed by a guard
+        std::vector<EventCD> exact(expected.size() + 1, EventCD(1, 2, 3, 4));
+        EventCD *out_end = detail::polarity_filter_events(events.data(), events.data() + events.size(), exact.data(),
+                                                          1, isa);
+
+        // THEN the accepted events are written, and nothing past them
+        ASSERT_TRUE(std::equal(expected.cbegin(), expected.cend(), in_place.cbegin(), in_place.cend(), are_equal));
+        ASSERT_EQ(exact.data() + expected.size(), out_end);
+        ASSERT_TRUE(std::equal(expected.cbegin(), expected.cend(), exact.cbegin(), are_equal));
+        ASSERT_TRUE(are_equal(EventCD(1, 2, 3, 4), exact.back()));
+    }
+}
+
+TEST(EventFilterKernels_GTest, algorithms_with_any_iterators) {
+    const auto events = make_random_events(1000);
+    RoiFilterAlgorithm roi(100, 100, 500, 400, true);
+    PolarityFilterAlgorithm polarity(0);
+
+    // GIVEN the events filtered from a list, which is not processed with the kernels
+    const std::list<EventCD> events_list(events.cbegin(), events.cend());
+    std::vector<EventCD> expected_roi, expected_polarity;
+    roi.process_events(events_list.cbegin(), events_list.cend(), std::back_inserter(expected_roi));
+    polarity.process_events(events_list.cbegin(), events_list.cend(), std::back_inserter(expected_polarity));
+
+    // WHEN we filter the events of a vector, written through a back inserter or an iterator
+    std::vector<EventCD> roi_inserted, polarity_inserted;
+    roi.process_events(events.cbegin(), events.cend(), std::back_inserter(roi_inserted));
+    polarity.process_events(events.cbegin(), events.cend(), std::back_inserter(polarity_inserted));
+    std::vector<EventCD> roi_written(events.size());
+    roi_written.erase(roi.process_events(events.cbegin(), events.cend(), roi_written.begin()), roi_written.end());
+
+    // THEN we get the same events
+    ASSERT_EQ(expected_roi.size(), roi_inserted.size());
+    ASSERT_TRUE(std::equal(expected_roi.cbegin(), expected_roi.cend(), roi_inserted.cbegin(), are_equal));
+    ASSERT_EQ(expected_roi.size(), roi_written.size());
+    ASSERT_TRUE(std::equal(expected_roi.cbegin(), expected_roi.cend(), roi_written.cbegin(), are_equal));
+    ASSERT_EQ(expected_polarity.size(), polarity_inserted.size());
+    ASSERT_TRUE(
+        std::equal(expected_polarity.cbegin(), expected_polarity.cend(), polarity_inserted.cbegin(), are_equal));
+}
+
+TEST(EventFilterKernels_GTest, unsupported_isa) {
+    for (SimdIsa isa : {SimdIsa::Neon, SimdIsa::Avx2, SimdIsa::Avx512}) {
+        if (!detail::is_simd_isa_supported(isa)) {
+            EventCD ev;
+            EXPECT_THROW(detail::polarity_filter_events(&ev, &ev + 1, &ev, 0, isa), std::invalid_argument);
+        }
+    }
+    EXPECT_TRUE(detail::is_simd_isa_supported(detail::best_simd_isa()));
+}
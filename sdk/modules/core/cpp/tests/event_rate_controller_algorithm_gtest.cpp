@@ -0,0 +1,138 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <iterator>
+#include <list>
+#include <map>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/core/algorithms/event_rate_controller_algorithm.h"
+
+using namespace Metavision;
+
+namespace {
+// Events at a constant rate, scanning the pixels of a width x height sensor in raster order
+std::vector<EventCD> make_events(std::uint32_t events_per_sec, timestamp duration, int width = 320, int height = 240) {
+    std::vector<EventCD> events;
+    const std::uint64_t n_events = static_cast<std::uint64_t>(events_per_sec) * duration / 1000000;
+    for (std::uint64_t i = 0; i < n_events; ++i) {
+        const std::uint64_t pixel = i % (width * height);
+        events.emplace_back(pixel % width, pixel / width, i % 2, static_cast<timestamp>(i * 1000000 / events_per_sec));
+    }
+    return events;
+}
+
+bool are_equal(const EventCD &lhs, const EventCD &rhs) {
+    return lhs.x == rhs.x && lhs.y == rhs.y && lhs.p == rhs.p && lhs.t == rhs.t;
+}
+} // namespace
+
+TEST(EventRateControllerAlgorithm_GTest, rate_below_target) {
+    // GIVEN events at a rate below the target
+    const auto events = make_events(10000000, 100000);
+    EventRateControllerAlgorithm algo(20000000, 200);
+
+    // WHEN we process them
+    std::vector<EventCD> output;
+    algo.process_events(events.cbegin(), events.cend(), std::back_inserter(output));
+
+    // THEN all of them are propagated
+    ASSERT_EQ(events.size(), output.size());
+    ASSERT_TRUE(std::equal(events.cbegin(), events.cend(), output.cbegin(), are_equal));
+}
+
+TEST(EventRateControllerAlgorithm_GTest, rate_above_target) {
+    // GIVEN events at 10 times the target rate
+    const auto events = make_events(50000000, 100000);
+    EventRateControllerAlgorithm algo(5000000, 200);
+    ASSERT_EQ(1000, algo.get_cd_event_count());
+    ASSERT_EQ(5000000, algo.get_cd_event_rate());
+    ASSERT_EQ(200, algo.get_count_period());
+
+    // WHEN we process them
+    std::vector<EventCD> output;
+    algo.process_events(events.cbegin(), events.cend(), std::back_inserter(output));
+
+    // THEN the event count is at most the target one in each count period, and close to it on average
+    std::map<timestamp, int> counts;
+    for (const auto &ev : output) {
+        ++counts[ev.t / 200];
+    }
+    for (const auto &count : counts) {
+        ASSERT_LE(count.second, 1000);
+    }
+    ASSERT_NEAR(500000, output.size(), 500000 * 0.02);
+
+    // AND the events are dropped uniformly: in each quarter of the sensor and for both parities of x
+    std::map<int, int> in_counts, out_counts;
+    for (const auto &ev : events) {
+        ++in_counts[(ev.x >= 160) + 2 * (ev.y >= 120) + 4 * (ev.x % 2)];
+    }
+    for (const auto &ev : output) {
+        ++out_counts[(ev.x >= 160) + 2 * (ev.y >= 120) + 4 * (ev.x % 2)];
+    }
+    for (const auto &count : in_counts) {
+        ASSERT_NEAR(0.1, out_counts[count.first] / static_cast<double>(count.second), 0.01);
+    }
+}
+
+TEST(EventRateControllerAlgorithm_GTest, independent_of_buffers) {
+    // GIVEN events at a varying rate
+    auto events        = make_events(30000000, 20000);
+    const auto burst   = make_events(80000000, 20000);
+    const auto t_burst = events.back().t + 1;
+    for (auto ev : burst) {
+        ev.t += t_burst;
+        events.push_back(ev);
+    }
+
+    // WHEN we process them at once, and by buffers of various sizes from a list
+    EventRateControllerAlgorithm algo(10000000, 100), algo_by_buffers(10000000, 100);
+    std::vector<EventCD> output, output_by_buffers;
+    algo.process_events(events.cbegin(), events.cend(), std::back_inserter(output));
+    const std::list<EventCD> events_list(events.cbegin(), events.cend());
+    auto it = events_list.cbegin();
+    for (std::size_t buffer_size = 1; it != events_list.cend(); buffer_size = (buffer_size * 7) % 1000) {
+        auto it_next = it;
+        for (std::size_t i = 0; i < buffer_size && it_next != events_list.cend(); ++i) {
+            ++it_next;
+        }
+        algo_by_buffers.process_events(it, it_next, std::back_inserter(output_by_buffers));
+        it = it_next;
+    }
+
+    // THEN we get the same events
+    ASSERT_LT(output.size(), events.size());
+    ASSERT_EQ(output.size(), output_by_buffers.size());
+    ASSERT_TRUE(std::equal(output.cbegin(), output.cend(), output_by_buffers.cbegin(), are_equal));
+}
+
+TEST(EventRateControllerAlgorithm_GTest, disabled) {
+    const auto events = make_events(50000000, 10000);
+    EventRateControllerAlgorithm algo(1000000);
+    algo.enable(false);
+    ASSERT_FALSE(algo.is_enabled());
+
+    std::vector<EventCD> output;
+    algo.process_events(events.cbegin(), events.cend(), std::back_inserter(output));
+    ASSERT_EQ(events.size(), output.size());
+
+    algo.enable(true);
+    output.clear();
+    algo.process_events(events.cbegin(), events.cend(), std::back_inserter(output));
+    ASSERT_LT(output.size(), events.size());
+}
+
+TEST(EventRateControllerAlgorithm_GTest, invalid_count_period) {
+    ASSERT_THROW(EventRateControllerAlgorithm(1000, 0), std::invalid_argument);
+}
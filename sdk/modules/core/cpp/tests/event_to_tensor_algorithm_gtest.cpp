@@ -0,0 +1,176 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/core/algorithms/event_to_tensor_algorithm.h"
+
+using namespace Metavision;
+
+namespace {
+const int width = 20, height = 15;
+
+std::vector<EventCD> make_random_events(timestamp start_ts, timestamp end_ts, size_t n_events) {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> x_dist(0, width - 1), y_dist(0, height - 1), p_dist(0, 1);
+    std::uniform_int_distribution<timestamp> t_dist(start_ts, end_ts - 1);
+    std::vector<EventCD> events;
+    for (size_t i = 0; i < n_events; ++i) {
+        events.emplace_back(x_dist(gen), y_dist(gen), p_dist(gen), t_dist(gen));
+    }
+    std::sort(events.begin(), events.end(), [](const EventCD &lhs, const EventCD &rhs) { return lhs.t < rhs.t; });
+    return events;
+}
+
+// Straightforward implementation of event_volume in bilinear mode, from metavision_core_ml
+std::vector<float> make_voxel_grid(const std::vector<EventCD> &events, timestamp start_ts, timestamp duration,
+                                   int n_bins) {
+    std::vector<float> values(n_bins * height * width, 0.f);
+    for (const auto &ev : events) {
+        if (ev.t < start_ts || ev.t >= start_ts + duration) {
+            continue;
+        }
+        const float t_star = static_cast<float>(ev.t - start_ts) * n_bins / static_cast<float>(duration) - 0.5f;
+        const int lbin     = std::min(std::max(static_cast<int>(std::floor(t_star)), 0), n_bins - 1);
+        const int rbin     = std::min(lbin + 1, n_bins - 1);
+        const float lvalue = std::max(1.f - std::abs(lbin - t_star), 0.f);
+        const float p      = ev.p ? 1.f : -1.f;
+        values[(lbin * height + ev.y) * width + ev.x] += p * lvalue;
+        values[(rbin * height + ev.y) * width + ev.x] += p * (1.f - lvalue);
+    }
+    return values;
+}
+} // namespace
+
+TEST(EventToTensorAlgorithm_GTest, histogram_and_difference) {
+    // GIVEN events in and out of a time slice
+    const std::vector<EventCD> events{{1, 2, 1, 90},  {1, 2, 1, 100}, {1, 2, 1, 110}, {1, 2, 0, 120},
+                                      {3, 4, 0, 130}, {3, 4, 0, 140}, {3, 4, 0, 150}, {1, 2, 1, 200}};
+
+    // WHEN we build the histogram and the difference image of [100, 200[
+    HistogramTensorAlgorithm histogram(width, height), clipped_histogram(width, height, 2.f);
+    DifferenceTensorAlgorithm difference(width, height), clipped_difference(width, height, 2.f);
+    ASSERT_EQ(2, histogram.get_num_channels());
+    ASSERT_EQ(1, difference.get_num_channels());
+    std::vector<float> histo(histogram.get_tensor_size(), -1.f), clipped_histo(histo), diff(width * height, -1.f),
+        clipped_diff(diff);
+    histogram.generate(events.cbegin(), events.cend(), 100, 100, histo.data());
+    clipped_histogram.generate(events.cbegin(), events.cend(), 100, 100, clipped_histo.data());
+    difference.generate(events.cbegin(), events.cend(), 100, 100, diff.data());
+    clipped_difference.generate(events.cbegin(), events.cend(), 100, 100, clipped_diff.data());
+
+    // THEN the OFF and ON events are counted in the expected channels, and the other values are reset
+    const int off = 0, on = width * height, px1 = 2 * width + 1, px2 = 4 * width + 3;
+    EXPECT_EQ(1.f, histo[off + px1]);
+    EXPECT_EQ(2.f, histo[on + px1]);
+    EXPECT_EQ(3.f, histo[off + px2]);
+    EXPECT_EQ(0.f, histo[on + px2]);
+    EXPECT_EQ(6.f, std::accumulate(histo.cbegin(), histo.cend(), 0.f));
+    EXPECT_EQ(0.5f, clipped_histo[off + px1]);
+    EXPECT_EQ(1.f, clipped_histo[on + px1]);
+    EXPECT_EQ(1.f, clipped_histo[off + px2]);
+    EXPECT_EQ(1.f, diff[px1]);
+    EXPECT_EQ(-3.f, diff[px2]);
+    EXPECT_EQ(-2.f, std::accumulate(diff.cbegin(), diff.cend(), 0.f));
+    EXPECT_EQ(0.5f, clipped_diff[px1]);
+    EXPECT_EQ(-1.f, clipped_diff[px2]);
+}
+
+TEST(EventToTensorAlgorithm_GTest, timestamps) {
+    const std::vector<EventCD> events{{1, 2, 1, 99}, {1, 2, 1, 100}, {1, 2, 1, 149}, {1, 2, 0, 199}, {3, 4, 0, 200}};
+    TimestampTensorAlgorithm algo(width, height);
+    std::vector<float> tensor(algo.get_tensor_size(), -1.f);
+    algo.generate(events.cbegin(), events.cend(), 100, 100, tensor.data());
+
+    const int off = 0, on = width * height, px1 = 2 * width + 1, px2 = 4 * width + 3;
+    EXPECT_FLOAT_EQ(1.f, tensor[off + px1]);
+    EXPECT_FLOAT_EQ(0.5f, tensor[on + px1]);
+    EXPECT_EQ(0.f, tensor[off + px2]);
+    EXPECT_EQ(0.f, tensor[on + px2]);
+}
+
+TEST(EventToTensorAlgorithm_GTest, voxel_grid_same_as_reference_implementation) {
+    const auto events = make_random_events(0, 10000, 20000);
+    for (int n_bins : {1, 2, 5, 7}) {
+        for (timestamp duration : {999, 1000, 3333}) {
+            // GIVEN the voxel grid expected with a straightforward implementation
+            const timestamp start_ts = 1234;
+            const auto expected      = make_voxel_grid(events, start_ts, duration, n_bins);
+
+            // WHEN we build it with several threads
+            VoxelGridTensorAlgorithm algo(width, height, n_bins);
+            algo.set_max_threads(3);
+            ASSERT_EQ(n_bins, algo.get_num_channels());
+            std::vector<float> tensor(algo.get_tensor_size(), -1.f);
+            algo.generate(events.cbegin(), events.cend(), start_ts, duration, tensor.data());
+
+            // THEN we get the same values
+            ASSERT_EQ(expected.size(), tensor.size());
+            for (size_t i = 0; i < expected.size(); ++i) {
+                ASSERT_NEAR(expected[i], tensor[i], 1e-4) << n_bins << " " << duration << " " << i;
+            }
+        }
+    }
+}
+
+TEST(EventToTensorAlgorithm_GTest, slices_and_threads) {
+    // GIVEN events over several slices
+    const auto events = make_random_events(0, 10000, 50000);
+    const timestamp slice_duration = 1000;
+    const int n_slices             = 9;
+
+    // WHEN we build the tensors of all the slices at once, with different numbers of threads
+    VoxelGridTensorAlgorithm algo(width, height, 3);
+    std::vector<float> tensors(n_slices * algo.get_tensor_size());
+    for (int max_threads : {1, 2, 4, 0}) {
+        algo.set_max_threads(max_threads);
+        ASSERT_EQ(max_threads, algo.get_max_threads());
+        algo.generate(events.cbegin(), events.cend(), 500, slice_duration, n_slices, tensors.data());
+
+        // THEN each tensor is the one of its slice
+        for (int s = 0; s < n_slices; ++s) {
+            std::vector<float> tensor(algo.get_tensor_size());
+            algo.generate(events.cbegin(), events.cend(), 500 + s * slice_duration, slice_duration, tensor.data());
+            ASSERT_TRUE(std::equal(tensor.cbegin(), tensor.cend(), tensors.cbegin() + s * tensor.size()));
+        }
+    }
+}
+
+TEST(EventToTensorAlgorithm_GTest, float16) {
+    const auto events = make_random_events(0, 10000, 20000);
+    HistogramTensorAlgorithm algo(width, height);
+    std::vector<float> tensors(2 * algo.get_tensor_size());
+    std::vector<cv::float16_t> tensors_f16(tensors.size(), cv::float16_t(-1.f));
+    algo.generate(events.cbegin(), events.cend(), 0, 5000, 2, tensors.data());
+    algo.generate(events.cbegin(), events.cend(), 0, 5000, 2, tensors_f16.data());
+
+    // Small counts are exact in float16
+    for (size_t i = 0; i < tensors.size(); ++i) {
+        ASSERT_EQ(tensors[i], static_cast<float>(tensors_f16[i]));
+    }
+}
+
+TEST(EventToTensorAlgorithm_GTest, invalid_parameters) {
+    const std::vector<EventCD> events;
+    std::vector<float> tensor(2 * width * height);
+    HistogramTensorAlgorithm algo(width, height);
+    ASSERT_THROW(algo.generate(events.cbegin(), events.cend(), 0, 0, tensor.data()), std::invalid_argument);
+    ASSERT_THROW(algo.generate(events.cbegin(), events.cend(), 0, 10, 0, tensor.data()), std::invalid_argument);
+    ASSERT_THROW(HistogramTensorAlgorithm(0, height), std::invalid_argument);
+    ASSERT_THROW(HistogramTensorAlgorithm(width, height, -1.f), std::invalid_argument);
+    ASSERT_THROW(VoxelGridTensorAlgorithm(width, height, 0), std::invalid_argument);
+}
@@ -0,0 +1,134 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/core/algorithms/events_slicer_algorithm.h"
+#include "metavision/sdk/core/algorithms/shared_events_buffer_producer_algorithm.h"
+
+using namespace Metavision;
+
+namespace {
+struct SliceCopy {
+    timestamp ts;
+    std::vector<EventCD> events;
+};
+
+bool are_equal(const EventCD &lhs, const EventCD &rhs) {
+    return lhs.x == rhs.x && lhs.y == rhs.y && lhs.p == rhs.p && lhs.t == rhs.t;
+}
+
+std::vector<EventCD> make_events(size_t n_events) {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> dt_dist(0, 30);
+    std::vector<EventCD> events;
+    timestamp t = 0;
+    for (size_t i = 0; i < n_events; ++i) {
+        t += dt_dist(gen);
+        events.emplace_back(i % 100, i % 50, i % 2, t);
+    }
+    return events;
+}
+
+// Processes the events in buffers of random sizes, each one being released after its processing
+template<typename Algo>
+void process_in_random_buffers(Algo &algo, const std::vector<EventCD> &events) {
+    std::mt19937 gen(7);
+    std::uniform_int_distribution<size_t> size_dist(0, 300);
+    for (size_t i = 0; i < events.size();) {
+        const size_t n = std::min(size_dist(gen), events.size() - i);
+        std::vector<EventCD> buffer(events.cbegin() + i, events.cbegin() + i + n);
+        algo.process_events(buffer.data(), buffer.data() + buffer.size());
+        i += n;
+    }
+}
+} // namespace
+
+TEST(EventsSlicerAlgorithm_GTest, same_slices_as_shared_events_buffer_producer) {
+    const auto events = make_events(20000);
+    for (int policy = 0; policy < 3; ++policy) {
+        // GIVEN the buffers produced by SharedEventsBufferProducerAlgorithm
+        SharedEventsBufferProducerParameters params;
+        params.buffers_events_count_  = policy == 1 ? 0 : 250;
+        params.buffers_time_slice_us_ = policy == 0 ? 0 : 1000;
+        params.bounded_memory_pool_   = false;
+        std::vector<SliceCopy> expected;
+        SharedEventsBufferProducerAlgorithm<EventCD> producer(
+            params, [&](timestamp ts, const SharedEventsBufferProducerAlgorithm<EventCD>::SharedEventsBuffer &buffer) {
+                expected.push_back({ts, *buffer});
+            });
+        process_in_random_buffers(producer, events);
+        producer.flush();
+
+        // WHEN we slice the same events with the same policy
+        std::vector<SliceCopy> slices;
+        EventsSlicerAlgorithm<EventCD> slicer([&](const EventsSlicerAlgorithm<EventCD>::Slice &slice) {
+            slices.push_back({slice.ts_, std::vector<EventCD>(slice.begin(), slice.end())});
+        });
+        if (policy == 0) {
+            slicer.set_processing_n_events(250);
+        } else if (policy == 1) {
+            slicer.set_processing_n_us(1000);
+        } else {
+            slicer.set_processing_mixed(250, 1000);
+        }
+        process_in_random_buffers(slicer, events);
+        slicer.flush();
+
+        // THEN we get the same slices
+        ASSERT_EQ(expected.size(), slices.size()) << policy;
+        for (size_t i = 0; i < expected.size(); ++i) {
+            ASSERT_EQ(expected[i].ts, slices[i].ts);
+            ASSERT_EQ(expected[i].events.size(), slices[i].events.size());
+            ASSERT_TRUE(std::equal(expected[i].events.cbegin(), expected[i].events.cend(), slices[i].events.cbegin(),
+                                   are_equal));
+        }
+    }
+}
+
+TEST(EventsSlicerAlgorithm_GTest, slices_refer_to_input_buffer) {
+    // GIVEN a slicer producing slices of 10 events
+    std::vector<EventsSlicerAlgorithm<EventCD>::Slice> slices;
+    std::vector<SliceCopy> copies;
+    EventsSlicerAlgorithm<EventCD> slicer([&](const EventsSlicerAlgorithm<EventCD>::Slice &slice) {
+        slices.push_back(slice);
+        copies.push_back({slice.ts_, std::vector<EventCD>(slice.begin(), slice.end())});
+    });
+    slicer.set_processing_n_events(10);
+    const auto events = make_events(45);
+
+    // WHEN we process a first buffer of 25 events
+    slicer.process_events(events.data(), events.data() + 25);
+
+    // THEN the two complete slices point to the input buffer, and the 5 remaining events are carried
+    ASSERT_EQ(2, slices.size());
+    EXPECT_EQ(events.data(), slices[0].begin());
+    EXPECT_EQ(events.data() + 10, slices[0].end());
+    EXPECT_EQ(events.data() + 10, slices[1].begin());
+    EXPECT_EQ(events.data() + 20, slices[1].end());
+    EXPECT_EQ(5, slicer.carried_events_count());
+
+    // WHEN we process the next 20 events
+    slices.clear();
+    copies.clear();
+    slicer.process_events(events.data() + 25, events.data() + 45);
+
+    // THEN the first slice is stitched from the carried events, and the next one points to the input buffer
+    ASSERT_EQ(2, slices.size());
+    ASSERT_EQ(10, copies[0].events.size());
+    EXPECT_TRUE(std::equal(events.cbegin() + 20, events.cbegin() + 30, copies[0].events.cbegin(), are_equal));
+    EXPECT_EQ(events.data() + 30, slices[1].begin());
+    EXPECT_EQ(events.data() + 40, slices[1].end());
+    EXPECT_EQ(5, slicer.carried_events_count());
+}
@@ -0,0 +1,126 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <iterator>
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/core/algorithms/filter_chain_algorithm.h"
+#include "metavision/sdk/core/algorithms/flip_x_algorithm.h"
+#include "metavision/sdk/core/algorithms/flip_y_algorithm.h"
+#include "metavision/sdk/core/algorithms/polarity_filter_algorithm.h"
+#include "metavision/sdk/core/algorithms/polarity_inverter_algorithm.h"
+#include "metavision/sdk/core/algorithms/roi_filter_algorithm.h"
+
+using namespace Metavision;
+
+namespace {
+std::vector<EventCD> make_random_events(size_t n_events) {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> x_dist(0, 639), y_dist(0, 479), p_dist(0, 1);
+    std::vector<EventCD> events;
+    for (size_t i = 0; i < n_events; ++i) {
+        events.emplace_back(x_dist(gen), y_dist(gen), p_dist(gen), static_cast<timestamp>(i));
+    }
+    return events;
+}
+
+bool are_equal(const EventCD &lhs, const EventCD &rhs) {
+    return lhs.x == rhs.x && lhs.y == rhs.y && lhs.p == rhs.p && lhs.t == rhs.t;
+}
+} // namespace
+
+TEST(FilterChainAlgorithm_GTest, same_output_as_sequence_of_algorithms) {
+    const auto events = make_random_events(10000);
+    for (bool relative_coordinates : {false, true}) {
+        // GIVEN a sequence of algorithms, each one working on the output of the previous one
+        RoiFilterAlgorithm roi(100, 50, 399, 349, relative_coordinates);
+        PolarityFilterAlgorithm polarity(1);
+        FlipXAlgorithm flip_x(299);
+        FlipYAlgorithm flip_y(299);
+        PolarityInverterAlgorithm inverter;
+
+        std::vector<EventCD> expected, tmp;
+        roi.process_events(events.cbegin(), events.cend(), std::back_inserter(expected));
+        polarity.process_events(expected.cbegin(), expected.cend(), std::back_inserter(tmp));
+        expected.clear();
+        flip_x.process_events(tmp.cbegin(), tmp.cend(), std::back_inserter(expected));
+        tmp.clear();
+        flip_y.process_events(expected.cbegin(), expected.cend(), std::back_inserter(tmp));
+        expected.clear();
+        inverter.process_events(tmp.cbegin(), tmp.cend(), std::back_inserter(expected));
+
+        // WHEN we apply the same algorithms as a single chain
+        const auto chain = make_filter_chain(roi, polarity, flip_x, flip_y, inverter);
+        std::vector<EventCD> output;
+        chain.process_events(events.cbegin(), events.cend(), std::back_inserter(output));
+
+        // THEN the output is the same
+        ASSERT_FALSE(expected.empty());
+        ASSERT_EQ(expected.size(), output.size());
+        ASSERT_TRUE(std::equal(expected.cbegin(), expected.cend(), output.cbegin(), are_equal));
+    }
+}
+
+TEST(FilterChainAlgorithm_GTest, filters_applied_in_order) {
+    // GIVEN an event flipped out of the ROI, or into it
+    const std::vector<EventCD> events{{5, 0, 0, 0}, {95, 0, 0, 1}};
+    const auto roi_then_flip = make_filter_chain(RoiFilterAlgorithm(0, 0, 9, 9), FlipXAlgorithm(99));
+    const auto flip_then_roi = make_filter_chain(FlipXAlgorithm(99), RoiFilterAlgorithm(0, 0, 9, 9));
+
+    // WHEN we apply the chains
+    std::vector<EventCD> roi_then_flip_output, flip_then_roi_output;
+    roi_then_flip.process_events(events.cbegin(), events.cend(), std::back_inserter(roi_then_flip_output));
+    flip_then_roi.process_events(events.cbegin(), events.cend(), std::back_inserter(flip_then_roi_output));
+
+    // THEN each filter sees the event modified by the previous ones
+    ASSERT_EQ(1u, roi_then_flip_output.size());
+    EXPECT_EQ(94, roi_then_flip_output[0].x);
+    EXPECT_EQ(0, roi_then_flip_output[0].t);
+    ASSERT_EQ(1u, flip_then_roi_output.size());
+    EXPECT_EQ(4, flip_then_roi_output[0].x);
+    EXPECT_EQ(1, flip_then_roi_output[0].t);
+}
+
+TEST(FilterChainAlgorithm_GTest, in_place) {
+    // GIVEN events and a chain with a custom predicate
+    const auto events = make_random_events(10000);
+    const auto chain  = make_filter_chain(PolarityFilterAlgorithm(0), [](const EventCD &ev) { return ev.x % 2 == 0; },
+                                         FlipYAlgorithm(479));
+    std::vector<EventCD> expected;
+    chain.process_events(events.cbegin(), events.cend(), std::back_inserter(expected));
+
+    // WHEN we apply the chain in place
+    std::vector<EventCD> output = events;
+    output.erase(chain.process_events_in_place(output.begin(), output.end()), output.end());
+
+    // THEN the output is the same as when applying the chain to another buffer
+    ASSERT_FALSE(expected.empty());
+    ASSERT_EQ(expected.size(), output.size());
+    ASSERT_TRUE(std::equal(expected.cbegin(), expected.cend(), output.cbegin(), are_equal));
+}
+
+TEST(FilterChainAlgorithm_GTest, update_filters) {
+    // GIVEN a chain keeping positive events
+    auto chain = make_filter_chain(PolarityFilterAlgorithm(1), FlipXAlgorithm(9));
+    EventCD ev(2, 0, 0, 0);
+    ASSERT_FALSE(chain(ev));
+
+    // WHEN we update its filters
+    chain.get<0>().set_polarity(0);
+    chain.get<1>().set_width_minus_one(19);
+
+    // THEN the new parameters are used
+    ASSERT_TRUE(chain(ev));
+    EXPECT_EQ(17, ev.x);
+}
@@ -0,0 +1,91 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <atomic>
+#include <thread>
+#include <boost/any.hpp>
+#include <gtest/gtest.h>
+
+#include "metavision/sdk/core/pipeline/pipeline.h"
+#include "metavision/sdk/core/pipeline/filter_chain_stage.h"
+#include "metavision/sdk/core/algorithms/flip_x_algorithm.h"
+#include "metavision/sdk/core/algorithms/polarity_filter_algorithm.h"
+
+using namespace Metavision;
+
+namespace {
+using EventBufferPool = SharedObjectPool<std::vector<EventCD>>;
+using EventBufferPtr  = EventBufferPool::ptr_type;
+
+struct MockProducingStage : public BaseStage {
+    MockProducingStage(const std::vector<std::vector<EventCD>> &evts) :
+        events(evts), pool(EventBufferPool::make_bounded()) {
+        set_starting_callback([this] {
+            thread = std::thread([this] {
+                for (const auto &evts : events) {
+                    if (stopped)
+                        break;
+                    auto buffer = pool.acquire();
+                    *buffer     = evts;
+                    produce(buffer);
+                }
+                if (!stopped)
+                    complete();
+            });
+        });
+        set_stopping_callback([this] {
+            stopped = true;
+            if (thread.joinable()) {
+                thread.join();
+            }
+        });
+    }
+
+    std::thread thread;
+    std::atomic<bool> stopped{false};
+    std::vector<std::vector<EventCD>> events;
+    EventBufferPool pool;
+};
+
+struct MockConsumingStage : public BaseStage {
+    MockConsumingStage(std::vector<std::vector<EventCD>> &bs) : buffers(bs) {
+        set_consuming_callback([this](const boost::any &data) {
+            try {
+                buffers.emplace_back(*boost::any_cast<EventBufferPtr>(data));
+            } catch (boost::bad_any_cast &) {}
+        });
+    }
+    std::vector<std::vector<EventCD>> &buffers;
+};
+} // namespace
+
+TEST(FilterChainStageTest, filter_buffers) {
+    // GIVEN buffers of events
+    std::vector<std::vector<EventCD>> events{{{1, 0, 1, 0}, {2, 0, 0, 1}, {3, 0, 1, 2}}, {{4, 0, 0, 3}}};
+
+    // WHEN we run them through a stage keeping positive events and flipping them
+    std::vector<std::vector<EventCD>> buffers;
+    Pipeline p;
+    auto &s1 = p.add_stage(std::make_unique<MockProducingStage>(events));
+    auto &s2 = p.add_stage(
+        make_filter_chain_stage(make_filter_chain(PolarityFilterAlgorithm(1), FlipXAlgorithm(9))), s1);
+    p.add_stage(std::make_unique<MockConsumingStage>(buffers), s2);
+    p.run();
+
+    // THEN each buffer is filtered in a single stage
+    ASSERT_EQ(2u, buffers.size());
+    ASSERT_EQ(2u, buffers[0].size());
+    EXPECT_EQ(8, buffers[0][0].x);
+    EXPECT_EQ(0, buffers[0][0].t);
+    EXPECT_EQ(6, buffers[0][1].x);
+    EXPECT_EQ(2, buffers[0][1].t);
+    EXPECT_TRUE(buffers[1].empty());
+}
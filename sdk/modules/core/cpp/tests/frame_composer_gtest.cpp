@@ -400,3 +400,93 @@ TEST_F(FrameComposer_GTest, gray_to_color) {
     }
     ASSERT_TRUE(is_equal);
 }
+
+TEST_F(FrameComposer_GTest, resize_grey_images) {
+    // GIVEN a random gray image
+    const int width = 60, height = 40;
+    cv::Mat input_frame(height, width, CV_8UC1);
+    cv::randu(input_frame, cv::Scalar(0), cv::Scalar(256));
+
+    // WHEN we add it to the FrameComposer, resized with each interpolation and with or without a colormap
+    FrameComposer composer(cv::Vec3b(0, 0, 0));
+    const int resized_width = 25, resized_height = 15;
+    const std::vector<FrameComposer::InterpolationType> interp_types = {FrameComposer::InterpolationType::Nearest,
+                                                                        FrameComposer::InterpolationType::Linear,
+                                                                        FrameComposer::InterpolationType::Area};
+    int k = 0;
+    for (int map_id : {-1, 2}) {
+        for (auto interp_type : interp_types) {
+            FrameComposer::ResizingOptions resize_options(resized_width, resized_height, false, interp_type);
+            FrameComposer::GrayToColorOptions gray_o;
+            gray_o.color_map_id   = map_id;
+            const unsigned int id = composer.add_new_subimage_parameters(resized_width * (k++), 0, resize_options,
+                                                                         gray_o);
+            ASSERT_TRUE(composer.update_subimage(id, input_frame));
+        }
+    }
+
+    // THEN we get the expected composed image, which is the horizontal concatenation of the resized images
+    std::vector<cv::Mat> frames;
+    for (int map_id : {-1, 2}) {
+        for (auto interp_type : interp_types) {
+            cv::Mat resized;
+            cv::resize(input_frame, resized, cv::Size(resized_width, resized_height), 0., 0., interp_type);
+            frames.emplace_back();
+            if (map_id >= 0) {
+                cv::applyColorMap(resized, frames.back(), map_id);
+            } else {
+                cv::cvtColor(resized, frames.back(), cv::COLOR_GRAY2BGR);
+            }
+        }
+    }
+    cv::Mat ref_frame;
+    cv::hconcat(frames, ref_frame);
+
+    const cv::Mat &test_frame = composer.get_full_image();
+    ASSERT_EQ(ref_frame.size(), test_frame.size());
+    ASSERT_EQ(ref_frame.type(), test_frame.type());
+    ASSERT_EQ(0, cv::norm(ref_frame, test_frame, cv::NORM_INF));
+}
+
+TEST_F(FrameComposer_GTest, update_subimages) {
+    // GIVEN random color and gray images of various sizes
+    const int width = 32, height = 24;
+    std::vector<cv::Mat> frames;
+    for (int i = 0; i < 4; ++i) {
+        frames.emplace_back(height + 8 * i, width + 8 * i, i % 2 == 0 ? CV_8UC3 : CV_8UC1);
+        cv::randu(frames.back(), cv::Scalar::all(0), cv::Scalar::all(256));
+    }
+
+    // WHEN we compose them on a 2x2 grid, either one after the other, all at once or after converting them
+    std::vector<FrameComposer> composers(3, FrameComposer(cv::Vec3b(0, 0, 0)));
+    std::vector<std::pair<unsigned int, cv::Mat>> updates;
+    for (int i = 0; i < 4; ++i) {
+        FrameComposer::ResizingOptions resize_options(width, height, i == 1, FrameComposer::InterpolationType::Nearest);
+        FrameComposer::GrayToColorOptions gray_o;
+        gray_o.min_rescaling_value = 20;
+        gray_o.max_rescaling_value = 200;
+        gray_o.color_map_id        = i == 3 ? 2 : -1;
+        for (auto &composer : composers) {
+            const unsigned int id = composer.add_new_subimage_parameters(width * (i % 2), height * (i / 2),
+                                                                         resize_options, gray_o);
+            ASSERT_EQ(static_cast<unsigned int>(i), id);
+        }
+        updates.emplace_back(i, frames[i]);
+    }
+
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(composers[0].update_subimage(i, frames[i]));
+    }
+    ASSERT_TRUE(composers[1].update_subimages(updates));
+    for (int i = 0; i < 4; ++i) {
+        cv::Mat subimage;
+        ASSERT_TRUE(composers[2].convert_subimage(i, frames[i], subimage));
+        ASSERT_EQ(cv::Size(width, height), subimage.size());
+        ASSERT_TRUE(composers[2].update_subimage(i, subimage));
+    }
+
+    // THEN the composed images are the same
+    for (int i = 1; i < 3; ++i) {
+        ASSERT_EQ(0, cv::norm(composers[0].get_full_image(), composers[i].get_full_image(), cv::NORM_INF));
+    }
+}
@@ -13,7 +13,9 @@
 #include <future>
 #include <chrono>
 #include <iterator>
+#include <mutex>
 #include <stdexcept>
+#include <thread>
 
 #include "metavision/sdk/core/algorithms/generic_producer_algorithm.h"
 #include "metavision/sdk/base/events/event2d.h"
@@ -31,13 +33,18 @@ protected:
         return producer_algo_.ring_event_;
     }
 
-    void assert_ring_size(size_t max_size) {
-        std::unique_lock<std::mutex> lock(producer_algo_.underfilled_wait_mut_);
-        std::unique_lock<std::mutex> lock2(producer_algo_.overfilled_wait_mut_);
-        if (producer_algo_.ring_event_.data_available()) {
-            ASSERT_GE(size_t(5), producer_algo_.ring_event_.get_last_time() - get_ring().get_first_time());
+    // Must be called from the producer thread, so that the last event does not change meanwhile, or from the consumer
+    // thread, so that the first event does not change meanwhile
+    void assert_ring_size(timestamp max_duration) {
+        const timestamp first_time = get_ring().get_first_time(), last_time = get_ring().get_last_time();
+        if (first_time >= 0 && last_time >= 0) {
+            ASSERT_GE(max_duration, last_time - first_time);
         }
     }
+
+    std::mutex &get_consumer_mutex() {
+        return producer_algo_.consumer_mut_;
+    }
     GenericProducerAlgorithm<Event2d> producer_algo_;
 };
 
@@ -200,6 +207,68 @@ TEST_F(GenericProducerAlgorithm_GTest, test_max_duration_drop_range_too_big) {
     ASSERT_EQ(timestamp(9), get_ring().get_last_time());
 }
 
+TEST_F(GenericProducerAlgorithm_GTest, test_max_duration_drop_queued_events) {
+    this->producer_algo_.set_max_duration_stored(5);
+    this->producer_algo_.set_allow_drop_when_overfilled(true);
+    std::vector<Event2d> events(11), events2;
+    int i = 0;
+    for (auto &event : events) {
+        event.t = i++;
+    }
+    this->producer_algo_.register_new_event_buffer(events.begin(), events.begin() + 5);
+
+    // the events from t = 0 to t = 4 are too old to be kept along with the new ones, up to t = 10
+    this->producer_algo_.register_new_event_buffer(events.begin() + 8, events.end());
+    this->producer_algo_.process_events(10, std::back_inserter(events2));
+    ASSERT_EQ(size_t(2), events2.size());
+    ASSERT_EQ(timestamp(8), events2.front().t);
+    ASSERT_EQ(timestamp(9), events2.back().t);
+    ASSERT_EQ(timestamp(10), get_ring().get_first_time());
+}
+
+TEST_F(GenericProducerAlgorithm_GTest, test_max_duration_drop_back_to_back_while_consumer_busy) {
+    this->producer_algo_.set_max_duration_stored(5);
+    this->producer_algo_.set_allow_drop_when_overfilled(true);
+    this->producer_algo_.set_timeout(-1);
+    std::vector<Event2d> events(12), events2;
+    int i = 0;
+    for (auto &event : events) {
+        event.t = i++;
+    }
+    this->producer_algo_.register_new_event_buffer(events.begin(), events.begin() + 5);
+
+    // while the consumer is processing events, the drops are only requested
+    {
+        std::unique_lock<std::mutex> lock(get_consumer_mutex());
+        this->producer_algo_.register_new_event_buffer(events.begin() + 8, events.begin() + 10);
+        this->producer_algo_.register_new_event_buffer(events.begin() + 10, events.begin() + 12);
+        ASSERT_EQ(timestamp(0), get_ring().get_first_time());
+    }
+
+    // the later request does not drop the events of the window of the last event
+    this->producer_algo_.process_events(12, std::back_inserter(events2));
+    ASSERT_EQ(size_t(4), events2.size());
+    ASSERT_EQ(timestamp(8), events2.front().t);
+    ASSERT_EQ(timestamp(11), events2.back().t);
+}
+
+TEST_F(GenericProducerAlgorithm_GTest, test_max_duration_drop_without_consumer) {
+    this->producer_algo_.set_max_duration_stored(5);
+    this->producer_algo_.set_allow_drop_when_overfilled(true);
+    std::vector<Event2d> events(1000);
+    int i = 0;
+    for (auto &event : events) {
+        event.t = i++;
+    }
+
+    // the events are dropped by the producer while no events are processed, so that the ring does not grow
+    for (int i = 0; i < 1000; i += 2) {
+        this->producer_algo_.register_new_event_buffer(events.begin() + i, events.begin() + i + 2);
+        assert_ring_size(5);
+        ASSERT_GE(size_t(6), get_ring().size());
+    }
+}
+
 TEST_F(GenericProducerAlgorithm_GTest, test_max_duration_no_drop_throw) {
     this->producer_algo_.set_max_duration_stored(5);
     this->producer_algo_.set_allow_drop_when_overfilled(false);
@@ -319,22 +388,18 @@ TEST_F(GenericProducerAlgorithm_GTest, test_max_duration_no_drop_big) {
         event.t = i++;
     }
 
-    std::atomic<bool> t1_done{false}, t2_done{false};
-    std::thread t1([&events, &t1_done, this] {
+    std::thread t1([&events, this] {
         for (int i = 0; i <= 1000 - 5; i += 5) {
             this->producer_algo_.register_new_event_buffer(events.begin() + i, events.begin() + i + 5);
+            assert_ring_size(5);
         }
-        t1_done = true;
     });
-    std::thread t2([&events2, &t2_done, this] {
+    std::thread t2([&events2, this] {
         for (timestamp t = 1; t < 1000; ++t) {
             this->producer_algo_.process_events(t, std::back_inserter(events2));
+            assert_ring_size(5);
         }
-        t2_done = true;
     });
-    while (!t1_done || !t2_done) {
-        assert_ring_size(size_t(5));
-    }
     t1.join();
     t2.join();
     ASSERT_EQ(timestamp(0), events2.front().t);
@@ -0,0 +1,163 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <iterator>
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/core/algorithms/filter_chain_algorithm.h"
+#include "metavision/sdk/core/algorithms/mask_filter_algorithm.h"
+#include "metavision/sdk/core/algorithms/polarity_filter_algorithm.h"
+#include "metavision/sdk/core/algorithms/roi_filter_algorithm.h"
+
+using namespace Metavision;
+
+namespace {
+const int width = 200, height = 100;
+
+// Mimics Metavision::DeviceRoi
+struct TestDeviceRoi {
+    int x_, y_, width_, height_;
+};
+
+std::vector<EventCD> make_random_events(size_t n_events) {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> x_dist(0, width + 9), y_dist(0, height + 9), p_dist(0, 1);
+    std::vector<EventCD> events;
+    for (size_t i = 0; i < n_events; ++i) {
+        events.emplace_back(x_dist(gen), y_dist(gen), p_dist(gen), static_cast<timestamp>(i));
+    }
+    return events;
+}
+
+bool are_equal(const EventCD &lhs, const EventCD &rhs) {
+    return lhs.x == rhs.x && lhs.y == rhs.y && lhs.p == rhs.p && lhs.t == rhs.t;
+}
+} // namespace
+
+TEST(MaskFilterAlgorithm_GTest, mask_from_image) {
+    // GIVEN a mask with a few arbitrary pixels, spanning several words per row
+    std::vector<std::uint8_t> data(width * height, 0);
+    cv::Mat mask(height, width, CV_8UC1, data.data());
+    const std::vector<std::pair<int, int>> pixels{{3, 5}, {63, 5}, {64, 5}, {65, 6}, {130, 40}, {199, 60}};
+    for (const auto &p : pixels) {
+        mask.at<std::uint8_t>(p.second, p.first) = 1;
+    }
+
+    // WHEN we build the filter from it
+    MaskFilterAlgorithm algo(mask);
+
+    // THEN only these pixels are in the mask, and the bounding box is the one of the pixels
+    int n_in_mask = 0;
+    for (int y = -2; y < height + 2; ++y) {
+        for (int x = -2; x < width + 2; ++x) {
+            const bool in_mask = x >= 0 && y >= 0 && x < width && y < height && mask.at<std::uint8_t>(y, x);
+            ASSERT_EQ(in_mask, algo.is_in_mask(x, y)) << x << " " << y;
+            n_in_mask += in_mask;
+        }
+    }
+    ASSERT_EQ(pixels.size(), n_in_mask);
+    ASSERT_EQ(width, algo.width());
+    ASSERT_EQ(height, algo.height());
+    ASSERT_EQ(3, algo.crop_x0());
+    ASSERT_EQ(5, algo.crop_y0());
+    ASSERT_EQ(197, algo.crop_width());
+    ASSERT_EQ(56, algo.crop_height());
+}
+
+TEST(MaskFilterAlgorithm_GTest, same_as_roi_filters) {
+    // GIVEN a mask made of several overlapping and partially outside rectangles
+    const std::vector<TestDeviceRoi> rois{{10, 10, 50, 20}, {40, 20, 100, 10}, {180, 90, 50, 50}, {300, 0, 10, 10}};
+    const auto events = make_random_events(20000);
+
+    for (bool relative : {false, true}) {
+        // WHEN we filter events with the mask
+        MaskFilterAlgorithm algo(width, height, rois, relative);
+        std::vector<EventCD> output;
+        algo.process_events(events.cbegin(), events.cend(), std::back_inserter(output));
+
+        // THEN we get the events in any of the rectangles, relative to their bounding box if requested
+        ASSERT_EQ(10, algo.crop_x0());
+        ASSERT_EQ(10, algo.crop_y0());
+        ASSERT_EQ(190, algo.crop_width());
+        ASSERT_EQ(90, algo.crop_height());
+
+        std::vector<EventCD> expected;
+        for (auto ev : events) {
+            for (const auto &roi : rois) {
+                const RoiFilterAlgorithm roi_filter(roi.x_, roi.y_, roi.x_ + roi.width_ - 1, roi.y_ + roi.height_ - 1);
+                if (roi_filter(static_cast<const EventCD &>(ev)) && ev.x < width && ev.y < height) {
+                    if (relative) {
+                        ev.x -= 10;
+                        ev.y -= 10;
+                    }
+                    expected.push_back(ev);
+                    break;
+                }
+            }
+        }
+        ASSERT_FALSE(expected.empty());
+        ASSERT_EQ(expected.size(), output.size());
+        ASSERT_TRUE(std::equal(expected.cbegin(), expected.cend(), output.cbegin(), are_equal));
+    }
+}
+
+TEST(MaskFilterAlgorithm_GTest, get_mask_round_trip) {
+    // GIVEN a filter built from ROIs
+    MaskFilterAlgorithm algo(width, height, std::vector<cv::Rect>{{0, 0, 64, 1}, {70, 50, 129, 3}});
+
+    // WHEN we get the mask and build a new filter from it
+    std::vector<std::uint8_t> data(width * height, 0);
+    cv::Mat mask(height, width, CV_8UC1, data.data());
+    algo.get_mask(mask);
+    MaskFilterAlgorithm algo_from_mask(mask);
+
+    // THEN both filters are the same
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            ASSERT_EQ(algo.is_in_mask(x, y), algo_from_mask.is_in_mask(x, y));
+            ASSERT_EQ(algo.is_in_mask(x, y) ? 255 : 0, mask.at<std::uint8_t>(y, x));
+        }
+    }
+    ASSERT_EQ(64 + 129 * 3, std::count(data.cbegin(), data.cend(), 255));
+}
+
+TEST(MaskFilterAlgorithm_GTest, empty_mask) {
+    MaskFilterAlgorithm algo(width, height, std::vector<cv::Rect>{{-10, -10, 5, 5}});
+    const auto events = make_random_events(1000);
+    std::vector<EventCD> output;
+    algo.process_events(events.cbegin(), events.cend(), std::back_inserter(output));
+    ASSERT_TRUE(output.empty());
+    ASSERT_EQ(0, algo.crop_width());
+    ASSERT_EQ(0, algo.crop_height());
+
+    ASSERT_THROW(MaskFilterAlgorithm(cv::Mat()), std::invalid_argument);
+    ASSERT_THROW(MaskFilterAlgorithm(0, height, std::vector<cv::Rect>()), std::invalid_argument);
+}
+
+TEST(MaskFilterAlgorithm_GTest, in_filter_chain) {
+    // GIVEN a chain with a mask filter outputting relative coordinates
+    const auto events = make_random_events(5000);
+    MaskFilterAlgorithm mask(width, height, std::vector<cv::Rect>{{20, 30, 40, 50}, {100, 0, 10, 10}}, true);
+    auto chain = make_filter_chain(PolarityFilterAlgorithm(1), mask);
+
+    // WHEN we process events with the chain and with the filters one after the other
+    std::vector<EventCD> output, polarity_filtered, expected;
+    chain.process_events(events.cbegin(), events.cend(), std::back_inserter(output));
+    PolarityFilterAlgorithm(1).process_events(events.cbegin(), events.cend(), std::back_inserter(polarity_filtered));
+    mask.process_events(polarity_filtered.cbegin(), polarity_filtered.cend(), std::back_inserter(expected));
+
+    // THEN we get the same events
+    ASSERT_EQ(expected.size(), output.size());
+    ASSERT_TRUE(std::equal(expected.cbegin(), expected.cend(), output.cbegin(), are_equal));
+}
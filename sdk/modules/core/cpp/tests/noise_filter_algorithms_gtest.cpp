@@ -0,0 +1,147 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <iterator>
+#include <list>
+#include <map>
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/core/algorithms/activity_noise_filter_algorithm.h"
+#include "metavision/sdk/core/algorithms/trail_filter_algorithm.h"
+
+using namespace Metavision;
+
+namespace {
+const int width = 64, height = 48;
+
+// Random events, whose delay to the previous event at the same pixel is far enough from the threshold for the result
+// not to depend on the resolution of the timestamps stored by the filters
+std::vector<EventCD> make_random_events(std::uint32_t threshold, size_t n_events) {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> x_dist(0, 3), y_dist(0, 3), p_dist(0, 1), burst_dist(0, 2);
+    std::map<int, timestamp> last_ts;
+    std::vector<EventCD> events;
+    timestamp t = 1000;
+    for (size_t i = 0; i < n_events; ++i) {
+        const int x = x_dist(gen), y = y_dist(gen);
+        t += 1 + burst_dist(gen);
+        auto &last_t = last_ts[y * width + x];
+        // Depending on the draw, the event is part of the burst of the previous event or starts a new one
+        if (t - last_t >= threshold * 7 / 8 && t - last_t <= threshold * 9 / 8) {
+            t = last_t + threshold * 9 / 8 + 1;
+        }
+        if (burst_dist(gen) == 0) {
+            t += threshold * 2;
+        }
+        last_t = t;
+        events.emplace_back(x, y, p_dist(gen), t);
+    }
+    return events;
+}
+
+// Straightforward implementation of the filters
+std::vector<EventCD> filter_events(const std::vector<EventCD> &events, std::uint32_t threshold, bool keep_first) {
+    struct PixelState {
+        timestamp t = -1;
+        short p     = -1;
+        bool kept   = false;
+    };
+    std::map<int, PixelState> states;
+    std::vector<EventCD> output;
+    for (const auto &ev : events) {
+        auto &state         = states[ev.y * width + ev.x];
+        const bool in_burst = state.t >= 0 && state.p == ev.p && ev.t - state.t < threshold;
+        const bool keep     = keep_first ? !in_burst : (in_burst && !state.kept);
+        state.kept          = in_burst;
+        state.t             = ev.t;
+        state.p             = ev.p;
+        if (keep) {
+            output.push_back(ev);
+        }
+    }
+    return output;
+}
+
+bool are_equal(const EventCD &lhs, const EventCD &rhs) {
+    return lhs.x == rhs.x && lhs.y == rhs.y && lhs.p == rhs.p && lhs.t == rhs.t;
+}
+} // namespace
+
+TEST(NoiseFilterAlgorithms_GTest, bursts_of_a_pixel) {
+    // GIVEN a burst of events, a burst of the other polarity and an isolated event
+    const std::vector<EventCD> events{{1, 2, 1, 100}, {1, 2, 1, 150}, {1, 2, 1, 250}, {1, 2, 0, 300},
+                                      {1, 2, 0, 350}, {1, 2, 0, 400}, {1, 2, 0, 2000}};
+
+    // WHEN we filter them
+    TrailFilterAlgorithm trail(width, height, 120);
+    ActivityNoiseFilterAlgorithm activity(width, height, 120);
+    std::vector<EventCD> trail_output, activity_output;
+    trail.process_events(events.cbegin(), events.cend(), std::back_inserter(trail_output));
+    activity.process_events(events.cbegin(), events.cend(), std::back_inserter(activity_output));
+
+    // THEN the trail filter keeps the first event of each burst, and the activity filter the second one
+    ASSERT_EQ(3, trail_output.size());
+    EXPECT_EQ(100, trail_output[0].t);
+    EXPECT_EQ(300, trail_output[1].t);
+    EXPECT_EQ(2000, trail_output[2].t);
+    ASSERT_EQ(2, activity_output.size());
+    EXPECT_EQ(150, activity_output[0].t);
+    EXPECT_EQ(350, activity_output[1].t);
+}
+
+TEST(NoiseFilterAlgorithms_GTest, same_as_reference_implementation) {
+    for (std::uint32_t threshold : {1u, 10u, 100u, 5000u, 100000u}) {
+        const auto events = make_random_events(threshold, 20000);
+        for (bool keep_first : {true, false}) {
+            // GIVEN the events expected with a straightforward implementation
+            const auto expected = filter_events(events, threshold, keep_first);
+
+            // WHEN we filter them, in place or from a list to a back inserter
+            std::vector<EventCD> output = events, output_from_list;
+            const std::list<EventCD> events_list(events.cbegin(), events.cend());
+            if (keep_first) {
+                TrailFilterAlgorithm algo(width, height, threshold);
+                output.erase(algo.process_events(output.begin(), output.end(), output.begin()), output.end());
+                algo.reset();
+                algo.process_events(events_list.cbegin(), events_list.cend(), std::back_inserter(output_from_list));
+            } else {
+                ActivityNoiseFilterAlgorithm algo(width, height, threshold);
+                output.erase(algo.process_events(output.begin(), output.end(), output.begin()), output.end());
+                algo.reset();
+                algo.process_events(events_list.cbegin(), events_list.cend(), std::back_inserter(output_from_list));
+            }
+
+            // THEN we get the same events
+            ASSERT_EQ(expected.size(), output.size()) << threshold << " " << keep_first;
+            ASSERT_TRUE(std::equal(expected.cbegin(), expected.cend(), output.cbegin(), are_equal));
+            ASSERT_EQ(expected.size(), output_from_list.size());
+            ASSERT_TRUE(std::equal(expected.cbegin(), expected.cend(), output_from_list.cbegin(), are_equal));
+        }
+    }
+}
+
+TEST(NoiseFilterAlgorithms_GTest, set_threshold_resets_state) {
+    const std::vector<EventCD> events{{1, 2, 1, 100}, {1, 2, 1, 150}};
+    TrailFilterAlgorithm algo(width, height, 10);
+    ASSERT_EQ(10, algo.get_threshold());
+
+    std::vector<EventCD> output;
+    algo.process_events(events.cbegin(), events.cbegin() + 1, std::back_inserter(output));
+    algo.set_threshold(100);
+    ASSERT_EQ(100, algo.get_threshold());
+    algo.process_events(events.cbegin() + 1, events.cend(), std::back_inserter(output));
+    ASSERT_EQ(2, output.size());
+
+    ASSERT_THROW(TrailFilterAlgorithm(0, height, 10), std::invalid_argument);
+}
@@ -0,0 +1,95 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <atomic>
+#include <thread>
+#include <boost/any.hpp>
+#include <gtest/gtest.h>
+
+#include "metavision/sdk/core/pipeline/pipeline.h"
+#include "metavision/sdk/core/pipeline/noise_filter_stage.h"
+
+using namespace Metavision;
+
+namespace {
+using EventBufferPool = SharedObjectPool<std::vector<EventCD>>;
+using EventBufferPtr  = EventBufferPool::ptr_type;
+
+struct MockProducingStage : public BaseStage {
+    MockProducingStage(const std::vector<std::vector<EventCD>> &evts) :
+        events(evts), pool(EventBufferPool::make_bounded()) {
+        set_starting_callback([this] {
+            thread = std::thread([this] {
+                for (const auto &evts : events) {
+                    if (stopped)
+                        break;
+                    auto buffer = pool.acquire();
+                    *buffer     = evts;
+                    produce(buffer);
+                }
+                if (!stopped)
+                    complete();
+            });
+        });
+        set_stopping_callback([this] {
+            stopped = true;
+            if (thread.joinable()) {
+                thread.join();
+            }
+        });
+    }
+
+    std::thread thread;
+    std::atomic<bool> stopped{false};
+    std::vector<std::vector<EventCD>> events;
+    EventBufferPool pool;
+};
+
+struct MockConsumingStage : public BaseStage {
+    MockConsumingStage(std::vector<std::vector<EventCD>> &bs) : buffers(bs) {
+        set_consuming_callback([this](const boost::any &data) {
+            try {
+                buffers.emplace_back(*boost::any_cast<EventBufferPtr>(data));
+            } catch (boost::bad_any_cast &) {}
+        });
+    }
+    std::vector<std::vector<EventCD>> &buffers;
+};
+} // namespace
+
+TEST(NoiseFilterStageTest, filter_buffers) {
+    // GIVEN buffers of events, with a burst spanning two buffers
+    std::vector<std::vector<EventCD>> events{{{1, 0, 1, 0}, {2, 0, 0, 1}, {1, 0, 1, 2}},
+                                             {{1, 0, 1, 3}, {2, 0, 0, 500}}};
+
+    // WHEN we run them through trail and activity noise filter stages
+    std::vector<std::vector<EventCD>> trail_buffers, activity_buffers;
+    Pipeline p;
+    auto &s1 = p.add_stage(std::make_unique<MockProducingStage>(events));
+    auto &s2 = p.add_stage(std::make_unique<TrailFilterStage>(10, 10, 100), s1);
+    auto &s3 = p.add_stage(std::make_unique<ActivityNoiseFilterStage>(10, 10, 100), s1);
+    p.add_stage(std::make_unique<MockConsumingStage>(trail_buffers), s2);
+    p.add_stage(std::make_unique<MockConsumingStage>(activity_buffers), s3);
+    p.run();
+
+    // THEN the state of the filters is kept from one buffer to the next
+    ASSERT_EQ(2u, trail_buffers.size());
+    ASSERT_EQ(2u, trail_buffers[0].size());
+    EXPECT_EQ(0, trail_buffers[0][0].t);
+    EXPECT_EQ(1, trail_buffers[0][1].t);
+    ASSERT_EQ(1u, trail_buffers[1].size());
+    EXPECT_EQ(500, trail_buffers[1][0].t);
+
+    ASSERT_EQ(2u, activity_buffers.size());
+    ASSERT_EQ(1u, activity_buffers[0].size());
+    EXPECT_EQ(2, activity_buffers[0][0].t);
+    EXPECT_TRUE(activity_buffers[1].empty());
+}
@@ -10,6 +10,8 @@
  **********************************************************************************************************************/
 
 #include <gtest/gtest.h>
+#include <memory>
+#include <random>
 #include <vector>
 #include <opencv2/core.hpp>
 
@@ -647,4 +649,104 @@ TEST(OnDemandFrameGenerationAlgorithm_GTest, delay_overlapping_frame_generation)
         ASSERT_TRUE(std::equal(expected_frame.begin<cv::Vec3b>(), expected_frame.end<cv::Vec3b>(),
                                generated_mat.begin<cv::Vec3b>()));
     }
-}
\ No newline at end of file
+}
+TEST(OnDemandFrameGenerationAlgorithm_GTest, shared_buffers_released_once_too_old) {
+    const int sensor_width               = 10;
+    const int sensor_height              = 10;
+    const timestamp accumulation_time_us = 100;
+
+    OnDemandFrameGenerationAlgorithm frame_generation(sensor_width, sensor_height);
+    frame_generation.set_accumulation_time_us(accumulation_time_us);
+
+    // GIVEN shared buffers of events spanning ]0, 100], ]100, 200] and ]200, 300]
+    std::vector<std::shared_ptr<std::vector<EventCD>>> buffers;
+    for (int k = 0; k < 3; ++k) {
+        buffers.push_back(std::make_shared<std::vector<EventCD>>());
+        for (int i = 0; i < 10; ++i) {
+            buffers.back()->emplace_back(i, k, i % 2, k * 100 + 10 * (i + 1));
+        }
+    }
+
+    // WHEN we process them
+    for (const auto &buffer : buffers) {
+        frame_generation.process_events(buffer);
+    }
+
+    // THEN they are referenced without being copied
+    for (const auto &buffer : buffers) {
+        ASSERT_EQ(2, buffer.use_count());
+    }
+
+    // WHEN we generate a frame at 250, i.e. with the events in ]150, 250]
+    cv::Mat generated;
+    frame_generation.generate(250, generated);
+
+    // THEN the frame holds the events of the last two buffers in this range
+    cv::Mat expected_frame(sensor_height, sensor_width, CV_8UC3, bg_color);
+    for (int k = 1; k < 3; ++k) {
+        for (const auto &ev : *buffers[k]) {
+            if (ev.t > 150 && ev.t <= 250) {
+                expected_frame.at<cv::Vec3b>(ev.y, ev.x) = (ev.p == 1 ? on_color : off_color);
+            }
+        }
+    }
+    ASSERT_TRUE(std::equal(expected_frame.begin<cv::Vec3b>(), expected_frame.end<cv::Vec3b>(),
+                           generated.begin<cv::Vec3b>()));
+
+    // AND the first buffer, whose events are all older than the accumulation window, is released
+    ASSERT_EQ(1, buffers[0].use_count());
+    ASSERT_EQ(2, buffers[1].use_count());
+    ASSERT_EQ(2, buffers[2].use_count());
+
+    // WHEN resetting the algorithm
+    frame_generation.reset();
+
+    // THEN all buffers are released
+    for (const auto &buffer : buffers) {
+        ASSERT_EQ(1, buffer.use_count());
+    }
+}
+
+TEST(OnDemandFrameGenerationAlgorithm_GTest, mixed_copied_and_shared_buffers) {
+    const int sensor_width               = 50;
+    const int sensor_height              = 40;
+    const timestamp accumulation_time_us = 1000;
+
+    OnDemandFrameGenerationAlgorithm frame_generation(sensor_width, sensor_height, accumulation_time_us);
+
+    // GIVEN events split in many small buffers, alternately copied and shared
+    std::mt19937 gen(0);
+    std::vector<EventCD> events;
+    for (timestamp t = 1; t < 10000; t += 3) {
+        events.emplace_back(gen() % sensor_width, gen() % sensor_height, gen() % 2, t);
+    }
+
+    auto it = events.cbegin();
+    for (int k = 0; it != events.cend(); ++k) {
+        const auto it_end = it + std::min<std::ptrdiff_t>(1 + gen() % 20, std::distance(it, events.cend()));
+        if (k % 2 == 0) {
+            frame_generation.process_events(it, it_end);
+        } else {
+            frame_generation.process_events(std::make_shared<const std::vector<EventCD>>(it, it_end));
+        }
+        it = it_end;
+    }
+
+    // WHEN we generate frames at increasing timestamps
+    // THEN each one holds the events in its accumulation window, whatever the buffers they came from
+    cv::Mat generated;
+    cv::Mat expected_frame(sensor_height, sensor_width, CV_8UC3);
+    for (timestamp ts = 500; ts < 10500; ts += 700) {
+        frame_generation.generate(ts, generated);
+
+        expected_frame.setTo(bg_color);
+        for (const auto &ev : events) {
+            if (ev.t > ts - accumulation_time_us && ev.t <= ts) {
+                expected_frame.at<cv::Vec3b>(ev.y, ev.x) = (ev.p == 1 ? on_color : off_color);
+            }
+        }
+        ASSERT_TRUE(std::equal(expected_frame.begin<cv::Vec3b>(), expected_frame.end<cv::Vec3b>(),
+                               generated.begin<cv::Vec3b>()))
+            << "Frame at " << ts;
+    }
+}
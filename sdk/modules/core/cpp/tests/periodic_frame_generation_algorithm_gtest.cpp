@@ -10,6 +10,7 @@
  **********************************************************************************************************************/
 
 #include <gtest/gtest.h>
+#include <random>
 #include <vector>
 #include <opencv2/core.hpp>
 
@@ -720,4 +721,67 @@ TEST(PeriodicFrameGenerationAlgorithm_GTest, test_doc_example_output) {
     // clang-format on
 
     ASSERT_EQ(expected_message, is.str());
-}
\ No newline at end of file
+}
+TEST(PeriodicFrameGenerationAlgorithm_GTest, incremental_update_matches_full_update) {
+    const int sensor_width               = 100;
+    const int sensor_height              = 50;
+    const timestamp period_us            = 10000;
+    const double fps                     = 1.e6 / period_us;
+    const timestamp accumulation_time_us = 5000;
+
+    // GIVEN two frame generators, one of them updating its frames incrementally
+    PeriodicFrameGenerationAlgorithm full_generation(sensor_width, sensor_height, accumulation_time_us, fps);
+    PeriodicFrameGenerationAlgorithm incremental_generation(sensor_width, sensor_height, accumulation_time_us, fps);
+    incremental_generation.set_incremental_update(true);
+
+    std::vector<FrameData> full_frames, incremental_frames;
+    full_generation.set_output_callback(
+        [&](timestamp ts, cv::Mat &frame) { full_frames.push_back({ts, frame.clone()}); });
+    incremental_generation.set_output_callback(
+        [&](timestamp ts, cv::Mat &frame) { incremental_frames.push_back({ts, frame.clone()}); });
+
+    // GIVEN events occurring in a small area moving over the sensor, and sparse events elsewhere
+    std::mt19937 gen(42);
+    auto make_events = [&](timestamp ts_begin, timestamp ts_end) {
+        std::vector<EventCD> events;
+        for (timestamp t = ts_begin; t < ts_end; t += 7) {
+            const int cx = static_cast<int>((t / 1000) % (sensor_width - 10));
+            const int cy = static_cast<int>((t / 3000) % (sensor_height - 10));
+            if (gen() % 8 == 0) {
+                events.emplace_back(gen() % sensor_width, gen() % sensor_height, gen() % 2, t);
+            } else {
+                events.emplace_back(cx + gen() % 10, cy + gen() % 10, gen() % 2, t);
+            }
+        }
+        return events;
+    };
+
+    // WHEN we process the same events with both generators, changing the parameters in between
+    auto process = [&](timestamp ts_begin, timestamp ts_end) {
+        const auto events = make_events(ts_begin, ts_end);
+        full_generation.process_events(events.cbegin(), events.cend());
+        incremental_generation.process_events(events.cbegin(), events.cend());
+    };
+    process(0, 100000);
+    full_generation.set_accumulation_time_us(20000);
+    incremental_generation.set_accumulation_time_us(20000);
+    process(100000, 200000);
+    full_generation.set_accumulation_time_us(2000);
+    incremental_generation.set_accumulation_time_us(2000);
+    process(200000, 300000);
+    full_generation.set_color_palette(ColorPalette::Gray);
+    incremental_generation.set_color_palette(ColorPalette::Gray);
+    process(300000, 400000);
+    full_generation.force_generate();
+    incremental_generation.force_generate();
+
+    // THEN the generated frames are identical
+    ASSERT_EQ(40u, full_frames.size());
+    ASSERT_EQ(full_frames.size(), incremental_frames.size());
+    for (size_t i = 0; i < full_frames.size(); ++i) {
+        ASSERT_EQ(full_frames[i].ts_us_, incremental_frames[i].ts_us_);
+        ASSERT_EQ(full_frames[i].frame_.type(), incremental_frames[i].frame_.type());
+        ASSERT_EQ(full_frames[i].frame_.size(), incremental_frames[i].frame_.size());
+        ASSERT_EQ(0, cv::norm(full_frames[i].frame_, incremental_frames[i].frame_, cv::NORM_L1)) << "Frame " << i;
+    }
+}
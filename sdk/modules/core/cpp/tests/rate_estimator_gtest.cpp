@@ -9,7 +9,11 @@
  * See the License for the specific language governing permissions and limitations under the License.                 *
  **********************************************************************************************************************/
 
+#include <algorithm>
 #include <chrono>
+#include <map>
+#include <random>
+#include <stdexcept>
 #include <thread>
 #include <gtest/gtest.h>
 
@@ -23,6 +27,17 @@ TEST(RateEstimator_GTest, default_ctor) {
     EXPECT_EQ(1000000, estim.window_time());
 }
 
+TEST(RateEstimator_GTest, ctor_throws_on_non_positive_durations) {
+    auto cb = [](timestamp, double, double) {};
+    EXPECT_THROW(RateEstimator(cb, 0, 1000), std::invalid_argument);
+    EXPECT_THROW(RateEstimator(cb, -100, 1000), std::invalid_argument);
+    EXPECT_THROW(RateEstimator(cb, 100, 0), std::invalid_argument);
+    EXPECT_THROW(RateEstimator(0, 1000, 100, cb), std::invalid_argument);
+    EXPECT_THROW(RateEstimator(100, 1000, 0, cb), std::invalid_argument);
+    EXPECT_THROW(RateEstimator(100, 1000, -10, cb), std::invalid_argument);
+    EXPECT_THROW(RateEstimator(100, 1000, 1000, cb), std::runtime_error);
+}
+
 TEST(RateEstimator_GTest, custom_ctor_not_enough_data) {
     // GIVEN a default estimator (step=100ms)
     size_t num_calls = 0;
@@ -352,6 +367,46 @@ TEST(RateEstimator_GTest, custom_ctor_values_outside_window_system_time) {
     }
 }
 
+TEST(RateEstimator_GTest, same_as_reference_implementation) {
+    // GIVEN random samples, with bursts and gaps longer than the window
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> dt_dist(0, 300), count_dist(0, 1000), gap_dist(0, 200);
+    std::vector<std::pair<timestamp, size_t>> samples;
+    timestamp t = 0;
+    for (int i = 0; i < 20000; ++i) {
+        t += gap_dist(gen) == 0 ? 30000 : dt_dist(gen);
+        samples.emplace_back(t, count_dist(gen));
+    }
+
+    // WHEN we estimate the rates (step=5ms, window=20ms, peak=500us)
+    std::vector<std::tuple<timestamp, double, double>> values;
+    RateEstimator estim(5000, 20000, 500,
+                        [&](timestamp t, double avg, double peak) { values.emplace_back(t, avg, peak); });
+    for (const auto &sample : samples) {
+        estim.add_data(sample.first, sample.second);
+    }
+
+    // THEN we get the rates computed from the samples of ]t - window, t], in buckets of ]k * peak, (k + 1) * peak]
+    ASSERT_LT(500, values.size());
+    for (const auto &value : values) {
+        const timestamp cb_t = std::get<0>(value);
+        size_t count         = 0;
+        std::map<timestamp, size_t> bucket_counts;
+        for (const auto &sample : samples) {
+            if (sample.first > cb_t - 20000 && sample.first <= cb_t) {
+                count += sample.second;
+                bucket_counts[(sample.first + 499) / 500] += sample.second;
+            }
+        }
+        size_t peak_count = 0;
+        for (const auto &bucket_count : bucket_counts) {
+            peak_count = std::max(peak_count, bucket_count.second);
+        }
+        EXPECT_DOUBLE_EQ(count / static_cast<double>(std::min<timestamp>(cb_t, 20000)) * 1.e6, std::get<1>(value));
+        EXPECT_DOUBLE_EQ(peak_count / 500. * 1.e6, std::get<2>(value));
+    }
+}
+
 TEST(RateEstimator_GTest, real_values) {
     int samples[][2] = {
         {5003, 313},  {5015, 294},  {5018, 289},  {5022, 293},  {5026, 295},  {5030, 289},  {5033, 290},  {5037, 295},
@@ -3982,11 +4037,12 @@ TEST(RateEstimator_GTest, real_values) {
         estim.add_data(sample[0], sample[1]);
     }
 
-    // THEN we get expected rates (around 100Me/s, except for first two windows and last one)
+    // THEN we get expected rates (around 100Me/s, except for first two windows and last one), the peak rates being
+    // computed over the 1ms buckets aligned on multiples of 1ms
     const std::vector<std::tuple<double, double>> expected_values = {
-        {49955300., 100318000.}, {74844850., 100318000.}, {97750200., 100170000.}, {86791600., 100031000.},
-        {88737950., 100193000.}, {99423850., 100193000.}, {86462250., 100040000.}, {86755100., 100040000.},
-        {99574450., 99982000.},  {74393850., 99879000.}};
+        {49955300., 100339000.}, {74844850., 100339000.}, {97750200., 100198000.}, {86791600., 100321000.},
+        {88737950., 100321000.}, {99423850., 100195000.}, {86462250., 100095000.}, {86755100., 100265000.},
+        {99574450., 100265000.}, {74393850., 100152000.}};
 
     EXPECT_EQ(values.size(), expected_values.size());
     for (size_t i = 0; i < values.size(); ++i) {
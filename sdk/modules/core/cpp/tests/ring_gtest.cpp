@@ -852,3 +852,109 @@ TEST_F(Ring_GTest, test_thread) {
     std::cout << "prod " << threadtest.get_produced() << " cons " << threadtest.get_next_to_consume() << std::endl;
     threadtest.stat_ring();
 }
+
+TEST_F(Ring_GTest, test_grow_and_wrap_around) {
+    // GIVEN a ring with a small storage, to which chunks are added faster than they are consumed
+    RingTest<Event_Gtest> r(4, 2);
+    type_buffer res;
+    auto inserter = std::back_inserter(res);
+    long next_t   = 0;
+    for (int i = 0; i < 50; ++i) {
+        type_buffer buf;
+        for (int j = 0; j < 1 + i % 7; ++j) {
+            buf.push_back(Event_Gtest{next_t++});
+        }
+        r.add(buf);
+        // WHEN we read the events a few at a time
+        if (i % 3 == 0) {
+            r.fill_buffer_to(inserter, next_t - 5);
+        }
+    }
+    EXPECT_EQ(Metavision::timestamp(next_t - 1), r.get_last_time());
+    r.fill_buffer_remaining(inserter);
+
+    // THEN we get all the events, in order
+    ASSERT_EQ(static_cast<size_t>(next_t), res.size());
+    for (long t = 0; t < next_t; ++t) {
+        ASSERT_EQ(t, res[t].t);
+    }
+    EXPECT_FALSE(r.data_available());
+}
+
+TEST_F(Ring_GTest, test_view_to) {
+    RingTest<Event_Gtest> r(8, 4);
+    type_buffer buf;
+    for (long t = 0; t < 6; ++t) {
+        buf.push_back(Event_Gtest{t});
+    }
+    r.add(buf);
+    r.fill_buffer_to(std::back_inserter(buf), 4);
+    buf.clear();
+    for (long t = 6; t < 10; ++t) {
+        buf.push_back(Event_Gtest{t});
+    }
+    r.add(buf);
+
+    // The events 4 to 8 wrap around the end of the storage, and are returned in two ranges
+    auto view = r.view_to(9);
+    ASSERT_EQ(size_t(5), view.size());
+    EXPECT_EQ(size_t(1), r.size());
+    EXPECT_EQ(Metavision::timestamp(9), r.get_first_time());
+    type_buffer res;
+    view.copy_to(std::back_inserter(res));
+    for (long t = 4; t < 9; ++t) {
+        EXPECT_EQ(t, res[t - 4].t);
+    }
+
+    // The events of the view are kept until the next read, even if the producer needs space
+    buf.assign(3, Event_Gtest{10});
+    r.add(buf);
+    res.clear();
+    view.copy_to(std::back_inserter(res));
+    EXPECT_EQ(Metavision::timestamp(4), res.front().t);
+    EXPECT_EQ(Metavision::timestamp(8), res.back().t);
+
+    view = r.view_remaining();
+    EXPECT_EQ(size_t(4), view.size());
+    EXPECT_FALSE(r.data_available());
+    EXPECT_TRUE(r.view_to(100).empty());
+}
+
+TEST_F(Ring_GTest, test_thread_no_lost_events) {
+    // GIVEN a producer adding chunks of various sizes, with timestamps increasing by 1
+    RingTest<Event_Gtest> r(64, 4);
+    const long n_events = 500000;
+    std::thread producer([&r, n_events] {
+        long t = 0;
+        type_buffer buf;
+        while (t < n_events) {
+            buf.clear();
+            for (long i = 0; i < 1 + t % 37 && t < n_events; ++i) {
+                buf.push_back(Event_Gtest{t++});
+            }
+            r.add(buf);
+        }
+    });
+
+    // WHEN the consumer reads them concurrently, by copy or through views
+    type_buffer res;
+    auto inserter = std::back_inserter(res);
+    for (long ts = 0; ts < n_events; ts += 100) {
+        while (!r.data_available(ts)) {
+            std::this_thread::yield();
+        }
+        if ((ts / 100) % 2) {
+            r.fill_buffer_to(inserter, ts);
+        } else {
+            r.view_to(ts).copy_to(inserter);
+        }
+    }
+    producer.join();
+    r.fill_buffer_remaining(inserter);
+
+    // THEN each event is received once, in order
+    ASSERT_EQ(static_cast<size_t>(n_events), res.size());
+    for (long t = 0; t < n_events; ++t) {
+        ASSERT_EQ(t, res[t].t);
+    }
+}
@@ -11,7 +11,12 @@
 
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
 #include <random>
+#include <thread>
 #include <vector>
 
 #include "metavision/sdk/core/algorithms/shared_cd_events_buffer_producer_algorithm.h"
@@ -252,3 +257,130 @@ TEST_F(SharedCdEventsBufferProducer_Gtest, shared_cd_buffer_producer_none_policy
     ASSERT_EQ(data.back().t + 1, produced[0].t);
     ASSERT_EQ(data.size(), produced[0].data_->size());
 }
+
+TEST_F(SharedCdEventsBufferProducer_Gtest, shared_cd_buffer_producer_pool_stats_grow) {
+    // GIVEN An unbounded buffer pool of size 2 and a consumer holding all the produced buffers
+    Metavision::SharedEventsBufferProducerParameters params;
+    params.buffers_pool_size_    = 2;
+    params.buffers_events_count_ = 1;
+    params.bounded_memory_pool_  = false;
+
+    std::vector<SharedCdBufferEvent> produced;
+    Metavision::SharedCdEventsBufferProducerAlgorithm producer(params, [&](Metavision::timestamp ts, const auto &ev) {
+        produced.push_back({ts, ev});
+    });
+    ASSERT_EQ(2, producer.pool_stats().capacity_);
+    ASSERT_EQ(1, producer.pool_stats().outstanding_buffers_);
+
+    // WHEN producing 4 buffers
+    std::vector<Metavision::Event2d> data{{0, 0, 0, 0}, {0, 0, 0, 2}, {0, 0, 0, 4}, {0, 0, 0, 5}};
+    producer.process_events(data.cbegin(), data.cend());
+    ASSERT_EQ(4, produced.size());
+
+    // THEN the pool grows to hold the produced buffers and the one being filled
+    auto stats = producer.pool_stats();
+    ASSERT_EQ(5, stats.capacity_);
+    ASSERT_EQ(3, stats.allocations_);
+    ASSERT_EQ(5, stats.outstanding_buffers_);
+    ASSERT_EQ(5, stats.high_water_mark_);
+    ASSERT_EQ(0, stats.blocking_acquisitions_);
+
+    // WHEN the consumer releases the buffers
+    produced.clear();
+
+    // THEN they are back in the pool, and the high-water mark is kept
+    stats = producer.pool_stats();
+    ASSERT_EQ(1, stats.outstanding_buffers_);
+    ASSERT_EQ(5, stats.high_water_mark_);
+}
+
+TEST_F(SharedCdEventsBufferProducer_Gtest, shared_cd_buffer_producer_pool_stats_drop) {
+    // GIVEN A bounded buffer pool of size 3 dropping buffers when exhausted, and a consumer holding the buffers
+    Metavision::SharedEventsBufferProducerParameters params;
+    params.buffers_pool_size_              = 3;
+    params.buffers_events_count_           = 1;
+    params.drop_buffers_if_pool_exhausted_ = true;
+
+    std::vector<SharedCdBufferEvent> produced;
+    Metavision::SharedCdEventsBufferProducerAlgorithm producer(params, [&](Metavision::timestamp ts, const auto &ev) {
+        produced.push_back({ts, ev});
+    });
+
+    // WHEN producing 4 buffers
+    std::vector<Metavision::Event2d> data{{0, 0, 0, 0}, {0, 0, 0, 2}, {0, 0, 0, 4}, {0, 0, 0, 5}, {0, 0, 0, 7}};
+    producer.process_events(data.cbegin(), data.cbegin() + 4);
+
+    // THEN the buffers produced once the pool is exhausted are dropped, without blocking
+    ASSERT_EQ(2, produced.size());
+    ASSERT_EQ(0, produced[0].data_->front().t);
+    ASSERT_EQ(2, produced[1].data_->front().t);
+    auto stats = producer.pool_stats();
+    ASSERT_EQ(3, stats.capacity_);
+    ASSERT_EQ(3, stats.outstanding_buffers_);
+    ASSERT_EQ(2, stats.dropped_buffers_);
+    ASSERT_EQ(2, stats.dropped_events_);
+    ASSERT_EQ(0, stats.blocking_acquisitions_);
+    ASSERT_EQ(0, stats.allocations_);
+
+    // WHEN the consumer releases the buffers and a new buffer is produced
+    produced.clear();
+    producer.process_events(data.cbegin() + 4, data.cend());
+
+    // THEN it is passed to the consumer
+    ASSERT_EQ(1, produced.size());
+    ASSERT_EQ(7, produced[0].data_->front().t);
+}
+
+TEST_F(SharedCdEventsBufferProducer_Gtest, shared_cd_buffer_producer_pool_stats_block) {
+    // GIVEN A bounded buffer pool of size 2, and a consumer releasing the buffers from another thread
+    Metavision::SharedEventsBufferProducerParameters params;
+    params.buffers_pool_size_    = 2;
+    params.buffers_events_count_ = 1;
+
+    std::mutex mutex;
+    std::condition_variable cond;
+    std::deque<SharedCdBufferEvent> queue;
+    size_t n_consumed = 0;
+    bool done         = false;
+    std::thread consumer([&] {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (!done || !queue.empty()) {
+            cond.wait(lock, [&] { return done || !queue.empty(); });
+            if (!queue.empty()) {
+                lock.unlock();
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                lock.lock();
+                queue.pop_front();
+                ++n_consumed;
+            }
+        }
+    });
+
+    Metavision::SharedCdEventsBufferProducerAlgorithm producer(params, [&](Metavision::timestamp ts, const auto &ev) {
+        std::lock_guard<std::mutex> lock(mutex);
+        queue.push_back({ts, ev});
+        cond.notify_one();
+    });
+
+    // WHEN producing more buffers than the pool holds
+    std::vector<Metavision::Event2d> data;
+    for (int i = 0; i < 10; ++i) {
+        data.emplace_back(0, 0, 0, i);
+    }
+    producer.process_events(data.cbegin(), data.cend());
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        done = true;
+        cond.notify_one();
+    }
+    consumer.join();
+
+    // THEN the producer waits for the buffers to be released, and no buffer is lost
+    ASSERT_EQ(10, n_consumed);
+    const auto stats = producer.pool_stats();
+    ASSERT_EQ(2, stats.capacity_);
+    ASSERT_EQ(2, stats.high_water_mark_);
+    ASSERT_LE(1, stats.blocking_acquisitions_);
+    ASSERT_EQ(0, stats.allocations_);
+    ASSERT_EQ(0, stats.dropped_buffers_);
+}
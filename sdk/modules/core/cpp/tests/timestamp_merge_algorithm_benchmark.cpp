@@ -0,0 +1,159 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+// Compares the throughput of TimestampMergeAlgorithm with std::merge, for 2, 4 and 16 inputs of EventCD. At each
+// round, every input delivers a buffer. The std::merge baseline then merges the events before the watermark, read in
+// place from the buffers of the inputs, with pairwise merges of adjacent inputs into temporary vectors, which orders
+// the events with the same timestamp by input as the loser tree does. Both check their output with the same checksum
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/core/algorithms/timestamp_merge_algorithm.h"
+
+using namespace Metavision;
+
+namespace {
+const size_t n_events      = 1 << 22; // Total number of events, over all the inputs
+const size_t events_buffer = 1 << 12; // Size of the buffers of each input
+const int n_runs           = 10;
+
+// Sorted events of each input, interleaved with the ones of the other inputs
+std::vector<std::vector<EventCD>> make_inputs(size_t n_inputs) {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> x_dist(0, 1279), y_dist(0, 719), p_dist(0, 1), dt_dist(0, 8);
+    std::vector<std::vector<EventCD>> inputs(n_inputs);
+    for (auto &input : inputs) {
+        timestamp t = 0;
+        input.reserve(n_events / n_inputs);
+        for (size_t i = 0; i < n_events / n_inputs; ++i) {
+            t += dt_dist(gen);
+            input.emplace_back(x_dist(gen), y_dist(gen), p_dist(gen), t);
+        }
+    }
+    return inputs;
+}
+
+// Checksum of merged events, which depends on their order
+struct Checksum {
+    std::uint64_t value = 0;
+    size_t n_events     = 0;
+
+    void add(const EventCD *begin, const EventCD *end) {
+        for (auto it = begin; it != end; ++it) {
+            value = value * 31 + static_cast<std::uint64_t>(it->t) * 1280 + it->x;
+        }
+        n_events += end - begin;
+    }
+};
+
+// Runs the merge over the buffers of the inputs, taken in turn, and prints the best throughput over all runs
+template<typename Merge>
+void benchmark(const std::string &name, const std::vector<std::vector<EventCD>> &inputs, Merge &&merge) {
+    double best_s = 1e9;
+    Checksum checksum;
+    for (int run = 0; run < n_runs; ++run) {
+        const auto t0 = std::chrono::steady_clock::now();
+        checksum      = merge(inputs);
+        const auto t1 = std::chrono::steady_clock::now();
+        best_s        = std::min(best_s, std::chrono::duration<double>(t1 - t0).count());
+    }
+    std::cout << std::left << std::setw(36) << name << std::right << std::setw(10) << std::fixed
+              << std::setprecision(1) << n_events / best_s * 1e-6 << " Mev/s  (" << checksum.n_events
+              << " events merged, checksum " << std::hex << checksum.value << std::dec << ")" << std::endl;
+}
+
+// Merges the events of each input before the watermark, pairwise, the events being read in place from the inputs
+Checksum windowed_std_merge(const std::vector<std::vector<EventCD>> &inputs, size_t n_buffers) {
+    const auto before     = [](const EventCD &lhs, const EventCD &rhs) { return lhs.t < rhs.t; };
+    const size_t n_inputs = inputs.size();
+    std::vector<size_t> positions(n_inputs, 0);
+    std::vector<std::pair<const EventCD *, const EventCD *>> windows(n_inputs);
+    std::vector<std::vector<EventCD>> merged[2] = {std::vector<std::vector<EventCD>>(n_inputs),
+                                                   std::vector<std::vector<EventCD>>(n_inputs)};
+    Checksum checksum;
+
+    for (size_t b = 0; b <= n_buffers; ++b) {
+        // All the buffers are received at the last round, so that all the remaining events are merged
+        const size_t n_received = b < n_buffers ? (b + 1) * events_buffer : n_buffers * events_buffer;
+        timestamp watermark     = std::numeric_limits<timestamp>::max();
+        if (b < n_buffers) {
+            for (const auto &input : inputs) {
+                watermark = std::min(watermark, input[n_received - 1].t);
+            }
+        }
+        for (size_t i = 0; i < n_inputs; ++i) {
+            const EventCD *begin = inputs[i].data() + positions[i], *end = inputs[i].data() + n_received;
+            end = std::lower_bound(begin, end, watermark, [](const EventCD &ev, timestamp t) { return ev.t < t; });
+            windows[i] = {begin, end};
+            positions[i] += end - begin;
+        }
+
+        // Merges the adjacent windows until there is only one left, the merges of a level reading the ones of the
+        // previous level
+        for (size_t step = 1, level = 0; step < n_inputs; step *= 2, level ^= 1) {
+            for (size_t i = 0; i + step < n_inputs; i += 2 * step) {
+                const auto &lhs = windows[i], &rhs = windows[i + step];
+                auto &out       = merged[level][i];
+                out.resize((lhs.second - lhs.first) + (rhs.second - rhs.first));
+                std::merge(lhs.first, lhs.second, rhs.first, rhs.second, out.begin(), before);
+                windows[i] = {out.data(), out.data() + out.size()};
+            }
+        }
+        checksum.add(windows[0].first, windows[0].second);
+    }
+    return checksum;
+}
+} // namespace
+
+int main() {
+    for (size_t n_inputs : {2, 4, 16}) {
+        const auto inputs      = make_inputs(n_inputs);
+        const size_t n_buffers = inputs[0].size() / events_buffer;
+        const std::string name = std::to_string(n_inputs) + " inputs";
+
+        benchmark(name + " / std::merge", inputs, [&](const std::vector<std::vector<EventCD>> &inputs) {
+            return windowed_std_merge(inputs, n_buffers);
+        });
+
+        for (bool tag_sources : {false, true}) {
+            benchmark(name + " / loser tree" + (tag_sources ? " tagged" : ""), inputs,
+                      [&](const std::vector<std::vector<EventCD>> &inputs) {
+                          Checksum checksum;
+                          TimestampMergeAlgorithm<EventCD> merger(
+                              inputs.size(),
+                              [&](const TimestampMergeAlgorithm<EventCD>::OutputBatch &batch) {
+                                  checksum.add(batch.begin<EventCD>(), batch.end<EventCD>());
+                              },
+                              1 << 16, tag_sources);
+                          for (size_t b = 0; b < n_buffers; ++b) {
+                              for (size_t i = 0; i < inputs.size(); ++i) {
+                                  const EventCD *begin = inputs[i].data() + b * events_buffer;
+                                  merger.process_events(i, begin, begin + events_buffer);
+                              }
+                          }
+                          merger.flush();
+                          return checksum;
+                      });
+        }
+    }
+
+    return 0;
+}
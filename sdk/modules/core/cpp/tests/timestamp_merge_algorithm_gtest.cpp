@@ -0,0 +1,215 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/base/events/event_ext_trigger.h"
+#include "metavision/sdk/core/algorithms/timestamp_merge_algorithm.h"
+
+using namespace Metavision;
+
+namespace {
+struct MergedEvent {
+    timestamp t;
+    int index; ///< Index of the event in its input
+    std::uint32_t source;
+
+    bool operator==(const MergedEvent &other) const {
+        return t == other.t && index == other.index && source == other.source;
+    }
+};
+
+// Sorted events of each input, the x coordinate holding the index of the event in the input
+std::vector<std::vector<EventCD>> make_inputs(std::size_t n_inputs, std::size_t n_events, std::mt19937 &gen) {
+    std::uniform_int_distribution<int> dt_dist(0, 20);
+    std::vector<std::vector<EventCD>> inputs(n_inputs);
+    for (auto &input : inputs) {
+        timestamp t = dt_dist(gen);
+        for (std::size_t i = 0; i < n_events; ++i) {
+            t += dt_dist(gen) / 4; // Many events with the same timestamp
+            input.emplace_back(static_cast<unsigned short>(i), 0, 0, t);
+        }
+    }
+    return inputs;
+}
+} // namespace
+
+TEST(TimestampMergeAlgorithm_GTest, merge_sorted_inputs) {
+    std::mt19937 gen(42);
+    for (std::size_t n_inputs : {1, 2, 3, 4, 16}) {
+        // GIVEN sorted inputs, added by buffers of random sizes in a random order
+        const auto inputs = make_inputs(n_inputs, 5000, gen);
+
+        std::vector<MergedEvent> merged;
+        TimestampMergeAlgorithm<EventCD> merger(
+            n_inputs,
+            [&](const TimestampMergeAlgorithm<EventCD>::OutputBatch &batch) {
+                const std::uint32_t *sources = batch.sources();
+                ASSERT_NE(nullptr, sources);
+                for (auto it = batch.begin<EventCD>(); it != batch.end<EventCD>(); ++it, ++sources) {
+                    merged.push_back({it->t, it->x, *sources});
+                }
+            },
+            100, true);
+
+        // WHEN they are merged
+        std::vector<std::size_t> positions(n_inputs, 0);
+        std::uniform_int_distribution<std::size_t> input_dist(0, n_inputs - 1), size_dist(0, 300);
+        for (std::size_t n_closed = 0; n_closed < n_inputs;) {
+            const std::size_t input = input_dist(gen);
+            if (positions[input] == inputs[input].size()) {
+                continue;
+            }
+            const std::size_t size = std::min(size_dist(gen), inputs[input].size() - positions[input]);
+            merger.process_events(input, inputs[input].data() + positions[input],
+                                  inputs[input].data() + positions[input] + size);
+            positions[input] += size;
+            if (positions[input] == inputs[input].size()) {
+                merger.close_input(input);
+                ++n_closed;
+            }
+        }
+        // All the inputs being closed, only the last batch remains to be output
+        ASSERT_EQ(0u, merger.get_pending_events_count());
+        merger.flush();
+
+        // THEN all the events are merged, sorted by timestamps and then by input
+        std::vector<MergedEvent> expected;
+        for (std::size_t input = 0; input < n_inputs; ++input) {
+            for (const auto &ev : inputs[input]) {
+                expected.push_back({ev.t, ev.x, static_cast<std::uint32_t>(input)});
+            }
+        }
+        std::stable_sort(expected.begin(), expected.end(), [](const MergedEvent &lhs, const MergedEvent &rhs) {
+            return std::tie(lhs.t, lhs.source) < std::tie(rhs.t, rhs.source);
+        });
+        ASSERT_TRUE(expected == merged);
+    }
+}
+
+TEST(TimestampMergeAlgorithm_GTest, watermark) {
+    // GIVEN a merge of two inputs, without source tagging
+    std::vector<timestamp> merged;
+    TimestampMergeAlgorithm<EventCD> merger(2, [&](const TimestampMergeAlgorithm<EventCD>::OutputBatch &batch) {
+        ASSERT_EQ(nullptr, batch.sources());
+        for (auto it = batch.begin<EventCD>(); it != batch.end<EventCD>(); ++it) {
+            merged.push_back(it->t);
+        }
+    });
+
+    // WHEN only the first input has events
+    std::vector<EventCD> events = {EventCD(0, 0, 0, 10), EventCD(0, 0, 0, 20), EventCD(0, 0, 0, 30),
+                                   EventCD(0, 0, 0, 40)};
+    merger.process_events(0, events.data(), events.data() + events.size());
+
+    // THEN none is merged, until the second input is known to have no events before a timestamp
+    ASSERT_EQ(4u, merger.get_pending_events_count());
+    merger.advance_input(1, 30);
+    ASSERT_EQ(30, merger.get_watermark());
+    ASSERT_EQ(2u, merger.get_pending_events_count());
+    merger.close_input(1);
+    ASSERT_EQ(40, merger.get_watermark());
+    ASSERT_EQ(1u, merger.get_pending_events_count());
+
+    merger.flush();
+    ASSERT_EQ(std::vector<timestamp>({10, 20, 30, 40}), merged);
+}
+
+TEST(TimestampMergeAlgorithm_GTest, invalid_arguments) {
+    const auto output_cb = [](const TimestampMergeAlgorithm<EventCD>::OutputBatch &) {};
+    ASSERT_THROW(TimestampMergeAlgorithm<EventCD>(0, output_cb), std::invalid_argument);
+    ASSERT_THROW(TimestampMergeAlgorithm<EventCD>(2, output_cb, 0), std::invalid_argument);
+
+    TimestampMergeAlgorithm<EventCD> merger(2, output_cb);
+    std::vector<EventCD> events = {EventCD(0, 0, 0, 10), EventCD(0, 0, 0, 20)};
+    ASSERT_THROW(merger.process_events(2, events.data(), events.data() + 2), std::invalid_argument);
+    merger.process_events(0, events.data() + 1, events.data() + 2);
+    ASSERT_THROW(merger.process_events(0, events.data(), events.data() + 1), std::invalid_argument);
+    merger.close_input(1);
+    ASSERT_THROW(merger.process_events(1, events.data(), events.data() + 1), std::invalid_argument);
+
+    // the min and max timestamps are reserved
+    merger.reset();
+    events[0].t = std::numeric_limits<timestamp>::min();
+    ASSERT_THROW(merger.process_events(0, events.data(), events.data() + 1), std::invalid_argument);
+    events[1].t = std::numeric_limits<timestamp>::max();
+    ASSERT_THROW(merger.process_events(1, events.data() + 1, events.data() + 2), std::invalid_argument);
+}
+
+TEST(TimestampMergeAlgorithm_GTest, merge_events_of_different_types) {
+    // GIVEN a merge of two inputs of CD events and one input of triggers
+    using Merger = TimestampMergeAlgorithm<EventCD, EventExtTrigger>;
+    std::vector<MergedEvent> merged;
+    std::size_t n_cd = 0, n_triggers = 0;
+    Merger merger({{2, 1}}, [&](const Merger::OutputBatch &batch) {
+        n_cd += batch.end<EventCD>() - batch.begin<EventCD>();
+        n_triggers += batch.end<EventExtTrigger>() - batch.begin<EventExtTrigger>();
+        struct Visitor {
+            std::vector<MergedEvent> &merged;
+            void operator()(const EventCD &ev, std::uint32_t source) {
+                merged.push_back({ev.t, ev.x, source});
+            }
+            void operator()(const EventExtTrigger &ev, std::uint32_t source) {
+                merged.push_back({ev.t, ev.id, source});
+            }
+        };
+        batch.visit(Visitor{merged});
+    }, 3);
+
+    // WHEN they are merged
+    std::vector<EventCD> cd_0 = {EventCD(0, 0, 0, 10), EventCD(1, 0, 0, 20), EventCD(2, 0, 0, 30)};
+    std::vector<EventCD> cd_1 = {EventCD(0, 0, 0, 15), EventCD(1, 0, 0, 20)};
+    std::vector<EventExtTrigger> triggers = {EventExtTrigger(1, 5, 0), EventExtTrigger(0, 20, 1)};
+    merger.process_events(0, cd_0.data(), cd_0.data() + cd_0.size());
+    merger.process_events(2, triggers.data(), triggers.data() + triggers.size());
+    ASSERT_THROW(merger.process_events(1, triggers.data(), triggers.data() + 1), std::invalid_argument);
+    merger.process_events(1, cd_1.data(), cd_1.data() + cd_1.size());
+    merger.close_input(2);
+    merger.flush();
+
+    // THEN the events of both types are merged, sorted by timestamps and then by input
+    const std::vector<MergedEvent> expected = {{5, 0, 2},  {10, 0, 0}, {15, 0, 1}, {20, 1, 0},
+                                               {20, 1, 1}, {20, 1, 2}, {30, 2, 0}};
+    ASSERT_TRUE(expected == merged);
+    ASSERT_EQ(5u, n_cd);
+    ASSERT_EQ(2u, n_triggers);
+}
+
+TEST(TimestampMergeAlgorithm_GTest, events_are_merged_from_the_buffers_of_the_caller) {
+    // GIVEN a merge of two inputs
+    std::vector<timestamp> merged;
+    TimestampMergeAlgorithm<EventCD> merger(2, [&](const TimestampMergeAlgorithm<EventCD>::OutputBatch &batch) {
+        for (auto it = batch.begin<EventCD>(); it != batch.end<EventCD>(); ++it) {
+            merged.push_back(it->t);
+        }
+    });
+
+    // WHEN several buffers are added to an input before the other one is advanced
+    std::vector<EventCD> buffer_0 = {EventCD(0, 0, 0, 10), EventCD(0, 0, 0, 20)};
+    std::vector<EventCD> buffer_1 = {EventCD(0, 0, 0, 30), EventCD(0, 0, 0, 40)};
+    merger.process_events(0, buffer_0.data(), buffer_0.data() + buffer_0.size());
+    merger.process_events(0, buffer_1.data(), buffer_1.data() + buffer_1.size());
+    ASSERT_EQ(4u, merger.get_pending_events_count());
+
+    // THEN the buffers are not copied: the events are read from them when they are merged
+    buffer_1[0].t = 35;
+    merger.advance_input(1, 35);
+    ASSERT_EQ(2u, merger.get_pending_events_count());
+    merger.flush();
+    ASSERT_EQ(std::vector<timestamp>({10, 20, 35, 40}), merged);
+}
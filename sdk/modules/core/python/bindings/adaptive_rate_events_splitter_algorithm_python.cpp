@@ -11,6 +11,7 @@
 
 #include <pybind11/pybind11.h>
 #include <pybind11/numpy.h>
+#include <pybind11/stl.h>
 
 #include "metavision/sdk/base/events/event_cd.h"
 #include "metavision/utils/pybind/sync_algorithm_process_helper.h"
@@ -37,6 +38,21 @@ bool AdaptiveRateEventsSplitter_process_events_buffer(
     return evsplitter.process_events(buff_events.buffer_.cbegin(), buff_events.buffer_.cend());
 }
 
+std::vector<std::size_t> AdaptiveRateEventsSplitter_split_events_array(
+    Metavision::AdaptiveRateEventsSplitterAlgorithm &evsplitter, const py::array_t<Metavision::EventCD> &events,
+    std::size_t n_events_per_check) {
+    auto info_events = events.request();
+    if (info_events.ndim != 1) {
+        throw std::runtime_error("Wrong events dim");
+    }
+    auto events_ptr     = static_cast<Metavision::EventCD *>(info_events.ptr);
+    const int nb_events = info_events.shape[0];
+
+    std::vector<std::size_t> split_offsets;
+    evsplitter.split_events(events_ptr, events_ptr + nb_events, split_offsets, n_events_per_check);
+    return split_offsets;
+}
+
 void AdaptiveRateEventsSplitter_retrieve_events_in_podeventbuffer(
     Metavision::AdaptiveRateEventsSplitterAlgorithm &evsplitter, PODEventBuffer<EventCD> &out) {
     evsplitter.retrieve_events(out.buffer_);
@@ -56,6 +72,13 @@ void export_adaptive_rate_events_splitter_algorithm(py::module &m) {
              "True if the frame is ready, False otherwise.")
         .def("retrieve_events", &AdaptiveRateEventsSplitter_retrieve_events_in_podeventbuffer, py::arg("events_buf"),
              "Retrieves the events (EventCDBuffer) and reinitializes the state of the EventsSplitter.")
+        .def("split_events", &AdaptiveRateEventsSplitter_split_events_array, py::arg("events_np"),
+             py::arg("n_events_per_check") = 0,
+             "Takes a chunk of events (numpy array of EventCD) without copying it, and returns the offsets in the "
+             "chunk of the ends of the slices that are ready. The events after the last offset belong to the next "
+             "slice.")
+        .def("reset", &AdaptiveRateEventsSplitterAlgorithm::reset,
+             pybind_doc_core["Metavision::AdaptiveRateEventsSplitterAlgorithm::reset"])
         .def_static("get_empty_output_buffer", &getEmptyPODBuffer<EventCD>, doc_get_empty_output_buffer_str);
 }
 
@@ -0,0 +1,116 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <string>
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/core/algorithms/event_to_tensor_algorithm.h"
+#include "pb_doc_core.h"
+
+namespace Metavision {
+
+namespace { // anonymous
+
+// The tensor is written in place, so that the caller can reuse its buffers (e.g. pinned memory of a data loader)
+template<typename Algo>
+void generate_helper(const Algo &algo, const py::array_t<EventCD> &events, timestamp start_ts,
+                     timestamp slice_duration, py::array &tensor) {
+    auto info = events.request();
+    if (info.ndim != 1) {
+        throw std::runtime_error("Bad input numpy array dimension " + std::to_string(info.ndim) +
+                                 " should be equal to 1");
+    }
+    if (tensor.ndim() != 3 && tensor.ndim() != 4) {
+        throw std::runtime_error("Bad tensor dimension " + std::to_string(tensor.ndim()) +
+                                 " should be equal to 3 (CHW) or 4 (TCHW)");
+    }
+    if (!(tensor.flags() & py::array::c_style)) {
+        throw std::runtime_error("Tensor must be C-contiguous");
+    }
+    const py::ssize_t first_dim = tensor.ndim() - 3;
+    if (tensor.shape(first_dim) != algo.get_num_channels() || tensor.shape(first_dim + 1) != algo.get_height() ||
+        tensor.shape(first_dim + 2) != algo.get_width()) {
+        throw std::runtime_error("Bad tensor shape, expected (" + std::to_string(algo.get_num_channels()) + ", " +
+                                 std::to_string(algo.get_height()) + ", " + std::to_string(algo.get_width()) + ")");
+    }
+    const int n_slices = tensor.ndim() == 4 ? static_cast<int>(tensor.shape(0)) : 1;
+    auto nelem         = static_cast<size_t>(info.shape[0]);
+    auto *in_ptr       = static_cast<EventCD *>(info.ptr);
+
+    if (tensor.dtype().is(py::dtype::of<float>())) {
+        float *out_ptr = static_cast<float *>(tensor.mutable_data());
+        py::gil_scoped_release release;
+        algo.generate(in_ptr, in_ptr + nelem, start_ts, slice_duration, n_slices, out_ptr);
+    } else if (tensor.dtype().kind() == 'f' && tensor.itemsize() == 2) {
+        cv::float16_t *out_ptr = static_cast<cv::float16_t *>(tensor.mutable_data());
+        py::gil_scoped_release release;
+        algo.generate(in_ptr, in_ptr + nelem, start_ts, slice_duration, n_slices, out_ptr);
+    } else {
+        throw std::runtime_error("Bad tensor type, should be float32 or float16");
+    }
+}
+
+template<typename Algo>
+py::class_<Algo> export_event_to_tensor_algorithm(py::module &m, const char *name, const char *doc) {
+    py::class_<Algo> algo(m, name, doc);
+    algo.def("generate", &generate_helper<Algo>, py::arg("events"), py::arg("start_ts"), py::arg("slice_duration"),
+             py::arg("tensor"),
+             "Builds the tensors of the events of consecutive time slices starting at start_ts, in place.\n\n"
+             "Args:\n"
+             "    events (numpy array): Events sorted by timestamps\n"
+             "    start_ts (int): Start of the first time slice, in us\n"
+             "    slice_duration (int): Duration of each time slice, in us\n"
+             "    tensor (numpy array): C-contiguous float32 or float16 array of shape (C, H, W) for a single slice, "
+             "or (T, C, H, W) for T slices, overwritten without copy\n")
+        .def_property_readonly("width", &Algo::get_width,
+                               pybind_doc_core["Metavision::EventToTensorAlgorithm::get_width"])
+        .def_property_readonly("height", &Algo::get_height,
+                               pybind_doc_core["Metavision::EventToTensorAlgorithm::get_height"])
+        .def_property_readonly("num_channels", &Algo::get_num_channels,
+                               pybind_doc_core["Metavision::EventToTensorAlgorithm::get_num_channels"])
+        .def_property("max_threads", &Algo::get_max_threads, &Algo::set_max_threads,
+                      pybind_doc_core["Metavision::EventToTensorAlgorithm::set_max_threads"]);
+    return algo;
+}
+
+} // anonymous namespace
+
+void export_event_to_tensor_algorithm(py::module &m) {
+    export_event_to_tensor_algorithm<HistogramTensorAlgorithm>(m, "HistogramTensorAlgorithm",
+                                                               pybind_doc_core["Metavision::HistogramTensorAlgorithm"])
+        .def(py::init<int, int, float>(), py::arg("width"), py::arg("height"), py::arg("max_count") = 0.f,
+             pybind_doc_core["Metavision::HistogramTensorAlgorithm::HistogramTensorAlgorithm"])
+        .def_property_readonly("max_count", &HistogramTensorAlgorithm::get_max_count,
+                               pybind_doc_core["Metavision::HistogramTensorAlgorithm::get_max_count"]);
+
+    export_event_to_tensor_algorithm<DifferenceTensorAlgorithm>(
+        m, "DifferenceTensorAlgorithm", pybind_doc_core["Metavision::DifferenceTensorAlgorithm"])
+        .def(py::init<int, int, float>(), py::arg("width"), py::arg("height"), py::arg("max_count") = 0.f,
+             pybind_doc_core["Metavision::DifferenceTensorAlgorithm::DifferenceTensorAlgorithm"])
+        .def_property_readonly("max_count", &DifferenceTensorAlgorithm::get_max_count,
+                               pybind_doc_core["Metavision::DifferenceTensorAlgorithm::get_max_count"]);
+
+    export_event_to_tensor_algorithm<VoxelGridTensorAlgorithm>(m, "VoxelGridTensorAlgorithm",
+                                                               pybind_doc_core["Metavision::VoxelGridTensorAlgorithm"])
+        .def(py::init<int, int, int>(), py::arg("width"), py::arg("height"), py::arg("n_bins"),
+             pybind_doc_core["Metavision::VoxelGridTensorAlgorithm::VoxelGridTensorAlgorithm"])
+        .def_property_readonly("num_bins", &VoxelGridTensorAlgorithm::get_num_bins,
+                               pybind_doc_core["Metavision::VoxelGridTensorAlgorithm::get_num_bins"]);
+
+    export_event_to_tensor_algorithm<TimestampTensorAlgorithm>(m, "TimestampTensorAlgorithm",
+                                                               pybind_doc_core["Metavision::TimestampTensorAlgorithm"])
+        .def(py::init<int, int>(), py::arg("width"), py::arg("height"),
+             pybind_doc_core["Metavision::TimestampTensorAlgorithm::TimestampTensorAlgorithm"]);
+}
+
+} // namespace Metavision
@@ -42,7 +42,9 @@ PythonBindingsDoc pybind_doc_core;
 void export_event_bbox(py::module &);
 void export_base_frame_generation_algorithm(py::module &);
 void export_colors(py::module &);
+void export_activity_noise_filter_algorithm(py::module &);
 void export_adaptive_rate_events_splitter_algorithm(py::module &);
+void export_event_to_tensor_algorithm(py::module &);
 void export_flip_x_algorithm(py::module &);
 void export_flip_y_algorithm(py::module &);
 void export_on_demand_frame_generation_algorithm(py::module &);
@@ -53,6 +55,7 @@ void export_polarity_inverter_algorithm(py::module &);
 void export_roi_filter_algorithm(py::module &);
 void export_shared_cd_events_buffer_producer(py::module &);
 void export_timesurface_producer_algorithm(py::module &);
+void export_trail_filter_algorithm(py::module &);
 } // namespace Metavision
 
 PYBIND11_MODULE(MODULE_NAME, m) {
@@ -78,7 +81,9 @@ PYBIND11_MODULE(MODULE_NAME, m) {
 
     // 3. Export algos
     Metavision::export_base_frame_generation_algorithm(m);
+    Metavision::export_activity_noise_filter_algorithm(m);
     Metavision::export_adaptive_rate_events_splitter_algorithm(m);
+    Metavision::export_event_to_tensor_algorithm(m);
     Metavision::export_flip_x_algorithm(m);
     Metavision::export_flip_y_algorithm(m);
     Metavision::export_on_demand_frame_generation_algorithm(m);
@@ -88,4 +93,5 @@ PYBIND11_MODULE(MODULE_NAME, m) {
     Metavision::export_roi_filter_algorithm(m);
     Metavision::export_shared_cd_events_buffer_producer(m);
     Metavision::export_timesurface_producer_algorithm(m);
+    Metavision::export_trail_filter_algorithm(m);
 }
@@ -89,6 +89,8 @@ void export_periodic_frame_generation_algorithm(py::module &m) {
              pybind_doc_core["Metavision::PeriodicFrameGenerationAlgorithm::get_fps"])
         .def("skip_frames_up_to", &PeriodicFrameGenerationAlgorithm::skip_frames_up_to, py::arg("ts"),
              pybind_doc_core["Metavision::PeriodicFrameGenerationAlgorithm::skip_frames_up_to"])
+        .def("set_incremental_update", &PeriodicFrameGenerationAlgorithm::set_incremental_update, py::arg("enabled"),
+             pybind_doc_core["Metavision::PeriodicFrameGenerationAlgorithm::set_incremental_update"])
         .def("reset", &PeriodicFrameGenerationAlgorithm::reset,
              pybind_doc_core["Metavision::PeriodicFrameGenerationAlgorithm::reset"])
         .def("set_accumulation_time_us", &PeriodicFrameGenerationAlgorithm::set_accumulation_time_us,
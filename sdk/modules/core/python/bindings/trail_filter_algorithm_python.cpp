@@ -0,0 +1,38 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/utils/pybind/sync_algorithm_process_helper.h"
+#include "metavision/sdk/core/algorithms/trail_filter_algorithm.h"
+#include "pb_doc_core.h"
+
+namespace Metavision {
+
+void export_trail_filter_algorithm(py::module &m) {
+    py::class_<TrailFilterAlgorithm>(m, "TrailFilterAlgorithm", pybind_doc_core["Metavision::TrailFilterAlgorithm"])
+        .def(py::init<int, int, std::uint32_t>(), py::arg("width"), py::arg("height"), py::arg("threshold"),
+             pybind_doc_core["Metavision::TrailFilterAlgorithm::TrailFilterAlgorithm"])
+        .def("process_events", &process_events_array_sync<TrailFilterAlgorithm, EventCD>, py::arg("input_np"),
+             py::arg("output_buf"), doc_process_events_array_sync_str)
+        .def("process_events", &process_events_buffer_sync<TrailFilterAlgorithm, EventCD>, py::arg("input_buf"),
+             py::arg("output_buf"), doc_process_events_buffer_sync_str)
+        .def("process_events_", &process_events_buffer_sync_inplace<TrailFilterAlgorithm, EventCD>,
+             py::arg("events_buf"), doc_process_events_buffer_sync_inplace_str)
+        .def_static("get_empty_output_buffer", &getEmptyPODBuffer<EventCD>, doc_get_empty_output_buffer_str)
+        .def_property("threshold", &TrailFilterAlgorithm::get_threshold, &TrailFilterAlgorithm::set_threshold,
+                      pybind_doc_core["Metavision::TrailFilterAlgorithm::get_threshold"])
+        .def("reset", &TrailFilterAlgorithm::reset, pybind_doc_core["Metavision::TrailFilterAlgorithm::reset"]);
+}
+
+} // namespace Metavision
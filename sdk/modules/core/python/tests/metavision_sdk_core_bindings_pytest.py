@@ -248,6 +248,66 @@ def pytestcase_PolarityInverterAlgorithm():
     assert events["p"].tolist() == [0, 1, 1, 0, 0]
 
 
+def pytestcase_NoiseFilterAlgorithms():
+    # Two bursts of events at the same pixel, then an isolated event
+    events = np.zeros(5, dtype=metavision_sdk_base.EventCD)
+    events["x"] = 3
+    events["y"] = 4
+    events["p"] = [1, 1, 1, 0, 0]
+    events["t"] = [100, 150, 200, 250, 2000]
+
+    trail_filter = metavision_sdk_core.TrailFilterAlgorithm(width=10, height=10, threshold=100)
+    assert trail_filter.threshold == 100
+    events_buf = trail_filter.get_empty_output_buffer()
+    trail_filter.process_events(events, events_buf)
+    assert events_buf.numpy()["t"].tolist() == [100, 250, 2000]
+
+    activity_filter = metavision_sdk_core.ActivityNoiseFilterAlgorithm(width=10, height=10, threshold=100)
+    events_buf = activity_filter.get_empty_output_buffer()
+    activity_filter.process_events(events, events_buf)
+    assert events_buf.numpy()["t"].tolist() == [150]
+
+
+def pytestcase_EventToTensorAlgorithms():
+    events = np.zeros(4, dtype=metavision_sdk_base.EventCD)
+    events["x"] = [1, 1, 2, 2]
+    events["y"] = [3, 3, 4, 4]
+    events["p"] = [1, 1, 0, 1]
+    events["t"] = [100, 150, 200, 350]
+
+    # The tensors are written in place, as float32 or float16, for one slice (CHW) or several ones (TCHW)
+    histogram = metavision_sdk_core.HistogramTensorAlgorithm(width=5, height=6)
+    assert histogram.num_channels == 2
+    tensor = np.full((2, 6, 5), -1, dtype=np.float32)
+    histogram.generate(events, start_ts=100, slice_duration=200, tensor=tensor)
+    assert tensor[1, 3, 1] == 2
+    assert tensor[0, 4, 2] == 1
+    assert tensor.sum() == 3
+    tensors = np.zeros((2, 2, 6, 5), dtype=np.float16)
+    histogram.generate(events, start_ts=100, slice_duration=200, tensor=tensors)
+    assert tensors[0].sum() == 3
+    assert tensors[1, 1, 4, 2] == 1
+
+    difference = metavision_sdk_core.DifferenceTensorAlgorithm(width=5, height=6, max_count=2)
+    tensor = np.zeros((1, 6, 5), dtype=np.float32)
+    difference.generate(events, start_ts=100, slice_duration=200, tensor=tensor)
+    assert tensor[0, 3, 1] == 1
+    assert tensor[0, 4, 2] == -0.5
+
+    voxel_grid = metavision_sdk_core.VoxelGridTensorAlgorithm(width=5, height=6, n_bins=4)
+    voxel_grid.max_threads = 2
+    tensor = np.zeros((4, 6, 5), dtype=np.float32)
+    voxel_grid.generate(events, start_ts=100, slice_duration=400, tensor=tensor)
+    assert np.allclose(tensor.sum(axis=0)[3, 1], 2)
+    assert np.allclose(tensor.sum(axis=0)[4, 2], 0)
+
+    timestamps = metavision_sdk_core.TimestampTensorAlgorithm(width=5, height=6)
+    tensor = np.zeros((2, 6, 5), dtype=np.float32)
+    timestamps.generate(events, start_ts=100, slice_duration=100, tensor=tensor)
+    assert np.isclose(tensor[1, 3, 1], 0.51)
+    assert tensor[0, 4, 2] == 0
+
+
 def pytestcase_TimeSurfaceProducerAlgoritm():
     events = np.zeros(5, dtype=metavision_sdk_base.EventCD)
     events["x"] = [1, 2, 3, 2, 1]
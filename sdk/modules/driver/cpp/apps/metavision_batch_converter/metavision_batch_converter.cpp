@@ -0,0 +1,126 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+// This application demonstrates how to use Metavision SDK Driver batch converter to convert many RAW files to DAT,
+// CSV or video files in a single process.
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <boost/program_options.hpp>
+#include <metavision/sdk/base/utils/log.h>
+#include <metavision/sdk/driver/batch_converter.h>
+
+namespace po = boost::program_options;
+
+int main(int argc, char *argv[]) {
+    std::vector<std::string> in_raw_file_paths;
+    std::string in_file_list_path;
+    std::string format;
+    size_t num_workers;
+    size_t max_memory_mb;
+    Metavision::BatchConversionRecipe recipe;
+
+    const std::string program_desc(
+        "Application to convert many RAW files to DAT, CSV or video files, using a fixed number of worker threads.\n");
+
+    po::options_description options_desc("Options");
+    // clang-format off
+    options_desc.add_options()
+        ("help,h", "Produce help message.")
+        ("input-raw-files,i",    po::value<std::vector<std::string>>(&in_raw_file_paths)->multitoken(), "Paths to input RAW files.")
+        ("input-file-list,l",    po::value<std::string>(&in_file_list_path), "Path to a text file listing the input RAW files, one per line.")
+        ("format,f",             po::value<std::string>(&format)->default_value("dat"), "Output format: dat, csv or video.")
+        ("output-dir,o",         po::value<std::string>(&recipe.output_dir), "Directory where the output files are written. If not provided, they are written next to the input files.")
+        ("workers,w",            po::value<size_t>(&num_workers)->default_value(0), "Number of files converted concurrently. If 0, the number of hardware threads is used.")
+        ("max-memory,m",         po::value<size_t>(&max_memory_mb)->default_value(0), "Approximate maximum memory (in MB) of the buffers used to read the RAW files. If 0, no limit is applied.")
+        ("accumulation-time,a",  po::value<uint32_t>(&recipe.accumulation_time_us)->default_value(10000), "Accumulation time (in us) of the video frames.")
+        ("slow-motion-factor,s", po::value<double>(&recipe.slow_motion_factor)->default_value(1.), "Slow motion factor (or fast for value lower than 1) to apply to generate the videos.")
+        ("fourcc",               po::value<std::string>(&recipe.fourcc)->default_value("MJPG"), "Fourcc 4-character code of codec used to compress the video frames.")
+    ;
+    // clang-format on
+
+    po::variables_map vm;
+    po::store(po::command_line_parser(argc, argv).options(options_desc).run(), vm);
+    if (vm.count("help")) {
+        MV_LOG_INFO() << program_desc;
+        MV_LOG_INFO() << options_desc;
+        return 0;
+    }
+
+    try {
+        po::notify(vm);
+    } catch (po::error &e) {
+        MV_LOG_ERROR() << program_desc;
+        MV_LOG_ERROR() << options_desc;
+        MV_LOG_ERROR() << "Parsing error:" << e.what();
+        return 1;
+    }
+
+    if (format == "dat") {
+        recipe.format = Metavision::BatchConversionFormat::DAT;
+    } else if (format == "csv") {
+        recipe.format = Metavision::BatchConversionFormat::CSV;
+    } else if (format == "video") {
+        recipe.format = Metavision::BatchConversionFormat::Video;
+    } else {
+        MV_LOG_ERROR() << "Unknown output format" << format;
+        return 1;
+    }
+
+    if (!in_file_list_path.empty()) {
+        std::ifstream ifs(in_file_list_path);
+        if (!ifs.is_open()) {
+            MV_LOG_ERROR() << "Unable to read" << in_file_list_path;
+            return 1;
+        }
+        for (std::string line; std::getline(ifs, line);) {
+            if (!line.empty()) {
+                in_raw_file_paths.push_back(line);
+            }
+        }
+    }
+
+    if (in_raw_file_paths.empty()) {
+        MV_LOG_ERROR() << program_desc;
+        MV_LOG_ERROR() << options_desc;
+        MV_LOG_ERROR() << "No input RAW file provided.";
+        return 1;
+    }
+
+    Metavision::BatchConverter converter(num_workers, max_memory_mb * 1024 * 1024);
+    MV_LOG_INFO() << "Converting" << in_raw_file_paths.size() << "files with" << converter.get_num_workers()
+                  << "workers";
+
+    converter.set_progress_callback(
+        [](const std::string &input_file, const std::string &error, size_t n_processed, size_t n_files) {
+            if (error.empty()) {
+                MV_LOG_INFO() << Metavision::Log::no_space << "[" << n_processed << "/" << n_files << "] "
+                              << input_file;
+            } else {
+                MV_LOG_ERROR() << Metavision::Log::no_space << "[" << n_processed << "/" << n_files << "] "
+                               << input_file << ": " << error;
+            }
+        });
+
+    const auto report = converter.run(in_raw_file_paths, recipe);
+
+    MV_LOG_INFO() << "Converted" << report.converted_files << "files in" << report.duration_us / 1e6 << "s:"
+                  << report.get_bytes_rate() / (1024 * 1024) << "MB/s," << report.get_events_rate() / 1e6
+                  << "Mev/s";
+    if (!report.failed_files.empty()) {
+        MV_LOG_ERROR() << report.failed_files.size() << "files could not be converted";
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,90 @@
+#!/usr/bin/env python
+
+# Copyright (c) Prophesee S.A.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+# Unless required by applicable law or agreed to in writing, software distributed under the License is distributed
+# on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and limitations under the License.
+
+import pytest
+import os
+from metavision_utils import os_tools, pytest_tools
+
+
+def pytestcase_test_metavision_batch_converter_show_help():
+    """
+    Checks output of metavision_batch_converter when displaying help message
+    """
+
+    cmd = "./metavision_batch_converter --help"
+    output, error_code = pytest_tools.run_cmd_setting_mv_log_file(cmd)
+
+    # Check app exited without error
+    assert error_code == 0, "******\nError while executing cmd '{}':{}\n******".format(cmd, output)
+
+    # Check that the options showed in the output
+    assert "Options:" in output, "******\nMissing options display in output :{}\n******".format(output)
+
+
+def pytestcase_test_metavision_batch_converter_missing_input_args():
+    """
+    Checks that metavision_batch_converter returns an error when not passing any input file
+    """
+
+    cmd = "./metavision_batch_converter"
+    output, error_code = pytest_tools.run_cmd_setting_mv_log_file(cmd)
+
+    # Assert app returned error
+    assert error_code != 0
+    assert "No input RAW file provided" in output
+
+
+def pytestcase_test_metavision_batch_converter_non_existing_input_file():
+    """
+    Checks that metavision_batch_converter reports the files it could not convert
+    """
+
+    tmp_dir = os_tools.TemporaryDirectoryHandler()
+    input_rawfile = os.path.join(tmp_dir.temporary_directory(), "nonexistent.raw")
+
+    cmd = "./metavision_batch_converter -i {}".format(input_rawfile)
+    output, error_code = pytest_tools.run_cmd_setting_mv_log_file(cmd)
+
+    # Assert app returned error
+    assert error_code != 0
+    assert "1 files could not be converted" in output
+
+
+def pytestcase_test_metavision_batch_converter_to_dat(dataset_dir):
+    """
+    Checks that metavision_batch_converter converts several files to DAT in a single run
+    """
+
+    filename_full = os.path.join(dataset_dir, "openeb", "gen31_timer.raw")
+    assert os.path.exists(filename_full)
+
+    tmp_dir = os_tools.TemporaryDirectoryHandler()
+    output_dir = os.path.join(tmp_dir.temporary_directory(), "out")
+    input_files = []
+    for i in range(3):
+        input_file = os.path.join(tmp_dir.temporary_directory(), "file_{}.raw".format(i))
+        os.symlink(filename_full, input_file)
+        input_files.append(input_file)
+
+    cmd = "./metavision_batch_converter -w 2 -o {} -i {}".format(output_dir, " ".join(input_files))
+    output, error_code = pytest_tools.run_cmd_setting_mv_log_file(cmd)
+
+    # Check app exited without error
+    assert error_code == 0, "******\nError while executing cmd '{}':{}\n******".format(cmd, output)
+    assert "Converted 3 files" in output
+
+    # All the outputs have the same content
+    sizes = set()
+    for i in range(3):
+        output_file = os.path.join(output_dir, "file_{}_cd.dat".format(i))
+        assert os.path.exists(output_file)
+        sizes.add(os.path.getsize(output_file))
+    assert len(sizes) == 1
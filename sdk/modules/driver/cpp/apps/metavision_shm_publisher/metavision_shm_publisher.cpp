@@ -0,0 +1,139 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+// This application demonstrates how to publish the RAW data of a camera or a RAW file in shared memory, so that other
+// processes can open the stream as if it were a camera, using the serial "shm://<name>".
+
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <functional>
+#include <string>
+#include <thread>
+#include <boost/program_options.hpp>
+#include <metavision/sdk/base/utils/log.h>
+#include <metavision/sdk/driver/camera.h>
+#include <metavision/hal/facilities/future/i_events_stream.h>
+#include <metavision/hal/facilities/i_events_stream.h>
+#include <metavision/hal/facilities/i_hw_identification.h>
+#include <metavision/hal/utils/hal_exception.h>
+#include <metavision/hal/utils/shm_ring.h>
+
+namespace po = boost::program_options;
+
+namespace {
+std::atomic<bool> signal_caught{false};
+
+void sig_handler(int s) {
+    MV_LOG_TRACE() << "Interrupt signal received." << std::endl;
+    signal_caught = true;
+}
+} // anonymous namespace
+
+int main(int argc, char *argv[]) {
+    std::string serial;
+    std::string in_raw_file_path;
+    std::string name;
+    uint32_t slot_count;
+    uint32_t slot_size_kb;
+
+    const std::string program_desc(
+        "Application to publish the RAW data of a camera or a RAW file in shared memory.\n\n"
+        "Other processes can open the published stream as a camera, using the serial \"shm://<name>\". "
+        "Readers that can not keep up skip the oldest data, the publisher is never slowed down by them.\n");
+
+    po::options_description options_desc("Options");
+    // clang-format off
+    options_desc.add_options()
+        ("help,h", "Produce help message.")
+        ("serial,s",         po::value<std::string>(&serial), "Serial ID of the camera to publish. If neither a serial nor an input file is provided, the first available camera is used.")
+        ("input-raw-file,i", po::value<std::string>(&in_raw_file_path), "Path to an input RAW file to publish, at its recording speed.")
+        ("name,n",           po::value<std::string>(&name)->required(), "Name of the shared memory ring.")
+        ("slots",            po::value<uint32_t>(&slot_count)->default_value(64), "Number of slots of the shared memory ring.")
+        ("slot-size",        po::value<uint32_t>(&slot_size_kb)->default_value(1024), "Size (in KB) of a slot of the shared memory ring.")
+    ;
+    // clang-format on
+
+    po::variables_map vm;
+    po::store(po::command_line_parser(argc, argv).options(options_desc).run(), vm);
+    if (vm.count("help")) {
+        MV_LOG_INFO() << program_desc;
+        MV_LOG_INFO() << options_desc;
+        return 0;
+    }
+
+    try {
+        po::notify(vm);
+    } catch (po::error &e) {
+        MV_LOG_ERROR() << program_desc;
+        MV_LOG_ERROR() << options_desc;
+        MV_LOG_ERROR() << "Parsing error:" << e.what();
+        return 1;
+    }
+
+    Metavision::Camera camera;
+    try {
+        if (!in_raw_file_path.empty()) {
+            camera = Metavision::Camera::from_file(in_raw_file_path);
+        } else if (!serial.empty()) {
+            camera = Metavision::Camera::from_serial(serial);
+        } else {
+            camera = Metavision::Camera::from_first_available();
+        }
+    } catch (Metavision::CameraException &e) {
+        MV_LOG_ERROR() << e.what();
+        return 2;
+    }
+
+    // The readers decode the stream with the same RAW header as the one of a recording of this camera
+    auto *hw_identification = camera.get_device().get_facility<Metavision::I_HW_Identification>();
+    const std::string raw_header = hw_identification ? hw_identification->get_header().to_string() : std::string();
+
+    std::unique_ptr<Metavision::ShmRingWriter> writer;
+    try {
+        writer = std::make_unique<Metavision::ShmRingWriter>(name, raw_header, slot_count, slot_size_kb * 1024);
+    } catch (Metavision::HalException &e) {
+        MV_LOG_ERROR() << e.what();
+        return 1;
+    }
+
+    // The whole buffers transferred by the device are published, rather than the chunks passed to the RAW data
+    // callbacks of the camera, so that each slot is filled as much as possible
+    std::function<void()> untap;
+    auto &device = camera.get_device();
+    if (auto *future_events_stream = device.get_facility<Metavision::Future::I_EventsStream>()) {
+        auto &data_transfer = future_events_stream->get_data_transfer();
+        const size_t cb_id  = writer->tap(data_transfer);
+        untap               = [&data_transfer, cb_id]() { data_transfer.remove_callback(cb_id); };
+    } else if (auto *events_stream = device.get_facility<Metavision::I_EventsStream>()) {
+        auto &data_transfer = events_stream->get_data_transfer();
+        const size_t cb_id  = writer->tap(data_transfer);
+        untap               = [&data_transfer, cb_id]() { data_transfer.remove_callback(cb_id); };
+    } else {
+        MV_LOG_ERROR() << "The device does not provide an events stream to publish.";
+        return 1;
+    }
+
+    signal(SIGINT, sig_handler);
+    camera.start();
+    MV_LOG_INFO() << "Publishing in shared memory ring" << std::string(Metavision::ShmRingSerialPrefix) + name
+                  << "(press Ctrl+C to stop)";
+
+    while (camera.is_running() && !signal_caught) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    camera.stop();
+    untap();
+
+    MV_LOG_INFO() << "Published" << writer->get_written_slots_count() << "slots";
+
+    return 0;
+}
@@ -0,0 +1,59 @@
+#!/usr/bin/env python
+
+# Copyright (c) Prophesee S.A.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+# Unless required by applicable law or agreed to in writing, software distributed under the License is distributed
+# on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and limitations under the License.
+
+import pytest
+import os
+from metavision_utils import pytest_tools
+
+
+def pytestcase_test_metavision_shm_publisher_show_help():
+    """
+    Checks output of metavision_shm_publisher when displaying help message
+    """
+
+    cmd = "./metavision_shm_publisher --help"
+    output, error_code = pytest_tools.run_cmd_setting_mv_log_file(cmd)
+
+    # Check app exited without error
+    assert error_code == 0, "******\nError while executing cmd '{}':{}\n******".format(cmd, output)
+
+    # Check that the options showed in the output
+    assert "Options:" in output, "******\nMissing options display in output :{}\n******".format(output)
+
+
+def pytestcase_test_metavision_shm_publisher_missing_name():
+    """
+    Checks that metavision_shm_publisher returns an error when not passing the name of the ring
+    """
+
+    cmd = "./metavision_shm_publisher -i file.raw"
+    output, error_code = pytest_tools.run_cmd_setting_mv_log_file(cmd)
+
+    # Assert app returned error
+    assert error_code != 0
+    assert "Parsing error" in output
+
+
+def pytestcase_test_metavision_shm_publisher_from_file(dataset_dir):
+    """
+    Checks that metavision_shm_publisher publishes a whole RAW file
+    """
+
+    filename_full = os.path.join(dataset_dir, "openeb", "gen31_timer.raw")
+    assert os.path.exists(filename_full)
+
+    cmd = "./metavision_shm_publisher -n mv_pytest_shm_publisher_{} -i {}".format(os.getpid(), filename_full)
+    output, error_code = pytest_tools.run_cmd_setting_mv_log_file(cmd)
+
+    # Check app exited without error
+    assert error_code == 0, "******\nError while executing cmd '{}':{}\n******".format(cmd, output)
+    assert "Publishing in shared memory ring shm://mv_pytest_shm_publisher_" in output
+    assert "Published" in output
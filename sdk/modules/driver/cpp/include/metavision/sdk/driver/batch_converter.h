@@ -0,0 +1,141 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_DRIVER_BATCH_CONVERTER_H
+#define METAVISION_SDK_DRIVER_BATCH_CONVERTER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "metavision/sdk/base/utils/timestamp.h"
+
+namespace Metavision {
+
+/// @brief Output formats supported by @ref BatchConverter
+enum class BatchConversionFormat {
+    DAT,  ///< CD and external triggers events written in <name>_cd.dat and <name>_trigger.dat
+    CSV,  ///< CD events written in <name>_cd.csv, one "x,y,p,t" line per event
+    Video ///< Frames generated from the CD events written in <name>.avi
+};
+
+/// @brief Describes how the RAW files are converted by a @ref BatchConverter
+struct BatchConversionRecipe {
+    /// Output format
+    BatchConversionFormat format = BatchConversionFormat::DAT;
+
+    /// Directory where the output files are written. If empty, they are written next to the input files
+    std::string output_dir;
+
+    /// Accumulation time (in us) of the generated frames (Video only)
+    uint32_t accumulation_time_us = 10000;
+
+    /// Frame rate of the output video (Video only)
+    uint16_t fps = 30;
+
+    /// Frames are generated at fps x slow_motion_factor (Video only)
+    double slow_motion_factor = 1.;
+
+    /// Fourcc 4-character code of the codec used to compress the frames (Video only)
+    std::string fourcc = "MJPG";
+};
+
+/// @brief Aggregated statistics of a call to @ref BatchConverter::run
+struct BatchConversionReport {
+    /// Number of files successfully converted
+    size_t converted_files{0};
+
+    /// Input files that could not be converted, along with the reason of the failure
+    std::vector<std::pair<std::string, std::string>> failed_files;
+
+    /// Total size of the converted RAW files
+    uint64_t input_bytes{0};
+
+    /// Total number of events decoded from the converted RAW files
+    uint64_t events{0};
+
+    /// Wall clock duration of the whole batch
+    timestamp duration_us{0};
+
+    /// @brief Gets the average number of input bytes processed per second
+    double get_bytes_rate() const {
+        return duration_us > 0 ? input_bytes * 1e6 / duration_us : 0.;
+    }
+
+    /// @brief Gets the average number of events processed per second
+    double get_events_rate() const {
+        return duration_us > 0 ? events * 1e6 / duration_us : 0.;
+    }
+};
+
+/// @brief Converts many RAW files concurrently on a fixed-size pool of worker threads
+///
+/// The worker threads are created once and reused for every file and every call to @ref run, as are their conversion
+/// buffers: the text buffer of the CSV conversions, and the time surface and frame of the video conversions as long as
+/// the geometry does not change. The RAW read buffers belong to the device opened for each file, and are thus
+/// allocated again for every file. The plugins needed to read the files are loaded only once for the whole process.
+class BatchConverter {
+public:
+    /// @brief Callback called each time a file has been processed
+    ///
+    /// Calls are serialized, but they happen in the worker threads. The callback may call the functions of the
+    /// converter, except @ref run, and only holds up the workers reporting progress at the same time.
+    /// @param input_file Path of the RAW file that has been processed
+    /// @param error Empty if the conversion succeeded, reason of the failure otherwise
+    /// @param n_processed Number of files processed so far in the current batch
+    /// @param n_files Number of files in the current batch
+    using ProgressCallback = std::function<void(const std::string &input_file, const std::string &error,
+                                                size_t n_processed, size_t n_files)>;
+
+    /// @brief Constructor
+    /// @param num_workers Number of files converted concurrently. If 0, the number of hardware threads is used
+    /// @param max_memory_bytes Approximate maximum amount of memory used by the read buffers of all the workers. The
+    /// size of the read buffers is reduced to fit, and so is the number of workers if it is not enough. If 0, the
+    /// default read buffers are used. The cap only covers the read buffers: the frames of a video conversion and the
+    /// 1 MB text buffer of a CSV conversion come on top of it, for each worker
+    BatchConverter(size_t num_workers = 0, size_t max_memory_bytes = 0);
+
+    /// @brief Destructor, stops the worker threads
+    ~BatchConverter();
+
+    /// @brief Gets the number of worker threads actually used
+    size_t get_num_workers() const;
+
+    /// @brief Sets the callback called each time a file has been processed
+    void set_progress_callback(const ProgressCallback &cb);
+
+    /// @brief Converts the input RAW files according to the recipe
+    ///
+    /// This function blocks until all the files have been processed. A file that can not be converted is reported
+    /// in @ref BatchConversionReport::failed_files and does not stop the batch. Concurrent calls are processed one
+    /// after the other.
+    /// @param input_files Paths of the RAW files to convert
+    /// @param recipe Conversion to apply to every file
+    /// @return Aggregated statistics of the batch
+    BatchConversionReport run(const std::vector<std::string> &input_files, const BatchConversionRecipe &recipe);
+
+    /// @brief Gets the path of the main output file produced for an input file
+    /// @param input_file Path of the RAW file to convert
+    /// @param recipe Conversion to apply
+    static std::string get_output_path(const std::string &input_file, const BatchConversionRecipe &recipe);
+
+private:
+    struct Private;
+    std::unique_ptr<Private> pimpl_;
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_DRIVER_BATCH_CONVERTER_H
@@ -112,6 +112,42 @@ struct CameraConfiguration {
     std::string serial_number = "";
 };
 
+/// @brief Struct with live runtime counters of the camera, see @ref Camera::get_stats
+///
+/// Rates and times are computed over the period elapsed since the previous call to @ref Camera::get_stats (or since
+/// the camera was built for the first call).
+struct CameraStats {
+    /// @brief Duration of the measurement period, in microseconds
+    timestamp period_us = 0;
+
+    /// @brief Number of RAW bytes processed per second
+    double raw_bytes_rate = 0.;
+
+    /// @brief Number of CD events decoded per second
+    double cd_events_rate = 0.;
+
+    /// @brief Number of external trigger events decoded per second
+    double ext_trigger_events_rate = 0.;
+
+    /// @brief Average decoding time per decoded event in nanoseconds, time spent in the events callbacks excluded
+    double decode_time_per_event_ns = 0.;
+
+    /// @brief Time spent in each registered CD, external trigger and RAW data callback, in microseconds
+    std::map<CallbackId, double> callbacks_time_us;
+
+    /// @brief Number of buffers transferred by the device and waiting to be processed
+    size_t buffers_in_flight = 0;
+
+    /// @brief Total number of buffers dropped by the device data transfer
+    uint64_t dropped_buffers = 0;
+
+    /// @brief Delay between the last decoded timestamp and the system clock, in microseconds
+    ///
+    /// The delay is measured relatively to the first decoded event and is 0 when the events are processed faster than
+    /// real time. It is only available when at least one event callback is registered.
+    timestamp realtime_lag_us = 0;
+};
+
 /// @brief Main class for the camera interface
 class Camera {
 public:
@@ -365,6 +401,15 @@ public:
     /// @warning If no event decoding callback has been set, this functions returns -1
     timestamp get_last_timestamp() const;
 
+    /// @brief Gets the runtime counters of the camera
+    ///
+    /// The counters are always collected while the camera is running, and are cheap enough to be polled periodically
+    /// (e.g. once per second) from any thread.
+    ///
+    /// @throw CameraException if the camera has not been initialized.
+    /// @return @ref CameraStats measured since the previous call to this function
+    CameraStats get_stats();
+
     /// @brief Gets corresponding @ref Device in HAL library
     ///
     /// This Device retrieved can then be used to call the different facilities of the camera.
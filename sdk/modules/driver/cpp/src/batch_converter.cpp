@@ -0,0 +1,418 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <boost/filesystem.hpp>
+#include <opencv2/core.hpp>
+#include <opencv2/videoio.hpp>
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/base/events/event_ext_trigger.h"
+#include "metavision/sdk/core/algorithms/periodic_frame_generation_algorithm.h"
+#include "metavision/sdk/core/algorithms/stream_logger_algorithm.h"
+#include "metavision/sdk/core/utils/video_writer.h"
+#include "metavision/sdk/driver/batch_converter.h"
+#include "metavision/sdk/driver/camera.h"
+
+namespace Metavision {
+
+namespace {
+
+// FileDataTransfer allocates at least this number of read buffers per file
+constexpr size_t read_buffers_per_file = 4;
+// Largest RAW event size among the supported formats (EVT 2.0)
+constexpr size_t max_raw_event_size_bytes = 4;
+// Bounds of the number of RAW events read at once, the upper bound being the default value of RawFileConfig
+constexpr size_t min_events_to_read = 10000;
+constexpr size_t max_events_to_read = 1000000;
+// Size of the text written at once in CSV files
+constexpr size_t csv_flush_size_bytes = 1 << 20;
+
+void append_number(std::string &str, int64_t value) {
+    char buf[24];
+    char *const end = buf + sizeof(buf);
+    char *p         = end;
+    uint64_t u      = value < 0 ? 0 - static_cast<uint64_t>(value) : static_cast<uint64_t>(value);
+    do {
+        *--p = static_cast<char>('0' + u % 10);
+        u /= 10;
+    } while (u != 0);
+    if (value < 0) {
+        *--p = '-';
+    }
+    str.append(p, end);
+}
+
+std::string get_output_base(const std::string &input_file, const BatchConversionRecipe &recipe) {
+    const boost::filesystem::path input_path(input_file);
+    const boost::filesystem::path output_dir =
+        recipe.output_dir.empty() ? input_path.parent_path() : boost::filesystem::path(recipe.output_dir);
+    return (output_dir / input_path.stem()).string();
+}
+
+// Buffers owned by a worker, reused from one file to the next
+struct WorkerBuffers {
+    // Text written at once in CSV files
+    std::string csv_text;
+
+    // Frame generation of the videos, whose time surface and frame are reused while the geometry does not change
+    std::unique_ptr<PeriodicFrameGenerationAlgorithm> frame_generation;
+
+    PeriodicFrameGenerationAlgorithm &get_frame_generation(int width, int height) {
+        if (frame_generation) {
+            uint32_t generation_height, generation_width, channels;
+            frame_generation->get_dimension(generation_height, generation_width, channels);
+            if (static_cast<int>(generation_width) != width || static_cast<int>(generation_height) != height) {
+                frame_generation.reset();
+            } else {
+                // Clears the time surface left by the previous file, without writing the frame generated on reset
+                frame_generation->set_output_callback([](timestamp, cv::Mat &) {});
+                frame_generation->reset();
+            }
+        }
+        if (!frame_generation) {
+            frame_generation = std::make_unique<PeriodicFrameGenerationAlgorithm>(width, height);
+        }
+        return *frame_generation;
+    }
+};
+
+struct FileStats {
+    uint64_t bytes{0};
+    uint64_t events{0};
+};
+
+} // namespace
+
+struct BatchConverter::Private {
+    Private(size_t num_workers, size_t max_memory_bytes) {
+        if (num_workers == 0) {
+            num_workers = std::max(1u, std::thread::hardware_concurrency());
+        }
+
+        n_events_to_read_ = max_events_to_read;
+        if (max_memory_bytes != 0) {
+            // Reduces the number of workers only if the smallest read buffers do not fit
+            const size_t bytes_per_event_read = read_buffers_per_file * max_raw_event_size_bytes;
+            const size_t max_num_workers      = max_memory_bytes / (min_events_to_read * bytes_per_event_read);
+            num_workers                       = std::max<size_t>(1, std::min(num_workers, max_num_workers));
+
+            n_events_to_read_ = max_memory_bytes / num_workers / bytes_per_event_read;
+            n_events_to_read_ = std::max(min_events_to_read, std::min(max_events_to_read, n_events_to_read_));
+        }
+
+        for (size_t i = 0; i < num_workers; ++i) {
+            workers_.emplace_back([this] { worker_loop(); });
+        }
+    }
+
+    ~Private() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        jobs_cond_.notify_all();
+        for (auto &worker : workers_) {
+            worker.join();
+        }
+    }
+
+    BatchConversionReport run(const std::vector<std::string> &input_files, const BatchConversionRecipe &recipe) {
+        std::lock_guard<std::mutex> run_lock(run_mutex_);
+
+        const auto start = std::chrono::steady_clock::now();
+        if (!recipe.output_dir.empty()) {
+            boost::filesystem::create_directories(recipe.output_dir);
+        }
+
+        {
+            std::lock_guard<std::mutex> progress_lock(progress_mutex_);
+            n_processed_ = 0;
+        }
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        report_     = BatchConversionReport();
+        recipe_     = recipe;
+        n_files_    = input_files.size();
+        n_reported_ = 0;
+        pending_files_.assign(input_files.begin(), input_files.end());
+        jobs_cond_.notify_all();
+        done_cond_.wait(lock, [this] { return n_reported_ == n_files_; });
+
+        report_.duration_us =
+            std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+        return report_;
+    }
+
+    void worker_loop() {
+        WorkerBuffers buffers;
+        while (true) {
+            std::string input_file;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                jobs_cond_.wait(lock, [this] { return stop_ || !pending_files_.empty(); });
+                if (stop_) {
+                    return;
+                }
+                input_file = std::move(pending_files_.front());
+                pending_files_.pop_front();
+            }
+
+            FileStats stats;
+            std::string error;
+            try {
+                convert(input_file, buffers, stats);
+            } catch (const std::exception &e) {
+                error = e.what();
+            }
+
+            ProgressCallback progress_cb;
+            size_t n_files;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (error.empty()) {
+                    ++report_.converted_files;
+                    report_.input_bytes += stats.bytes;
+                    report_.events += stats.events;
+                } else {
+                    report_.failed_files.emplace_back(input_file, error);
+                }
+                n_files     = n_files_;
+                progress_cb = progress_cb_;
+            }
+
+            // The callback is called without holding the state lock, so that it can call the converter back and
+            // does not hold up the workers still converting
+            {
+                std::lock_guard<std::mutex> progress_lock(progress_mutex_);
+                ++n_processed_;
+                if (progress_cb) {
+                    progress_cb(input_file, error, n_processed_, n_files);
+                }
+            }
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (++n_reported_ == n_files_) {
+                done_cond_.notify_all();
+            }
+        }
+    }
+
+    void convert(const std::string &input_file, WorkerBuffers &buffers, FileStats &stats) {
+        // recipe_ is only modified by run when no file is pending, it is safe to read it while converting
+        const BatchConversionRecipe &recipe = recipe_;
+
+        Future::RawFileConfig file_config;
+        file_config.n_events_to_read_ = static_cast<uint32_t>(n_events_to_read_);
+        file_config.build_index_      = false;
+        Camera camera                 = Camera::from_file(input_file, false, file_config);
+        stats.bytes                   = boost::filesystem::file_size(input_file);
+
+        const int width          = camera.geometry().width();
+        const int height         = camera.geometry().height();
+        const std::string output = get_output_base(input_file, recipe);
+
+        std::mutex stopped_mutex;
+        std::condition_variable stopped_cond;
+        bool stopped = false;
+        std::function<void()> on_stopped;
+        camera.add_status_change_callback([&](const CameraStatus &status) {
+            if (status == CameraStatus::STOPPED) {
+                std::lock_guard<std::mutex> lock(stopped_mutex);
+                if (stopped) {
+                    return;
+                }
+                if (on_stopped) {
+                    on_stopped();
+                }
+                stopped = true;
+                stopped_cond.notify_all();
+            }
+        });
+
+        // Objects used by the callbacks, they must outlive the camera streaming
+        std::unique_ptr<StreamLoggerAlgorithm> cd_logger, trigger_logger;
+        std::ofstream csv_ofs;
+        std::unique_ptr<VideoWriter> video_writer;
+
+        switch (recipe.format) {
+        case BatchConversionFormat::DAT: {
+            cd_logger = std::make_unique<StreamLoggerAlgorithm>(output + "_cd.dat", width, height);
+            cd_logger->enable(true);
+            camera.cd().add_callback([&](const EventCD *begin, const EventCD *end) {
+                stats.events += std::distance(begin, end);
+                if (begin != end) {
+                    cd_logger->process_events(begin, end, std::prev(end)->t);
+                }
+            });
+            try {
+                camera.ext_trigger().add_callback([&](const EventExtTrigger *begin, const EventExtTrigger *end) {
+                    stats.events += std::distance(begin, end);
+                    if (begin == end) {
+                        return;
+                    }
+                    // The file is only created if the recording contains external triggers
+                    if (!trigger_logger) {
+                        trigger_logger =
+                            std::make_unique<StreamLoggerAlgorithm>(output + "_trigger.dat", width, height);
+                        trigger_logger->enable(true);
+                    }
+                    trigger_logger->process_events(begin, end, std::prev(end)->t);
+                });
+            } catch (CameraException &) {
+                // no external triggers available in this recording
+            }
+            break;
+        }
+        case BatchConversionFormat::CSV: {
+            const std::string csv_path = output + "_cd.csv";
+            csv_ofs.open(csv_path);
+            if (!csv_ofs.is_open()) {
+                throw std::runtime_error("Unable to write in " + csv_path);
+            }
+            buffers.csv_text.clear();
+            buffers.csv_text.reserve(csv_flush_size_bytes + 64);
+            camera.cd().add_callback([&](const EventCD *begin, const EventCD *end) {
+                stats.events += std::distance(begin, end);
+                std::string &text = buffers.csv_text;
+                for (auto it = begin; it != end; ++it) {
+                    append_number(text, it->x);
+                    text += ',';
+                    append_number(text, it->y);
+                    text += ',';
+                    append_number(text, it->p);
+                    text += ',';
+                    append_number(text, it->t);
+                    text += '\n';
+                    if (text.size() >= csv_flush_size_bytes) {
+                        csv_ofs.write(text.data(), text.size());
+                        text.clear();
+                    }
+                }
+            });
+            on_stopped = [&] {
+                csv_ofs.write(buffers.csv_text.data(), buffers.csv_text.size());
+                buffers.csv_text.clear();
+            };
+            break;
+        }
+        case BatchConversionFormat::Video: {
+            if (recipe.fourcc.size() != 4) {
+                throw std::invalid_argument("Invalid fourcc code '" + recipe.fourcc + "'");
+            }
+            if (recipe.slow_motion_factor <= 0) {
+                throw std::invalid_argument("Slow motion factor must be greater than 0");
+            }
+            const std::string video_path = output + ".avi";
+            const int fourcc =
+                cv::VideoWriter::fourcc(recipe.fourcc[0], recipe.fourcc[1], recipe.fourcc[2], recipe.fourcc[3]);
+            video_writer =
+                std::make_unique<VideoWriter>(video_path, fourcc, recipe.fps, cv::Size(width, height), true);
+            if (!video_writer->isOpened()) {
+                throw std::runtime_error("Unable to write in " + video_path);
+            }
+            PeriodicFrameGenerationAlgorithm &frame_generation = buffers.get_frame_generation(width, height);
+            frame_generation.set_accumulation_time_us(recipe.accumulation_time_us);
+            frame_generation.set_fps(recipe.slow_motion_factor * recipe.fps);
+            frame_generation.set_incremental_update(true);
+            // Frames are encoded in the camera thread: the parallelism comes from the worker pool
+            frame_generation.set_output_callback([&](timestamp, cv::Mat &frame) { video_writer->write(frame); });
+            camera.cd().add_callback([&](const EventCD *begin, const EventCD *end) {
+                stats.events += std::distance(begin, end);
+                buffers.frame_generation->process_events(begin, end);
+            });
+            on_stopped = [&] {
+                buffers.frame_generation->force_generate();
+                video_writer->release();
+            };
+            break;
+        }
+        }
+
+        camera.start();
+        {
+            std::unique_lock<std::mutex> lock(stopped_mutex);
+            stopped_cond.wait(lock, [&] { return stopped; });
+        }
+        camera.stop();
+
+        if (cd_logger) {
+            cd_logger->enable(false);
+        }
+        if (trigger_logger) {
+            trigger_logger->enable(false);
+        }
+        if (csv_ofs.is_open()) {
+            csv_ofs.close();
+            if (csv_ofs.fail()) {
+                throw std::runtime_error("Failed to write " + output + "_cd.csv");
+            }
+        }
+    }
+
+    std::vector<std::thread> workers_;
+    size_t n_events_to_read_;
+
+    std::mutex run_mutex_; // serializes the batches
+
+    std::mutex progress_mutex_; // serializes the calls to the progress callback, protects the count below
+    size_t n_processed_{0};
+
+    std::mutex mutex_; // protects everything below
+    std::condition_variable jobs_cond_, done_cond_;
+    bool stop_{false};
+    std::deque<std::string> pending_files_;
+    BatchConversionRecipe recipe_;
+    BatchConversionReport report_;
+    size_t n_files_{0}, n_reported_{0};
+    ProgressCallback progress_cb_;
+};
+
+BatchConverter::BatchConverter(size_t num_workers, size_t max_memory_bytes) :
+    pimpl_(new Private(num_workers, max_memory_bytes)) {}
+
+BatchConverter::~BatchConverter() {}
+
+size_t BatchConverter::get_num_workers() const {
+    return pimpl_->workers_.size();
+}
+
+void BatchConverter::set_progress_callback(const ProgressCallback &cb) {
+    std::lock_guard<std::mutex> lock(pimpl_->mutex_);
+    pimpl_->progress_cb_ = cb;
+}
+
+BatchConversionReport BatchConverter::run(const std::vector<std::string> &input_files,
+                                          const BatchConversionRecipe &recipe) {
+    return pimpl_->run(input_files, recipe);
+}
+
+std::string BatchConverter::get_output_path(const std::string &input_file, const BatchConversionRecipe &recipe) {
+    const std::string output = get_output_base(input_file, recipe);
+    switch (recipe.format) {
+    case BatchConversionFormat::DAT:
+        return output + "_cd.dat";
+    case BatchConversionFormat::CSV:
+        return output + "_cd.csv";
+    case BatchConversionFormat::Video:
+        return output + ".avi";
+    }
+    return output;
+}
+
+} // namespace Metavision
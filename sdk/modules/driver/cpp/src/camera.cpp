@@ -59,6 +59,21 @@
 
 namespace Metavision {
 
+namespace {
+// Calls all the callbacks registered in a callback manager, accumulating the time spent in each of them
+template<typename CallbackManagerType, typename... Args>
+void call_timed_callbacks(const CallbackManagerType &cbs_manager, detail::CameraStatsCollector &stats_collector,
+                          const Args &...args) {
+    const auto &cbs = cbs_manager.get_cbs();
+    const auto &ids = cbs_manager.get_cb_ids();
+    for (size_t i = 0, i_end = std::min(cbs.size(), ids.size()); i < i_end; ++i) {
+        const auto t_start = detail::CameraStatsCollector::Clock::now();
+        cbs[i](args...);
+        stats_collector.add_callback_time(ids[i], detail::CameraStatsCollector::Clock::now() - t_start);
+    }
+}
+} // namespace
+
 // ********************
 // PIMPL
 Camera::Private::Private(bool empty_init) {
@@ -385,6 +400,21 @@ void Camera::Private::stop_recording() {
     is_recording_ = false;
 }
 
+CameraStats Camera::Private::get_stats() {
+    check_events_stream_instance();
+
+    CameraStats stats;
+    stats_collector_.get_stats(stats);
+    if (i_future_events_stream_) {
+        stats.buffers_in_flight = i_future_events_stream_->get_pending_buffers_count();
+        stats.dropped_buffers   = i_future_events_stream_->get_dropped_buffers_count();
+    } else {
+        stats.buffers_in_flight = i_events_stream_->get_pending_buffers_count();
+        stats.dropped_buffers   = i_events_stream_->get_dropped_buffers_count();
+    }
+    return stats;
+}
+
 Biases &Camera::Private::biases() {
     if (from_file_) {
         throw CameraException(UnsupportedFeatureErrors::BiasesUnavailable, "Cannot get biases from a file.");
@@ -591,9 +621,8 @@ void Camera::Private::init_callbacks() {
         throw CameraException(InternalInitializationErrors::ICDDecoderNotFound);
     }
     i_cd_events_decoder->add_event_buffer_callback([this](const EventCD *begin, const EventCD *end) {
-        for (auto &&cb : cd_->get_pimpl().get_cbs()) {
-            cb(begin, end);
-        }
+        stats_collector_.add_cd_events(std::distance(begin, end));
+        call_timed_callbacks(cd_->get_pimpl(), stats_collector_, begin, end);
     });
 
     // External triggers
@@ -603,9 +632,8 @@ void Camera::Private::init_callbacks() {
         ext_trigger_.reset(ExtTrigger::Private::build(index_manager_));
         i_ext_trigger_events_decoder->add_event_buffer_callback(
             [this](const EventExtTrigger *begin, const EventExtTrigger *end) {
-                for (auto &&cb : ext_trigger_->get_pimpl().get_cbs()) {
-                    cb(begin, end);
-                }
+                stats_collector_.add_ext_trigger_events(std::distance(begin, end));
+                call_timed_callbacks(ext_trigger_->get_pimpl(), stats_collector_, begin, end);
             });
     }
 }
@@ -694,6 +722,8 @@ int Camera::Private::run_main_loop(TimingProfilerType *profiler) {
 
                 // we first decode the buffer and call the corresponding events callback ...
                 if (has_decode_callbacks) {
+                    stats_collector_.begin_decode();
+                    const auto t_decode_start = detail::CameraStatsCollector::Clock::now();
                     if (i_future_decoder_) {
                         i_future_decoder_->decode(ev_buffer, ev_buffer + bytes_to_decode);
                         t.setNumProcessedElements(bytes_to_decode / i_future_decoder_->get_raw_event_size_bytes());
@@ -701,13 +731,13 @@ int Camera::Private::run_main_loop(TimingProfilerType *profiler) {
                         i_decoder_->decode(ev_buffer, ev_buffer + bytes_to_decode);
                         t.setNumProcessedElements(bytes_to_decode / i_decoder_->get_raw_event_size_bytes());
                     }
+                    stats_collector_.end_decode(detail::CameraStatsCollector::Clock::now() - t_decode_start);
                 }
+                stats_collector_.add_raw_bytes(bytes_to_decode);
 
                 // ... then we call the raw buffer callback so that a user has access to some info (e.g last
                 // decoded timestamp) when the raw callback is called
-                for (auto &cb : raw_data_->get_pimpl().get_cbs()) {
-                    cb(ev_buffer, bytes_to_decode);
-                }
+                call_timed_callbacks(raw_data_->get_pimpl(), stats_collector_, ev_buffer, bytes_to_decode);
 
                 // call the callbacks that could modify the events stream, and early stop the decoding loop if the
                 // stream has been modified. this can happen in some cases (e.g when we seek and the remaining data to
@@ -717,26 +747,29 @@ int Camera::Private::run_main_loop(TimingProfilerType *profiler) {
                 }
 
                 if (has_decode_callbacks) {
-                    // emulate real time if needed
-                    if (emulate_real_time_) {
-                        const timestamp cur_ts      = i_future_decoder_ ? i_future_decoder_->get_last_timestamp() :
-                                                                          i_decoder_->get_last_timestamp();
-                        const uint64_t cur_ts_clock = get_system_time_us();
-
-                        // compute the offset first, if never done
-                        if (first_ts_clock_ == 0 && cur_ts != first_ts_) {
-                            first_ts_clock_ = cur_ts_clock;
-                            first_ts_       = cur_ts;
-                        }
+                    const timestamp cur_ts      = i_future_decoder_ ? i_future_decoder_->get_last_timestamp() :
+                                                                      i_decoder_->get_last_timestamp();
+                    const uint64_t cur_ts_clock = get_system_time_us();
+
+                    // compute the offset first, if never done
+                    if (first_ts_clock_ == 0 && cur_ts != first_ts_) {
+                        first_ts_clock_ = cur_ts_clock;
+                        first_ts_       = cur_ts;
+                    }
 
+                    if (first_ts_clock_ != 0) {
                         const uint64_t expected_ts = first_ts_clock_ + (cur_ts - first_ts_);
+                        stats_collector_.set_realtime_lag(cur_ts_clock > expected_ts ? cur_ts_clock - expected_ts :
+                                                                                       0);
 
-                        if (cur_ts_clock < expected_ts) {
+                        // emulate real time if needed
+                        if (emulate_real_time_ && cur_ts_clock < expected_ts) {
                             std::this_thread::sleep_for(std::chrono::microseconds(expected_ts - cur_ts_clock));
                         }
                     }
                 }
             }
+            stats_collector_.flush();
         }
     }
 
@@ -1027,6 +1060,10 @@ Metavision::timestamp Camera::get_last_timestamp() const {
                                        pimpl_->i_decoder_->get_last_timestamp();
 }
 
+CameraStats Camera::get_stats() {
+    return pimpl_->get_stats();
+}
+
 Device &Camera::get_device() {
     return *pimpl_->device_;
 }
@@ -0,0 +1,73 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include "metavision/sdk/driver/camera.h"
+#include "metavision/sdk/driver/internal/camera_stats_internal.h"
+
+namespace Metavision {
+namespace detail {
+
+CameraStatsCollector::CameraStatsCollector() : last_read_time_(Clock::now()) {}
+
+void CameraStatsCollector::flush() {
+    if (local_callbacks_time_ns_.empty()) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(callbacks_time_mutex_);
+        for (auto &p : local_callbacks_time_ns_) {
+            callbacks_time_ns_[p.first] += p.second;
+        }
+    }
+    local_callbacks_time_ns_.clear();
+}
+
+void CameraStatsCollector::get_stats(CameraStats &stats) {
+    std::lock_guard<std::mutex> reader_lock(reader_mutex_);
+
+    const auto now          = Clock::now();
+    const timestamp elapsed = std::chrono::duration_cast<std::chrono::microseconds>(now - last_read_time_).count();
+    last_read_time_         = now;
+
+    const uint64_t raw_bytes          = raw_bytes_.load(std::memory_order_relaxed);
+    const uint64_t cd_events          = cd_events_.load(std::memory_order_relaxed);
+    const uint64_t ext_trigger_events = ext_trigger_events_.load(std::memory_order_relaxed);
+    const uint64_t decode_time_ns     = decode_time_ns_.load(std::memory_order_relaxed);
+
+    const uint64_t delta_events = (cd_events - last_cd_events_) + (ext_trigger_events - last_ext_trigger_events_);
+    const double to_rate        = elapsed > 0 ? 1e6 / elapsed : 0.;
+
+    stats.period_us                = elapsed;
+    stats.raw_bytes_rate           = (raw_bytes - last_raw_bytes_) * to_rate;
+    stats.cd_events_rate           = (cd_events - last_cd_events_) * to_rate;
+    stats.ext_trigger_events_rate  = (ext_trigger_events - last_ext_trigger_events_) * to_rate;
+    stats.decode_time_per_event_ns = delta_events > 0 ? double(decode_time_ns - last_decode_time_ns_) / delta_events : 0.;
+    stats.realtime_lag_us          = realtime_lag_us_.load(std::memory_order_relaxed);
+
+    last_raw_bytes_          = raw_bytes;
+    last_cd_events_          = cd_events;
+    last_ext_trigger_events_ = ext_trigger_events;
+    last_decode_time_ns_     = decode_time_ns;
+
+    std::map<CallbackId, uint64_t> callbacks_time_ns;
+    {
+        std::lock_guard<std::mutex> lock(callbacks_time_mutex_);
+        std::swap(callbacks_time_ns, callbacks_time_ns_);
+    }
+    stats.callbacks_time_us.clear();
+    for (auto &p : callbacks_time_ns) {
+        stats.callbacks_time_us[p.first] = p.second / 1000.;
+    }
+}
+
+} // namespace detail
+} // namespace Metavision
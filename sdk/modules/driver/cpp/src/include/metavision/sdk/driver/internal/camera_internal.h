@@ -25,6 +25,7 @@
 #include "metavision/hal/facilities/future/i_decoder.h"
 #include "metavision/hal/utils/future/raw_file_config.h"
 #include "metavision/sdk/driver/camera.h"
+#include "metavision/sdk/driver/internal/camera_stats_internal.h"
 #include "metavision/sdk/core/utils/index_manager.h"
 #include "metavision/sdk/core/utils/timing_profiler.h"
 
@@ -155,6 +156,8 @@ public:
     void start_recording(const std::string &rawfile_path);
     void stop_recording();
 
+    CameraStats get_stats();
+
     // Pimpl functions
     void init_online_interfaces(const detail::Config &cfg = detail::Config());
     void init_common_interfaces(const std::string &serial = std::string(),
@@ -189,6 +192,7 @@ public:
     uint64_t first_ts_clock_;
     bool print_timings_ = false;
     TimingProfilerPair<> timing_profiler_tuple_;
+    detail::CameraStatsCollector stats_collector_;
 
     std::unique_ptr<Device> device_    = nullptr;
     I_DeviceControl *i_device_control_ = nullptr;
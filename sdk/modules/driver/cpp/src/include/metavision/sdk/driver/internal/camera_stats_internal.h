@@ -0,0 +1,111 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_DRIVER_CAMERA_STATS_INTERNAL_H
+#define METAVISION_SDK_DRIVER_CAMERA_STATS_INTERNAL_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+
+#include "metavision/sdk/base/utils/callback_id.h"
+#include "metavision/sdk/base/utils/timestamp.h"
+
+namespace Metavision {
+
+struct CameraStats;
+
+namespace detail {
+
+/// @brief Collects the runtime counters exposed by @ref Camera::get_stats
+///
+/// All the add_* and set_* functions must be called from a single thread (the camera run thread). Scalar counters are
+/// published with relaxed atomic stores, so that the writer never takes a lock while decoding. Callbacks durations are
+/// accumulated locally and published once per processed buffer by @ref flush.
+class CameraStatsCollector {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    CameraStatsCollector();
+
+    void add_raw_bytes(uint64_t n) {
+        relaxed_add(raw_bytes_, n);
+    }
+
+    void add_cd_events(uint64_t n) {
+        relaxed_add(cd_events_, n);
+    }
+
+    void add_ext_trigger_events(uint64_t n) {
+        relaxed_add(ext_trigger_events_, n);
+    }
+
+    void add_callback_time(CallbackId id, Clock::duration d) {
+        const uint64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(d).count();
+        local_callbacks_time_ns_[id] += ns;
+        callbacks_time_in_decode_ns_ += ns;
+    }
+
+    /// @brief Must be called right before decoding a chunk of data
+    void begin_decode() {
+        callbacks_time_in_decode_ns_ = 0;
+    }
+
+    /// @brief Must be called right after decoding a chunk of data, with the total decoding duration
+    ///
+    /// The time spent in the callbacks called by the decoder is subtracted from @p d.
+    void end_decode(Clock::duration d) {
+        const uint64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(d).count();
+        relaxed_add(decode_time_ns_, ns > callbacks_time_in_decode_ns_ ? ns - callbacks_time_in_decode_ns_ : 0);
+    }
+
+    void set_realtime_lag(timestamp lag_us) {
+        realtime_lag_us_.store(lag_us, std::memory_order_relaxed);
+    }
+
+    /// @brief Publishes the callbacks durations accumulated since the last call
+    void flush();
+
+    /// @brief Computes the stats since the last call to this function
+    /// @param stats Stats to fill, buffers related fields are left untouched
+    void get_stats(CameraStats &stats);
+
+private:
+    template<typename T>
+    static void relaxed_add(std::atomic<T> &counter, T value) {
+        // single writer: avoid the cost of an atomic read-modify-write
+        counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+
+    std::atomic<uint64_t> raw_bytes_{0}, cd_events_{0}, ext_trigger_events_{0}, decode_time_ns_{0};
+    std::atomic<timestamp> realtime_lag_us_{0};
+
+    // owned by the writer thread
+    std::unordered_map<CallbackId, uint64_t> local_callbacks_time_ns_;
+    uint64_t callbacks_time_in_decode_ns_{0};
+
+    // shared between the writer and the reader
+    std::mutex callbacks_time_mutex_;
+    std::map<CallbackId, uint64_t> callbacks_time_ns_;
+
+    // owned by the reader
+    std::mutex reader_mutex_;
+    Clock::time_point last_read_time_;
+    uint64_t last_raw_bytes_{0}, last_cd_events_{0}, last_ext_trigger_events_{0}, last_decode_time_ns_{0};
+};
+
+} // namespace detail
+} // namespace Metavision
+
+#endif // METAVISION_SDK_DRIVER_CAMERA_STATS_INTERNAL_H
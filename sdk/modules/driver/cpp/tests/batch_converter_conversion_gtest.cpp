@@ -0,0 +1,152 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <boost/filesystem.hpp>
+#include <gtest/gtest.h>
+
+#include "metavision/hal/utils/raw_file_header.h"
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/driver/batch_converter.h"
+#include "metavision/utils/gtest/gtest_with_tmp_dir.h"
+#include "encoding_policies.h"
+#include "tencoder_gtest_common.h"
+
+using namespace Metavision;
+
+class BatchConverterConversion_GTest : public GTestWithTmpDir {
+protected:
+    virtual void SetUp() override {
+        expected_events_ = build_vector_of_events<Evt2RawFormat, EventCD>();
+        output_dir_      = tmpdir_handler_->get_full_path("output");
+    }
+
+    // Writes an EVT 2.0 RAW file with the expected events, and returns its path
+    std::string write_raw_file(const std::string &name) {
+        const std::string path = tmpdir_handler_->get_full_path(name);
+        std::ofstream ofs(path, std::ios::binary);
+
+        RawFileHeader header;
+        header.set_plugin_name("hal_plugin_gen31_fx3");
+        header.set_integrator_name("Prophesee");
+        // Prophesee header only. Duplicated what PropheseeRawHeader does to be able to encode then read test RAW
+        // file
+        header.set_field("system_ID", std::to_string(28));
+        ofs << header;
+
+        TEncoder<Evt2RawFormat, TimerHighRedundancyEvt2Default> encoder;
+        encoder.set_encode_event_callback([&](const uint8_t *data, const uint8_t *data_end) {
+            ofs.write(reinterpret_cast<const char *>(data), std::distance(data, data_end));
+        });
+        encoder.encode(expected_events_.cbegin(), expected_events_.cend());
+        encoder.flush();
+        return path;
+    }
+
+    // Reads the events of a CSV file written by the converter
+    static std::vector<EventCD> read_csv_file(const std::string &path) {
+        std::vector<EventCD> events;
+        std::ifstream ifs(path);
+        std::string line;
+        while (std::getline(ifs, line)) {
+            std::istringstream iss(line);
+            int x, y, p;
+            timestamp t;
+            char sep;
+            iss >> x >> sep >> y >> sep >> p >> sep >> t;
+            events.emplace_back(x, y, p, t);
+        }
+        return events;
+    }
+
+    std::vector<EventCD> expected_events_;
+    std::string output_dir_;
+};
+
+TEST_F(BatchConverterConversion_GTest, convert_to_csv) {
+    // GIVEN RAW files, converted by a single worker so that the second file reuses the buffers of the first one
+    const std::vector<std::string> input_files = {write_raw_file("file_1.raw"), write_raw_file("file_2.raw")};
+    BatchConverter converter(1);
+    BatchConversionRecipe recipe;
+    recipe.format     = BatchConversionFormat::CSV;
+    recipe.output_dir = output_dir_;
+
+    // WHEN we convert them
+    const auto report = converter.run(input_files, recipe);
+
+    // THEN all the events are written in the CSV files
+    ASSERT_TRUE(report.failed_files.empty());
+    EXPECT_EQ(input_files.size(), report.converted_files);
+    EXPECT_EQ(input_files.size() * expected_events_.size(), report.events);
+    EXPECT_EQ(boost::filesystem::file_size(input_files[0]) + boost::filesystem::file_size(input_files[1]),
+              report.input_bytes);
+
+    for (const auto &input_file : input_files) {
+        const auto events = read_csv_file(BatchConverter::get_output_path(input_file, recipe));
+        ASSERT_EQ(expected_events_.size(), events.size());
+        // The timestamps are shifted by the same offset as when reading the RAW file with a camera
+        const timestamp ts_shift = expected_events_[0].t - events[0].t;
+        for (size_t i = 0; i < events.size(); ++i) {
+            ASSERT_EQ(expected_events_[i].x, events[i].x);
+            ASSERT_EQ(expected_events_[i].y, events[i].y);
+            ASSERT_EQ(expected_events_[i].p, events[i].p);
+            ASSERT_EQ(expected_events_[i].t - ts_shift, events[i].t);
+        }
+    }
+}
+
+TEST_F(BatchConverterConversion_GTest, convert_to_dat) {
+    // GIVEN a RAW file
+    const std::vector<std::string> input_files = {write_raw_file("file.raw")};
+    BatchConverter converter(1);
+    BatchConversionRecipe recipe;
+    recipe.output_dir = output_dir_;
+
+    // WHEN we convert it to DAT
+    const auto report = converter.run(input_files, recipe);
+
+    // THEN the events are written in the DAT file
+    ASSERT_TRUE(report.failed_files.empty());
+    EXPECT_EQ(1u, report.converted_files);
+    EXPECT_EQ(expected_events_.size(), report.events);
+    const std::string output_path = BatchConverter::get_output_path(input_files[0], recipe);
+    ASSERT_TRUE(boost::filesystem::exists(output_path));
+    // EventCD are encoded on 8 bytes in DAT files, after the header
+    EXPECT_LE(expected_events_.size() * 8, boost::filesystem::file_size(output_path));
+}
+
+TEST_F(BatchConverterConversion_GTest, convert_to_video_reusing_frame_generation) {
+    // GIVEN RAW files, converted by a single worker so that the second file reuses the frame generation of the first
+    // one
+    const std::vector<std::string> input_files = {write_raw_file("file_1.raw"), write_raw_file("file_2.raw")};
+    BatchConverter converter(1);
+    BatchConversionRecipe recipe;
+    recipe.format     = BatchConversionFormat::Video;
+    recipe.output_dir = output_dir_;
+
+    // WHEN we convert them twice
+    auto report = converter.run(input_files, recipe);
+    ASSERT_TRUE(report.failed_files.empty());
+    const auto first_size = boost::filesystem::file_size(BatchConverter::get_output_path(input_files[0], recipe));
+    report                = converter.run(input_files, recipe);
+
+    // THEN the videos of the same recording are the same, whatever the frames generated before
+    ASSERT_TRUE(report.failed_files.empty());
+    EXPECT_EQ(input_files.size(), report.converted_files);
+    EXPECT_EQ(input_files.size() * expected_events_.size(), report.events);
+    for (const auto &input_file : input_files) {
+        EXPECT_LT(0u, boost::filesystem::file_size(BatchConverter::get_output_path(input_file, recipe)));
+        EXPECT_EQ(first_size, boost::filesystem::file_size(BatchConverter::get_output_path(input_file, recipe)));
+    }
+}
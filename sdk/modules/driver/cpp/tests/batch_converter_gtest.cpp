@@ -0,0 +1,94 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <set>
+#include <string>
+#include <vector>
+#include <boost/filesystem.hpp>
+
+#include "metavision/sdk/driver/batch_converter.h"
+#include "metavision/utils/gtest/gtest_with_tmp_dir.h"
+
+using namespace Metavision;
+
+class BatchConverter_GTest : public GTestWithTmpDir {};
+
+TEST_F(BatchConverter_GTest, number_of_workers) {
+    EXPECT_EQ(3u, BatchConverter(3).get_num_workers());
+    EXPECT_LE(1u, BatchConverter().get_num_workers());
+
+    // the memory cap is too low for more than one worker
+    EXPECT_EQ(1u, BatchConverter(8, 1).get_num_workers());
+    // the memory cap is large enough not to limit the number of workers
+    EXPECT_EQ(8u, BatchConverter(8, 1024 * 1024 * 1024).get_num_workers());
+}
+
+TEST_F(BatchConverter_GTest, output_path) {
+    BatchConversionRecipe recipe;
+    recipe.format = BatchConversionFormat::CSV;
+    EXPECT_EQ(boost::filesystem::path("dir/file_cd.csv"),
+              boost::filesystem::path(BatchConverter::get_output_path("dir/file.raw", recipe)));
+
+    recipe.format     = BatchConversionFormat::Video;
+    recipe.output_dir = "out";
+    EXPECT_EQ(boost::filesystem::path("out/file.avi"),
+              boost::filesystem::path(BatchConverter::get_output_path("dir/file.raw", recipe)));
+}
+
+TEST_F(BatchConverter_GTest, failed_files_are_reported) {
+    const std::vector<std::string> input_files = {tmpdir_handler_->get_full_path("does_not_exist_1.raw"),
+                                                  tmpdir_handler_->get_full_path("does_not_exist_2.raw"),
+                                                  tmpdir_handler_->get_full_path("does_not_exist_3.raw")};
+
+    BatchConverter converter(2);
+    std::set<std::string> processed_files;
+    size_t last_n_processed = 0;
+    converter.set_progress_callback(
+        [&](const std::string &input_file, const std::string &error, size_t n_processed, size_t n_files) {
+            EXPECT_FALSE(error.empty());
+            EXPECT_EQ(input_files.size(), n_files);
+            EXPECT_EQ(last_n_processed + 1, n_processed);
+            last_n_processed = n_processed;
+            processed_files.insert(input_file);
+        });
+
+    auto report = converter.run(input_files, BatchConversionRecipe());
+    EXPECT_EQ(0u, report.converted_files);
+    EXPECT_EQ(input_files.size(), report.failed_files.size());
+    EXPECT_EQ(input_files.size(), processed_files.size());
+    EXPECT_EQ(0u, report.input_bytes);
+
+    // the workers are reused for the next batch
+    report = converter.run({input_files[0]}, BatchConversionRecipe());
+    EXPECT_EQ(1u, report.failed_files.size());
+
+    // an empty batch returns right away
+    report = converter.run({}, BatchConversionRecipe());
+    EXPECT_EQ(0u, report.converted_files);
+    EXPECT_TRUE(report.failed_files.empty());
+}
+
+TEST_F(BatchConverter_GTest, progress_callback_can_call_the_converter) {
+    const std::vector<std::string> input_files = {tmpdir_handler_->get_full_path("does_not_exist_1.raw"),
+                                                  tmpdir_handler_->get_full_path("does_not_exist_2.raw")};
+
+    // the callback replaces itself, which requires the converter not to be locked while it is called
+    BatchConverter converter(2);
+    size_t n_calls = 0;
+    converter.set_progress_callback([&](const std::string &, const std::string &, size_t, size_t) {
+        ++n_calls;
+        converter.set_progress_callback([&](const std::string &, const std::string &, size_t, size_t) { ++n_calls; });
+    });
+
+    auto report = converter.run(input_files, BatchConversionRecipe());
+    EXPECT_EQ(input_files.size(), report.failed_files.size());
+    EXPECT_EQ(input_files.size(), n_calls);
+}
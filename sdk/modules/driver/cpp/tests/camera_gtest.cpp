@@ -21,7 +21,9 @@
 #include <thread>
 
 #include "metavision/hal/device/device_discovery.h"
+#include "metavision/hal/facilities/i_hw_identification.h"
 #include "metavision/hal/utils/raw_file_header.h"
+#include "metavision/hal/utils/shm_ring.h"
 #include "metavision/sdk/base/utils/timestamp.h"
 #include "metavision/utils/gtest/gtest_with_tmp_dir.h"
 #include "metavision/utils/gtest/gtest_custom.h"
@@ -1044,6 +1046,39 @@ TEST_F(Camera_Gtest, multiple_events_callbacks) {
     ASSERT_LE(n_cd_decoded, 0);
 }
 
+TEST_F(Camera_Gtest, runtime_stats) {
+    const auto expected_events = write_evt2_raw_data();
+    Camera camera              = Camera::from_file(tmp_file_, false);
+
+    size_t n_raw_bytes = 0;
+    camera.raw_data().add_callback([&n_raw_bytes](const uint8_t *, size_t size) { n_raw_bytes += size; });
+    CallbackId cd_cb_id = camera.cd().add_callback([](const EventCD *ev_begin, const EventCD *ev_end) {});
+
+    // resets the measurement period
+    camera.get_stats();
+
+    camera.start();
+    while (camera.is_running()) {
+        std::this_thread::sleep_for(std::chrono::microseconds(1000));
+    }
+    camera.stop();
+
+    const CameraStats stats = camera.get_stats();
+    ASSERT_LT(0, stats.period_us);
+    ASSERT_NEAR(expected_events.size(), stats.cd_events_rate * stats.period_us / 1e6, 1);
+    ASSERT_NEAR(n_raw_bytes, stats.raw_bytes_rate * stats.period_us / 1e6, 1);
+    ASSERT_EQ(0, stats.ext_trigger_events_rate);
+    ASSERT_EQ(1, stats.callbacks_time_us.count(cd_cb_id));
+    ASSERT_EQ(0, stats.buffers_in_flight);
+    ASSERT_EQ(0, stats.dropped_buffers);
+
+    // counters are reset after each call
+    const CameraStats stats_after = camera.get_stats();
+    ASSERT_EQ(0, stats_after.cd_events_rate);
+    ASSERT_EQ(0, stats_after.raw_bytes_rate);
+    ASSERT_TRUE(stats_after.callbacks_time_us.empty());
+}
+
 TEST_F_WITHOUT_CAMERA(Camera_Gtest, roi_with_file) {
     //////////////////////////////////////////////////////
     // PURPOSE
@@ -1262,6 +1297,52 @@ TEST_F(Camera_Gtest, decode_evt2_data) {
     }
 }
 
+#ifndef _WIN32
+TEST_F(Camera_Gtest, open_stream_published_in_shm_ring) {
+    const auto expected_events = write_evt2_raw_data();
+
+    // File-backed producer, publishing its RAW data in a shared memory ring
+    Camera producer = Camera::from_file(tmp_file_, false);
+    const std::string name =
+        "mv_driver_gtest_" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count());
+    const auto header = producer.get_device().get_facility<I_HW_Identification>()->get_header();
+    auto writer       = std::make_unique<ShmRingWriter>(name, header.to_string());
+    producer.raw_data().add_callback([&writer](const uint8_t *data, size_t size) { writer->write(data, size); });
+
+    Camera consumer;
+    try {
+        consumer = Camera::from_serial(ShmRingSerialPrefix + name);
+    } catch (CameraException &e) { FAIL() << e.what(); }
+
+    std::vector<EventCD> received_events;
+    consumer.cd().add_callback(
+        [&](auto ev_begin, auto ev_end) { received_events.insert(received_events.end(), ev_begin, ev_end); });
+
+    consumer.start();
+    producer.start();
+    while (producer.is_running()) {
+        std::this_thread::sleep_for(std::chrono::microseconds(1000));
+    }
+    producer.stop();
+
+    // Closing the ring stops the consumer once it has read everything
+    writer.reset();
+    while (consumer.is_running()) {
+        std::this_thread::sleep_for(std::chrono::microseconds(1000));
+    }
+    consumer.stop();
+
+    ASSERT_EQ(expected_events.size(), received_events.size());
+    using SizeType = std::vector<EventCD>::size_type;
+    for (SizeType i = 0, i_end = expected_events.size(); i < i_end; ++i) {
+        ASSERT_EQ(expected_events[i].x, received_events[i].x);
+        ASSERT_EQ(expected_events[i].y, received_events[i].y);
+        ASSERT_EQ(expected_events[i].p, received_events[i].p);
+        ASSERT_EQ(expected_events[i].t, received_events[i].t);
+    }
+}
+#endif
+
 TEST_F_WITH_DATASET(Camera_Gtest, decode_evt3_data) {
     // Read the dataset provided
     std::string dataset_file_path =